@@ -177,6 +177,24 @@ void CopyPrebuiltContent()
   Download(outputDirectory);
 }
 
+void RunReplicationBenchmark()
+{
+  // Session settings can be overridden on the command line, e.g.
+  // "-ReplicationBenchmark -Clients 8 -Replicas 1024 -Latency 50 -PacketLoss 0.05"
+  ReplicationBenchmarkSettings settings;
+  settings.mClientCount = Environment::GetValue<uint>("Clients", settings.mClientCount);
+  settings.mReplicaCount = Environment::GetValue<uint>("Replicas", settings.mReplicaCount);
+  settings.mFrameCount = Environment::GetValue<uint>("Frames", settings.mFrameCount);
+  settings.mFrameInterval = Environment::GetValue<TimeMs>("FrameInterval", settings.mFrameInterval);
+  settings.mConditions.mLatency = Environment::GetValue<TimeMs>("Latency", settings.mConditions.mLatency);
+  settings.mConditions.mJitter = Environment::GetValue<TimeMs>("Jitter", settings.mConditions.mJitter);
+  settings.mConditions.mLossChance = Environment::GetValue<float>("PacketLoss", settings.mConditions.mLossChance);
+
+  ZPrint("Running replication benchmark...\n");
+  String results = ReplicationBenchmark::Run(settings);
+  ZPrint("ReplicationBenchmark: %s\n", results.Empty() ? "failed" : results.c_str());
+}
+
 void BindAppCommands(Cog* config, CommandManager* commands)
 {
   commands->AddCommand("About", BindCommandFunction(ShowAbout), true);
@@ -193,6 +211,7 @@ void BindAppCommands(Cog* config, CommandManager* commands)
   commands->AddCommand("Documentation", BindCommandFunction(OpenDocumentation), true);
 
   commands->AddCommand("CopyPrebuiltContent", BindCommandFunction(CopyPrebuiltContent));
+  commands->AddCommand("ReplicationBenchmark", BindCommandFunction(RunReplicationBenchmark));
 }
 
 } // namespace Raverie
@@ -4,17 +4,74 @@
 namespace Raverie
 {
 
+// Bits are stored left-justified (most significant bit first), so a run of
+// stream bits reads as a big-endian integer. These let the unaligned paths
+// move 32 bits at a time through a 64-bit accumulator instead of bit by bit.
+inline u32 LoadBigEndian32(const byte* bytes)
+{
+  return (u32(bytes[0]) << 24) | (u32(bytes[1]) << 16) | (u32(bytes[2]) << 8) | u32(bytes[3]);
+}
+inline void StoreBigEndian32(byte* bytes, u32 value)
+{
+  bytes[0] = byte(value >> 24);
+  bytes[1] = byte(value >> 16);
+  bytes[2] = byte(value >> 8);
+  bytes[3] = byte(value);
+}
+/// Mask of the N left-justified bits of a byte (N in [0, 8])
+inline byte LeftBitMask(Bits n)
+{
+  return byte(0xFF00 >> n);
+}
+/// Mask of the N left-justified bits of a 32-bit word (N in [1, 32])
+inline u32 LeftBitMask32(Bits n)
+{
+  return ~u32(0) << (32 - n);
+}
+
+/// Reference count stored in front of every BitStream data array
+/// (Copies of a BitStream share the same data array until one is written to)
+struct BitStreamDataHeader
+{
+  Atomic<s32> mReferenceCount;
+};
+
+/// Allocates an unshared data array of the specified capacity (uninitialized)
+inline byte* AllocateBitStreamData(Bytes capacity)
+{
+  byte* block = new byte[sizeof(BitStreamDataHeader) + capacity];
+  BitStreamDataHeader* header = new (block) BitStreamDataHeader;
+  header->mReferenceCount = 1;
+  return block + sizeof(BitStreamDataHeader);
+}
+/// Returns the header of the data array
+inline BitStreamDataHeader* GetBitStreamDataHeader(const byte* data)
+{
+  return reinterpret_cast<BitStreamDataHeader*>(const_cast<byte*>(data) - sizeof(BitStreamDataHeader));
+}
+/// Adds a reference to the data array
+inline void AcquireBitStreamData(const byte* data)
+{
+  if (data)
+    ++GetBitStreamDataHeader(data)->mReferenceCount;
+}
+/// Removes a reference to the data array, freeing it once unreferenced
+inline void ReleaseBitStreamData(byte* data)
+{
+  if (data && GetBitStreamDataHeader(data)->mReferenceCount.FetchSubtract(1) == 1)
+    delete[] (data - sizeof(BitStreamDataHeader));
+}
+
 //                                  BitStream //
 
 BitStream::BitStream()
 {
   Initialize();
 }
-BitStream::BitStream(const BitStream& rhs) :
-    mData(rhs.mByteCapacity ? new byte[rhs.mByteCapacity] : nullptr), mByteCapacity(rhs.mByteCapacity), mBitsWritten(rhs.mBitsWritten), mBitsRead(rhs.mBitsRead), mAlignment(rhs.mAlignment)
+BitStream::BitStream(const BitStream& rhs) : mData(rhs.mData), mByteCapacity(rhs.mByteCapacity), mBitsWritten(rhs.mBitsWritten), mBitsRead(rhs.mBitsRead), mAlignment(rhs.mAlignment)
 {
-  if (mData)
-    memcpy(mData, rhs.mData, rhs.mByteCapacity);
+  // Share their data array
+  AcquireBitStreamData(mData);
 }
 BitStream::BitStream(MoveReference<BitStream> rhs) : mData(rhs->mData), mByteCapacity(rhs->mByteCapacity), mBitsWritten(rhs->mBitsWritten), mBitsRead(rhs->mBitsRead), mAlignment(rhs->mAlignment)
 {
@@ -30,11 +87,12 @@ BitStream& BitStream::operator=(const BitStream& rhs)
 {
   if (this != &rhs)
   {
-    // Capacity too small to fit data?
-    if (mByteCapacity < rhs.mByteCapacity)
-      Reallocate(rhs.mByteCapacity, false);
+    // Share their data array
+    AcquireBitStreamData(rhs.mData);
+    ReleaseBitStreamData(mData);
 
-    memcpy(mData, rhs.mData, rhs.mByteCapacity);
+    mData = rhs.mData;
+    mByteCapacity = rhs.mByteCapacity;
     mBitsWritten = rhs.mBitsWritten;
     mBitsRead = rhs.mBitsRead;
     mAlignment = rhs.mAlignment;
@@ -87,12 +145,20 @@ void BitStream::Clear(bool freeMemory)
   if (freeMemory)
   {
     // Free memory
-    if (mData)
-      delete[] mData;
+    ReleaseBitStreamData(mData);
     Initialize();
   }
   else
   {
+    // Shared with copies?
+    if (IsDataShared())
+    {
+      // Replace with our own zeroed data array of the same capacity
+      byte* data = AllocateBitStreamData(mByteCapacity);
+      ReleaseBitStreamData(mData);
+      mData = data;
+    }
+
     // Zero memory
     if (mData)
       memset(mData, 0, mByteCapacity);
@@ -130,8 +196,6 @@ Bits BitStream::WriteBits(const byte* data, Bits dataBits)
   Assert(data && dataBits);
   // Data size must not exceed maximum possible BitStream size
   Assert(dataBits <= BYTES_TO_BITS(BITSTREAM_MAX_BYTES));
-  // Data must not overlap with internal BitStream memory
-  Assert(!MemoryIsOverlapping(mData, mByteCapacity, data, BITS_TO_BYTES(dataBits)));
 
   // Byte Alignment?
   if (mAlignment == BitAlignment::Byte)
@@ -156,6 +220,10 @@ Bits BitStream::WriteBits(const byte* data, Bits dataBits)
   // Ensure there is enough space before continuing
   ReallocateIfNecessary(dataBits);
 
+  // Data must not overlap with internal BitStream memory
+  // (Checked once our data array is no longer shared with copies)
+  Assert(!MemoryIsOverlapping(mData, mByteCapacity, data, BITS_TO_BYTES(dataBits)));
+
   // Get full bytes and remaining bits written
   Bytes fullBytesWritten = DIV8(mBitsWritten);
   Bits remBitsWritten = MOD8(mBitsWritten);
@@ -167,58 +235,62 @@ Bits BitStream::WriteBits(const byte* data, Bits dataBits)
 
   Assert(BYTES_TO_BITS(fullBytesWritten) + remBitsWritten == mBitsWritten && BYTES_TO_BITS(fullDataBytes) + remDataBits == dataBits);
 
+  // The accumulator holds the pending output bits left-justified, starting
+  // with the bits already written to the current byte
+  u64 accumulator = u64(*writeCursor & LeftBitMask(remBitsWritten)) << 56;
+
   // Write full data bytes first (if any)
-  if (writeCursorByteAligned && fullDataBytes)
+  Bits remainingBits = dataBits;
+  if (writeCursorByteAligned)
   {
     // Byte aligned?
     // Write bytes using memcpy
-    memcpy(writeCursor, dataCursor, fullDataBytes);
+    if (fullDataBytes)
+      memcpy(writeCursor, dataCursor, fullDataBytes);
     dataCursor += fullDataBytes;
-    fullBytesWritten += fullDataBytes;
     writeCursor += fullDataBytes;
+    remainingBits = remDataBits;
   }
   else
   {
     // Not byte aligned?
-    // Write bytes manually
-    for (Bytes k = 0; k < fullDataBytes; ++k)
+    // Shift 32 data bits at a time in behind the pending bits (the accumulator
+    // holds exactly remBitsWritten pending bits between words)
+    while (remainingBits >= 32)
     {
-      // Write a data byte
-      for (Bits i = 0; i < 8; ++i)
-      {
-        // Write value at cursor
-        ASSIGN_LBIT(*dataCursor & LBIT(i), writeCursor, remBitsWritten);
-
-        ++remBitsWritten;
-
-        // Write cursor reached a byte boundary?
-        if (remBitsWritten == 8)
-        {
-          remBitsWritten = 0;
-          ++fullBytesWritten;
-          ++writeCursor;
-        }
-      }
-
-      ++dataCursor;
+      accumulator |= u64(LoadBigEndian32(dataCursor)) << (32 - remBitsWritten);
+      StoreBigEndian32(writeCursor, u32(accumulator >> 32));
+      accumulator <<= 32;
+      dataCursor += 4;
+      writeCursor += 4;
+      remainingBits -= 32;
     }
   }
 
   // Write remaining data bits second (if any)
-  for (Bits i = 0; i < remDataBits; ++i)
+  if (remainingBits)
   {
-    // Write value at cursor
-    ASSIGN_LBIT(*dataCursor & LBIT(i), writeCursor, remBitsWritten);
+    // Gather the remaining (less than 32) data bits in behind the pending bits
+    u32 word = 0;
+    Bytes remainingBytes = BITS_TO_BYTES(remainingBits);
+    for (Bytes i = 0; i < remainingBytes; ++i)
+      word |= u32(dataCursor[i]) << (24 - 8 * i);
+    accumulator |= u64(word & LeftBitMask32(remainingBits)) << (32 - remBitsWritten);
+  }
 
-    ++remBitsWritten;
+  // Flush the pending bits
+  Bits accumulatorBits = remBitsWritten + remainingBits;
+  for (; accumulatorBits >= 8; accumulatorBits -= 8)
+  {
+    *writeCursor++ = byte(accumulator >> 56);
+    accumulator <<= 8;
+  }
 
-    // Write cursor reached a byte boundary?
-    if (remBitsWritten == 8)
-    {
-      remBitsWritten = 0;
-      ++fullBytesWritten;
-      ++writeCursor;
-    }
+  // Leave the bits past the end of the written data untouched
+  if (accumulatorBits)
+  {
+    byte mask = LeftBitMask(accumulatorBits);
+    *writeCursor = (byte(accumulator >> 56) & mask) | (*writeCursor & ~mask);
   }
 
   mBitsWritten += dataBits;
@@ -247,10 +319,11 @@ Bits BitStream::WriteUntilByteAligned()
   Bits remBitsWritten = MOD8(mBitsWritten);
   if (remBitsWritten)
   {
-    // Write pad bits
+    // Write pad bits (clear the rest of the current byte)
     Bits padBits = 8 - remBitsWritten;
-    for (Bits i = 0; i < padBits; ++i)
-      WriteBit(false);
+    ReallocateIfNecessary(padBits);
+    mData[DIV8(mBitsWritten)] &= LeftBitMask(remBitsWritten);
+    mBitsWritten += padBits;
 
     // Write cursor should now be byte aligned
     Assert(!MOD8(mBitsWritten));
@@ -402,57 +475,45 @@ Bits BitStream::ReadBits(byte* data, Bits dataBits) const
   Assert(BYTES_TO_BITS(fullBytesRead) + remBitsRead == mBitsRead && BYTES_TO_BITS(fullDataBytes) + remDataBits == dataBits);
 
   // Read full data bytes first (if any)
-  if (readCursorByteAligned && fullDataBytes)
+  Bits remainingBits = dataBits;
+  if (readCursorByteAligned)
   {
     // Byte aligned?
     // Read bytes using memcpy
-    memcpy(dataCursor, readCursor, fullDataBytes);
+    if (fullDataBytes)
+      memcpy(dataCursor, readCursor, fullDataBytes);
     dataCursor += fullDataBytes;
-    fullBytesRead += fullDataBytes;
     readCursor += fullDataBytes;
+    remainingBits = remDataBits;
   }
   else
   {
     // Not byte aligned?
-    // Read bytes manually
-    for (Bytes k = 0; k < fullDataBytes; ++k)
+    // Read 32 bits at a time, each word straddles up to 5 stream bytes (the
+    // 5th byte is always within the unread data since at least 32 bits remain)
+    while (remainingBits >= 32)
     {
-      // Read a data byte
-      for (Bits i = 0; i < 8; ++i)
-      {
-        // Write value at data cursor
-        ASSIGN_LBIT(*readCursor & LBIT(remBitsRead), dataCursor, i);
-
-        ++remBitsRead;
-
-        // Read cursor reached a byte boundary?
-        if (remBitsRead == 8)
-        {
-          remBitsRead = 0;
-          ++fullBytesRead;
-          ++readCursor;
-        }
-      }
-
-      ++dataCursor;
+      u64 accumulator = (u64(LoadBigEndian32(readCursor)) << 32) | (u64(readCursor[4]) << 24);
+      StoreBigEndian32(dataCursor, u32(accumulator >> (32 - remBitsRead)));
+      dataCursor += 4;
+      readCursor += 4;
+      remainingBits -= 32;
     }
   }
 
   // Read remaining data bits second (if any)
-  for (Bits i = 0; i < remDataBits; ++i)
+  if (remainingBits)
   {
-    // Write value at data cursor
-    ASSIGN_LBIT(*readCursor & LBIT(remBitsRead), dataCursor, i);
-
-    ++remBitsRead;
-
-    // Read cursor reached a byte boundary?
-    if (remBitsRead == 8)
-    {
-      remBitsRead = 0;
-      ++fullBytesRead;
-      ++readCursor;
-    }
+    // Gather only the stream bytes that hold the remaining (less than 32) bits
+    u64 accumulator = 0;
+    Bytes streamBytes = BITS_TO_BYTES(remBitsRead + remainingBits);
+    for (Bytes i = 0; i < streamBytes; ++i)
+      accumulator |= u64(readCursor[i]) << (56 - 8 * i);
+
+    u32 word = u32(accumulator >> (32 - remBitsRead)) & LeftBitMask32(remainingBits);
+    Bytes remainingBytes = BITS_TO_BYTES(remainingBits);
+    for (Bytes i = 0; i < remainingBytes; ++i)
+      dataCursor[i] = byte(word >> (24 - 8 * i));
   }
 
   mBitsRead += dataBits;
@@ -548,17 +609,10 @@ Bits BitStream::ReadUntilByteAligned() const
   if (remBitsRead)
   {
     // Read pad bits
-    bool padValue;
     Bits padBits = 8 - remBitsRead;
-    for (Bits i = 0; i < padBits; ++i)
-    {
-      if (!ReadBit(padValue)) // Unable?
-      {
-        // Failure
-        Unread(i);
-        return 0;
-      }
-    }
+    if (padBits > GetBitsUnread()) // Unable?
+      return 0; // Failure
+    mBitsRead += padBits;
 
     // Read cursor should now be byte aligned
     Assert(!MOD8(mBitsRead));
@@ -597,6 +651,28 @@ void BitStream::ReallocateIfNecessary(Bits additionalBits)
     else
       Reallocate(growSize, true);
   }
+  // Shared with copies?
+  else
+    MakeDataUnique();
+}
+bool BitStream::IsDataShared() const
+{
+  return mData && GetBitStreamDataHeader(mData)->mReferenceCount > 1;
+}
+void BitStream::MakeDataUnique()
+{
+  // Not shared?
+  if (!IsDataShared())
+    return;
+
+  // Copy the bytes written into our own data array (zeroing the rest)
+  Bytes bytesWritten = std::min(GetBytesWritten(), mByteCapacity);
+  byte* data = AllocateBitStreamData(mByteCapacity);
+  memcpy(data, mData, bytesWritten);
+  memset(data + bytesWritten, 0, mByteCapacity - bytesWritten);
+
+  ReleaseBitStreamData(mData);
+  mData = data;
 }
 void BitStream::Reallocate(Bytes capacity, bool copyData)
 {
@@ -604,7 +680,7 @@ void BitStream::Reallocate(Bytes capacity, bool copyData)
 
   byte* temp = mData;
   Bytes tempCapacity = GetByteCapacity();
-  mData = new byte[capacity];
+  mData = AllocateBitStreamData(capacity);
   mByteCapacity = capacity;
 
   Assert(mByteCapacity > tempCapacity);
@@ -619,8 +695,8 @@ void BitStream::Reallocate(Bytes capacity, bool copyData)
     memset(mData + tempCapacity, 0, mByteCapacity - tempCapacity); // Zero the rest
   }
 
-  if (temp)
-    delete[] temp;
+  // (Copies sharing the previous data array keep it alive)
+  ReleaseBitStreamData(temp);
 }
 
 String GetBinaryString(const BitStream& bitStream, Bytes bytesPerLine)
@@ -42,12 +42,15 @@ class BitStream;
 //                                  BitStream //
 
 /// Bit-packed data stream
+/// Copies share the same reference-counted data array, which is only copied
+/// once a copy is written to (copy-on-write)
 class BitStream
 {
 public:
   /// Default Constructor
   BitStream();
   /// Copy Constructor
+  /// Shares the data array with rhs until either is written to
   BitStream(const BitStream& rhs);
   /// Move Constructor
   BitStream(MoveReference<BitStream> rhs);
@@ -56,6 +59,7 @@ public:
   ~BitStream();
 
   /// Copy Assignment Operator
+  /// Shares the data array with rhs until either is written to
   BitStream& operator=(const BitStream& rhs);
   /// Move Assignment Operator
   BitStream& operator=(MoveReference<BitStream> rhs);
@@ -522,8 +526,13 @@ protected:
   void ReallocateIfNecessary(Bits additionalBits);
   /// Reallocates to the specified capacity, copying data if copyData is enabled
   void Reallocate(Bytes capacity, bool copyData);
+  /// Returns true if the data array is shared with copies of this BitStream, else false
+  bool IsDataShared() const;
+  /// Copies the data array if it is shared with copies of this BitStream
+  /// Must be called before modifying the data array
+  void MakeDataUnique();
 
-  /// Binary data array
+  /// Binary data array (reference-counted, shared between copies)
   byte* mData;
   /// Binary data capacity
   Bytes mByteCapacity;
@@ -56,6 +56,7 @@ inline const byte* BitStream::GetData() const
 }
 inline byte* BitStream::GetDataExposed()
 {
+  MakeDataUnique();
   return mData;
 }
 
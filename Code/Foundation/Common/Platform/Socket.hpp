@@ -76,6 +76,19 @@ public:
 
   /// Clears the socket address
   void Clear();
+
+private:
+  /// Address family
+  SocketAddressFamily::Enum mFamily;
+  /// Port number (only used by IPv4/IPv6 socket addresses)
+  uint mPort;
+  /// Host address in network byte order (IPv4 only uses the first four bytes)
+  byte mHost[Ipv6AddressBytes];
+
+  // Friends
+  friend Bits Serialize(SerializeDirection::Enum direction, BitStream& bitStream, SocketAddress& socketAddress);
+  friend String Ipv4AddressToString(const SocketAddress& address);
+  friend String Ipv6AddressToString(const SocketAddress& address);
 };
 
 /// Serializes a socket address (currently only defined for InternetworkV4 and
@@ -191,6 +204,21 @@ SocketAddress StringToIpv4Address(StringParam address, ushort port);
 SocketAddress StringToIpv6Address(StringParam address);
 SocketAddress StringToIpv6Address(StringParam address, ushort port);
 
+//                                SocketDatagram //
+
+/// A single datagram within a batched send or receive
+struct SocketDatagram
+{
+  SocketDatagram() : mData(nullptr), mDataLength(0), mBytes(0), mAddress()
+  {
+  }
+
+  byte* mData;            /// Datagram buffer
+  size_t mDataLength;     /// Datagram length on send, buffer capacity on receive
+  size_t mBytes;          /// Bytes actually sent or received
+  SocketAddress mAddress; /// Destination address on send, source address on receive
+};
+
 //                                    Socket //
 
 /// Network host endpoint
@@ -385,6 +413,21 @@ public:
   /// status will contain the error)
   size_t ReceiveFrom(Status& status, byte* dataOut, size_t dataLength, SocketAddress& from, SocketFlags::Enum flags = SocketFlags::None);
 
+  /// Sends each datagram on the open socket to its destination address
+  /// Backends with a batched send call (such as sendmmsg) send the whole batch
+  /// at once, else the datagrams are sent one at a time
+  /// Returns the number of datagrams sent (stops at the first error, status
+  /// will contain the error)
+  size_t SendToBatch(Status& status, SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags = SocketFlags::None);
+
+  /// Receives up to the specified number of datagrams on the open socket from
+  /// any remote address Will block until at least one datagram is received
+  /// (unless the socket is set to non-blocking), then receives only what is
+  /// immediately available Backends with a batched receive call (such as
+  /// recvmmsg) receive the whole batch at once Returns the number of
+  /// datagrams received (0 if an error occurs, status will contain the error)
+  size_t ReceiveFromBatch(Status& status, SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags = SocketFlags::None);
+
   /// Returns true if the specified socket capability is ready for use, else
   /// false In a high efficiency situation, mechanisms other than select should
   /// be used
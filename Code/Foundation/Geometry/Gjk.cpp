@@ -107,6 +107,54 @@ Type Gjk::TestDebug(const SupportShape* shapeA, const SupportShape* shapeB, Mani
   return Intersection::None;
 }
 
+bool Gjk::ClosestPoints(const SupportShape* shapeA, const SupportShape* shapeB, Manifold* manifold, unsigned maxIter)
+{
+  Initialize(shapeA, shapeB);
+
+  if (mSupportVector.Length() < sEpsilon)
+    mSupportVector.Set(1, 0, 0);
+
+  Vec3 csoPoint, pointA, pointB;
+  float lastDistanceSq = Math::PositiveMax();
+
+  unsigned iter_count = 0;
+  while (iter_count < maxIter)
+  {
+    // Find support point on Minkowski Difference
+    CSOVertex support = ComputeSupport(mSupportVector);
+
+    // Add point to simplex and reduce it to the geometry closest to the origin
+    mSimplex.AddPoint(support);
+    mSimplex.Update();
+
+    // Overlapping shapes have no separating distance
+    if (mSimplex.ContainsOrigin())
+      return false;
+
+    ComputeClosestPoints(&csoPoint, &pointA, &pointB);
+
+    // Terminate once the new support point no longer moves us closer
+    float distanceSq = csoPoint.LengthSq();
+    if (distanceSq < sEpsilon)
+      return false;
+    if (lastDistanceSq - distanceSq <= sEpsilon * lastDistanceSq)
+      break;
+    lastDistanceSq = distanceSq;
+
+    // Get new support vector
+    mSupportVector = mSimplex.GetSupportVector();
+    ++iter_count;
+  }
+
+  float distance = Math::Sqrt(csoPoint.LengthSq());
+  manifold->PointCount = 1;
+  manifold->Normal = -csoPoint / distance;
+  manifold->Points[0].Depth = -distance;
+  manifold->Points[0].Points[0] = pointA;
+  manifold->Points[0].Points[1] = pointB;
+  return true;
+}
+
 void Gjk::DrawDebug(uint debugFlag)
 {
   DrawCSO();
@@ -337,6 +385,46 @@ bool Gjk::ComputeContactData(Manifold* manifold, unsigned maxExpands, bool debug
   return true;
 }
 
+void Gjk::ComputeClosestPoints(Vec3Ptr csoPoint, Vec3Ptr pointA, Vec3Ptr pointB)
+{
+  CSOVertex* points = mSimplex.mPoints;
+  Vec3 weights(1, 0, 0);
+
+  // The simplex has already been reduced to the feature closest to the
+  // origin, so the origin only needs to be projected onto it
+  if (mSimplex.mCount == 2)
+  {
+    Vec3 lineDir = points[1].cso - points[0].cso;
+    float lengthSq = lineDir.LengthSq();
+    if (lengthSq > sEpsilon)
+    {
+      float t = Math::Clamp(-points[0].cso.Dot(lineDir) / lengthSq, 0.0f, 1.0f);
+      weights.Set(1.0f - t, t, 0.0f);
+    }
+  }
+  else if (mSimplex.mCount == 3)
+  {
+    Vec3 p0p1 = points[1].cso - points[0].cso;
+    Vec3 p0p2 = points[2].cso - points[0].cso;
+    Vec3 normal = p0p1.Cross(p0p2);
+    if (normal.LengthSq() > sEpsilon)
+    {
+      Vec3 projected = normal * (normal.Dot(points[0].cso) / normal.LengthSq());
+      Geometry::BarycentricTriangle(projected, points[0].cso, points[1].cso, points[2].cso, &weights);
+    }
+  }
+
+  *csoPoint = points[0].cso * weights.x;
+  *pointA = points[0].objA * weights.x;
+  *pointB = points[0].objB * weights.x;
+  for (uint i = 1; i < mSimplex.mCount && i < 3; ++i)
+  {
+    *csoPoint += points[i].cso * weights[i];
+    *pointA += points[i].objA * weights[i];
+    *pointB += points[i].objB * weights[i];
+  }
+}
+
 void Gjk::CompleteSimplex(void)
 {
   // The only way gjk could terminate with a single point simplex
@@ -13,6 +13,12 @@ public:
   Type Test(const SupportShape* shapeA, const SupportShape* shapeB, Manifold* manifold = nullptr, unsigned maxIter = 20);
   Type TestDebug(const SupportShape* shapeA, const SupportShape* shapeB, Manifold* manifold = nullptr, unsigned maxIter = 20);
 
+  /// Finds the closest points between two separated shapes. Returns false if
+  /// the shapes overlap. On success the manifold holds a single point whose
+  /// depth is the negative separation distance, with the normal pointing from
+  /// shapeA towards shapeB.
+  bool ClosestPoints(const SupportShape* shapeA, const SupportShape* shapeB, Manifold* manifold, unsigned maxIter = 20);
+
   void DrawDebug(uint debugFlag);
 
   Simplex GetSimplex(void);
@@ -26,6 +32,7 @@ private:
   CSOVertex ComputeSupport(Vec3 supportVector);
   void ComputeCSO(void);
   bool ComputeContactData(Manifold* manifold, unsigned maxExpands = 20, bool debug = false);
+  void ComputeClosestPoints(Vec3Ptr csoPoint, Vec3Ptr pointA, Vec3Ptr pointB);
   void CompleteSimplex(void);
 
   const SupportShape* mShapeA;
@@ -44,86 +44,315 @@ s32 NetworkToHostLong(s32 networkLong)
   return networkLong;
 }
 
+// There is no socket library on this platform, so socket addresses are stored
+// directly and only numeric hosts (plus "localhost") can be resolved. This is
+// enough for in-process transports to address each other.
+
+/// Maximum port number
+static const uint MaxPort = 65535;
+/// Number of 16-bit groups in an IPv6 address
+static const uint Ipv6GroupCount = Ipv6AddressBytes / 2;
+
+/// Parses a numeric IPv4 host ("a.b.c.d") into network byte order
+/// Returns true if successful, else false
+static bool ParseIpv4Host(StringParam host, byte* hostOut)
+{
+  cstr text = host.c_str();
+  for (uint part = 0; part < Ipv4AddressBytes; ++part)
+  {
+    // Parts after the first are separated by periods
+    if (part != 0 && *text++ != '.')
+      return false;
+
+    uint value = 0;
+    uint digits = 0;
+    while (*text >= '0' && *text <= '9')
+    {
+      value = value * 10 + uint(*text++ - '0');
+      if (++digits > 3 || value > 255) // Invalid?
+        return false;
+    }
+    if (digits == 0) // Missing part?
+      return false;
+
+    hostOut[part] = byte(value);
+  }
+
+  return *text == '\0';
+}
+
+/// Returns the value of a hexadecimal digit, else -1
+static int HexDigitValue(char digit)
+{
+  if (digit >= '0' && digit <= '9')
+    return digit - '0';
+  if (digit >= 'a' && digit <= 'f')
+    return digit - 'a' + 10;
+  if (digit >= 'A' && digit <= 'F')
+    return digit - 'A' + 10;
+  return -1;
+}
+
+/// Parses a numeric IPv6 host ("x:x:x:x:x:x:x:x", allowing one "::") into
+/// network byte order
+/// Returns true if successful, else false
+static bool ParseIpv6Host(StringParam host, byte* hostOut)
+{
+  uint groups[Ipv6GroupCount];
+  uint count = 0;
+  int gap = -1;
+
+  cstr text = host.c_str();
+
+  // Leading zero groups?
+  if (text[0] == ':')
+  {
+    if (text[1] != ':')
+      return false;
+    gap = 0;
+    text += 2;
+  }
+
+  while (*text != '\0')
+  {
+    if (count == Ipv6GroupCount) // Too many groups?
+      return false;
+
+    uint value = 0;
+    uint digits = 0;
+    for (int digitValue = HexDigitValue(*text); digitValue != -1; digitValue = HexDigitValue(*text))
+    {
+      value = (value << 4) | uint(digitValue);
+      ++text;
+      if (++digits > 4) // Invalid?
+        return false;
+    }
+    if (digits == 0) // Missing group?
+      return false;
+    groups[count++] = value;
+
+    if (*text == '\0')
+      break;
+
+    // Groups are separated by colons
+    if (*text++ != ':')
+      return false;
+
+    // Zero groups?
+    if (*text == ':')
+    {
+      if (gap != -1) // Only one is allowed
+        return false;
+      gap = int(count);
+      ++text;
+    }
+    // Trailing colon?
+    else if (*text == '\0')
+    {
+      return false;
+    }
+  }
+
+  // Must have every group, or fewer groups and a gap to fill with zeros
+  if (gap == -1 ? count != Ipv6GroupCount : count == Ipv6GroupCount)
+    return false;
+
+  // Groups after the gap are placed at the end
+  uint tailCount = (gap == -1) ? 0 : count - uint(gap);
+  uint headCount = count - tailCount;
+  memset(hostOut, 0, Ipv6AddressBytes);
+  for (uint i = 0; i < count; ++i)
+  {
+    uint position = (i < headCount) ? i : (Ipv6GroupCount - tailCount + (i - headCount));
+    hostOut[position * 2] = byte(groups[i] >> 8);
+    hostOut[position * 2 + 1] = byte(groups[i] & 0xFF);
+  }
+  return true;
+}
+
 //                                SocketAddress //
 SocketAddress::SocketAddress()
 {
+  Clear();
 }
 
-SocketAddress::SocketAddress(const SocketAddress& rhs)
+SocketAddress::SocketAddress(const SocketAddress& rhs) : mFamily(rhs.mFamily), mPort(rhs.mPort)
 {
+  memcpy(mHost, rhs.mHost, sizeof(mHost));
 }
 
 SocketAddress& SocketAddress::operator=(const SocketAddress& rhs)
 {
+  mFamily = rhs.mFamily;
+  mPort = rhs.mPort;
+  memcpy(mHost, rhs.mHost, sizeof(mHost));
   return *this;
 }
 
 bool SocketAddress::operator==(const SocketAddress& rhs) const
 {
-  return false;
+  return mFamily == rhs.mFamily && mPort == rhs.mPort && memcmp(mHost, rhs.mHost, sizeof(mHost)) == 0;
 }
 bool SocketAddress::operator!=(const SocketAddress& rhs) const
 {
-  return false;
+  return !(*this == rhs);
 }
 bool SocketAddress::operator<(const SocketAddress& rhs) const
 {
-  return false;
+  if (mFamily != rhs.mFamily)
+    return mFamily < rhs.mFamily;
+
+  int hostComparison = memcmp(mHost, rhs.mHost, sizeof(mHost));
+  if (hostComparison != 0)
+    return hostComparison < 0;
+
+  return mPort < rhs.mPort;
 }
 
 SocketAddress::operator bool(void) const
 {
-  return false;
+  return !IsEmpty();
 }
 
 bool SocketAddress::IsEmpty() const
 {
-  return true;
+  return mFamily == SocketAddressFamily::Unspecified;
 }
 
 SocketAddressFamily::Enum SocketAddress::GetAddressFamily() const
 {
-  return SocketAddressFamily::Unspecified;
+  return mFamily;
 }
 
 void SocketAddress::SetIpv4(Status& status, StringParam host, uint port)
 {
-  status.SetFailed("Socket not implemented");
+  // An empty host is the unspecified address (any host)
+  byte address[Ipv6AddressBytes] = {};
+  if (host == "localhost")
+  {
+    address[0] = 127;
+    address[3] = 1;
+  }
+  else if (!host.Empty() && !ParseIpv4Host(host, address)) // Unable?
+  {
+    status.SetFailed(String::Format("Unable to resolve IPv4 host '%s' (only numeric hosts can be resolved on this platform)", host.c_str()));
+    return;
+  }
+  if (port > MaxPort) // Invalid?
+  {
+    status.SetFailed("Invalid port");
+    return;
+  }
+
+  mFamily = SocketAddressFamily::InternetworkV4;
+  mPort = port;
+  memcpy(mHost, address, sizeof(mHost));
 }
 
 void SocketAddress::SetIpv4(Status& status, StringParam host, uint port, SocketAddressResolutionFlags::Enum addressResolutionFlags)
 {
-  status.SetFailed("Socket not implemented");
+  UnusedParameter(addressResolutionFlags);
+  SetIpv4(status, host, port);
 }
 
 void SocketAddress::SetIpv6(Status& status, StringParam host, uint port)
 {
-  status.SetFailed("Socket not implemented");
+  // An empty host is the unspecified address (any host)
+  byte address[Ipv6AddressBytes] = {};
+  if (host == "localhost")
+  {
+    address[Ipv6AddressBytes - 1] = 1;
+  }
+  else if (!host.Empty() && !ParseIpv6Host(host, address)) // Unable?
+  {
+    status.SetFailed(String::Format("Unable to resolve IPv6 host '%s' (only numeric hosts can be resolved on this platform)", host.c_str()));
+    return;
+  }
+  if (port > MaxPort) // Invalid?
+  {
+    status.SetFailed("Invalid port");
+    return;
+  }
+
+  mFamily = SocketAddressFamily::InternetworkV6;
+  mPort = port;
+  memcpy(mHost, address, sizeof(mHost));
 }
 
 void SocketAddress::SetIpv6(Status& status, StringParam host, uint port, SocketAddressResolutionFlags::Enum addressResolutionFlags)
 {
-  status.SetFailed("Socket not implemented");
+  UnusedParameter(addressResolutionFlags);
+  SetIpv6(status, host, port);
 }
 
 void SocketAddress::SetIpPort(Status& status, uint port)
 {
-  status.SetFailed("Socket not implemented");
+  if (mFamily != SocketAddressFamily::InternetworkV4 && mFamily != SocketAddressFamily::InternetworkV6) // Not an IP address?
+  {
+    status.SetFailed("Not an IPv4 or IPv6 socket address");
+    return;
+  }
+  if (port > MaxPort) // Invalid?
+  {
+    status.SetFailed("Invalid port");
+    return;
+  }
+
+  mPort = port;
 }
 
 uint SocketAddress::GetIpPort(Status& status) const
 {
-  status.SetFailed("Socket not implemented");
-  return 0;
+  if (mFamily != SocketAddressFamily::InternetworkV4 && mFamily != SocketAddressFamily::InternetworkV6) // Not an IP address?
+  {
+    status.SetFailed("Not an IPv4 or IPv6 socket address");
+    return 0;
+  }
+
+  return mPort;
 }
 
 void SocketAddress::Clear()
 {
+  mFamily = SocketAddressFamily::Unspecified;
+  mPort = 0;
+  memset(mHost, 0, sizeof(mHost));
 }
 
 Bits Serialize(SerializeDirection::Enum direction, BitStream& bitStream, SocketAddress& socketAddress)
 {
-  return 0;
+  const Bits bitsStart = bitStream.GetBitsSerialized(direction);
+
+  // Serialize address family
+  uint8 family = uint8(socketAddress.mFamily);
+  if (!bitStream.SerializeByte(direction, family)) // Unable?
+    return 0;
+
+  // Only IPv4 and IPv6 socket addresses are serializable
+  Bytes hostBytes = 0;
+  if (family == SocketAddressFamily::InternetworkV4)
+    hostBytes = Ipv4AddressBytes;
+  else if (family == SocketAddressFamily::InternetworkV6)
+    hostBytes = Ipv6AddressBytes;
+  else
+    return 0;
+
+  // Serialize host and port
+  byte host[Ipv6AddressBytes] = {};
+  memcpy(host, socketAddress.mHost, hostBytes);
+  u16 port = u16(socketAddress.mPort);
+  if (!bitStream.SerializeBytes(direction, host, hostBytes) || !bitStream.Serialize(direction, port)) // Unable?
+    return 0;
+
+  // Read operation?
+  if (direction == SerializeDirection::Read)
+  {
+    socketAddress.mFamily = SocketAddressFamily::Enum(family);
+    socketAddress.mPort = port;
+    memcpy(socketAddress.mHost, host, sizeof(host));
+  }
+
+  return bitStream.GetBitsSerialized(direction) - bitsStart;
 }
 
 SocketAddress ResolveSocketAddress(Status& status,
@@ -220,54 +449,129 @@ Pair<String, String> ResolveHostAndServiceNames(Status& status, const SocketAddr
 
 String SocketAddressToString(Status& status, SocketAddressFamily::Enum addressFamily, const SocketAddress& address)
 {
-  status.SetFailed("Socket not implemented");
-  return String();
+  if (addressFamily != address.GetAddressFamily()) // Mismatch?
+  {
+    status.SetFailed("Socket address family does not match the specified address family");
+    return String();
+  }
+
+  switch (addressFamily)
+  {
+  case SocketAddressFamily::InternetworkV4:
+    return Ipv4AddressToStringWithPort(address);
+  case SocketAddressFamily::InternetworkV6:
+    return Ipv6AddressToStringWithPort(address);
+  default:
+    status.SetFailed("Only IPv4 and IPv6 socket addresses can be converted to strings on this platform");
+    return String();
+  }
 }
 
 String SocketAddressToString(SocketAddressFamily::Enum addressFamily, const SocketAddress& address)
 {
-  return String();
+  Status status;
+  return SocketAddressToString(status, addressFamily, address);
 }
 
 SocketAddress StringToSocketAddress(Status& status, SocketAddressFamily::Enum addressFamily, StringParam address)
 {
-  status.SetFailed("Socket not implemented");
-  return SocketAddress();
+  SocketAddress result;
+  switch (addressFamily)
+  {
+  case SocketAddressFamily::InternetworkV4:
+    result = StringToIpv4Address(address);
+    break;
+  case SocketAddressFamily::InternetworkV6:
+    result = StringToIpv6Address(address);
+    break;
+  default:
+    break;
+  }
+
+  if (result.IsEmpty()) // Unable?
+    status.SetFailed(String::Format("Unable to convert '%s' to a socket address", address.c_str()));
+  return result;
 }
 
 SocketAddress StringToSocketAddress(SocketAddressFamily::Enum addressFamily, StringParam address)
 {
-  return SocketAddress();
+  Status status;
+  return StringToSocketAddress(status, addressFamily, address);
 }
 
 bool IsValidIpv4Address(const SocketAddress& address)
 {
-  return false;
+  return address.GetAddressFamily() == SocketAddressFamily::InternetworkV4;
 }
 
 bool IsValidIpv6Address(const SocketAddress& address)
 {
-  return false;
+  return address.GetAddressFamily() == SocketAddressFamily::InternetworkV6;
 }
 
 bool IsValidIpv4Address(StringParam address)
 {
-  return false;
+  byte host[Ipv6AddressBytes];
+  return ParseIpv4Host(address, host);
 }
 
 bool IsValidIpv6Address(StringParam address)
 {
-  return false;
+  byte host[Ipv6AddressBytes];
+  return ParseIpv6Host(address, host);
 }
 
 String Ipv4AddressToString(const SocketAddress& address)
 {
-  return String();
+  if (!IsValidIpv4Address(address))
+    return String();
+
+  const byte* host = address.mHost;
+  return String::Format("%u.%u.%u.%u", uint(host[0]), uint(host[1]), uint(host[2]), uint(host[3]));
 }
 
 String Ipv6AddressToString(const SocketAddress& address)
 {
-  return String();
+  if (!IsValidIpv6Address(address))
+    return String();
+
+  uint groups[Ipv6GroupCount];
+  for (uint i = 0; i < Ipv6GroupCount; ++i)
+    groups[i] = (uint(address.mHost[i * 2]) << 8) | uint(address.mHost[i * 2 + 1]);
+
+  // Find the longest run of two or more zero groups (the first if tied) to
+  // write as "::" (as recommended by RFC 5952)
+  uint runStart = Ipv6GroupCount;
+  uint runLength = 1;
+  for (uint i = 0; i < Ipv6GroupCount;)
+  {
+    uint end = i;
+    while (end < Ipv6GroupCount && groups[end] == 0)
+      ++end;
+
+    if (end - i > runLength)
+    {
+      runStart = i;
+      runLength = end - i;
+    }
+    i = (end == i) ? i + 1 : end;
+  }
+
+  StringBuilder builder;
+  for (uint i = 0; i < Ipv6GroupCount; ++i)
+  {
+    if (i == runStart)
+    {
+      builder.Append("::");
+      i += runLength - 1;
+      continue;
+    }
+
+    if (i != 0 && i != runStart + runLength)
+      builder.Append(":");
+    builder.Append(String::Format("%x", groups[i]));
+  }
+  return builder.ToString();
 }
 
 String PortToString(uint port)
@@ -277,32 +581,52 @@ String PortToString(uint port)
 
 String Ipv4AddressToStringWithPort(const SocketAddress& address)
 {
-  return String();
+  if (!IsValidIpv4Address(address))
+    return String();
+
+  Status status;
+  return BuildString(Ipv4AddressToString(address), ":", PortToString(address.GetIpPort(status)));
 }
 
 String Ipv6AddressToStringWithPort(const SocketAddress& address)
 {
-  return String();
+  if (!IsValidIpv6Address(address))
+    return String();
+
+  Status status;
+  return BuildString("[", Ipv6AddressToString(address), "]:", PortToString(address.GetIpPort(status)));
 }
 
 SocketAddress StringToIpv4Address(StringParam address)
 {
-  return SocketAddress();
+  return StringToIpv4Address(address, 0);
 }
 
 SocketAddress StringToIpv4Address(StringParam address, ushort port)
 {
-  return SocketAddress();
+  SocketAddress result;
+  if (IsValidIpv4Address(address))
+  {
+    Status status;
+    result.SetIpv4(status, address, port);
+  }
+  return result;
 }
 
 SocketAddress StringToIpv6Address(StringParam address)
 {
-  return SocketAddress();
+  return StringToIpv6Address(address, 0);
 }
 
 SocketAddress StringToIpv6Address(StringParam address, ushort port)
 {
-  return SocketAddress();
+  SocketAddress result;
+  if (IsValidIpv6Address(address))
+  {
+    Status status;
+    result.SetIpv6(status, address, port);
+  }
+  return result;
 }
 
 //                                    Socket //
@@ -481,6 +805,42 @@ size_t Socket::ReceiveFrom(Status& status, byte* dataOut, size_t dataLength, Soc
   return 0;
 }
 
+size_t Socket::SendToBatch(Status& status, SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags)
+{
+  // No batched send call available, send one at a time
+  for (size_t i = 0; i < datagramCount; ++i)
+  {
+    SocketDatagram& datagram = datagrams[i];
+    datagram.mBytes = SendTo(status, datagram.mData, datagram.mDataLength, datagram.mAddress, flags);
+    if (status.Failed())
+      return i;
+  }
+  return datagramCount;
+}
+
+size_t Socket::ReceiveFromBatch(Status& status, SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags)
+{
+  // No batched receive call available, block on the first datagram then take
+  // any others that are already waiting
+  size_t received = 0;
+  while (received < datagramCount)
+  {
+    if (received != 0)
+    {
+      Status selectStatus;
+      if (!Select(selectStatus, SocketSelect::Read, 0))
+        break;
+    }
+
+    SocketDatagram& datagram = datagrams[received];
+    datagram.mBytes = ReceiveFrom(status, datagram.mData, datagram.mDataLength, datagram.mAddress, flags);
+    if (status.Failed())
+      break;
+    ++received;
+  }
+  return received;
+}
+
 bool Socket::Select(Status& status, SocketSelect::Enum selectMode, float timeoutSeconds) const
 {
   status.SetFailed("Socket not implemented");
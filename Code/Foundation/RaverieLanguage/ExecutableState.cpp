@@ -1059,10 +1059,13 @@ void ExecutableState::ForcePatchLibrary(LibraryParam newLibrary)
                   "go outside! What do we do in that case though... fail patching?");
 
       // Loop through all heap objects and check if any of them are the old type
-      RaverieForEach (const byte* object, this->HeapObjects->LiveObjects)
+      Array<ObjectHeader*> liveHeaders;
+      this->HeapObjects->Allocator.GetLiveHeaders(liveHeaders);
+      RaverieForEach (ObjectHeader* liveHeader, liveHeaders)
       {
-        // Just behind the allocated object is the header
-        ObjectHeader& header = *(ObjectHeader*)(object - sizeof(ObjectHeader));
+        // The object is just after the header
+        ObjectHeader& header = *liveHeader;
+        const byte* object = ((byte*)liveHeader) + sizeof(ObjectHeader);
 
         // Remember, we only compare names, which means the oldHeapType can
         // actually be different than oldType This is especially true after
@@ -189,6 +189,275 @@ bool HandleManager::GetNativeTypeFullyConstructed(const Handle& handle)
   return true;
 }
 
+// The slot size of each slab size class. The header and the patch space are
+// added to every heap object, so even empty objects need close to 300 bytes.
+// Four classes per power of two keep the unused space at the end of each slot
+// small.
+const size_t cHeapSlabSizeClasses[] = {288, 320, 384, 448, 512, 640, 768, 896, 1024, 1280, 1536, 1792, 2048, 2560, 3072, 3584, 4096};
+const unsigned cHeapSlabSizeClassCount = sizeof(cHeapSlabSizeClasses) / sizeof(size_t);
+
+// Memory used by heap objects in every executable state
+Memory::Graph* sHeapObjectGraph = new Memory::Graph("HeapObjects", Memory::GetRoot());
+
+HeapSlabAllocator::HeapSlabAllocator()
+{
+  this->FreeSlots.Resize(cHeapSlabSizeClassCount, nullptr);
+}
+
+HeapSlabAllocator::~HeapSlabAllocator()
+{
+  this->DeallocateAll();
+}
+
+ObjectHeader* HeapSlabAllocator::Allocate(size_t size)
+{
+  unsigned sizeClass = GetSizeClass(size);
+  byte* memory = nullptr;
+
+  if (sizeClass == HeapSizeClassLarge)
+  {
+    // Too big for a slot, so it gets its own memory
+    memory = (byte*)Raverie::zAllocate(size);
+    if (memory == nullptr)
+      return nullptr;
+
+    this->LargeAllocations.Insert(memory, size);
+    sHeapObjectGraph->DeltaDedicated(size);
+  }
+  else
+  {
+    // Take the first free slot, adding a page if there are none left
+    if (this->FreeSlots[sizeClass] == nullptr && this->AllocatePage(sizeClass) == false)
+      return nullptr;
+
+    FreeSlot* slot = this->FreeSlots[sizeClass];
+    this->FreeSlots[sizeClass] = slot->Next;
+
+    // The free slot is stored just after the header
+    memory = (byte*)slot - sizeof(ObjectHeader);
+    size = cHeapSlabSizeClasses[sizeClass];
+  }
+
+  sHeapObjectGraph->AddAllocation(size);
+
+  // All primitives should support being zeroed out
+  memset(memory, 0, size);
+
+  ObjectHeader* header = (ObjectHeader*)memory;
+  header->Flags = HeapObjectFlags::Live;
+  header->SizeClass = sizeClass;
+  return header;
+}
+
+void HeapSlabAllocator::Deallocate(ObjectHeader* header)
+{
+  if (header->SizeClass == HeapSizeClassLarge)
+  {
+    size_t size = this->LargeAllocations.FindValue((byte*)header, 0);
+    this->LargeAllocations.Erase((byte*)header);
+    sHeapObjectGraph->RemoveAllocation(size);
+    sHeapObjectGraph->DeltaDedicated(-(MemCounterType)size);
+    Raverie::zDeallocate(header);
+    return;
+  }
+
+  unsigned sizeClass = header->SizeClass;
+  size_t slotSize = cHeapSlabSizeClasses[sizeClass];
+
+  // The header (and its unique id) is kept, only the Live flag is cleared, so
+  // any handle still pointing at the slot knows the object is gone
+  header->Flags = HeapObjectFlags::None;
+  byte* object = (byte*)header + sizeof(ObjectHeader);
+
+#ifdef RaverieDebug
+  // 0xFAFAFAFA is our own byte pattern used to show that we deallocated the
+  // memory, but have not yet released it to the os
+  memset(object, 0xFA, slotSize - sizeof(ObjectHeader));
+#endif
+
+  FreeSlot* slot = (FreeSlot*)object;
+  slot->Next = this->FreeSlots[sizeClass];
+  this->FreeSlots[sizeClass] = slot;
+
+  sHeapObjectGraph->RemoveAllocation(slotSize);
+}
+
+ObjectHeader* HeapSlabAllocator::FindLiveHeader(const byte* object)
+{
+  // Just behind the allocated object is the header
+  const byte* memory = object - sizeof(ObjectHeader);
+
+  if (this->LargeAllocations.ContainsKey(memory))
+    return (ObjectHeader*)memory;
+
+  int pageIndex = this->FindPageIndex(memory);
+  if (pageIndex == -1)
+    return nullptr;
+
+  // The pointer must be at the start of the object in one of the page's slots
+  SlabPage& page = this->Pages[pageIndex];
+  size_t slotSize = cHeapSlabSizeClasses[page.SizeClass];
+  size_t offset = (size_t)(memory - page.Memory);
+  if (offset % slotSize != 0 || offset + slotSize > HeapSlabPageSize)
+    return nullptr;
+
+  ObjectHeader* header = (ObjectHeader*)memory;
+  if ((header->Flags & HeapObjectFlags::Live) == 0)
+    return nullptr;
+
+  return header;
+}
+
+bool HeapSlabAllocator::IsLargeLive(const ObjectHeader* header)
+{
+  return this->LargeAllocations.ContainsKey((const byte*)header);
+}
+
+ObjectHeader* HeapSlabAllocator::NextLiveSlot(ObjectHeader* previous)
+{
+  size_t pageIndex = 0;
+  size_t offset = 0;
+
+  // Continue from the slot after the previous one
+  if (previous != nullptr)
+  {
+    int previousPageIndex = this->FindPageIndex((byte*)previous);
+    ReturnIf(previousPageIndex == -1, nullptr, "The previous header was not allocated from a slab page");
+
+    pageIndex = (size_t)previousPageIndex;
+    SlabPage& page = this->Pages[pageIndex];
+    offset = (size_t)((byte*)previous - page.Memory) + cHeapSlabSizeClasses[page.SizeClass];
+  }
+
+  for (; pageIndex < this->Pages.Size(); ++pageIndex, offset = 0)
+  {
+    SlabPage& page = this->Pages[pageIndex];
+    size_t slotSize = cHeapSlabSizeClasses[page.SizeClass];
+
+    for (; offset + slotSize <= HeapSlabPageSize; offset += slotSize)
+    {
+      ObjectHeader* header = (ObjectHeader*)(page.Memory + offset);
+      if (header->Flags & HeapObjectFlags::Live)
+        return header;
+    }
+  }
+
+  return nullptr;
+}
+
+ObjectHeader* HeapSlabAllocator::AnyLiveLarge()
+{
+  if (this->LargeAllocations.Empty())
+    return nullptr;
+
+  return (ObjectHeader*)this->LargeAllocations.All().Front().first;
+}
+
+void HeapSlabAllocator::GetLiveHeaders(Array<ObjectHeader*>& headersOut)
+{
+  for (ObjectHeader* header = this->NextLiveSlot(nullptr); header != nullptr; header = this->NextLiveSlot(header))
+    headersOut.PushBack(header);
+
+  HashMap<const byte*, size_t>::range largeAllocations = this->LargeAllocations.All();
+  for (; largeAllocations.Empty() == false; largeAllocations.PopFront())
+    headersOut.PushBack((ObjectHeader*)largeAllocations.Front().first);
+}
+
+void HeapSlabAllocator::DeallocateAll()
+{
+  // Return every page at once rather than slot by slot
+  for (size_t i = 0; i < this->Pages.Size(); ++i)
+    Raverie::zDeallocate(this->Pages[i].Memory);
+  sHeapObjectGraph->DeltaDedicated(-(MemCounterType)(this->Pages.Size() * HeapSlabPageSize));
+  this->Pages.Clear();
+
+  for (size_t i = 0; i < this->FreeSlots.Size(); ++i)
+    this->FreeSlots[i] = nullptr;
+
+  HashMap<const byte*, size_t>::range largeAllocations = this->LargeAllocations.All();
+  for (; largeAllocations.Empty() == false; largeAllocations.PopFront())
+  {
+    Raverie::zDeallocate((byte*)largeAllocations.Front().first);
+    sHeapObjectGraph->DeltaDedicated(-(MemCounterType)largeAllocations.Front().second);
+  }
+  this->LargeAllocations.Clear();
+}
+
+unsigned HeapSlabAllocator::GetSizeClass(size_t size)
+{
+  for (unsigned i = 0; i < cHeapSlabSizeClassCount; ++i)
+  {
+    if (size <= cHeapSlabSizeClasses[i])
+      return i;
+  }
+
+  return HeapSizeClassLarge;
+}
+
+bool HeapSlabAllocator::AllocatePage(unsigned sizeClass)
+{
+  byte* memory = (byte*)Raverie::zAllocate(HeapSlabPageSize);
+  if (memory == nullptr)
+    return false;
+
+  // Zeroing clears the Live flag in the header of every slot
+  memset(memory, 0, HeapSlabPageSize);
+  sHeapObjectGraph->DeltaDedicated(HeapSlabPageSize);
+
+  // Keep the pages sorted by address
+  size_t begin = 0;
+  size_t end = this->Pages.Size();
+  while (begin < end)
+  {
+    size_t middle = (begin + end) / 2;
+    if (this->Pages[middle].Memory < memory)
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+
+  SlabPage page;
+  page.Memory = memory;
+  page.SizeClass = sizeClass;
+  this->Pages.InsertAt(begin, page);
+
+  // Push the slots in reverse so they get used in address order
+  size_t slotSize = cHeapSlabSizeClasses[sizeClass];
+  size_t slotCount = HeapSlabPageSize / slotSize;
+  for (size_t i = slotCount; i > 0; --i)
+  {
+    FreeSlot* slot = (FreeSlot*)(memory + (i - 1) * slotSize + sizeof(ObjectHeader));
+    slot->Next = this->FreeSlots[sizeClass];
+    this->FreeSlots[sizeClass] = slot;
+  }
+
+  return true;
+}
+
+int HeapSlabAllocator::FindPageIndex(const byte* memory)
+{
+  // Find the last page that starts at or before the memory
+  size_t begin = 0;
+  size_t end = this->Pages.Size();
+  while (begin < end)
+  {
+    size_t middle = (begin + end) / 2;
+    if (this->Pages[middle].Memory <= memory)
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+
+  if (begin == 0)
+    return -1;
+
+  SlabPage& page = this->Pages[begin - 1];
+  if (memory >= page.Memory + HeapSlabPageSize)
+    return -1;
+
+  return (int)(begin - 1);
+}
+
 HeapManager::HeapManager(ExecutableState* state) : HandleManager(state)
 {
   // Initialize the counter to zero
@@ -205,52 +474,52 @@ byte* HeapManager::HandleToObject(const Handle& handle)
 {
   HeapHandleData& data = *(HeapHandleData*)handle.Data;
 
-  // The pointer to the object is just after the header
-  byte* object = ((byte*)data.Header) + sizeof(ObjectHeader);
-
   // First check if the object is even live
-  if (this->LiveObjects.Contains(object) == false)
+  // (Slab pages are never released while we exist, so the header of a slab
+  // object can always be read, but large objects are freed when deleted)
+  if (data.Large)
+  {
+    if (this->Allocator.IsLargeLive(data.Header) == false)
+      return nullptr;
+  }
+  else if ((data.Header->Flags & HeapObjectFlags::Live) == 0)
+  {
     return nullptr;
+  }
 
   // If the unique-ids for that slot don't match (it was reused)
   // then we return null since this handle is no longer valid
   if (data.UniqueId != data.Header->UniqueId)
     return nullptr;
 
-  // The object must be valid!
-  return object;
+  // The object must be valid! (the pointer to the object is just after the
+  // header)
+  return ((byte*)data.Header) + sizeof(ObjectHeader);
 }
 
 void HeapManager::Allocate(BoundType* type, Handle& handleToInitialize, size_t customFlags)
 {
-  // Create a buffer that's the size of the object we'd like to allocate
-  // At the beginning of the buffer, we put the object slot pointer so that
-  // 'ObjectToHandle' can recreate a handle via the slot data pointer
+  // Get memory that's the size of the object we'd like to allocate
+  // At the beginning of the memory is the object header so that
+  // 'ObjectToHandle' can recreate a handle from the object pointer
   size_t objectSize = type->GetAllocatedSize();
   size_t fullSize = sizeof(ObjectHeader) + objectSize + HeapManagerExtraPatchSize;
-  byte* memory = (byte*)Raverie::zAllocate(fullSize);
+  ObjectHeader* allocatedHeader = this->Allocator.Allocate(fullSize);
 
   // If the memory failed to allocate, early out
-  if (memory == nullptr)
+  if (allocatedHeader == nullptr)
   {
     Error("Failed memory allocation within a Raverie heap object");
     handleToInitialize.Manager = nullptr;
     return;
   }
 
-  // Make sure we mark this as a live object
-  byte* object = memory + sizeof(ObjectHeader);
-  this->LiveObjects.Insert(object);
-
-  // All primitives should support being zeroed out
-  memset(memory, 0, fullSize);
-
-  // Store a pointer back to the slot on the memory itself
-  ObjectHeader& header = *(ObjectHeader*)memory;
+  // The memory comes back zeroed and marked as live
+  ObjectHeader& header = *allocatedHeader;
   header.Type = type;
   header.UniqueId = this->UidCount;
   header.ReferenceCount = 1;
-  header.Flags = (HeapObjectFlags::Enum)customFlags;
+  header.Flags = (HeapObjectFlags::Enum)(header.Flags | customFlags);
 
   // Increment the unique ID counter
   ++this->UidCount;
@@ -265,6 +534,7 @@ void HeapManager::Allocate(BoundType* type, Handle& handleToInitialize, size_t c
   HeapHandleData& data = *(HeapHandleData*)handleToInitialize.Data;
   data.Header = &header;
   data.UniqueId = header.UniqueId;
+  data.Large = (header.SizeClass == HeapSizeClassLarge);
 }
 
 void HeapManager::ObjectToHandle(const byte* object, BoundType* type, Handle& handleToInitialize)
@@ -277,7 +547,8 @@ void HeapManager::ObjectToHandle(const byte* object, BoundType* type, Handle& ha
   }
 
   // First, check if this object was even allocated through us
-  if (this->LiveObjects.Contains(object) == false)
+  ObjectHeader* liveHeader = this->Allocator.FindLiveHeader(object);
+  if (liveHeader == nullptr)
   {
     // Since the object that was passed in isn't managed by us, the only valid
     // way to get a handle to it is to use the pointer manager Most likely this
@@ -294,7 +565,7 @@ void HeapManager::ObjectToHandle(const byte* object, BoundType* type, Handle& ha
   }
 
   // Just behind the allocated object is the header
-  ObjectHeader& header = *(ObjectHeader*)(object - sizeof(ObjectHeader));
+  ObjectHeader& header = *liveHeader;
 
   // If specified, we won't do reference counting on this handle
   // This means the only way to destroy the handle is via delete
@@ -308,6 +579,7 @@ void HeapManager::ObjectToHandle(const byte* object, BoundType* type, Handle& ha
   HeapHandleData& data = *(HeapHandleData*)handleToInitialize.Data;
   data.Header = &header;
   data.UniqueId = header.UniqueId;
+  data.Large = (header.SizeClass == HeapSizeClassLarge);
 }
 
 void HeapManager::DeleteAll(ExecutableState* state)
@@ -322,33 +594,46 @@ void HeapManager::DeleteAll(ExecutableState* state)
   // Leak detection includes the stack frame of who allocated it
   // as well as all those still referencing it
 
-  while (this->LiveObjects.Empty() == false)
+  // Destructors and memory leak handlers can run script that allocates, and a
+  // new object may land in a slot we already walked past, so keep walking the
+  // slab pages (slots stay readable after they are freed) until a walk finds
+  // nothing left alive
+  while (this->Allocator.NextLiveSlot(nullptr) != nullptr || this->Allocator.AnyLiveLarge() != nullptr)
   {
-    // Just get the first object and attempt to free it
-    const byte* object = this->LiveObjects.All().Front();
-
-    // Just behind the allocated object is the header
-    ObjectHeader& header = *(ObjectHeader*)(object - sizeof(ObjectHeader));
-
-    // Create a temporary handle to point at the object
-    Handle handle(object, header.Type, this);
-
-    // Send out an event letting the user know that a memory leak occurred
-    MemoryLeakEvent toSend;
-    toSend.State = state;
-    toSend.LeakedObject = &handle;
-    EventSend(state, Events::MemoryLeak, &toSend);
-
-    // Delete the object forcibly
-    // Note that this Delete should call HeapManager::Delete, which will remove
-    // this from LiveObjects!
-    bool deleted = handle.Delete();
-    ErrorIf(deleted != true,
-            "Delete on the handle returned that the object was not deleted (it "
-            "always should be deletable)");
+    for (ObjectHeader* header = this->Allocator.NextLiveSlot(nullptr); header != nullptr; header = this->Allocator.NextLiveSlot(header))
+      this->DeleteLeakedObject(state, header);
+
+    // Large objects are freed immediately, so always start over from any that
+    // are left
+    while (ObjectHeader* header = this->Allocator.AnyLiveLarge())
+      this->DeleteLeakedObject(state, header);
   }
 
-  ErrorIf(this->LiveObjects.Empty() == false, "All objects should be cleared by this point");
+  // The pages themselves are all returned at once when the allocator is
+  // destroyed, so handles released after this can still safely read headers
+}
+
+void HeapManager::DeleteLeakedObject(ExecutableState* state, ObjectHeader* header)
+{
+  // The object is just after the header
+  byte* object = ((byte*)header) + sizeof(ObjectHeader);
+
+  // Create a temporary handle to point at the object
+  Handle handle(object, header->Type, this);
+
+  // Send out an event letting the user know that a memory leak occurred
+  MemoryLeakEvent toSend;
+  toSend.State = state;
+  toSend.LeakedObject = &handle;
+  EventSend(state, Events::MemoryLeak, &toSend);
+
+  // Delete the object forcibly
+  // Note that this Delete should call HeapManager::Delete, which will free the
+  // object's memory!
+  bool deleted = handle.Delete();
+  ErrorIf(deleted != true,
+          "Delete on the handle returned that the object was not deleted (it "
+          "always should be deletable)");
 }
 
 void HeapManager::Delete(const Handle& handle)
@@ -356,14 +641,8 @@ void HeapManager::Delete(const Handle& handle)
   // Get the associated slot
   HeapHandleData& data = *(HeapHandleData*)handle.Data;
 
-  // The pointer to the object is just after the header
-  byte* object = ((byte*)data.Header) + sizeof(ObjectHeader);
-
-  // Remove the object from the list of live objects
-  this->LiveObjects.Erase(object);
-
-  // Delete the data in the slot and null it out
-  Raverie::zDeallocate(data.Header);
+  // Free the object's memory (this also marks it as no longer live)
+  this->Allocator.Deallocate(data.Header);
 }
 
 bool HeapManager::CanDelete(const Handle& handle)
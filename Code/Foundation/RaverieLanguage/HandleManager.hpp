@@ -229,7 +229,11 @@ enum Enum
   // class, and our base class is native C++ and has a virtual table, then it
   // would be VERY bad to invoke the C++ destructor if we're not fully
   // constructed
-  NativeFullyConstructed = 2
+  NativeFullyConstructed = 2,
+
+  // Set while the object's memory is allocated (cleared when the memory is
+  // freed, so a handle to a freed slot in a slab page knows it is invalid)
+  Live = 4
 };
 }
 
@@ -242,6 +246,8 @@ public:
   Uid UniqueId;
   unsigned ReferenceCount;
   HeapObjectFlags::Enum Flags;
+  // Which slab size class the memory came from (see HeapSlabAllocator)
+  unsigned SizeClass;
 };
 
 // The structure of our heap handle's inner data
@@ -252,6 +258,11 @@ public:
   // which we implicitly allocate behind every object
   ObjectHeader* Header;
   Uid UniqueId;
+
+  // Whether the object was too big for a slab page and got its own allocation
+  // (its memory is freed as soon as it is deleted, so the header cannot be
+  // read to check if it's live)
+  bool Large;
 };
 static_assert(sizeof(HeapHandleData) <= HandleUserDataSize,
               "The HeapHandleData class must fit within Handle::Data (make "
@@ -271,6 +282,90 @@ static_assert(sizeof(HeapHandleData) <= HandleUserDataSize,
 // platform basis (such as HeapReAlloc on Windows with the flag of no moving)
 const size_t HeapManagerExtraPatchSize = 256;
 
+// The size class given to allocations that are too big for any slab page
+const unsigned HeapSizeClassLarge = (unsigned)-1;
+
+// The size of every slab page (each page is divided into slots of one size
+// class)
+const size_t HeapSlabPageSize = 64 * 1024;
+
+// Allocates the memory for heap objects (the header, the object, and the patch
+// space) from pages that are divided into fixed size slots, one page per size
+// class. Freed slots go on a free list for their size class and are reused.
+// Pages are only returned when the allocator is destroyed, so the header of a
+// freed slot can always be read, and the Live flag in it tells whether it is
+// still allocated. Allocations bigger than the largest size class get their
+// own memory and are tracked separately.
+class HeapSlabAllocator
+{
+public:
+  HeapSlabAllocator();
+  ~HeapSlabAllocator();
+
+  // Allocates zeroed memory of at least the given size (with the SizeClass and
+  // the Live flag set in the header), or returns null if out of memory
+  ObjectHeader* Allocate(size_t size);
+
+  // Frees memory returned from Allocate
+  void Deallocate(ObjectHeader* header);
+
+  // Returns the header of the live allocation that the given object pointer
+  // is at, or null if the pointer is not a live object from this allocator
+  // (any pointer may be given)
+  ObjectHeader* FindLiveHeader(const byte* object);
+
+  // Returns true if the large allocation has not been freed
+  bool IsLargeLive(const ObjectHeader* header);
+
+  // Returns the next live slab allocation after the given one (or the first
+  // if null is given), or null if there are no more
+  ObjectHeader* NextLiveSlot(ObjectHeader* previous);
+
+  // Returns any live large allocation, or null if there are none
+  ObjectHeader* AnyLiveLarge();
+
+  // Adds the headers of every live allocation to the array
+  void GetLiveHeaders(Array<ObjectHeader*>& headersOut);
+
+  // Returns all pages and large allocations at once (any live objects are
+  // not destructed)
+  void DeallocateAll();
+
+private:
+  // A single free slot (stored just after the slot's header, so the header
+  // stays intact)
+  struct FreeSlot
+  {
+    FreeSlot* Next;
+  };
+
+  // A page of slots that all belong to the same size class
+  struct SlabPage
+  {
+    byte* Memory;
+    unsigned SizeClass;
+  };
+
+  // Returns the smallest size class that fits the size, or HeapSizeClassLarge
+  static unsigned GetSizeClass(size_t size);
+
+  // Allocates a new page for the size class and puts its slots on the free
+  // list, returns false if out of memory
+  bool AllocatePage(unsigned sizeClass);
+
+  // Returns the index of the page containing the memory, or -1 if none does
+  int FindPageIndex(const byte* memory);
+
+  // The pages sorted by address (so they can be binary searched)
+  Array<SlabPage> Pages;
+
+  // The first free slot of each size class
+  Array<FreeSlot*> FreeSlots;
+
+  // Allocations too big for a slab page, and their sizes
+  HashMap<const byte*, size_t> LargeAllocations;
+};
+
 // This manages heap objects allocated in the language (including references to
 // heap members via offset)
 class HeapManager : public HandleManager
@@ -293,14 +388,17 @@ public:
   // A unique ID counter (so we can Assign objects unique IDs...)
   Uid UidCount;
 
-  // When we validate a handle, we first check if the object is live (this is
-  // NOT a pointer to the header) Because a completely different object could
-  // have been allocated in the exact same place (pointer) then we also have to
-  // check the version stored in the handle against the version in the object's
-  // header If the pointer given to 'ObjectToHandle' does not exist here, we
-  // implicitly allocate a new object and invoke the copy constructor on the
-  // object
-  HashSet<const byte*> LiveObjects;
+  // When we validate a handle, we first check if the object is live (the Live
+  // flag in its header) Because a completely different object could have been
+  // allocated in the exact same place (pointer) then we also have to check the
+  // version stored in the handle against the version in the object's header If
+  // the pointer given to 'ObjectToHandle' was not allocated here, we implicitly
+  // allocate a new object and invoke the copy constructor on the object
+  HeapSlabAllocator Allocator;
+
+private:
+  // Sends out a memory leak event for the object and then deletes it
+  void DeleteLeakedObject(ExecutableState* state, ObjectHeader* header);
 };
 
 // The structure of our stack handle's inner data
@@ -196,11 +196,20 @@ CodeDefinition::CodeDefinition() :
 {
 }
 
-Project::Project() : UserData(nullptr), VariableUniqueIdCounter(0), CursorPosition(NoCursor)
+CachedCodeEntry::CachedCodeEntry() : VariableUniqueIdCounter(0), Used(false)
+{
+}
+
+Project::Project() : UserData(nullptr), VariableUniqueIdCounter(0), CacheEntries(false), LastParseSeconds(0.0), LastCheckSeconds(0.0), LastCodeGenerationSeconds(0.0), CursorPosition(NoCursor)
 {
   RaverieErrorIfNotStarted(Project);
 }
 
+Project::~Project()
+{
+  this->ClearCache();
+}
+
 void Project::AddCodeFromString(StringParam code, StringParam origin, void* codeUserData)
 {
   // Add an entry to the list of all entries
@@ -265,6 +274,13 @@ void Project::Clear()
   this->Entries.Clear();
 }
 
+void Project::ClearCache()
+{
+  RaverieForEach (Array<CachedCodeEntry*>& cachedEntries, this->EntryCache.Values())
+    DeleteObjectsInContainer(cachedEntries);
+  this->EntryCache.Clear();
+}
+
 bool Project::Tokenize(Array<UserToken>& tokensOut, Array<UserToken>& commentsOut)
 {
   // Reset whether there was an error or not
@@ -421,6 +437,11 @@ void Project::AttachCommentsToNodes(SyntaxTree& syntaxTree, Array<UserToken>& co
 
 bool Project::CompileUncheckedSyntaxTree(SyntaxTree& syntaxTreeOut, Array<UserToken>& tokensOut, EvaluationMode::Enum evaluation)
 {
+  // Tolerant mode and expressions are always compiled from scratch
+  // (tolerant code is typically being edited, so it would rarely hit the cache)
+  if (this->CacheEntries && this->TolerantMode == false && evaluation == EvaluationMode::Project && this->Entries.Empty() == false)
+    return this->CompileUncheckedSyntaxTreeFromCache(syntaxTreeOut, tokensOut);
+
   // Reset the unique variable-id counter (ensures deterministic behavior)
   this->VariableUniqueIdCounter = 0;
 
@@ -448,6 +469,141 @@ bool Project::CompileUncheckedSyntaxTree(SyntaxTree& syntaxTreeOut, Array<UserTo
   return !this->WasError;
 }
 
+CachedCodeEntry* Project::FindOrCacheEntry(CodeEntry& entry)
+{
+  // Look for results from a previous compile of the exact same entry
+  Array<CachedCodeEntry*>& cachedEntries = this->EntryCache[entry.GetHash()];
+  for (size_t i = 0; i < cachedEntries.Size(); ++i)
+  {
+    CachedCodeEntry* cachedEntry = cachedEntries[i];
+    const CodeEntry& cached = cachedEntry->Entry;
+    if (cached.CodeUserData == entry.CodeUserData && cached.Origin == entry.Origin && cached.Code == entry.Code)
+      return cachedEntry;
+  }
+
+  CachedCodeEntry* cachedEntry = new CachedCodeEntry();
+  cachedEntry->Entry = entry;
+
+  // Tokenize the entry on its own, ending it with its own end of file
+  // (a new tokenizer so no state is carried over from another entry)
+  ScriptTokenizer tokenizer(*this);
+  tokenizer.Parse(entry, cachedEntry->Tokens, cachedEntry->Comments);
+  tokenizer.Finalize(cachedEntry->Tokens);
+
+  // Parse the entry on its own, starting the unique variable-id counter at
+  // zero so the tree is the same no matter which entries came before it
+  if (this->WasError == false)
+  {
+    this->VariableUniqueIdCounter = 0;
+    Parser parser(*this);
+    parser.ParseIntoTree(cachedEntry->Tokens, cachedEntry->Tree, EvaluationMode::Project);
+    cachedEntry->VariableUniqueIdCounter = this->VariableUniqueIdCounter;
+  }
+
+  // Never cache entries with errors (they should report their errors again)
+  if (this->WasError)
+  {
+    delete cachedEntry;
+    return nullptr;
+  }
+
+  cachedEntries.PushBack(cachedEntry);
+  return cachedEntry;
+}
+
+bool Project::CompileUncheckedSyntaxTreeFromCache(SyntaxTree& syntaxTreeOut, Array<UserToken>& tokensOut)
+{
+  // Reset whether there was an error or not
+  this->WasError = false;
+
+  RaverieForEach (Array<CachedCodeEntry*>& cachedEntries, this->EntryCache.Values())
+  {
+    for (size_t i = 0; i < cachedEntries.Size(); ++i)
+      cachedEntries[i]->Used = false;
+  }
+
+  // Store all the comments from every entry
+  Array<UserToken> comments;
+  size_t variableUniqueIdCounter = 0;
+
+  RootNode* root = syntaxTreeOut.Root;
+  for (size_t i = 0; i < this->Entries.Size(); ++i)
+  {
+    CachedCodeEntry* cachedEntry = this->FindOrCacheEntry(this->Entries[i]);
+    if (cachedEntry == nullptr)
+      return false;
+
+    cachedEntry->Used = true;
+
+    // Output the same token stream as tokenizing every entry together
+    // (every entry's end of file is skipped except the last one's)
+    Array<UserToken>& tokens = cachedEntry->Tokens;
+    tokensOut.Insert(tokensOut.End(), tokens.Begin(), tokens.End() - 1);
+    if (i == this->Entries.Size() - 1)
+      tokensOut.PushBack(tokens.Back());
+
+    comments.Append(cachedEntry->Comments.All());
+
+    // Every variable-id generated in any entry must stay unique once the
+    // syntaxer starts generating its own
+    variableUniqueIdCounter = Math::Max(variableUniqueIdCounter, cachedEntry->VariableUniqueIdCounter);
+
+    // Clone the cached nodes (the syntaxer modifies the tree it checks)
+    NodeList<SyntaxNode>& cachedNodes = cachedEntry->Tree.Root->NonTraversedNonOwnedNodesInOrder;
+    for (size_t j = 0; j < cachedNodes.Size(); ++j)
+    {
+      SyntaxNode* clone = cachedNodes[j]->Clone();
+
+      if (ClassNode* classNode = Type::DynamicCast<ClassNode*>(clone))
+      {
+        // The in order nodes are not owned and are not remapped by the clone,
+        // so they would still point at the cached tree (only the formatter uses
+        // them, and it never compiles from the cache)
+        classNode->NonTraversedNonOwnedNodesInOrder.Clear();
+        root->Classes.Add(classNode);
+      }
+      else if (EnumNode* enumNode = Type::DynamicCast<EnumNode*>(clone))
+      {
+        root->Enums.Add(enumNode);
+      }
+      else
+      {
+        Error("Only classes and enums should be at the root of a parsed entry");
+        delete clone;
+        continue;
+      }
+
+      root->NonTraversedNonOwnedNodesInOrder.Add(clone);
+    }
+  }
+
+  this->VariableUniqueIdCounter = variableUniqueIdCounter;
+
+  // Remove cached entries that are no longer part of the project
+  RaverieForEach (Array<CachedCodeEntry*>& cachedEntries, this->EntryCache.Values())
+  {
+    for (size_t i = 0; i < cachedEntries.Size();)
+    {
+      if (cachedEntries[i]->Used)
+      {
+        ++i;
+        continue;
+      }
+
+      delete cachedEntries[i];
+      cachedEntries.EraseAt(i);
+    }
+  }
+
+  // Make sure to attach all the comments we parsed to
+  // any nodes, so we can collect them for documentation
+  this->AttachCommentsToNodes(syntaxTreeOut, comments);
+
+  // Fix up any parent pointers
+  SyntaxNode::FixParentPointers(syntaxTreeOut.Root, nullptr);
+  return true;
+}
+
 bool Project::CompileCheckedSyntaxTree(SyntaxTree& syntaxTreeOut, LibraryBuilder& builder, Array<UserToken>& tokensOut, const Module& dependencies, EvaluationMode::Enum evaluation)
 {
   // The syntaxer holds information about all the internal and parsed types
@@ -455,12 +611,18 @@ bool Project::CompileCheckedSyntaxTree(SyntaxTree& syntaxTreeOut, LibraryBuilder
   Syntaxer syntaxer(*this);
 
   // Start by compiling the code into an unchecked tree
-  if (this->CompileUncheckedSyntaxTree(syntaxTreeOut, tokensOut, evaluation) == false)
+  Timer timer;
+  this->LastParseSeconds = 0.0;
+  this->LastCheckSeconds = 0.0;
+  bool parsed = this->CompileUncheckedSyntaxTree(syntaxTreeOut, tokensOut, evaluation);
+  this->LastParseSeconds = timer.UpdateAndGetTime();
+  if (parsed == false)
     return false;
 
   // Collect all the types, Assign types where they are needed, and perform
   // syntax checking
   syntaxer.ApplyToTree(syntaxTreeOut, builder, *this, dependencies);
+  this->LastCheckSeconds = timer.UpdateAndGetTime() - this->LastParseSeconds;
 
   // Fix up any parent pointers (in case anything gets moved around)
   // This may be unnecessary... but we'd still like to do it
@@ -487,6 +649,7 @@ LibraryRef Project::Compile(StringParam libraryName, Module& dependencies, Evalu
   builder.SetEntries(this->Entries);
 
   // Compile the code into a checked syntax tree
+  this->LastCodeGenerationSeconds = 0.0;
   if (this->CompileCheckedSyntaxTree(treeOut, builder, tokensOut, dependencies, evaluation) == false)
     return nullptr;
 
@@ -503,8 +666,10 @@ LibraryRef Project::Compile(StringParam libraryName, Module& dependencies, Evalu
   {
     // The code generator uses the syntax tree to generate opcode for each
     // function
+    Timer timer;
     CodeGenerator codeGenerator;
     LibraryRef library = codeGenerator.Generate(treeOut, builder);
+    this->LastCodeGenerationSeconds = timer.UpdateAndGetTime();
 
     // Check that the library was valid
     ErrorIf(library == nullptr, "Somehow the library returned from code generation was not valid!");
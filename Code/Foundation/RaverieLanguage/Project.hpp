@@ -231,6 +231,40 @@ public:
   LibraryRef IncompleteLibrary;
 };
 
+// The tokens and unchecked syntax tree of a single code entry, kept by a project
+// between compiles so that code which has not changed is not tokenized or
+// parsed again (see Project::CacheEntries)
+class CachedCodeEntry
+{
+public:
+  // Constructor
+  CachedCodeEntry();
+
+  // The code entry that these results were compiled from
+  CodeEntry Entry;
+
+  // The tokens of only this entry, ending with its own end of file token
+  // The nodes in the tree point directly at these tokens
+  Array<UserToken> Tokens;
+
+  // The comments of only this entry (attached once all the trees are combined)
+  Array<UserToken> Comments;
+
+  // The syntax tree parsed from only this entry
+  // This tree is never checked, only clones of its nodes are
+  SyntaxTree Tree;
+
+  // The unique variable id counter after parsing this entry
+  size_t VariableUniqueIdCounter;
+
+  // Whether the latest compile used this entry (entries that are not used are
+  // removed after the compile)
+  bool Used;
+
+  // Not copyable
+  RaverieNoCopy(CachedCodeEntry);
+};
+
 // The project Contains all the files that are being compiled together
 class Project : public CompilationErrors
 {
@@ -240,6 +274,9 @@ public:
   // Constructor
   Project();
 
+  // Destructor
+  ~Project();
+
   // Adds a code to the project
   // The origin is the display name (typically the file name)
   // Any time any error occurs with compilation, or anything that references
@@ -254,6 +291,9 @@ public:
   // plugin files, etc)
   void Clear();
 
+  // Removes all the cached tokens and syntax trees (see CacheEntries)
+  void ClearCache();
+
   // Reads a text file into a string, returns true on success, false on failure
   static String ReadTextFile(Status& status, StringParam fileName);
 
@@ -305,6 +345,21 @@ public:
   // use this counter as a unique id
   size_t VariableUniqueIdCounter;
 
+  // When set, the tokens and unchecked syntax tree of every code entry are kept
+  // after compiling, and entries whose code, origin, and user-data have not
+  // changed are cloned from the cache instead of being tokenized and parsed
+  // again. Only used when compiling a whole project outside of tolerant mode.
+  // The syntax tree output by a compile points at tokens owned by the cache, so
+  // it must not outlive the next compile or a call to ClearCache
+  bool CacheEntries;
+
+  // How long each stage of the last compile took in seconds. Parsing is the
+  // tokenizing and parsing that CacheEntries skips for unchanged entries, and
+  // checking is the syntaxer (both are zero if the compile failed before them)
+  double LastParseSeconds;
+  double LastCheckSeconds;
+  double LastCodeGenerationSeconds;
+
   // Setup the location and the name for a found definition
   void InitializeDefinitionInfo(CodeDefinition& resultOut, ReflectionObject* object);
 
@@ -323,10 +378,22 @@ private:
   // (generally used when performing a call)
   CompletionOverload& AddAutoCompleteOverload(AutoCompleteInfo& info, DelegateType* delegateType);
 
+  // Compiles the project into an unchecked syntax tree by combining the cached
+  // tree of each code entry (see CacheEntries)
+  bool CompileUncheckedSyntaxTreeFromCache(SyntaxTree& syntaxTreeOut, Array<UserToken>& tokensOut);
+
+  // Finds the cached results for a code entry, or tokenizes and parses the
+  // entry and caches the results (returns null if there was an error)
+  CachedCodeEntry* FindOrCacheEntry(CodeEntry& entry);
+
 private:
   // All the code that makes up this project
   Array<CodeEntry> Entries;
 
+  // The tokens and unchecked syntax trees of code entries from previous
+  // compiles, by the hash of the code entry (multiple entries may share a hash)
+  HashMap<size_t, Array<CachedCodeEntry*>> EntryCache;
+
   // A special constant that means we don't have a cursor
   static const size_t NoCursor = (size_t)-1;
 
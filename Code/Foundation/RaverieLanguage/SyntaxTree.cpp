@@ -431,7 +431,7 @@ void SyntaxNode::DestroyChildren()
   }
 }
 
-SyntaxNode::SyntaxNode(const SyntaxNode& toCopy) : Parent(nullptr), Location(toCopy.Location)
+SyntaxNode::SyntaxNode(const SyntaxNode& toCopy) : Parent(nullptr), Location(toCopy.Location), IsGenerated(toCopy.IsGenerated)
 {
   // We never copy the parent from other nodes
 }
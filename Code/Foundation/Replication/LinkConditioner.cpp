@@ -0,0 +1,226 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Raverie
+{
+
+//                                LinkConditions //
+
+LinkConditions::LinkConditions() :
+    mLatency(0),
+    mJitter(0),
+    mLossChance(0),
+    mDuplicateChance(0),
+    mReorderChance(0),
+    mReorderDelay(0),
+    mBandwidthLimit(0)
+{
+}
+
+bool LinkConditions::IsSet() const
+{
+  return mLatency > 0 || mJitter > 0 || mLossChance > 0 || mDuplicateChance > 0 || (mReorderChance > 0 && mReorderDelay > 0) || mBandwidthLimit > 0;
+}
+
+//                               LinkConditioner //
+
+LinkConditioner::LinkConditioner(uint seed) :
+    PeerPlugin(),
+    mOutgoingConditions(),
+    mIncomingConditions(),
+    mRandom(seed),
+    mHeldOutgoingPackets(),
+    mHeldIncomingPackets(),
+    mOutgoingBandwidthFreeTime(0),
+    mIncomingBandwidthFreeTime(0),
+    mSentBytes(0),
+    mReceivedBytes(0),
+    mDroppedPacketCount(0)
+{
+}
+
+//
+// Operations
+//
+
+void LinkConditioner::SetOutgoingConditions(const LinkConditions& outgoingConditions)
+{
+  mOutgoingConditions = outgoingConditions;
+}
+const LinkConditions& LinkConditioner::GetOutgoingConditions() const
+{
+  return mOutgoingConditions;
+}
+
+void LinkConditioner::SetIncomingConditions(const LinkConditions& incomingConditions)
+{
+  mIncomingConditions = incomingConditions;
+}
+const LinkConditions& LinkConditioner::GetIncomingConditions() const
+{
+  return mIncomingConditions;
+}
+
+uint64 LinkConditioner::GetSentBytes() const
+{
+  return mSentBytes;
+}
+uint64 LinkConditioner::GetReceivedBytes() const
+{
+  return mReceivedBytes;
+}
+uint64 LinkConditioner::GetDroppedPacketCount() const
+{
+  return mDroppedPacketCount;
+}
+
+//
+// Peer Plugin Interface
+//
+
+void LinkConditioner::OnUninitialize()
+{
+  // Packets still held are lost, as they would be on a real network
+  mDroppedPacketCount += mHeldOutgoingPackets.Size() + mHeldIncomingPackets.Size();
+  mHeldOutgoingPackets.Clear();
+  mHeldIncomingPackets.Clear();
+}
+
+void LinkConditioner::OnUpdate()
+{
+  TimeMs now = GetPeer()->GetLocalTime();
+
+  // Deliver outgoing packets that have come due
+  // (Sent with this update's send batch)
+  size_t dueCount = 0;
+  while (dueCount < mHeldOutgoingPackets.Size() && mHeldOutgoingPackets[dueCount].first <= now)
+  {
+    OutPacket& packet = mHeldOutgoingPackets[dueCount].second;
+    mSentBytes += BITS_TO_BYTES(packet.GetTotalBits());
+    ReleaseOutgoingPacket(packet);
+    ++dueCount;
+  }
+  mHeldOutgoingPackets.Erase(mHeldOutgoingPackets.SubRange(0, dueCount));
+
+  // Deliver incoming packets that have come due
+  // (Processed on the next peer update)
+  dueCount = 0;
+  while (dueCount < mHeldIncomingPackets.Size() && mHeldIncomingPackets[dueCount].first <= now)
+  {
+    InPacket& packet = mHeldIncomingPackets[dueCount].second;
+    mReceivedBytes += BITS_TO_BYTES(packet.GetTotalBits());
+    ReleaseIncomingPacket(RaverieMove(packet));
+    ++dueCount;
+  }
+  mHeldIncomingPackets.Erase(mHeldIncomingPackets.SubRange(0, dueCount));
+}
+
+bool LinkConditioner::OnPacketSend(OutPacket& packet)
+{
+  Bits packetBits = packet.GetTotalBits();
+
+  // No outgoing conditions?
+  if (!mOutgoingConditions.IsSet())
+  {
+    // Send immediately
+    mSentBytes += BITS_TO_BYTES(packetBits);
+    return true;
+  }
+
+  // Lost?
+  if (mRandom.Float() < mOutgoingConditions.mLossChance)
+  {
+    ++mDroppedPacketCount;
+    return false;
+  }
+
+  // Hold a copy until delivery
+  // (The sender keeps the original packet to track acknowledgements)
+  TimeMs now = GetPeer()->GetLocalTime();
+  OutPacket packetCopy(packet);
+  HoldPacket(mHeldOutgoingPackets, ScheduleDelivery(mOutgoingConditions, mOutgoingBandwidthFreeTime, packetBits, now), RaverieMove(packetCopy));
+
+  // Duplicated?
+  if (mRandom.Float() < mOutgoingConditions.mDuplicateChance)
+  {
+    OutPacket duplicatePacket(packet);
+    HoldPacket(mHeldOutgoingPackets, ScheduleDelivery(mOutgoingConditions, mOutgoingBandwidthFreeTime, packetBits, now), RaverieMove(duplicatePacket));
+  }
+
+  return false;
+}
+
+bool LinkConditioner::OnPacketReceive(InPacket& packet)
+{
+  Bits packetBits = packet.GetTotalBits();
+
+  // No incoming conditions?
+  if (!mIncomingConditions.IsSet())
+  {
+    // Receive immediately
+    mReceivedBytes += BITS_TO_BYTES(packetBits);
+    return true;
+  }
+
+  // Lost?
+  if (mRandom.Float() < mIncomingConditions.mLossChance)
+  {
+    ++mDroppedPacketCount;
+    return false;
+  }
+
+  // Duplicated?
+  TimeMs now = GetPeer()->GetLocalTime();
+  if (mRandom.Float() < mIncomingConditions.mDuplicateChance)
+  {
+    InPacket duplicatePacket(packet);
+    HoldPacket(mHeldIncomingPackets, ScheduleDelivery(mIncomingConditions, mIncomingBandwidthFreeTime, packetBits, now), RaverieMove(duplicatePacket));
+  }
+
+  // Hold until delivery
+  // (The peer discards stopped packets, so the original can be taken)
+  HoldPacket(mHeldIncomingPackets, ScheduleDelivery(mIncomingConditions, mIncomingBandwidthFreeTime, packetBits, now), RaverieMove(packet));
+  return false;
+}
+
+//
+// Internal
+//
+
+TimeMs LinkConditioner::ScheduleDelivery(const LinkConditions& conditions, TimeMs& bandwidthFreeTime, Bits packetBits, TimeMs now)
+{
+  // Apply latency and jitter
+  TimeMs deliveryTime = now + conditions.mLatency;
+  if (conditions.mJitter > 0)
+    deliveryTime += TimeMs(mRandom.IntRangeInIn(0, int(conditions.mJitter)));
+
+  // Held back behind later packets?
+  if (mRandom.Float() < conditions.mReorderChance)
+    deliveryTime += conditions.mReorderDelay;
+
+  // Bandwidth limited?
+  if (conditions.mBandwidthLimit > 0)
+  {
+    // Wait for the packets ahead of this one to finish, then occupy the link
+    // for as long as this packet takes at the limit (1 Kbps is 1 bit per ms)
+    deliveryTime = std::max(deliveryTime, bandwidthFreeTime);
+    bandwidthFreeTime = deliveryTime + TimeMs(double(packetBits) / conditions.mBandwidthLimit);
+  }
+
+  return deliveryTime;
+}
+
+template <typename PacketType>
+void LinkConditioner::HoldPacket(Array<Pair<TimeMs, PacketType>>& heldPackets, TimeMs deliveryTime, MoveReference<PacketType> packet)
+{
+  // Find the first held packet due after this one
+  // (Packets due at the same time keep the order they were held in)
+  size_t index = heldPackets.Size();
+  while (index > 0 && heldPackets[index - 1].first > deliveryTime)
+    --index;
+
+  Pair<TimeMs, PacketType> heldPacket(deliveryTime, RaverieMove(packet));
+  heldPackets.InsertAt(index, RaverieMove(heldPacket));
+}
+
+} // namespace Raverie
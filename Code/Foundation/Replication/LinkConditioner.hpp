@@ -0,0 +1,96 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Raverie
+{
+
+//                                LinkConditions //
+
+/// Link Conditions
+/// Simulated network conditions applied to packets travelling in one direction
+struct LinkConditions
+{
+  /// Constructor
+  LinkConditions();
+
+  /// Returns true if any condition would affect packets, else false
+  bool IsSet() const;
+
+  /// Data
+  TimeMs mLatency;        /// Delay added to every packet
+  TimeMs mJitter;         /// Maximum random delay added on top of latency
+  float mLossChance;      /// Chance [0, 1] that a packet is dropped
+  float mDuplicateChance; /// Chance [0, 1] that a packet is delivered twice
+  float mReorderChance;   /// Chance [0, 1] that a packet is held back behind later packets
+  TimeMs mReorderDelay;   /// Delay added to packets that are held back
+  Kbps mBandwidthLimit;   /// Maximum throughput, packets queue up beyond it (0 for unlimited)
+};
+
+//                               LinkConditioner //
+
+/// Link Conditioner Peer Plugin
+/// Simulates latency, jitter, loss, duplication, reordering and bandwidth
+/// limits on every packet the peer sends and receives, so networked behavior
+/// can be exercised over loopback without a real network
+class LinkConditioner : public PeerPlugin
+{
+public:
+  /// Constructor
+  LinkConditioner(uint seed = 0);
+
+  //
+  // Operations
+  //
+
+  /// Conditions applied to packets sent by the peer
+  void SetOutgoingConditions(const LinkConditions& outgoingConditions);
+  const LinkConditions& GetOutgoingConditions() const;
+
+  /// Conditions applied to packets received by the peer
+  void SetIncomingConditions(const LinkConditions& incomingConditions);
+  const LinkConditions& GetIncomingConditions() const;
+
+  /// Returns the number of bytes delivered to the network (after conditions)
+  uint64 GetSentBytes() const;
+  /// Returns the number of bytes delivered to the peer (after conditions)
+  uint64 GetReceivedBytes() const;
+  /// Returns the number of packets dropped in either direction
+  uint64 GetDroppedPacketCount() const;
+
+protected:
+  //
+  // Peer Plugin Interface
+  //
+
+  void OnUninitialize() override;
+  void OnUpdate() override;
+  bool OnPacketSend(OutPacket& packet) override;
+  bool OnPacketReceive(InPacket& packet) override;
+
+private:
+  //
+  // Internal
+  //
+
+  /// Returns the time at which a packet of the specified size should be
+  /// delivered according to the conditions (reserving bandwidth as needed)
+  TimeMs ScheduleDelivery(const LinkConditions& conditions, TimeMs& bandwidthFreeTime, Bits packetBits, TimeMs now);
+
+  /// Inserts the held packet, keeping held packets sorted by delivery time
+  template <typename PacketType>
+  static void HoldPacket(Array<Pair<TimeMs, PacketType>>& heldPackets, TimeMs deliveryTime, MoveReference<PacketType> packet);
+
+  /// Data
+  LinkConditions mOutgoingConditions;                  /// Outgoing packet conditions
+  LinkConditions mIncomingConditions;                  /// Incoming packet conditions
+  Math::Random mRandom;                                /// Condition random number generator
+  Array<Pair<TimeMs, OutPacket>> mHeldOutgoingPackets; /// Outgoing packets awaiting delivery
+  Array<Pair<TimeMs, InPacket>> mHeldIncomingPackets;  /// Incoming packets awaiting delivery
+  TimeMs mOutgoingBandwidthFreeTime;                   /// Time the outgoing bandwidth limit is next free
+  TimeMs mIncomingBandwidthFreeTime;                   /// Time the incoming bandwidth limit is next free
+  uint64 mSentBytes;                                   /// Bytes delivered to the network
+  uint64 mReceivedBytes;                               /// Bytes delivered to the peer
+  uint64 mDroppedPacketCount;                          /// Packets dropped in either direction
+};
+
+} // namespace Raverie
@@ -4,6 +4,24 @@
 namespace Raverie
 {
 
+/// First port assigned to loopback peers opened on any port
+static const uint LoopbackFirstDynamicPort = 49152;
+/// Last port assigned to loopback peers opened on any port
+static const uint LoopbackLastDynamicPort = 65535;
+
+/// Returns the peers open on the in-process loopback transport, by port
+static HashMap<uint, Peer*>& GetLoopbackPeers()
+{
+  static HashMap<uint, Peer*> sLoopbackPeers;
+  return sLoopbackPeers;
+}
+/// Returns the loopback peers thread lock
+static ThreadLock& GetLoopbackPeersLock()
+{
+  static ThreadLock sLoopbackPeersLock;
+  return sLoopbackPeersLock;
+}
+
 //                                    Peer //
 
 void Peer::ResetSession()
@@ -13,14 +31,22 @@ void Peer::ResetSession()
   mIpv6Address.Clear();
   mInternetProtocol = InternetProtocol::Unspecified;
   mTransportProtocol = TransportProtocol::Unspecified;
+  mLoopback = false;
 
   /// Thread Data
   mFatalError = false;
 
   /// Packet Data
   mIpv4RawPackets.Clear();
+  mIpv4FreeRawPackets.Clear();
   mIpv6RawPackets.Clear();
+  mIpv6FreeRawPackets.Clear();
   mSendBitStream.Clear(false);
+  mSendBatch.Clear();
+  mSendBatchCount = 0;
+  mIpv4SendDatagrams.Clear();
+  mIpv6SendDatagrams.Clear();
+  mPluginReleasedPackets.Clear();
 
   InitializeStats();
 }
@@ -38,6 +64,7 @@ Peer::Peer(ProcessReceivedCustomPacketFn processReceivedCustomPacketFn, ProcessR
     mIpv6Socket(),
     mInternetProtocol(InternetProtocol::Unspecified),
     mTransportProtocol(TransportProtocol::Unspecified),
+    mLoopback(false),
     mUserData(nullptr),
 
     /// Thread Data
@@ -55,13 +82,20 @@ Peer::Peer(ProcessReceivedCustomPacketFn processReceivedCustomPacketFn, ProcessR
 
     /// Packet Data
     mIpv4RawPackets(),
+    mIpv4FreeRawPackets(),
     mIpv4RawPacketsLock(),
     mIpv6RawPackets(),
+    mIpv6FreeRawPackets(),
     mIpv6RawPacketsLock(),
     mSendBitStream(),
+    mSendBatch(),
+    mSendBatchCount(0),
+    mIpv4SendDatagrams(),
+    mIpv6SendDatagrams(),
     mReceiveStatsLock(),
     mReleasedCustomPackets(),
     mReleasedCustomPacketsLock(),
+    mPluginReleasedPackets(),
 
     /// Link Data
     mCreatedLinks(),
@@ -139,7 +173,12 @@ const IpAddress& Peer::GetLocalIpv6Address() const
 
 bool Peer::IsOpen() const
 {
-  return mIpv4Socket.IsOpen() || mIpv6Socket.IsOpen() || !mIpv4ReceiveThread.IsCompleted() || !mIpv6ReceiveThread.IsCompleted();
+  return mLoopback || mIpv4Socket.IsOpen() || mIpv6Socket.IsOpen() || !mIpv4ReceiveThread.IsCompleted() || !mIpv6ReceiveThread.IsCompleted();
+}
+
+bool Peer::IsLoopback() const
+{
+  return mLoopback;
 }
 
 InternetProtocol::Enum Peer::GetInternetProtocol() const
@@ -293,6 +332,56 @@ void Peer::Open(Status& status, ushort port, InternetProtocol::Enum internetProt
   Update();
 }
 
+void Peer::OpenLoopback(Status& status, ushort port)
+{
+  // Close peer if anything is open
+  Close();
+
+  { //<>-<>-<>-<>-< Loopback Peers Locked >-<>-<>-<>-<>-
+    Lock lock(GetLoopbackPeersLock());
+    HashMap<uint, Peer*>& loopbackPeers = GetLoopbackPeers();
+
+    // Choose the first free dynamic port?
+    uint loopbackPort = port;
+    if (loopbackPort == AnyPort)
+    {
+      for (loopbackPort = LoopbackFirstDynamicPort; loopbackPort <= LoopbackLastDynamicPort; ++loopbackPort)
+        if (!loopbackPeers.ContainsKey(loopbackPort))
+          break;
+    }
+
+    // Port already in use?
+    if (loopbackPort > LoopbackLastDynamicPort || loopbackPeers.ContainsKey(loopbackPort))
+    {
+      status.SetFailed(String::Format("Unable to open loopback peer, port %u is already in use", loopbackPort));
+      return;
+    }
+
+    // Specify loopback IPv4 host and chosen port
+    mIpv4Address.SetHost(status, "127.0.0.1", InternetProtocol::V4);
+    if (status.Failed()) // Unable?
+    {
+      mIpv4Address.Clear();
+      return;
+    }
+    mIpv4Address.SetPort(loopbackPort);
+
+    // Register loopback peer
+    loopbackPeers.InsertOrError(loopbackPort, this);
+
+  } //-<>-<>-<>-<>-< Loopback Peers Unlocked >-<>-<>-<>-<>
+
+  //
+  // Store Session Information
+  //
+  mInternetProtocol = InternetProtocol::V4;
+  mTransportProtocol = TransportProtocol::Udp;
+  mLoopback = true;
+
+  // Update once to initialize links and plugins
+  Update();
+}
+
 void Peer::Close()
 {
   //
@@ -329,6 +418,23 @@ void Peer::Close()
   Assert(mPlugins.Empty());
   Assert(mRemovedPlugins.Empty());
 
+  //
+  // Close Loopback
+  //
+
+  // Open on the loopback transport?
+  if (mLoopback)
+  {
+    //<>-<>-<>-<>-< Loopback Peers Locked >-<>-<>-<>-<>-
+    Lock lock(GetLoopbackPeersLock());
+
+    // Unregister loopback peer (no more packets will be delivered to it)
+    GetLoopbackPeers().Erase(mIpv4Address.GetPort());
+    mLoopback = false;
+
+    //-<>-<>-<>-<>-< Loopback Peers Unlocked >-<>-<>-<>-<>
+  }
+
   //
   // Unblock Receive Threads
   //
@@ -794,6 +900,17 @@ bool Peer::SendPacket(OutPacket& outPacket)
   // Write packet to bitstream
   mSendBitStream.Write(outPacket);
 
+  // Open on the loopback transport?
+  if (mLoopback)
+  {
+    // Deliver packet to the loopback peer
+    Bytes result = SendLoopbackPacket(mSendBitStream.GetData(), mSendBitStream.GetBytesWritten(), outPacket.GetDestinationIpAddress());
+
+    // Clear for next send
+    mSendBitStream.Clear(false);
+    return (result != 0);
+  }
+
   // Choose correct socket (IPv4 or IPv6)
   Socket& socket = outPacket.GetDestinationIpAddress().GetInternetProtocol() == InternetProtocol::V4 ? mIpv4Socket : mIpv6Socket;
 
@@ -813,6 +930,88 @@ bool Peer::SendPacket(OutPacket& outPacket)
   mSendBitStream.Clear(false);
   return (result != 0);
 }
+void Peer::QueuePacket(OutPacket& outPacket)
+{
+  // [Peer Plugin Event] Stop?
+  if (!PluginEventOnPacketSend(outPacket))
+    return;
+
+  // Write packet to the send batch
+  BatchPacket(outPacket);
+}
+void Peer::BatchPacket(OutPacket& outPacket)
+{
+  // Send batch full?
+  if (mSendBatchCount == PeerSocketBatchSize)
+    FlushQueuedPackets();
+
+  // Send batch buffers not yet allocated?
+  if (mSendBatch.Empty())
+  {
+    mSendBatch.Resize(PeerSocketBatchSize);
+    forRange (BitStream& bitStream, mSendBatch.All())
+      bitStream.Reserve(EthernetMtuBytes);
+    mIpv4SendDatagrams.Reserve(PeerSocketBatchSize);
+    mIpv6SendDatagrams.Reserve(PeerSocketBatchSize);
+  }
+
+  // Write packet to the next queued bitstream
+  BitStream& bitStream = mSendBatch[mSendBatchCount];
+  bitStream.Write(outPacket);
+  ++mSendBatchCount;
+
+  // Queue datagram on the correct socket (IPv4 or IPv6)
+  SocketDatagram datagram;
+  datagram.mData = bitStream.GetDataExposed();
+  datagram.mDataLength = bitStream.GetBytesWritten();
+  datagram.mAddress = outPacket.GetDestinationIpAddress();
+  if (outPacket.GetDestinationIpAddress().GetInternetProtocol() == InternetProtocol::V4)
+    mIpv4SendDatagrams.PushBack(datagram);
+  else
+    mIpv6SendDatagrams.PushBack(datagram);
+}
+void Peer::FlushQueuedPackets()
+{
+  // Nothing queued?
+  if (mSendBatchCount == 0)
+    return;
+
+  // Open on the loopback transport?
+  if (mLoopback)
+  {
+    // Deliver queued packets to the loopback peers
+    forRange (SocketDatagram& datagram, mIpv4SendDatagrams.All())
+      SendLoopbackPacket(datagram.mData, datagram.mDataLength, datagram.mAddress);
+  }
+  // Send queued IPv4 packets over socket
+  else if (!mIpv4SendDatagrams.Empty())
+  {
+    Status status;
+    size_t sent = mIpv4Socket.SendToBatch(status, mIpv4SendDatagrams.Data(), mIpv4SendDatagrams.Size());
+
+    // Update stats
+    for (size_t i = 0; i < sent; ++i)
+      UpdateSendStats(mIpv4SendDatagrams[i].mBytes);
+  }
+
+  // Send queued IPv6 packets over socket
+  if (!mIpv6SendDatagrams.Empty())
+  {
+    Status status;
+    size_t sent = mIpv6Socket.SendToBatch(status, mIpv6SendDatagrams.Data(), mIpv6SendDatagrams.Size());
+
+    // Update stats
+    for (size_t i = 0; i < sent; ++i)
+      UpdateSendStats(mIpv6SendDatagrams[i].mBytes);
+  }
+
+  // Clear for next send batch
+  for (uint i = 0; i < mSendBatchCount; ++i)
+    mSendBatch[i].Clear(false);
+  mSendBatchCount = 0;
+  mIpv4SendDatagrams.Clear();
+  mIpv6SendDatagrams.Clear();
+}
 
 void Peer::UpdateSendStats(Bytes sentPacketBytes)
 {
@@ -886,35 +1085,14 @@ OsInt Peer::Ipv4ReceiveThreadFn()
     //
     // Receive Loop
     //
-    RawPacket rawPacket;
-    rawPacket.mData.Reserve(EthernetMtuBytes);
+    Array<RawPacket> batch(PeerSocketBatchSize);
+    forRange (RawPacket& rawPacket, batch.All())
+      rawPacket.mData.Reserve(EthernetMtuBytes);
+    Array<SocketDatagram> datagrams(PeerSocketBatchSize);
     while (!mExitIpv4ReceiveThread)
     {
-      // Wait to receive a packet over socket
-      Status status;
-      SocketAddress sourceAddress;
-      Bytes result = mIpv4Socket.ReceiveFrom(status, rawPacket.mData.GetDataExposed(), EthernetMtuBytes, sourceAddress);
-      rawPacket.mData.SetBytesWritten(result);
-      rawPacket.mIpAddress = sourceAddress;
-      if (result && IsValidRawPacket(rawPacket)) // Successful?
-      {
-        Assert(rawPacket.mIpAddress.IsValid());
-
-        { //<>-<>-<>-<>-< IPv4 Raw Packets Locked >-<>-<>-<>-<>-
-          Lock lock(mIpv4RawPacketsLock);
-
-          // Push raw packet copy
-          mIpv4RawPackets.PushBack(rawPacket);
-
-        } //-<>-<>-<>-<>-< IPv4 Raw Packets Unlocked >-<>-<>-<>-<>
-
-        // Update stats
-        UpdateReceiveStats(result);
-      }
-
-      // Clear for next receive
-      rawPacket.mIpAddress.Clear();
-      rawPacket.mData.Clear(false);
+      // Wait to receive one or more packets over socket
+      ReceiveRawPacketBatch(mIpv4Socket, batch, datagrams, mIpv4RawPackets, mIpv4FreeRawPackets, mIpv4RawPacketsLock);
     }
 
     // Success
@@ -944,33 +1122,14 @@ OsInt Peer::Ipv6ReceiveThreadFn()
     //
     // Receive Loop
     //
-    RawPacket rawPacket;
-    rawPacket.mData.Reserve(EthernetMtuBytes);
+    Array<RawPacket> batch(PeerSocketBatchSize);
+    forRange (RawPacket& rawPacket, batch.All())
+      rawPacket.mData.Reserve(EthernetMtuBytes);
+    Array<SocketDatagram> datagrams(PeerSocketBatchSize);
     while (!mExitIpv6ReceiveThread)
     {
-      // Wait to receive a packet over socket
-      Status status;
-      Bytes result = mIpv6Socket.ReceiveFrom(status, rawPacket.mData.GetDataExposed(), EthernetMtuBytes, rawPacket.mIpAddress);
-      rawPacket.mData.SetBytesWritten(result);
-      if (result && IsValidRawPacket(rawPacket)) // Successful?
-      {
-        Assert(rawPacket.mIpAddress.IsValid());
-
-        { //<>-<>-<>-<>-< IPv6 Raw Packets Locked >-<>-<>-<>-<>-
-          Lock lock(mIpv6RawPacketsLock);
-
-          // Push raw packet copy
-          mIpv6RawPackets.PushBack(rawPacket);
-
-        } //-<>-<>-<>-<>-< IPv6 Raw Packets Unlocked >-<>-<>-<>-<>
-
-        // Update stats
-        UpdateReceiveStats(result);
-      }
-
-      // Clear for next receive
-      rawPacket.mIpAddress.Clear();
-      rawPacket.mData.Clear(false);
+      // Wait to receive one or more packets over socket
+      ReceiveRawPacketBatch(mIpv6Socket, batch, datagrams, mIpv6RawPackets, mIpv6FreeRawPackets, mIpv6RawPacketsLock);
     }
 
     // Success
@@ -992,6 +1151,168 @@ OsInt Peer::Ipv6ReceiveThreadFn()
   return 1;
 }
 
+void Peer::ReceiveRawPacketBatch(Socket& socket, Array<RawPacket>& batch, Array<SocketDatagram>& datagrams, Array<RawPacket>& rawPackets, Array<RawPacket>& freeRawPackets, ThreadLock& rawPacketsLock)
+{
+  // Receive directly into each packet's reserved buffer
+  for (size_t i = 0; i < batch.Size(); ++i)
+  {
+    datagrams[i].mData = batch[i].mData.GetDataExposed();
+    datagrams[i].mDataLength = EthernetMtuBytes;
+    datagrams[i].mBytes = 0;
+  }
+
+  // Wait to receive one or more packets over socket
+  Status status;
+  size_t received = socket.ReceiveFromBatch(status, datagrams.Data(), datagrams.Size());
+
+  // Validate received packets
+  uint validCount = 0;
+  for (size_t i = 0; i < received; ++i)
+  {
+    RawPacket& rawPacket = batch[i];
+    rawPacket.mData.SetBytesWritten(datagrams[i].mBytes);
+    rawPacket.mIpAddress = datagrams[i].mAddress;
+    if (datagrams[i].mBytes && IsValidRawPacket(rawPacket)) // Successful?
+    {
+      Assert(rawPacket.mIpAddress.IsValid());
+      ++validCount;
+    }
+    else
+    {
+      // Clear for next receive
+      rawPacket.mIpAddress.Clear();
+      rawPacket.mData.Clear(false);
+      datagrams[i].mBytes = 0;
+    }
+  }
+
+  // Nothing to hand off?
+  if (validCount == 0)
+    return;
+
+  { //<>-<>-<>-<>-< Raw Packets Locked >-<>-<>-<>-<>-
+    Lock lock(rawPacketsLock);
+
+    for (size_t i = 0; i < received; ++i)
+    {
+      if (datagrams[i].mBytes == 0)
+        continue;
+
+      // Hand off raw packet (no copy)
+      rawPackets.PushBack(RaverieMove(batch[i]));
+
+      // Replace it with a recycled buffer, if available
+      if (!freeRawPackets.Empty())
+      {
+        batch[i] = RaverieMove(freeRawPackets.Back());
+        freeRawPackets.PopBack();
+      }
+    }
+
+  } //-<>-<>-<>-<>-< Raw Packets Unlocked >-<>-<>-<>-<>
+
+  for (size_t i = 0; i < received; ++i)
+  {
+    if (datagrams[i].mBytes == 0)
+      continue;
+
+    // Allocate a new buffer if the pool was empty (does nothing for recycled
+    // buffers)
+    batch[i].mData.Reserve(EthernetMtuBytes);
+
+    // Update stats
+    UpdateReceiveStats(datagrams[i].mBytes);
+  }
+}
+Bytes Peer::SendLoopbackPacket(const byte* data, Bytes dataLength, const IpAddress& destination)
+{
+  // Not an IPv4 destination? (Loopback peers only use IPv4)
+  if (destination.GetInternetProtocol() != InternetProtocol::V4)
+    return 0;
+
+  { //<>-<>-<>-<>-< Loopback Peers Locked >-<>-<>-<>-<>-
+    Lock lock(GetLoopbackPeersLock());
+
+    // No loopback peer open on the destination port?
+    // (Dropped, just like a datagram sent to a closed port)
+    Peer* peer = GetLoopbackPeers().FindValue(destination.GetPort(), nullptr);
+    if (!peer)
+      return 0;
+
+    // Deliver packet
+    if (!peer->ReceiveLoopbackPacket(data, dataLength, mIpv4Address)) // Unable?
+      return 0;
+
+  } //-<>-<>-<>-<>-< Loopback Peers Unlocked >-<>-<>-<>-<>
+
+  // Update stats
+  UpdateSendStats(dataLength);
+  return dataLength;
+}
+bool Peer::ReceiveLoopbackPacket(const byte* data, Bytes dataLength, const IpAddress& source)
+{
+  // Packet larger than a datagram?
+  if (dataLength > EthernetMtuBytes)
+    return false;
+
+  { //<>-<>-<>-<>-< Raw Packets Locked >-<>-<>-<>-<>-
+    Lock lock(mIpv4RawPacketsLock);
+
+    // Use a recycled buffer, if available
+    RawPacket rawPacket;
+    if (!mIpv4FreeRawPackets.Empty())
+    {
+      rawPacket = RaverieMove(mIpv4FreeRawPackets.Back());
+      mIpv4FreeRawPackets.PopBack();
+    }
+    rawPacket.mData.Reserve(EthernetMtuBytes);
+
+    // Copy packet data
+    memcpy(rawPacket.mData.GetDataExposed(), data, dataLength);
+    rawPacket.mData.SetBytesWritten(dataLength);
+    rawPacket.mIpAddress = source;
+    if (!IsValidRawPacket(rawPacket)) // Invalid?
+    {
+      // Return buffer to the pool
+      rawPacket.mIpAddress.Clear();
+      rawPacket.mData.Clear(false);
+      mIpv4FreeRawPackets.PushBack(RaverieMove(rawPacket));
+      return false;
+    }
+
+    // Hand off raw packet
+    mIpv4RawPackets.PushBack(RaverieMove(rawPacket));
+
+  } //-<>-<>-<>-<>-< Raw Packets Unlocked >-<>-<>-<>-<>
+
+  // Update stats
+  UpdateReceiveStats(dataLength);
+  return true;
+}
+void Peer::RecycleRawPackets(Array<RawPacket>& rawPackets, Array<RawPacket>& freeRawPackets, ThreadLock& rawPacketsLock)
+{
+  // Clear for next receive
+  forRange (RawPacket& rawPacket, rawPackets.All())
+  {
+    rawPacket.mIpAddress.Clear();
+    rawPacket.mData.Clear(false);
+  }
+
+  { //<>-<>-<>-<>-< Raw Packets Locked >-<>-<>-<>-<>-
+    Lock lock(rawPacketsLock);
+
+    // Return buffers to the pool (freeing any beyond the pool size)
+    while (!rawPackets.Empty() && freeRawPackets.Size() < PeerRawPacketPoolSize)
+    {
+      freeRawPackets.PushBack(RaverieMove(rawPackets.Back()));
+      rawPackets.PopBack();
+    }
+
+  } //-<>-<>-<>-<>-< Raw Packets Unlocked >-<>-<>-<>-<>
+
+  rawPackets.Clear();
+}
+
 void Peer::UpdatePeerState()
 {
   //
@@ -1117,6 +1438,7 @@ void Peer::UpdatePeerState()
 
   // Translate raw IPv4 packets
   TranslateRawPackets(rawPackets, inPackets);
+  RecycleRawPackets(rawPackets, mIpv4FreeRawPackets, mIpv4RawPacketsLock);
 
   //
   // Translate Raw IPv6 Packets
@@ -1132,6 +1454,7 @@ void Peer::UpdatePeerState()
 
   // Translate raw IPv6 packets
   TranslateRawPackets(rawPackets, inPackets);
+  RecycleRawPackets(rawPackets, mIpv6FreeRawPackets, mIpv6RawPacketsLock);
 
   //
   // Process Received Packets
@@ -1142,53 +1465,17 @@ void Peer::UpdatePeerState()
     if (!PluginEventOnPacketReceive(inPacket))
       continue;
 
-    // Is a standalone packet?
-    if (inPacket.IsStandalone())
-    {
-      // Let the user process the custom packet
-      ProcessReceivedCustomPacket(inPacket);
-      continue;
-    }
-
-    // Get the link representing this packet's remote peer
-    PeerLink* link = mLinks.FindValue(inPacket.GetSourceIpAddress(), nullptr);
-    if (!link) // Doesn't exist?
-    {
-      // Link limit already reached?
-      if (mLinks.Size() >= GetLinkLimit())
-        continue; // Ignore packet
-
-      // Create new incoming link
-      link = new PeerLink(this, inPacket.GetSourceIpAddress(), TransmissionDirection::Incoming);
-
-      // [Peer Plugin Event] Continue?
-      if (PluginEventOnLinkAdd(link))
-      {
-        // Add link to active links
-        PeerLinkSet::pointer_bool_pair result = mLinks.Insert(link);
-        Assert(result.second); // (Insertion should have succeeded)
-      }
-      else
-      {
-        // [Peer Plugin Event]
-        PluginEventOnLinkRemove(link);
-
-        // Delete link
-        delete link;
-
-        // Ignore packet
-        continue;
-      }
-
-      // [Peer Event]
-      PeerEventIncomingLinkCreated(inPacket.GetSourceIpAddress());
-    }
-
-    // Push received packet into link to be processed later
-    link->ReceivePacket(RaverieMove(inPacket));
+    // Process received packet
+    ProcessReceivedPacket(inPacket);
   }
   inPackets.Clear();
 
+  // Process packets released late by peer plugins
+  // (They have already been through the peer plugin event)
+  forRange (InPacket& inPacket, mPluginReleasedPackets.All())
+    ProcessReceivedPacket(inPacket);
+  mPluginReleasedPackets.Clear();
+
   //
   // Update Links
   //
@@ -1208,6 +1495,58 @@ void Peer::UpdatePeerState()
   //
   forRange (PeerPlugin* plugin, mPlugins.All())
     plugin->OnUpdate();
+
+  //
+  // Send Queued Packets
+  //
+  FlushQueuedPackets();
+}
+void Peer::ProcessReceivedPacket(InPacket& inPacket)
+{
+  // Is a standalone packet?
+  if (inPacket.IsStandalone())
+  {
+    // Let the user process the custom packet
+    ProcessReceivedCustomPacket(inPacket);
+    return;
+  }
+
+  // Get the link representing this packet's remote peer
+  PeerLink* link = mLinks.FindValue(inPacket.GetSourceIpAddress(), nullptr);
+  if (!link) // Doesn't exist?
+  {
+    // Link limit already reached?
+    if (mLinks.Size() >= GetLinkLimit())
+      return; // Ignore packet
+
+    // Create new incoming link
+    link = new PeerLink(this, inPacket.GetSourceIpAddress(), TransmissionDirection::Incoming);
+
+    // [Peer Plugin Event] Continue?
+    if (PluginEventOnLinkAdd(link))
+    {
+      // Add link to active links
+      PeerLinkSet::pointer_bool_pair result = mLinks.Insert(link);
+      Assert(result.second); // (Insertion should have succeeded)
+    }
+    else
+    {
+      // [Peer Plugin Event]
+      PluginEventOnLinkRemove(link);
+
+      // Delete link
+      delete link;
+
+      // Ignore packet
+      return;
+    }
+
+    // [Peer Event]
+    PeerEventIncomingLinkCreated(inPacket.GetSourceIpAddress());
+  }
+
+  // Push received packet into link to be processed later
+  link->ReceivePacket(RaverieMove(inPacket));
 }
 void Peer::ProcessReceivedCustomPackets()
 {
@@ -1244,7 +1583,6 @@ void Peer::TranslateRawPackets(Array<RawPacket>& rawPackets, Array<InPacket>& in
     if (rawPacket.mData.Read(inPacket)) // Successful?
       inPackets.PushBack(RaverieMove(inPacket));
   }
-  rawPackets.Clear();
 }
 
 bool Peer::PluginEventOnPacketSend(OutPacket& packet)
@@ -1384,6 +1722,21 @@ PeerPlugin::PeerPlugin() : mName(), mPeer(nullptr)
 {
 }
 
+//
+// Peer Plugin Helpers
+//
+
+void PeerPlugin::ReleaseOutgoingPacket(OutPacket& packet)
+{
+  Assert(IsInitialized());
+  mPeer->BatchPacket(packet);
+}
+void PeerPlugin::ReleaseIncomingPacket(MoveReference<InPacket> packet)
+{
+  Assert(IsInitialized());
+  mPeer->mPluginReleasedPackets.PushBack(RaverieMove(packet));
+}
+
 //
 // Internal
 //
@@ -16,6 +16,11 @@ typedef void (*ProcessReceivedCustomPacketFn)(Peer* peer, InPacket& packet);
 /// (will continue next update call)
 typedef bool (*ProcessReceivedCustomMessageFn)(PeerLink* link, Message& message);
 
+/// Maximum number of datagrams moved per batched socket send or receive call
+static const uint PeerSocketBatchSize = 32;
+/// Maximum number of spare raw packet buffers kept for reuse per socket
+static const uint PeerRawPacketPoolSize = 1024;
+
 //                                    Peer //
 
 /// Acts as a host on the network
@@ -60,6 +65,9 @@ public:
 
   /// Returns true if the peer is open, else false
   bool IsOpen() const;
+  /// Returns true if the peer is open on the in-process loopback transport,
+  /// else false
+  bool IsLoopback() const;
 
   /// Returns the open peer's IP address protocol version, else
   /// InternetProtocol::Unspecified
@@ -76,6 +84,12 @@ public:
   /// sockets
   void Open(Status& status, ushort port = AnyPort, InternetProtocol::Enum internetProtocol = InternetProtocol::Both, TransportProtocol::Enum transportProtocol = TransportProtocol::Udp);
 
+  /// Opens the closed peer on the in-process loopback transport (closes the
+  /// peer if already open) at 127.0.0.1 on the specified port
+  /// Loopback peers exchange packets directly with other loopback peers in
+  /// this process, without sockets or receive threads
+  void OpenLoopback(Status& status, ushort port = AnyPort);
+
   /// Closes the peer (safe to call multiple times)
   /// Uninitializes any initialized links and plugins managed by this peer
   /// Frees socket and thread resources used to run the peer
@@ -248,6 +262,15 @@ public:
   /// Sends an outgoing packet to the network
   /// Returns true if successful, else false
   bool SendPacket(OutPacket& outPacket);
+  /// Writes an outgoing packet into the send batch, to be sent over the
+  /// network on the next flush (flushes automatically once the batch is full)
+  void QueuePacket(OutPacket& outPacket);
+  /// Writes an outgoing packet into the send batch without raising the
+  /// packet send plugin event
+  void BatchPacket(OutPacket& outPacket);
+  /// Sends all queued outgoing packets to the network, using one batched
+  /// socket call per socket
+  void FlushQueuedPackets();
 
   /// Updates packet send statistics
   void UpdateSendStats(Bytes sentPacketBytes);
@@ -262,6 +285,21 @@ public:
   OsInt Ipv4ReceiveThreadFn();
   /// Receives incoming IPv6 packets from the network
   OsInt Ipv6ReceiveThreadFn();
+  /// Receives a batch of incoming packets from the socket into the thread's
+  /// packet buffers, then hands valid packets off to the user thread by move
+  /// (replacing them with recycled buffers from the pool)
+  /// (Exclusively used by the Peer's receive threads)
+  void ReceiveRawPacketBatch(Socket& socket, Array<RawPacket>& batch, Array<SocketDatagram>& datagrams, Array<RawPacket>& rawPackets, Array<RawPacket>& freeRawPackets, ThreadLock& rawPacketsLock);
+  /// Delivers an outgoing packet to the loopback peer at the destination
+  /// address Returns the number of bytes sent, else 0
+  Bytes SendLoopbackPacket(const byte* data, Bytes dataLength, const IpAddress& destination);
+  /// Receives an incoming packet from a loopback peer, handing it off to the
+  /// user thread like a packet received over a socket
+  /// Returns true if successful, else false
+  bool ReceiveLoopbackPacket(const byte* data, Bytes dataLength, const IpAddress& source);
+  /// Returns translated raw packets to the pool so their buffers can be reused
+  /// by the receive thread
+  void RecycleRawPackets(Array<RawPacket>& rawPackets, Array<RawPacket>& freeRawPackets, ThreadLock& rawPacketsLock);
 
   /// Processes incoming packets, updates peer and link state, and generates
   /// outgoing packets
@@ -270,6 +308,9 @@ public:
   void ProcessReceivedCustomPackets();
   /// Processes a custom packet received by the peer
   void ProcessReceivedCustomPacket(InPacket& packet);
+  /// Processes a packet received by the peer (creating its incoming link as
+  /// needed), after the packet receive plugin event
+  void ProcessReceivedPacket(InPacket& inPacket);
 
   // Translate raw incoming packets into packets that can be processed
   void TranslateRawPackets(Array<RawPacket>& rawPackets, Array<InPacket>& inPackets);
@@ -307,6 +348,7 @@ public:
   Socket mIpv6Socket;                                             /// IPv6 TCP/UDP socket
   InternetProtocol::Enum mInternetProtocol;                       /// IP address protocol version
   TransportProtocol::Enum mTransportProtocol;                     /// Transport layer protocol
+  bool mLoopback;                                                 /// Open on the loopback transport?
   void* mUserData;                                                /// Optional user data
 
   /// Thread Data
@@ -324,13 +366,20 @@ public:
 
   /// Packet Data
   Array<RawPacket> mIpv4RawPackets;              /// Raw incoming IPv4 packets
+  Array<RawPacket> mIpv4FreeRawPackets;          /// Reusable raw incoming IPv4 packet buffers
   mutable ThreadLock mIpv4RawPacketsLock;        /// Raw incoming IPv4 packets thread lock
   Array<RawPacket> mIpv6RawPackets;              /// Raw incoming IPv6 packets
+  Array<RawPacket> mIpv6FreeRawPackets;          /// Reusable raw incoming IPv6 packet buffers
   mutable ThreadLock mIpv6RawPacketsLock;        /// Raw incoming IPv6 packets thread lock
   BitStream mSendBitStream;                      /// Reusable outgoing packet bitstream
+  Array<BitStream> mSendBatch;                   /// Reusable queued outgoing packet bitstreams
+  uint mSendBatchCount;                          /// Queued outgoing packet count
+  Array<SocketDatagram> mIpv4SendDatagrams;      /// Queued outgoing IPv4 datagrams
+  Array<SocketDatagram> mIpv6SendDatagrams;      /// Queued outgoing IPv6 datagrams
   mutable ThreadLock mReceiveStatsLock;          /// Receive stats thread lock
   Array<InPacket> mReleasedCustomPackets;        /// Released incoming user packets
   mutable ThreadLock mReleasedCustomPacketsLock; /// Released incoming user packets thread lock
+  Array<InPacket> mPluginReleasedPackets;        /// Incoming packets released late by peer plugins
 
   /// Link Data
   PeerLinkSet mCreatedLinks;   /// Links which were just created, need to be added
@@ -458,6 +507,17 @@ protected:
   {
   }
 
+  //
+  // Peer Plugin Helpers
+  //
+
+  /// Sends a packet previously stopped in OnPacketSend, without calling
+  /// OnPacketSend again (Sent with the current peer update's send batch)
+  void ReleaseOutgoingPacket(OutPacket& packet);
+  /// Receives a packet previously stopped in OnPacketReceive, without calling
+  /// OnPacketReceive again (Processed on the next peer update)
+  void ReleaseIncomingPacket(MoveReference<InPacket> packet);
+
 private:
   //
   // Internal
@@ -234,6 +234,7 @@ MessageReceiptId PeerLink::Send(Status& status, const Message& message, bool rel
   }
 
   // Copy message
+  // (Shares the message data, which is only copied if modified)
   Message messageCopy(message);
 
   // Convert relative message type to absolute message type
@@ -804,8 +805,8 @@ void PeerLink::SendPacket(OutPacket& outPacket)
   // Get packet size (in bits)
   Bits outPacketBits = outPacket.GetTotalBits();
 
-  // Send packet now
-  GetPeer()->SendPacket(outPacket);
+  // Queue packet to be sent with the peer's next send batch
+  GetPeer()->QueuePacket(outPacket);
 
   // Update Stats
   UpdatePacketsSent();
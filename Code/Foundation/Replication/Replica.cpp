@@ -20,6 +20,7 @@ Replica::Replica() :
     mDetectOutgoingChanges(false),
     mAcceptIncomingChanges(false),
     mAllowNapping(false),
+    mChangePriority(1),
     mAuthorityClientReplicatorId(0),
     mAccurateTimestampOnInitialization(false),
     mAccurateTimestampOnChange(false),
@@ -43,6 +44,7 @@ Replica::Replica(const CreateContext& createContext, const ReplicaType& replicaT
     mDetectOutgoingChanges(false),
     mAcceptIncomingChanges(false),
     mAllowNapping(false),
+    mChangePriority(1),
     mAuthorityClientReplicatorId(0),
     mAccurateTimestampOnInitialization(false),
     mAccurateTimestampOnChange(false),
@@ -252,6 +254,7 @@ void Replica::ResetConfig()
   SetDetectOutgoingChanges();
   SetAcceptIncomingChanges();
   SetAllowNapping();
+  SetChangePriority();
   SetAuthorityClientReplicatorId();
   SetAccurateTimestampOnInitialization();
   SetAccurateTimestampOnChange();
@@ -285,6 +288,15 @@ bool Replica::GetAllowNapping() const
   return mAllowNapping;
 }
 
+void Replica::SetChangePriority(float changePriority)
+{
+  mChangePriority = Math::Max(changePriority, 0.0f);
+}
+float Replica::GetChangePriority() const
+{
+  return mChangePriority;
+}
+
 void Replica::SetAuthorityClientReplicatorId(ReplicatorId authorityClientReplicatorId)
 {
   mAuthorityClientReplicatorId = authorityClientReplicatorId;
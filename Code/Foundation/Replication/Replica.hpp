@@ -136,6 +136,11 @@ public:
   void SetAllowNapping(bool allowNapping = true);
   bool GetAllowNapping() const;
 
+  /// Controls how quickly the replica's withheld changes gain priority on a
+  /// bandwidth constrained link, relative to other replicas (1 is normal)
+  void SetChangePriority(float changePriority = 1);
+  float GetChangePriority() const;
+
   /// Sets the change authority client by replicator ID
   /// Controls which client has change authority over all replica channels with
   /// client change authority (specified by ReplicaChannel::Authority)
@@ -232,6 +237,7 @@ public:
   bool mDetectOutgoingChanges;               /// Detect outgoing changes?
   bool mAcceptIncomingChanges;               /// Accept incoming changes?
   bool mAllowNapping;                        /// Allow napping?
+  float mChangePriority;                     /// Change priority weight
   ReplicatorId mAuthorityClientReplicatorId; /// Authority client by replicator ID
   bool mAccurateTimestampOnInitialization;   /// Accurate timestamp when
                                              /// initialized?
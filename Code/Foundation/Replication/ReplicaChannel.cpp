@@ -17,7 +17,11 @@ ReplicaChannel::ReplicaChannel(const String& name, ReplicaChannelType* replicaCh
     mLastChangeTimestamp(cInvalidMessageTimestamp),
     mLastChangeFrameId(0),
     mAuthority(Authority::Server),
-    mReplicaProperties()
+    mReplicaProperties(),
+    mIsSnapshotLaidOut(false),
+    mSnapshotSlots(),
+    mCurrentSnapshot(),
+    mLastSnapshot()
 {
   // Replica channel type provided?
   if (replicaChannelType)
@@ -429,19 +433,8 @@ bool ReplicaChannel::ObserveForChange()
   // Get replica channel type
   ReplicaChannelType* replicaChannelType = GetReplicaChannelType();
 
-  // For all replica properties
-  bool propertyChanged = false;
-  forRange (ReplicaProperty* replicaProperty, GetReplicaProperties().All())
-  {
-    // Property has changed?
-    if (replicaProperty->HasChanged())
-    {
-      propertyChanged = true;
-      break;
-    }
-  }
-
   // Channel has changed?
+  // (Properties are only compared when the detection mode needs them)
   switch (replicaChannelType->GetDetectionMode())
   {
   case DetectionMode::Assume:
@@ -451,10 +444,10 @@ bool ReplicaChannel::ObserveForChange()
     return CheckChangeFlag();
 
   case DetectionMode::Automatic:
-    return propertyChanged;
+    return HasAnyPropertyChanged();
 
   case DetectionMode::Manumatic:
-    return CheckChangeFlag() || propertyChanged;
+    return CheckChangeFlag() || HasAnyPropertyChanged();
 
   default:
     Assert(false);
@@ -462,7 +455,117 @@ bool ReplicaChannel::ObserveForChange()
   }
 }
 
-bool ReplicaChannel::Serialize(BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp) const
+bool ReplicaChannel::HasAnyPropertyChanged()
+{
+  // Snapshot slots not assigned yet?
+  if (!mIsSnapshotLaidOut)
+    LayOutSnapshot();
+
+  // For all replica properties without a snapshot slot
+  forRange (ReplicaProperty* replicaProperty, GetReplicaProperties().All())
+  {
+    if (replicaProperty->mSnapshotOffset != cInvalidSnapshotOffset)
+      continue;
+
+    // Property has changed?
+    if (replicaProperty->HasChanged())
+      return true;
+  }
+
+  // No snapshot properties?
+  if (mSnapshotSlots.Empty())
+    return false;
+
+  // For all replica properties with a snapshot slot
+  byte* currentSnapshot = mCurrentSnapshot.Data();
+  const byte* lastSnapshot = mLastSnapshot.Data();
+  forRange (ReplicaProperty* replicaProperty, mSnapshotSlots.All())
+  {
+    ReplicaPropertyType* replicaPropertyType = replicaProperty->GetReplicaPropertyType();
+    NativeType* nativeType = replicaPropertyType->GetNativeType();
+    byte* currentValue = currentSnapshot + replicaProperty->mSnapshotOffset;
+    const byte* lastValue = lastSnapshot + replicaProperty->mSnapshotOffset;
+
+    // Copy current raw value into the snapshot
+    // Unable? (Or the last value is not held in the snapshot?)
+    if (!replicaProperty->mHasLastSnapshot || !replicaPropertyType->GetGetRawValueFn()(replicaProperty->GetPropertyData(), nativeType, currentValue))
+    {
+      // Property has changed? (Compare using variants instead)
+      if (replicaProperty->HasChanged())
+        return true;
+
+      // Exclude from the snapshot comparison
+      memcpy(currentValue, lastValue, nativeType->mTypeSize);
+      continue;
+    }
+
+    // Use delta threshold comparison?
+    if (replicaPropertyType->GetUseDeltaThreshold())
+    {
+      // Property has changed?
+      if (replicaProperty->HasExceededDeltaThreshold(currentValue, lastValue))
+        return true;
+
+      // Exclude from the snapshot comparison
+      memcpy(currentValue, lastValue, nativeType->mTypeSize);
+    }
+  }
+
+  // Compare every remaining snapshot property at once
+  return memcmp(currentSnapshot, lastSnapshot, mCurrentSnapshot.Size()) != 0;
+}
+
+void ReplicaChannel::LayOutSnapshot()
+{
+  Assert(!mIsSnapshotLaidOut);
+  mIsSnapshotLaidOut = true;
+
+  // For all replica properties
+  size_t snapshotSize = 0;
+  forRange (ReplicaProperty* replicaProperty, GetReplicaProperties().All())
+  {
+    // Property type can't provide raw values?
+    ReplicaPropertyType* replicaPropertyType = replicaProperty->GetReplicaPropertyType();
+    NativeType* nativeType = replicaPropertyType->GetNativeType();
+    if (!replicaPropertyType->GetGetRawValueFn() || !nativeType->mIsBasicNativeTypeArithmetic)
+      continue;
+
+    // Assign snapshot slot
+    // (Aligned so primitive members can be read in place)
+    replicaProperty->mSnapshotOffset = snapshotSize;
+    snapshotSize += RaverieAlignCount(nativeType->mTypeSize) * sizeof(MaxAlignmentType);
+    mSnapshotSlots.PushBack(replicaProperty);
+  }
+
+  // Allocate snapshots
+  // (Zeroed so padding never differs)
+  mCurrentSnapshot.Resize(snapshotSize, byte(0));
+  mLastSnapshot.Resize(snapshotSize, byte(0));
+
+  // Store the last values observed so far
+  forRange (ReplicaProperty* replicaProperty, mSnapshotSlots.All())
+    StoreLastSnapshotValue(replicaProperty);
+}
+
+void ReplicaChannel::StoreLastSnapshotValue(ReplicaProperty* replicaProperty)
+{
+  Assert(replicaProperty->mSnapshotOffset != cInvalidSnapshotOffset);
+
+  // Last value is not of the property type's native type? (Or empty?)
+  const Variant& lastValue = replicaProperty->GetLastValue();
+  NativeType* nativeType = replicaProperty->GetReplicaPropertyType()->GetNativeType();
+  if (lastValue.GetNativeType() != nativeType)
+  {
+    replicaProperty->mHasLastSnapshot = false;
+    return;
+  }
+
+  // Copy last value into the snapshot
+  memcpy(mLastSnapshot.Data() + replicaProperty->mSnapshotOffset, lastValue.GetData(), nativeType->mTypeSize);
+  replicaProperty->mHasLastSnapshot = true;
+}
+
+bool ReplicaChannel::Serialize(BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp, const Array<bool>* changedProperties) const
 {
   // Get replica channel type
   ReplicaChannelType* replicaChannelType = GetReplicaChannelType();
@@ -493,11 +596,19 @@ bool ReplicaChannel::Serialize(BitStream& bitStream, ReplicationPhase::Enum repl
   {
     Assert(replicaChannelType->GetSerializationMode() == SerializationMode::Changed);
 
+    // Get replica properties
+    const ReplicaPropertySet& replicaProperties = GetReplicaProperties();
+    Assert(!changedProperties || changedProperties->Size() == replicaProperties.Size());
+
     // For all replica properties
-    forRange (ReplicaProperty* replicaProperty, GetReplicaProperties().All())
+    for (size_t i = 0; i < replicaProperties.Size(); ++i)
     {
+      const ReplicaProperty* replicaProperty = replicaProperties[i];
+
       // Write 'Has Changed?' Flag
-      bool hasChanged = replicaProperty->HasChanged();
+      // (Changes withheld from a link flag every replica property changed
+      // since the link was last sent this replica channel)
+      bool hasChanged = changedProperties ? (*changedProperties)[i] : replicaProperty->HasChanged();
       bitStream.Write(hasChanged);
       if (hasChanged) // Has changed?
       {
@@ -573,6 +684,70 @@ bool ReplicaChannel::Deserialize(const BitStream& bitStream, ReplicationPhase::E
   return true;
 }
 
+bool ReplicaChannel::SerializeDelta(BitStream& bitStream, const ReplicaChannelState* baselineState, ReplicaChannelState& sentState) const
+{
+  // Get replica properties
+  const ReplicaPropertySet& replicaProperties = GetReplicaProperties();
+  Assert(!baselineState || baselineState->Size() == replicaProperties.Size());
+
+  // For all replica properties
+  sentState.Resize(replicaProperties.Size());
+  for (size_t i = 0; i < replicaProperties.Size(); ++i)
+  {
+    // Write replica property delta
+    const Variant& baselineValue = baselineState ? (*baselineState)[i] : Variant();
+    bool result = replicaProperties[i]->SerializeDelta(bitStream, baselineValue, sentState[i]);
+    if (!result) // Unable?
+    {
+      Assert(false);
+      return false;
+    }
+  }
+
+  // Success
+  return true;
+}
+bool ReplicaChannel::DeserializeDelta(const BitStream& bitStream, const ReplicaChannelState* baselineState, ReplicaChannelState& receivedState) const
+{
+  // Get replica properties
+  const ReplicaPropertySet& replicaProperties = GetReplicaProperties();
+  if (baselineState && baselineState->Size() != replicaProperties.Size()) // Mismatched?
+    return false;
+
+  // For all replica properties
+  receivedState.Resize(replicaProperties.Size());
+  for (size_t i = 0; i < replicaProperties.Size(); ++i)
+  {
+    // Read replica property delta
+    const Variant& baselineValue = baselineState ? (*baselineState)[i] : Variant();
+    bool result = replicaProperties[i]->DeserializeDelta(bitStream, baselineValue, receivedState[i]);
+    if (!result) // Unable?
+      return false;
+  }
+
+  // Success
+  return true;
+}
+void ReplicaChannel::ReceiveState(const ReplicaChannelState& receivedState, const ReplicaChannelState* previousState, TimeMs timestamp)
+{
+  // Get replica properties
+  ReplicaPropertySet& replicaProperties = GetReplicaProperties();
+  Assert(receivedState.Size() == replicaProperties.Size());
+
+  // For all replica properties
+  for (size_t i = 0; i < replicaProperties.Size(); ++i)
+  {
+    // Unchanged since the previous received state?
+    // (The state was encoded against an older baseline, so this property may
+    // only look changed relative to that baseline)
+    if (previousState && (*previousState)[i] == receivedState[i])
+      continue;
+
+    // Handle received value
+    replicaProperties[i]->ReceiveValue(receivedState[i], ReplicationPhase::Change, timestamp);
+  }
+}
+
 //                             ReplicaChannelIndex //
 
 ReplicaChannelIndex::ReplicaChannelIndex() : mChannelLists(), mChannelCount(0)
@@ -913,6 +1088,7 @@ void ReplicaChannelType::ResetConfig()
   SetSerializationMode();
   SetReliabilityMode();
   SetTransferMode();
+  SetUseBaselineDeltas();
   SetAccurateTimestampOnChange();
 }
 
@@ -1111,6 +1287,23 @@ TransferMode::Enum ReplicaChannelType::GetTransferMode() const
   return mTransferMode;
 }
 
+void ReplicaChannelType::SetUseBaselineDeltas(bool useBaselineDeltas)
+{
+  // Already valid?
+  if (IsValid())
+  {
+    // Unable to modify configuration
+    Error("ReplicaChannelType is already valid, unable to modify configuration");
+    return;
+  }
+
+  mUseBaselineDeltas = useBaselineDeltas;
+}
+bool ReplicaChannelType::GetUseBaselineDeltas() const
+{
+  return mUseBaselineDeltas;
+}
+
 void ReplicaChannelType::SetAccurateTimestampOnChange(bool accurateTimestampOnChange)
 {
   mAccurateTimestampOnChange = accurateTimestampOnChange;
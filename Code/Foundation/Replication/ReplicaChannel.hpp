@@ -153,13 +153,40 @@ public:
   /// Returns true if a change was detected, else false
   bool ObserveForChange();
 
+  /// Returns true if any replica property has changed (according to the
+  /// configured delta threshold) since the last observation, else false
+  bool HasAnyPropertyChanged();
+
+  /// Assigns snapshot slots to replica properties whose types provide a raw
+  /// value getter, so they can be observed for changes without constructing
+  /// variants
+  void LayOutSnapshot();
+  /// Copies the replica property's last value into its snapshot slot
+  void StoreLastSnapshotValue(ReplicaProperty* replicaProperty);
+
   /// Serializes the replica channel
+  /// Changed properties, if specified, flags the replica properties to write
+  /// (by index) instead of those that have changed now
   /// Returns true if successful, else false
-  bool Serialize(BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp) const;
+  bool Serialize(BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp, const Array<bool>* changedProperties = nullptr) const;
   /// Deserializes the replica channel
   /// Returns true if successful, else false
   bool Deserialize(const BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp);
 
+  /// Serializes every replica property as a delta against the baseline state
+  /// (one value per replica property, else nullptr to encode against zero)
+  /// Sets sent state to the values the remote peer will decode
+  /// Returns true if successful, else false
+  bool SerializeDelta(BitStream& bitStream, const ReplicaChannelState* baselineState, ReplicaChannelState& sentState) const;
+  /// Deserializes every replica property delta encoded against the baseline
+  /// state (else nullptr to decode against zero) Does not set any property
+  /// values Returns true if successful, else false
+  bool DeserializeDelta(const BitStream& bitStream, const ReplicaChannelState* baselineState, ReplicaChannelState& receivedState) const;
+  /// Handles a received state (one value per replica property) as a change,
+  /// skipping replica properties whose values match the previous received
+  /// state (if any)
+  void ReceiveState(const ReplicaChannelState& receivedState, const ReplicaChannelState* previousState, TimeMs timestamp);
+
   /// Data
   String mName;                            /// Replica channel name
   ReplicaChannelType* mReplicaChannelType; /// Operating replica channel type
@@ -173,6 +200,10 @@ public:
   uint64 mLastChangeFrameId;               /// Frame ID of the last detected change
   Authority::Enum mAuthority;              /// Change authority
   ReplicaPropertySet mReplicaProperties;   /// Replica properties
+  bool mIsSnapshotLaidOut;                 /// Have snapshot slots been assigned?
+  ReplicaPropertyArray mSnapshotSlots;     /// Replica properties with snapshot slots
+  Array<byte> mCurrentSnapshot;            /// Raw current values (scratch, filled on observation)
+  Array<byte> mLastSnapshot;               /// Raw last values
 };
 
 /// Typedefs
@@ -371,6 +402,15 @@ public:
   void SetTransferMode(TransferMode::Enum transferMode = TransferMode::Ordered);
   TransferMode::Enum GetTransferMode() const;
 
+  /// Controls whether or not replica channel changes are delta encoded, per
+  /// link, against the last state the remote peer acknowledged receiving
+  /// (Changes are encoded against nothing until a state is acknowledged)
+  /// (Sequenced transfer mode cannot confirm receipt, so always sends full
+  /// states) (Cannot be modified after the replica channel type has been made
+  /// valid)
+  void SetUseBaselineDeltas(bool useBaselineDeltas = false);
+  bool GetUseBaselineDeltas() const;
+
   /// Controls whether or not the replica channel will serialize an accurate
   /// timestamp value when changed, or will instead accept an estimated
   /// timestamp value (This setting may be overridden for replica channels
@@ -400,6 +440,7 @@ public:
   SerializationMode::Enum mSerializationMode;   /// Serialization mode
   ReliabilityMode::Enum mReliabilityMode;       /// Change message reliability mode
   TransferMode::Enum mTransferMode;             /// Change message transfer mode
+  bool mUseBaselineDeltas;                      /// Delta encode changes against acknowledged states?
   bool mAccurateTimestampOnChange;              /// Accurate timestamp when changed?
 };
 
@@ -33,6 +33,17 @@ StaticAssertWithinRange(Range14, REPLICA_TYPE_ID_BITS, 1, UINTMAX_BITS);
 #define EMPLACE_CONTEXT_ID_BITS 11
 StaticAssertWithinRange(Range15, EMPLACE_CONTEXT_ID_BITS, 1, UINTMAX_BITS);
 
+/// Baseline Sequence bits
+/// Determines how many replica channel states may be sent over a link before
+/// their sequences wrap around
+#define BASELINE_SEQUENCE_BITS 16
+StaticAssertWithinRange(Range19, BASELINE_SEQUENCE_BITS, 1, UINTMAX_BITS);
+
+/// Baseline history size
+/// Determines how many recent replica channel states are kept per link to
+/// delta encode changes against (must be a power of two)
+#define BASELINE_HISTORY_SIZE 32
+
 /// Replica should use a virtual destructor?
 /// Enable this if you're relying on replica polymorphism for deletion
 #define REPLICA_USE_VIRTUAL_DESTRUCTOR 0
@@ -109,6 +120,22 @@ typedef UintN<ReplicaIdBits> ReplicaId;
 static const Bits EmplaceIdBits = EMPLACE_ID_BITS;
 typedef UintN<EmplaceIdBits> EmplaceId;
 
+//                             Baseline Sequence //
+
+/// Baseline Sequence
+/// Identifies a replica channel state sent over a link (changes are delta
+/// encoded against a previously sent state the remote peer is known to hold)
+static const Bits BaselineSequenceBits = BASELINE_SEQUENCE_BITS;
+typedef UintN<BaselineSequenceBits, true> BaselineSequence;
+
+/// Baseline history size
+static const uint BaselineHistorySize = BASELINE_HISTORY_SIZE;
+static_assert((BaselineHistorySize & (BaselineHistorySize - 1)) == 0, "Baseline history size must be a power of two");
+
+/// Baseline offset bits (distance from a state back to the baseline it was
+/// encoded against)
+static const Bits BaselineOffsetBits = BITS_NEEDED_TO_REPRESENT(BaselineHistorySize - 1);
+
 //                               Create Context //
 
 /// Create Context
@@ -179,10 +206,20 @@ typedef Variant (*GetValueFn)(const Variant& propertyData);
 /// Sets the current property value
 typedef void (*SetValueFn)(const Variant& value, Variant& propertyData);
 
+/// Property Raw Getter
+/// Copies the current property value (which must be of the specified basic
+/// arithmetic native type) into value without constructing a variant
+/// Returns true if successful, else false
+typedef bool (*GetRawValueFn)(const Variant& propertyData, NativeType* nativeType, void* value);
+
+/// Replica property has no slot in its replica channel's snapshot
+static const size_t cInvalidSnapshotOffset = size_t(-1);
+
 //                                 Typedefs //
 
 /// Typedefs
 typedef Array<Replica*> ReplicaArray;
+typedef Array<ReplicaProperty*> ReplicaPropertyArray;
 typedef ArraySet<Replica*, PointerSortPolicy<Replica*>> ReplicaSet;
 typedef ArrayMap<CreateContext, ReplicaSet> CreateMap;
 typedef ArrayMap<ReplicaType, ReplicaSet> ReplicaMap;
@@ -193,6 +230,7 @@ typedef ArrayMap<ReplicaChannel*, MessageChannelId> OutReplicaChannels;
 typedef ArrayMap<MessageChannelId, ReplicaChannel*> InReplicaChannels;
 typedef ArrayMap<ReplicaChannel*, MessageChannelId> InReplicaChannelsFlipped;
 typedef Pair<Message, TransmissionDirection::Enum> MessageDirectionPair;
+typedef Array<Variant> ReplicaChannelState;
 
 //                                  Enums //
 
@@ -222,7 +260,7 @@ DeclareEnum2(AuthorityMode,
                       /// replica is made valid
 
 /// Replicator Plugin Message Types
-DeclareEnum11(ReplicatorMessageType,
+DeclareEnum12(ReplicatorMessageType,
               ConnectConfirmation,     /// Connect confirmation
               CreateContextItems,      /// Creation context cache items
               ReplicaTypeItems,        /// Replica type cache items
@@ -233,7 +271,8 @@ DeclareEnum11(ReplicatorMessageType,
               Destroy,                 /// Destroy command
               Change,                  /// Replica channel change
               Interrupt,               /// Interrupt step command
-              ReverseReplicaChannels); /// Reverse replica channel mappings
+              ReverseReplicaChannels,  /// Reverse replica channel mappings
+              BaselineAcks);           /// Received replica channel state acknowledgements
 
 // Replica Stream Serialization Mode
 DeclareEnum5(ReplicaStreamMode,
@@ -76,7 +76,9 @@ ReplicaProperty::ReplicaProperty(const String& name, ReplicaPropertyType* replic
     mLastReceivedChangeFrameId(0),
     mSplineCurve(),
     mBakedCurve(),
-    mConvergenceState(ConvergenceState::None)
+    mConvergenceState(ConvergenceState::None),
+    mSnapshotOffset(cInvalidSnapshotOffset),
+    mHasLastSnapshot(false)
 {
   // Configure spline curves
   for (size_t i = 0; i < 4; ++i)
@@ -320,6 +322,13 @@ const Variant& ReplicaProperty::GetPropertyData() const
 void ReplicaProperty::SetLastValue(MoveReference<Variant> value)
 {
   mLastValue = RaverieMove(value);
+
+  // Has a snapshot slot?
+  if (mSnapshotOffset != cInvalidSnapshotOffset)
+  {
+    // Keep the snapshot's last value in sync
+    mReplicaChannel->StoreLastSnapshotValue(this);
+  }
 }
 const Variant& ReplicaProperty::GetLastValue() const
 {
@@ -1586,9 +1595,6 @@ bool ReplicaProperty::Deserialize(const BitStream& bitStream, ReplicationPhase::
   // Get replica property type
   ReplicaPropertyType* replicaPropertyType = GetReplicaPropertyType();
 
-  // Get frame ID
-  uint64 frameId = replicaPropertyType->GetReplicator()->GetPeer()->GetLocalFrameId();
-
   // Get quantization settings
   bool useQuantization = replicaPropertyType->GetUseQuantization();
   const Variant& quantizationRangeMin = replicaPropertyType->GetQuantizationRangeMin();
@@ -1657,6 +1663,390 @@ bool ReplicaProperty::Deserialize(const BitStream& bitStream, ReplicationPhase::
   // (Property type should be arithmetic if we reached this point)
   Assert(replicaPropertyType->GetNativeType()->mIsBasicNativeTypeArithmetic);
 
+  // Handle received value
+  ReceiveValue(newValue, replicationPhase, timestamp);
+
+  // Success
+  return true;
+}
+
+/// Writes the unsigned value four bits at a time, each followed by a 'Has
+/// more?' flag (so small values only take a few bits)
+inline void WriteVariableLength(BitStream& bitStream, u64 value)
+{
+  do
+  {
+    uint nibble = uint(value & 0xF);
+    value >>= 4;
+
+    bitStream.WriteQuantized(nibble, uint(0), uint(15));
+    bitStream.Write(value != 0);
+  } while (value != 0);
+}
+/// Reads an unsigned value written by WriteVariableLength
+/// Returns true if successful, else false
+inline bool ReadVariableLength(const BitStream& bitStream, u64& value)
+{
+  value = 0;
+  for (uint shift = 0; shift < 64; shift += 4)
+  {
+    // Read nibble and 'Has more?' flag
+    uint nibble;
+    bool hasMore;
+    if (!bitStream.ReadQuantized(nibble, uint(0), uint(15)) || !bitStream.Read(hasMore)) // Unable?
+      return false;
+
+    value |= (u64(nibble) << shift);
+    if (!hasMore)
+      return true;
+  }
+
+  // Value too large
+  return false;
+}
+
+/// Maps a two's complement delta to an unsigned value so that deltas of small
+/// magnitude (positive or negative) stay small
+inline u64 ZigZagEncode(u64 delta)
+{
+  return (delta << 1) ^ u64(s64(delta) >> 63);
+}
+inline u64 ZigZagDecode(u64 value)
+{
+  return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+/// Returns the primitive member's bit pattern
+template <typename PrimitiveType>
+inline u64 GetPrimitiveMemberBits(PrimitiveType value)
+{
+  u64 bits = 0;
+  memcpy(&bits, &value, sizeof(value));
+  return bits;
+}
+/// Returns the primitive member with the given bit pattern
+template <typename PrimitiveType>
+inline PrimitiveType SetPrimitiveMemberBits(u64 bits)
+{
+  PrimitiveType value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/// Returns the primitive member encoded as a delta against the baseline
+/// (Integers are encoded as their zig-zagged difference)
+template <typename PrimitiveType, TF_ENABLE_IF(is_integral<PrimitiveType>::value)>
+inline u64 EncodePrimitiveMemberDelta(PrimitiveType value, PrimitiveType baseline)
+{
+  return ZigZagEncode(u64(value) - u64(baseline));
+}
+/// (Floating point values are encoded as their bitwise XOR, since nearby
+/// values share their sign, exponent, and high mantissa bits)
+template <typename PrimitiveType, TF_ENABLE_IF(is_floating_point<PrimitiveType>::value)>
+inline u64 EncodePrimitiveMemberDelta(PrimitiveType value, PrimitiveType baseline)
+{
+  return GetPrimitiveMemberBits(value) ^ GetPrimitiveMemberBits(baseline);
+}
+
+/// Returns the primitive member decoded from a delta against the baseline
+template <typename PrimitiveType, TF_ENABLE_IF(is_integral<PrimitiveType>::value)>
+inline PrimitiveType DecodePrimitiveMemberDelta(PrimitiveType baseline, u64 delta)
+{
+  return PrimitiveType(u64(baseline) + ZigZagDecode(delta));
+}
+template <typename PrimitiveType, TF_ENABLE_IF(is_floating_point<PrimitiveType>::value)>
+inline PrimitiveType DecodePrimitiveMemberDelta(PrimitiveType baseline, u64 delta)
+{
+  return SetPrimitiveMemberBits<PrimitiveType>(GetPrimitiveMemberBits(baseline) ^ delta);
+}
+
+/// Returns the primitive member as a quantum step count within the
+/// quantization range
+template <typename PrimitiveType>
+inline s64 QuantizePrimitiveMember(PrimitiveType value, PrimitiveType minValue, PrimitiveType maxValue, PrimitiveType quantum)
+{
+  double clampedValue = Math::Clamp(double(value), double(minValue), double(maxValue));
+  return s64(Math::Floor((clampedValue - double(minValue)) / double(quantum) + 0.5));
+}
+/// Returns the primitive member at the quantum step count within the
+/// quantization range
+template <typename PrimitiveType>
+inline PrimitiveType DequantizePrimitiveMember(s64 steps, PrimitiveType minValue, PrimitiveType maxValue, PrimitiveType quantum)
+{
+  return PrimitiveType(Math::Clamp(double(minValue) + double(steps) * double(quantum), double(minValue), double(maxValue)));
+}
+
+/// (Arithmetic property type behavior)
+template <typename PropertyType, TF_ENABLE_IF(IsBasicNativeTypeArithmetic<PropertyType>::Value)>
+bool SerializeDeltaArithmetic(BitStream& bitStream, const ReplicaProperty* replicaProperty, const ReplicaPropertyType* replicaPropertyType, const Variant& baselineValue, Variant& sentValue)
+{
+  // Primitive member info
+  typedef typename BasicNativeTypePrimitiveMembers<PropertyType>::Type PrimitiveType;
+  static const size_t PrimitiveCount = BasicNativeTypePrimitiveMembers<PropertyType>::Count;
+
+  // Get current property value
+  Variant currentValue = replicaProperty->GetValue();
+
+  // (Current value should be non-empty)
+  Assert(currentValue.IsNotEmpty());
+
+  // Get serialization settings
+  bool hasBaseline = baselineValue.IsNotEmpty();
+  bool useHalfFloats = replicaPropertyType->GetUseHalfFloats();
+  bool useDeltaThreshold = (hasBaseline && replicaPropertyType->GetUseDeltaThreshold());
+  const Variant& deltaThreshold = replicaPropertyType->GetDeltaThreshold();
+
+  // Get quantization settings
+  bool useQuantization = replicaPropertyType->GetUseQuantization();
+  const Variant& quantizationRangeMin = replicaPropertyType->GetQuantizationRangeMin();
+  const Variant& quantizationRangeMax = replicaPropertyType->GetQuantizationRangeMax();
+  const Variant& quantum = replicaPropertyType->GetDeltaThreshold();
+
+  // Should we quantize?
+  // (Quantization is enabled and our quantization parameters are valid?)
+  bool shouldQuantize = (useQuantization && quantizationRangeMin.IsNotEmpty() && quantizationRangeMax.IsNotEmpty() && quantum.IsNotEmpty());
+
+  // For each primitive member
+  u64 deltas[PrimitiveCount];
+  bool hasChanged = false;
+  for (size_t i = 0; i < PrimitiveCount; ++i)
+  {
+    // Get primitive members
+    PrimitiveType& currentValuePrimitiveMember = currentValue.GetPrimitiveMemberOrError<PropertyType>(i);
+    PrimitiveType baselinePrimitiveMember = hasBaseline ? baselineValue.GetPrimitiveMemberOrError<PropertyType>(i) : PrimitiveType(0);
+
+    // Within the delta threshold of the baseline?
+    // (Treat as unchanged)
+    if (useDeltaThreshold && Math::Abs(currentValuePrimitiveMember - baselinePrimitiveMember) <= deltaThreshold.GetPrimitiveMemberOrError<PropertyType>(i))
+      currentValuePrimitiveMember = baselinePrimitiveMember;
+
+    // Should quantize?
+    if (shouldQuantize)
+    {
+      // Get quantization primitive members
+      const PrimitiveType& quantizationRangeMinPrimitiveMember = quantizationRangeMin.GetPrimitiveMemberOrError<PropertyType>(i);
+      const PrimitiveType& quantizationRangeMaxPrimitiveMember = quantizationRangeMax.GetPrimitiveMemberOrError<PropertyType>(i);
+      const PrimitiveType& quantumPrimitiveMember = quantum.GetPrimitiveMemberOrError<PropertyType>(i);
+
+      // Encode difference in quantum steps
+      s64 currentSteps = QuantizePrimitiveMember(currentValuePrimitiveMember, quantizationRangeMinPrimitiveMember, quantizationRangeMaxPrimitiveMember, quantumPrimitiveMember);
+      s64 baselineSteps = QuantizePrimitiveMember(baselinePrimitiveMember, quantizationRangeMinPrimitiveMember, quantizationRangeMaxPrimitiveMember, quantumPrimitiveMember);
+      deltas[i] = ZigZagEncode(u64(currentSteps - baselineSteps));
+
+      // Store the value exactly as the remote peer will decode it
+      currentValuePrimitiveMember = DequantizePrimitiveMember(currentSteps, quantizationRangeMinPrimitiveMember, quantizationRangeMaxPrimitiveMember, quantumPrimitiveMember);
+    }
+    // Should not quantize?
+    else
+    {
+      // Use half floats?
+      if (useHalfFloats)
+      {
+        // Round primitive member to half float precision
+        currentValuePrimitiveMember = (PrimitiveType)HalfFloatConverter::ToFloat(HalfFloatConverter::ToHalfFloat((float)currentValuePrimitiveMember));
+      }
+
+      // Encode difference
+      deltas[i] = EncodePrimitiveMemberDelta(currentValuePrimitiveMember, baselinePrimitiveMember);
+    }
+
+    hasChanged |= (deltas[i] != 0);
+  }
+
+  // Write 'Has Changed?' Flag
+  bitStream.Write(hasChanged);
+  if (hasChanged) // Has changed?
+  {
+    // For each primitive member
+    for (size_t i = 0; i < PrimitiveCount; ++i)
+    {
+      // Write 'Has Changed?' Flag
+      bitStream.Write(deltas[i] != 0);
+      if (deltas[i] != 0) // Has changed?
+      {
+        // Write difference
+        WriteVariableLength(bitStream, deltas[i]);
+      }
+    }
+  }
+
+  // Success
+  sentValue = RaverieMove(currentValue);
+  return true;
+}
+
+/// (Arithmetic property type behavior)
+template <typename PropertyType, TF_ENABLE_IF(IsBasicNativeTypeArithmetic<PropertyType>::Value)>
+bool DeserializeDeltaArithmetic(BitStream& bitStream, const ReplicaProperty* replicaProperty, const ReplicaPropertyType* replicaPropertyType, const Variant& baselineValue, Variant& receivedValue)
+{
+  // Primitive member info
+  typedef typename BasicNativeTypePrimitiveMembers<PropertyType>::Type PrimitiveType;
+  static const size_t PrimitiveCount = BasicNativeTypePrimitiveMembers<PropertyType>::Count;
+
+  // Start from the baseline value (else the current value as a typed
+  // container)
+  bool hasBaseline = baselineValue.IsNotEmpty();
+  Variant newValue = hasBaseline ? baselineValue : replicaProperty->GetValue();
+  Assert(newValue.IsNotEmpty());
+
+  // Get quantization settings
+  bool useQuantization = replicaPropertyType->GetUseQuantization();
+  const Variant& quantizationRangeMin = replicaPropertyType->GetQuantizationRangeMin();
+  const Variant& quantizationRangeMax = replicaPropertyType->GetQuantizationRangeMax();
+  const Variant& quantum = replicaPropertyType->GetDeltaThreshold();
+
+  // Should we quantize?
+  // (Quantization is enabled and our quantization parameters are valid?)
+  bool shouldQuantize = (useQuantization && quantizationRangeMin.IsNotEmpty() && quantizationRangeMax.IsNotEmpty() && quantum.IsNotEmpty());
+
+  // Read 'Has Changed?' Flag
+  bool hasChanged;
+  if (!bitStream.Read(hasChanged)) // Unable?
+    return false;
+
+  // For each primitive member
+  for (size_t i = 0; i < PrimitiveCount; ++i)
+  {
+    // Get primitive members
+    PrimitiveType& newValuePrimitiveMember = newValue.GetPrimitiveMemberOrError<PropertyType>(i);
+    PrimitiveType baselinePrimitiveMember = hasBaseline ? newValuePrimitiveMember : PrimitiveType(0);
+
+    // Read 'Has Changed?' Flag and difference
+    u64 delta = 0;
+    if (hasChanged) // Has changed?
+    {
+      bool hasMemberChanged;
+      if (!bitStream.Read(hasMemberChanged)) // Unable?
+        return false;
+      if (hasMemberChanged && !ReadVariableLength(bitStream, delta)) // Unable?
+        return false;
+    }
+
+    // Should quantize?
+    if (shouldQuantize)
+    {
+      // Get quantization primitive members
+      const PrimitiveType& quantizationRangeMinPrimitiveMember = quantizationRangeMin.GetPrimitiveMemberOrError<PropertyType>(i);
+      const PrimitiveType& quantizationRangeMaxPrimitiveMember = quantizationRangeMax.GetPrimitiveMemberOrError<PropertyType>(i);
+      const PrimitiveType& quantumPrimitiveMember = quantum.GetPrimitiveMemberOrError<PropertyType>(i);
+
+      // Decode difference in quantum steps
+      s64 baselineSteps = QuantizePrimitiveMember(baselinePrimitiveMember, quantizationRangeMinPrimitiveMember, quantizationRangeMaxPrimitiveMember, quantumPrimitiveMember);
+      s64 newSteps = baselineSteps + s64(ZigZagDecode(delta));
+      newValuePrimitiveMember = DequantizePrimitiveMember(newSteps, quantizationRangeMinPrimitiveMember, quantizationRangeMaxPrimitiveMember, quantumPrimitiveMember);
+    }
+    // Should not quantize?
+    else
+    {
+      // Decode difference
+      newValuePrimitiveMember = DecodePrimitiveMemberDelta(baselinePrimitiveMember, delta);
+    }
+  }
+
+  // Success
+  receivedValue = RaverieMove(newValue);
+  return true;
+}
+
+bool ReplicaProperty::SerializeDelta(BitStream& bitStream, const Variant& baselineValue, Variant& sentValue) const
+{
+  // Get replica property type
+  ReplicaPropertyType* replicaPropertyType = GetReplicaPropertyType();
+
+  // Switch on property's native type
+  switch (replicaPropertyType->GetNativeTypeId())
+  {
+  // Other Types
+  default:
+  {
+    // Get current property value
+    Variant currentValue = GetValue();
+
+    // Write 'Has Changed?' Flag
+    bool hasChanged = (baselineValue.IsEmpty() || currentValue != baselineValue);
+    bitStream.Write(hasChanged);
+    if (hasChanged) // Has changed?
+    {
+      // Get standard serialization function
+      SerializeValueFn serializeValueFn = replicaPropertyType->GetSerializeValueFn();
+
+      // Perform standard serialization
+      if (!serializeValueFn(SerializeDirection::Write, bitStream, currentValue)) // Unable?
+        return false;
+    }
+
+    // Success
+    sentValue = RaverieMove(currentValue);
+    return true;
+  }
+
+    // Non-Boolean Arithmetic Types
+    SWITCH_CASES_NON_BOOL_ARITHMETIC_CALL_AND_RETURN(SerializeDeltaArithmetic, bitStream, this, replicaPropertyType, baselineValue, sentValue);
+  }
+}
+bool ReplicaProperty::DeserializeDelta(const BitStream& bitStream, const Variant& baselineValue, Variant& receivedValue) const
+{
+  // Get replica property type
+  ReplicaPropertyType* replicaPropertyType = GetReplicaPropertyType();
+
+  // Switch on property's native type
+  switch (replicaPropertyType->GetNativeTypeId())
+  {
+  // Other Types
+  default:
+  {
+    // Read 'Has Changed?' Flag
+    bool hasChanged;
+    if (!bitStream.Read(hasChanged)) // Unable?
+      return false;
+
+    // Unchanged?
+    if (!hasChanged)
+    {
+      // (Only the first state is sent without a baseline, and it is always
+      // written in full)
+      if (baselineValue.IsEmpty())
+        return false;
+
+      receivedValue = baselineValue;
+      return true;
+    }
+
+    // Get standard serialization function
+    SerializeValueFn serializeValueFn = replicaPropertyType->GetSerializeValueFn();
+
+    // Perform standard serialization
+    Variant newValue = GetValue();
+    if (!serializeValueFn(SerializeDirection::Read, const_cast<BitStream&>(bitStream), newValue)) // Unable?
+      return false;
+
+    // Success
+    receivedValue = RaverieMove(newValue);
+    return true;
+  }
+
+    // Non-Boolean Arithmetic Types
+    SWITCH_CASES_NON_BOOL_ARITHMETIC_CALL_AND_RETURN(DeserializeDeltaArithmetic, const_cast<BitStream&>(bitStream), this, replicaPropertyType, baselineValue, receivedValue);
+  }
+}
+
+void ReplicaProperty::ReceiveValue(const Variant& newValue, ReplicationPhase::Enum replicationPhase, TimeMs timestamp)
+{
+  // Get replica property type
+  ReplicaPropertyType* replicaPropertyType = GetReplicaPropertyType();
+
+  // Not arithmetic?
+  // (Only arithmetic types support interpolation and convergence)
+  if (!replicaPropertyType->GetNativeType()->mIsBasicNativeTypeArithmetic)
+  {
+    // Set current property value
+    SetValue(newValue);
+    return;
+  }
+
+  // Get frame ID
+  uint64 frameId = replicaPropertyType->GetReplicator()->GetPeer()->GetLocalFrameId();
+
   // Use convergence?
   if (replicaPropertyType->GetUseConvergence())
   {
@@ -1706,9 +2096,60 @@ bool ReplicaProperty::Deserialize(const BitStream& bitStream, ReplicationPhase::
       SnapNow();
     }
   }
+}
 
-  // Success
-  return true;
+/// (Arithmetic property type behavior)
+template <typename PropertyType, TF_ENABLE_IF(IsBasicNativeTypeArithmetic<PropertyType>::Value)>
+bool HasExceededDeltaThresholdArithmetic(const byte* currentValue, const byte* lastValue, const ReplicaPropertyType* replicaPropertyType)
+{
+  // Primitive member info
+  typedef typename BasicNativeTypePrimitiveMembers<PropertyType>::Type PrimitiveType;
+  static const size_t PrimitiveCount = BasicNativeTypePrimitiveMembers<PropertyType>::Count;
+
+  // Get raw primitive members
+  const PrimitiveType* currentValuePrimitiveMembers = reinterpret_cast<const PrimitiveType*>(currentValue);
+  const PrimitiveType* lastValuePrimitiveMembers = reinterpret_cast<const PrimitiveType*>(lastValue);
+
+  // Get delta threshold value for comparison
+  const Variant& deltaThreshold = replicaPropertyType->GetDeltaThreshold();
+
+  // (Delta threshold value should be non-empty)
+  Assert(deltaThreshold.IsNotEmpty());
+
+  // For each primitive member
+  for (size_t i = 0; i < PrimitiveCount; ++i)
+  {
+    // Current value and last value primitive members differ by more than the
+    // delta threshold value primitive member?
+    if (Math::Abs(currentValuePrimitiveMembers[i] - lastValuePrimitiveMembers[i]) > deltaThreshold.GetPrimitiveMemberOrError<PropertyType>(i))
+    {
+      // Has changed
+      return true;
+    }
+  }
+
+  // Has not changed
+  return false;
+}
+
+bool ReplicaProperty::HasExceededDeltaThreshold(const byte* currentValue, const byte* lastValue) const
+{
+  // Get replica property type
+  ReplicaPropertyType* replicaPropertyType = GetReplicaPropertyType();
+
+  // Switch on property's native type
+  switch (replicaPropertyType->GetNativeTypeId())
+  {
+  // Other Types
+  default:
+  {
+    // Perform raw inequality comparison
+    return memcmp(currentValue, lastValue, replicaPropertyType->GetNativeType()->mTypeSize) != 0;
+  }
+
+    // Non-Boolean Arithmetic Types
+    SWITCH_CASES_NON_BOOL_ARITHMETIC_CALL_AND_RETURN(HasExceededDeltaThresholdArithmetic, currentValue, lastValue, replicaPropertyType);
+  }
 }
 
 //                             ReplicaPropertyIndex //
@@ -1820,7 +2261,7 @@ void ReplicaPropertyIndex::Remove(ReplicaProperty* property)
 //                             ReplicaPropertyType //
 
 ReplicaPropertyType::ReplicaPropertyType(const String& name, NativeType* nativeType, SerializeValueFn serializeValueFn, GetValueFn getValueFn, SetValueFn setValueFn) :
-    mName(name), mNativeType(nativeType), mSerializeValueFn(serializeValueFn), mGetValueFn(getValueFn), mSetValueFn(setValueFn), mReplicator(nullptr)
+    mName(name), mNativeType(nativeType), mSerializeValueFn(serializeValueFn), mGetValueFn(getValueFn), mSetValueFn(setValueFn), mGetRawValueFn(nullptr), mReplicator(nullptr)
 {
   ResetConfig();
 }
@@ -1885,6 +2326,15 @@ SetValueFn ReplicaPropertyType::GetSetValueFn() const
   return mSetValueFn;
 }
 
+void ReplicaPropertyType::SetGetRawValueFn(GetRawValueFn getRawValueFn)
+{
+  mGetRawValueFn = getRawValueFn;
+}
+GetRawValueFn ReplicaPropertyType::GetGetRawValueFn() const
+{
+  return mGetRawValueFn;
+}
+
 bool ReplicaPropertyType::IsValid() const
 {
   return (GetReplicator() != nullptr);
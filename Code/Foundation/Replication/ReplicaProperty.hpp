@@ -149,6 +149,25 @@ public:
   /// Returns true if successful, else false
   bool Deserialize(const BitStream& bitStream, ReplicationPhase::Enum replicationPhase, TimeMs timestamp);
 
+  /// Serializes the current property value as a delta against the baseline
+  /// value (a value the remote peer is known to hold, else empty to encode
+  /// against zero) Sets sent value to the value the remote peer will decode
+  /// Returns true if successful, else false
+  bool SerializeDelta(BitStream& bitStream, const Variant& baselineValue, Variant& sentValue) const;
+  /// Deserializes a property value delta encoded against the baseline value
+  /// (else empty to decode against zero) Does not set the current property
+  /// value Returns true if successful, else false
+  bool DeserializeDelta(const BitStream& bitStream, const Variant& baselineValue, Variant& receivedValue) const;
+
+  /// Handles a received property value as configured (interpolation,
+  /// convergence, etc.)
+  void ReceiveValue(const Variant& newValue, ReplicationPhase::Enum replicationPhase, TimeMs timestamp);
+
+  /// Returns true if the raw current property value differs from the raw last
+  /// property value by more than the configured delta threshold, else false
+  /// (Both values must be of the property type's basic arithmetic native type)
+  bool HasExceededDeltaThreshold(const byte* currentValue, const byte* lastValue) const;
+
   /// Data
   String mName;                              /// Replica property name
   ReplicaPropertyType* mReplicaPropertyType; /// Operating replica property type
@@ -168,6 +187,9 @@ public:
                                              /// baked out (for each primitive member)
   ConvergenceState::Enum mConvergenceState;  /// Convergence method currently being applied to this
                                              /// replica property
+  size_t mSnapshotOffset;                    /// Raw value offset in the replica channel's snapshot
+                                             /// (else cInvalidSnapshotOffset)
+  bool mHasLastSnapshot;                     /// Last value is held in the replica channel's snapshot?
 };
 
 /// Typedefs
@@ -263,6 +285,14 @@ public:
   /// Property value setter function
   SetValueFn GetSetValueFn() const;
 
+  /// Property raw value getter function (else nullptr)
+  /// When set on a basic arithmetic native type, replica channels observe
+  /// properties of this type for changes by comparing raw values copied into a
+  /// contiguous snapshot instead of constructing variants (Must be set before
+  /// replica properties of this type are observed)
+  void SetGetRawValueFn(GetRawValueFn getRawValueFn = nullptr);
+  GetRawValueFn GetGetRawValueFn() const;
+
   /// Returns true if the replica property type is valid (registered with the
   /// replicator), else false
   bool IsValid() const;
@@ -436,6 +466,7 @@ public:
   SerializeValueFn mSerializeValueFn;         /// Property value serializer function
   GetValueFn mGetValueFn;                     /// Property value getter function
   SetValueFn mSetValueFn;                     /// Property value setter function
+  GetRawValueFn mGetRawValueFn;               /// Property raw value getter function
   Replicator* mReplicator;                    /// Operating replicator
   ReplicaPropertyIndex mActivePropertyIndex;  /// Active replica properties index
   ReplicaPropertyIndex mRestingPropertyIndex; /// Resting replica properties index
@@ -0,0 +1,527 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Raverie
+{
+
+class ReplicationBenchmarkReplicator;
+
+//                          ReplicationBenchmarkReplica //
+
+/// A synthetic replica that moves every frame and is stamped with the
+/// benchmark time of its latest change
+class ReplicationBenchmarkReplica : public Replica
+{
+public:
+  ReplicationBenchmarkReplica(ReplicationBenchmarkReplicator* replicator, const CreateContext& createContext, const ReplicaType& replicaType) :
+      Replica(createContext, replicaType),
+      mReplicator(replicator),
+      mPosition(Vec3::cZero),
+      mStamp(0)
+  {
+  }
+
+  /// Data
+  ReplicationBenchmarkReplicator* mReplicator; /// Operating replicator
+  Vec3 mPosition;                              /// Replicated position
+  int mStamp;                                  /// Replicated benchmark time of the latest change
+};
+
+//                        ReplicationBenchmarkReplicator //
+
+/// Replicates benchmark replicas and records how long their changes took to
+/// arrive (on clients)
+class ReplicationBenchmarkReplicator : public Replicator
+{
+public:
+  ReplicationBenchmarkReplicator(Role::Enum role, Timer* clock);
+  ~ReplicationBenchmarkReplicator();
+
+  /// Creates a benchmark replica owned by this replicator
+  ReplicationBenchmarkReplica* CreateReplica();
+
+  /// Records the arrival of a change stamped with the specified benchmark time
+  void RecordChange(int stamp);
+
+  //
+  // Replicator Interface
+  //
+
+  bool SerializeReplicas(const ReplicaArray& replicas, ReplicaStream& replicaStream) override;
+  bool DeserializeReplicas(const ReplicaStream& replicaStream, ReplicaArray& replicas) override;
+  bool ReleaseReplicas(const ReplicaArray& replicas) override;
+
+  /// Data
+  Timer* mClock;                                      /// Benchmark clock
+  ReplicaChannelType* mChannelType;                   /// Benchmark replica channel type
+  ReplicaPropertyType* mPositionType;                 /// Position replica property type
+  ReplicaPropertyType* mStampType;                    /// Stamp replica property type
+  Array<ReplicationBenchmarkReplica*> mOwnedReplicas; /// Replicas created by this replicator
+  uint64 mChangeCount;                                /// Number of changes received
+  TimeMs mTotalLatency;                               /// Sum of every received change's latency
+  TimeMs mMaxLatency;                                 /// Largest received change latency
+};
+
+namespace ReplicationBenchmarkSession
+{
+
+const cstr cCreateContext = "ReplicationBenchmark";
+const cstr cReplicaType = "ReplicationBenchmarkReplica";
+
+// Wait between updates while establishing and tearing down the session
+const uint cPollInterval = 1;
+
+Variant GetPosition(const Variant& propertyData)
+{
+  return Variant(propertyData.GetOrError<ReplicationBenchmarkReplica*>()->mPosition);
+}
+void SetPosition(const Variant& value, Variant& propertyData)
+{
+  propertyData.GetOrError<ReplicationBenchmarkReplica*>()->mPosition = value.GetOrError<Vec3>();
+}
+
+Variant GetStamp(const Variant& propertyData)
+{
+  return Variant(propertyData.GetOrError<ReplicationBenchmarkReplica*>()->mStamp);
+}
+void SetStamp(const Variant& value, Variant& propertyData)
+{
+  ReplicationBenchmarkReplica* replica = propertyData.GetOrError<ReplicationBenchmarkReplica*>();
+  replica->mStamp = value.GetOrError<int>();
+  replica->mReplicator->RecordChange(replica->mStamp);
+}
+
+// Custom packets and messages are not used by the benchmark
+void ProcessReceivedCustomPacket(Peer* peer, InPacket& packet)
+{
+}
+bool ProcessReceivedCustomMessage(PeerLink* link, Message& message)
+{
+  return false;
+}
+
+// Updates every peer once, returning the time the server update took in seconds
+double UpdatePeers(Peer& server, Array<Peer*>& clients, Timer& tickTimer, double& clientSeconds)
+{
+  tickTimer.Reset();
+  server.Update();
+  double serverSeconds = tickTimer.UpdateAndGetTime();
+
+  tickTimer.Reset();
+  forRange (Peer* client, clients.All())
+    client->Update();
+  clientSeconds = tickTimer.UpdateAndGetTime();
+
+  return serverSeconds;
+}
+
+// Waits until the clock reaches the specified time
+// (Keeps checking the clock, since sleeping does nothing on some platforms)
+void WaitForTime(Timer& clock, TimeMs time)
+{
+  for (TimeMs now = clock.UpdateAndGetTimeMilliseconds(); now < time; now = clock.UpdateAndGetTimeMilliseconds())
+    Os::Sleep(uint(time - now));
+}
+
+} // namespace ReplicationBenchmarkSession
+
+ReplicationBenchmarkReplicator::ReplicationBenchmarkReplicator(Role::Enum role, Timer* clock) :
+    Replicator(role),
+    mClock(clock),
+    mChannelType(nullptr),
+    mPositionType(nullptr),
+    mStampType(nullptr),
+    mOwnedReplicas(),
+    mChangeCount(0),
+    mTotalLatency(0),
+    mMaxLatency(0)
+{
+  using namespace ReplicationBenchmarkSession;
+
+  // Changes are found by comparing property values every update
+  ReplicaChannelTypePtr channelType(new ReplicaChannelType("Motion"));
+  channelType->SetDetectionMode(DetectionMode::Automatic);
+  mChannelType = AddReplicaChannelType(RaverieMove(channelType));
+
+  ReplicaPropertyTypePtr positionType(new ReplicaPropertyType("Position", NativeTypeOf(Vec3), SerializeKnownBasicVariant, GetPosition, SetPosition));
+  mPositionType = AddReplicaPropertyType(RaverieMove(positionType));
+
+  ReplicaPropertyTypePtr stampType(new ReplicaPropertyType("Stamp", NativeTypeOf(int), SerializeKnownBasicVariant, GetStamp, SetStamp));
+  mStampType = AddReplicaPropertyType(RaverieMove(stampType));
+}
+
+ReplicationBenchmarkReplicator::~ReplicationBenchmarkReplicator()
+{
+  forRange (ReplicationBenchmarkReplica* replica, mOwnedReplicas.All())
+    delete replica;
+}
+
+ReplicationBenchmarkReplica* ReplicationBenchmarkReplicator::CreateReplica()
+{
+  using namespace ReplicationBenchmarkSession;
+
+  ReplicationBenchmarkReplica* replica = new ReplicationBenchmarkReplica(this, CreateContext(String(cCreateContext)), ReplicaType(String(cReplicaType)));
+
+  ReplicaChannel* channel = replica->AddReplicaChannel(ReplicaChannelPtr(new ReplicaChannel("Motion", mChannelType)));
+  channel->AddReplicaProperty(ReplicaPropertyPtr(new ReplicaProperty("Position", mPositionType, Variant(replica))));
+  channel->AddReplicaProperty(ReplicaPropertyPtr(new ReplicaProperty("Stamp", mStampType, Variant(replica))));
+
+  mOwnedReplicas.PushBack(replica);
+  return replica;
+}
+
+void ReplicationBenchmarkReplicator::RecordChange(int stamp)
+{
+  TimeMs latency = std::max(mClock->UpdateAndGetTimeMilliseconds() - TimeMs(stamp), TimeMs(0));
+
+  ++mChangeCount;
+  mTotalLatency += latency;
+  mMaxLatency = std::max(mMaxLatency, latency);
+}
+
+//
+// Replicator Interface
+//
+
+bool ReplicationBenchmarkReplicator::SerializeReplicas(const ReplicaArray& replicas, ReplicaStream& replicaStream)
+{
+  // Is a spawn replica stream?
+  // (Every benchmark replica shares the same creation info)
+  if (replicaStream.GetReplicaStreamMode() == ReplicaStreamMode::Spawn)
+  {
+    if (!replicaStream.WriteCreationInfo(CreateContext(String(ReplicationBenchmarkSession::cCreateContext)), ReplicaType(String(ReplicationBenchmarkSession::cReplicaType)))) // Unable?
+    {
+      Assert(false);
+      return false;
+    }
+  }
+
+  // For All replicas
+  forRange (Replica* replica, replicas.All())
+  {
+    // Write identification info
+    if (!replicaStream.WriteIdentificationInfo(replica == nullptr, replica)) // Unable?
+    {
+      Assert(false);
+      return false;
+    }
+
+    // Present replica?
+    if (replica)
+    {
+      // Write channel data
+      if (!replicaStream.WriteChannelData(replica)) // Unable?
+      {
+        Assert(false);
+        return false;
+      }
+    }
+  }
+
+  // Success
+  return true;
+}
+bool ReplicationBenchmarkReplicator::DeserializeReplicas(const ReplicaStream& replicaStream, ReplicaArray& replicas)
+{
+  // Is a spawn replica stream?
+  bool isSpawn = (replicaStream.GetReplicaStreamMode() == ReplicaStreamMode::Spawn);
+  if (isSpawn)
+  {
+    // Read creation info
+    CreateContext createContext;
+    ReplicaType replicaType;
+    if (!replicaStream.ReadCreationInfo(createContext, replicaType)) // Unable?
+    {
+      Assert(false);
+      return false;
+    }
+  }
+
+  // Gather All replicas
+  while (replicaStream.GetBitStream().GetBitsUnread())
+  {
+    Replica* replica = nullptr;
+
+    // Is a spawn replica stream?
+    if (isSpawn)
+    {
+      // Create replica and read identification info into it
+      ReplicationBenchmarkReplica* createdReplica = CreateReplica();
+      bool isAbsent = false;
+      if (!replicaStream.ReadIdentificationInfo(isAbsent, createdReplica)) // Unable?
+      {
+        Assert(false);
+        return false;
+      }
+
+      // Absent replica?
+      if (isAbsent)
+      {
+        mOwnedReplicas.PopBack();
+        delete createdReplica;
+        replicas.PushBack(nullptr);
+        continue;
+      }
+
+      replica = createdReplica;
+    }
+    // Is another type of replica stream?
+    else
+    {
+      // Read identification info
+      bool isAbsent = false;
+      ReplicaId replicaId = 0;
+      bool isCloned = false;
+      bool isEmplaced = false;
+      EmplaceContext emplaceContext;
+      EmplaceId emplaceId = 0;
+      if (!replicaStream.ReadIdentificationInfo(isAbsent, replicaId, isCloned, isEmplaced, emplaceContext, emplaceId)) // Unable?
+      {
+        Assert(false);
+        return false;
+      }
+
+      // Absent replica?
+      if (isAbsent)
+      {
+        replicas.PushBack(nullptr);
+        continue;
+      }
+
+      // Find replica
+      replica = GetReplica(replicaId);
+      if (!replica) // Unable?
+      {
+        Assert(false);
+        return false;
+      }
+    }
+
+    // Read channel data
+    if (!replicaStream.ReadChannelData(replica)) // Unable?
+    {
+      Assert(false);
+      return false;
+    }
+
+    // Add replica
+    replicas.PushBack(replica);
+  }
+
+  // Success
+  return true;
+}
+bool ReplicationBenchmarkReplicator::ReleaseReplicas(const ReplicaArray& replicas)
+{
+  // For All replicas
+  forRange (Replica* replica, replicas.All())
+  {
+    // Absent or still valid replica?
+    if (!replica || replica->IsValid())
+      continue; // Skip
+
+    // Delete the replica if we created it
+    for (size_t i = 0; i < mOwnedReplicas.Size(); ++i)
+    {
+      if (mOwnedReplicas[i] == replica)
+      {
+        delete mOwnedReplicas[i];
+        mOwnedReplicas.EraseAt(i);
+        break;
+      }
+    }
+  }
+
+  // Success
+  return true;
+}
+
+//                          ReplicationBenchmarkSettings //
+
+ReplicationBenchmarkSettings::ReplicationBenchmarkSettings() :
+    mClientCount(4),
+    mReplicaCount(256),
+    mFrameCount(600),
+    mFrameInterval(16),
+    mConnectTimeout(5000),
+    mConditions()
+{
+}
+
+//                             ReplicationBenchmark //
+
+String ReplicationBenchmark::Run(const ReplicationBenchmarkSettings& settings)
+{
+  using namespace ReplicationBenchmarkSession;
+
+  ReturnIf(settings.mClientCount == 0, String(), "Cannot run a replication benchmark without clients.");
+
+  Timer clock;
+  Timer tickTimer;
+  clock.Reset();
+
+  //
+  // Open Peers
+  //
+
+  // Open the server on any available port of the in-process loopback transport
+  // (The replicator is declared first so it outlives the server)
+  ReplicationBenchmarkReplicator serverReplicator(Role::Server, &clock);
+  Peer server(ProcessReceivedCustomPacket, ProcessReceivedCustomMessage);
+  server.AddPlugin(&serverReplicator, "Replicator");
+
+  Status status;
+  server.OpenLoopback(status);
+  ReturnIf(status.Failed(), String(), "Unable to open the replication benchmark server: %s", status.Message.c_str());
+  IpAddress serverAddress = server.GetLocalIpv4Address();
+
+  // Open every client, each behind its own conditioned link
+  Array<Peer*> clients;
+  Array<ReplicationBenchmarkReplicator*> clientReplicators;
+  Array<LinkConditioner*> conditioners;
+  for (uint i = 0; i < settings.mClientCount; ++i)
+  {
+    Peer* client = new Peer(ProcessReceivedCustomPacket, ProcessReceivedCustomMessage);
+    ReplicationBenchmarkReplicator* clientReplicator = new ReplicationBenchmarkReplicator(Role::Client, &clock);
+    LinkConditioner* conditioner = new LinkConditioner(i);
+    conditioner->SetOutgoingConditions(settings.mConditions);
+    conditioner->SetIncomingConditions(settings.mConditions);
+
+    client->AddPlugin(clientReplicator, "Replicator");
+    client->AddPlugin(conditioner, "LinkConditioner");
+    client->OpenLoopback(status);
+    if (status.Succeeded())
+      client->CreateLink(serverAddress)->Connect();
+
+    clients.PushBack(client);
+    clientReplicators.PushBack(clientReplicator);
+    conditioners.PushBack(conditioner);
+  }
+
+  //
+  // Connect and Spawn
+  //
+
+  // Wait for every client to connect
+  double clientSeconds = 0;
+  TimeMs connectStart = clock.UpdateAndGetTimeMilliseconds();
+  while (server.GetLinkCount(LinkStatus::Connected) < settings.mClientCount && clock.UpdateAndGetTimeMilliseconds() - connectStart < settings.mConnectTimeout)
+  {
+    TimeMs pollStart = clock.UpdateAndGetTimeMilliseconds();
+    UpdatePeers(server, clients, tickTimer, clientSeconds);
+    WaitForTime(clock, pollStart + cPollInterval);
+  }
+  bool connected = (server.GetLinkCount(LinkStatus::Connected) == settings.mClientCount);
+
+  // Spawn every replica to every client
+  ReplicaArray replicas;
+  if (connected)
+  {
+    for (uint i = 0; i < settings.mReplicaCount; ++i)
+      replicas.PushBack(serverReplicator.CreateReplica());
+    connected = serverReplicator.SpawnReplicas(replicas);
+  }
+
+  //
+  // Run Frames
+  //
+
+  double totalServerSeconds = 0;
+  double maxServerSeconds = 0;
+  double totalClientSeconds = 0;
+  uint frameCount = connected ? settings.mFrameCount : 0;
+  for (uint frame = 0; frame < frameCount; ++frame)
+  {
+    TimeMs frameStart = clock.UpdateAndGetTimeMilliseconds();
+
+    // Move every replica along its own circle, stamping the change
+    float angle = float(frame) * 0.05f;
+    for (uint i = 0; i < replicas.Size(); ++i)
+    {
+      ReplicationBenchmarkReplica* replica = static_cast<ReplicationBenchmarkReplica*>(replicas[i]);
+      replica->mPosition = Vec3(Math::Cos(angle + i), float(i), Math::Sin(angle + i));
+      replica->mStamp = int(frameStart);
+    }
+
+    // Replicate the changes
+    double serverSeconds = UpdatePeers(server, clients, tickTimer, clientSeconds);
+    totalServerSeconds += serverSeconds;
+    maxServerSeconds = std::max(maxServerSeconds, serverSeconds);
+    totalClientSeconds += clientSeconds;
+
+    // Wait out the rest of the frame
+    WaitForTime(clock, frameStart + settings.mFrameInterval);
+  }
+
+  //
+  // Report Results
+  //
+
+  JsonBuilder builder;
+  if (connected)
+  {
+    builder.Begin(JsonType::Object);
+    builder.Key("clients");
+    builder.Value(settings.mClientCount);
+    builder.Key("replicas");
+    builder.Value(settings.mReplicaCount);
+    builder.Key("frames");
+    builder.Value(frameCount);
+    builder.Key("frameIntervalMs");
+    builder.Value((long long)settings.mFrameInterval);
+
+    // CPU time per tick in milliseconds
+    builder.Key("serverTickMs");
+    builder.Value(frameCount ? totalServerSeconds * 1000.0 / frameCount : 0.0);
+    builder.Key("serverTickMaxMs");
+    builder.Value(maxServerSeconds * 1000.0);
+    builder.Key("clientTickMs");
+    builder.Value(frameCount ? totalClientSeconds * 1000.0 / (double(frameCount) * settings.mClientCount) : 0.0);
+
+    // Per client traffic and convergence latency
+    builder.Key("perClient");
+    builder.Begin(JsonType::ArrayMultiLine);
+    for (uint i = 0; i < settings.mClientCount; ++i)
+    {
+      ReplicationBenchmarkReplicator* clientReplicator = clientReplicators[i];
+      LinkConditioner* conditioner = conditioners[i];
+
+      builder.Begin(JsonType::Object);
+      builder.Key("sentBytes");
+      builder.Value((unsigned long long)conditioner->GetSentBytes());
+      builder.Key("receivedBytes");
+      builder.Value((unsigned long long)conditioner->GetReceivedBytes());
+      builder.Key("droppedPackets");
+      builder.Value((unsigned long long)conditioner->GetDroppedPacketCount());
+      builder.Key("changes");
+      builder.Value((unsigned long long)clientReplicator->mChangeCount);
+      builder.Key("latencyMs");
+      builder.Value(clientReplicator->mChangeCount ? double(clientReplicator->mTotalLatency) / clientReplicator->mChangeCount : 0.0);
+      builder.Key("latencyMaxMs");
+      builder.Value((long long)clientReplicator->mMaxLatency);
+      builder.End();
+    }
+    builder.End();
+
+    builder.End();
+  }
+
+  //
+  // Close Peers
+  //
+
+  // (Closing removes and deletes the link conditioners, replicators are owned here)
+  forRange (Peer* client, clients.All())
+  {
+    client->Close();
+    delete client;
+  }
+  forRange (ReplicationBenchmarkReplicator* clientReplicator, clientReplicators.All())
+    delete clientReplicator;
+  server.Close();
+
+  ReturnIf(!connected, String(), "Unable to connect every replication benchmark client to the server.");
+  return builder.ToString();
+}
+
+} // namespace Raverie
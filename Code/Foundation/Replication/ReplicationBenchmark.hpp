@@ -0,0 +1,41 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Raverie
+{
+
+//                          ReplicationBenchmarkSettings //
+
+/// Replication Benchmark Settings
+/// Describes the loopback session a replication benchmark runs
+struct ReplicationBenchmarkSettings
+{
+  /// Constructor
+  ReplicationBenchmarkSettings();
+
+  /// Data
+  uint mClientCount;          /// Number of client peers connected to the server
+  uint mReplicaCount;         /// Number of replicas spawned and moved by the server
+  uint mFrameCount;           /// Number of frames to run once every replica is spawned
+  TimeMs mFrameInterval;      /// Time between frames
+  TimeMs mConnectTimeout;     /// Maximum time to wait for every client to connect
+  LinkConditions mConditions; /// Conditions applied to every client's link (in both directions)
+};
+
+//                             ReplicationBenchmark //
+
+/// Replication Benchmark
+/// Runs a server peer and several client peers over the in-process loopback
+/// transport (see Peer::OpenLoopback), replicating synthetic replicas that
+/// change every frame, so the cost of replication can be measured repeatably
+/// without a network. Every client's link is shaped by a LinkConditioner. Reports CPU time per tick, bytes per client and the time
+/// taken for changes to reach clients (convergence latency) as Json.
+class ReplicationBenchmark
+{
+public:
+  /// Runs the benchmark session described by the settings
+  /// Returns the results as a Json object, else an empty string if the session could not be established
+  static String Run(const ReplicationBenchmarkSettings& settings);
+};
+
+} // namespace Raverie
@@ -54,6 +54,7 @@ class InMessageChannel;
 #include "LinkOutbox.hpp"
 #include "PeerLink.hpp"
 #include "Peer.hpp"
+#include "LinkConditioner.hpp"
 
 // Replicator Forward Declarations
 namespace Raverie
@@ -79,3 +80,4 @@ class Route;
 #include "ReplicaStream.hpp"
 #include "ReplicatorLink.hpp"
 #include "Replicator.hpp"
+#include "ReplicationBenchmark.hpp"
@@ -1175,6 +1175,11 @@ bool Replicator::ShouldIncludeAccurateTimestampOnChange(ReplicaChannel* replicaC
   return replicaChannel->GetReplica()->GetAccurateTimestampOnChange() || replicaChannel->GetReplicaChannelType()->GetAccurateTimestampOnChange();
 }
 
+bool Replicator::ShouldUseBaselineDeltas(ReplicaChannel* replicaChannel)
+{
+  return replicaChannel->GetReplicaChannelType()->GetUseBaselineDeltas();
+}
+
 TimeMs Replicator::GetInitializationTimestamp(const ReplicaArray& replicas)
 {
 #ifdef RaverieDebug
@@ -1791,17 +1796,22 @@ bool Replicator::RouteChange(ReplicaChannel* replicaChannel, const Route& route,
   ReplicaId::value_type replicaId = replica->GetReplicaId().value();
   Assert(replica && replicaId);
 
+  // Delta encode against each link's acknowledged baseline?
+  bool useBaselineDeltas = ShouldUseBaselineDeltas(replicaChannel);
+
   // Route replica channel change
   PeerLinkSet links = GetLinks(route);
   if (!links.Empty()) // Links in route?
   {
     // Serialize replica channel change
+    // (Baseline deltas are serialized per link instead)
     Message message(ReplicatorMessageType::Change);
-    if (!SerializeChange(replicaChannel, message, timestamp)) // Unable?
+    if (!useBaselineDeltas && !SerializeChange(replicaChannel, message, timestamp)) // Unable?
       return false;
 
     // Should include an accurate timestamp with this message?
-    if (Replicator::ShouldIncludeAccurateTimestampOnChange(replicaChannel))
+    bool includeAccurateTimestamp = Replicator::ShouldIncludeAccurateTimestampOnChange(replicaChannel);
+    if (includeAccurateTimestamp)
     {
       // Set accurate timestamp
       message.SetTimestamp(timestamp);
@@ -1813,27 +1823,52 @@ bool Replicator::RouteChange(ReplicaChannel* replicaChannel, const Route& route,
       // Get replicator link
       ReplicatorLink* replicatorLink = link->GetPlugin<ReplicatorLink>("ReplicatorLink");
 
-      // Should skip change replication?
-      if (replicatorLink->ShouldSkipChangeReplication())
+      // Doesn't have replica remotely?
+      if (!replicatorLink->HasReplica(replica))
         continue; // Skip link
 
-      // Has replica remotely?
-      if (replicatorLink->HasReplica(replica))
-        replicatorLink->SendChange(replicaChannel,
-                                   message); // Send replica channel change
+      //    Replica not due every frame on this link?
+      // OR Should skip change replication?
+      // OR Link is out of outgoing bandwidth?
+      if (GetChangeInterval(replicatorLink, replica) != 1 || replicatorLink->ShouldSkipChangeReplication() || replicatorLink->ShouldScheduleChanges()
+          || replicatorLink->GetChangeBudget() == 0)
+      {
+        // Withhold change (it will be sent once the replica channel's
+        // accumulated priority comes due)
+        replicatorLink->AddStaleReplicaChannel(replicaChannel);
+        continue;
+      }
+
+      // Link missed earlier changes?
+      if (replicatorLink->IsStaleReplicaChannel(replicaChannel))
+      {
+        // Send withheld changes along with this one
+        replicatorLink->SendStaleChange(replicaChannel, timestamp);
+      }
+      // Delta encode against this link's acknowledged baseline?
+      else if (useBaselineDeltas)
+      {
+        // Send replica channel delta
+        replicatorLink->SendBaselineChange(replicaChannel, timestamp);
+      }
+      else
+      {
+        // Send replica channel change
+        replicatorLink->SendChange(replicaChannel, message);
+      }
     }
   }
 
   // Success
   return true;
 }
-bool Replicator::SerializeChange(ReplicaChannel* replicaChannel, Message& message, TimeMs timestamp)
+bool Replicator::SerializeChange(ReplicaChannel* replicaChannel, Message& message, TimeMs timestamp, const Array<bool>* changedProperties)
 {
   // Serialize replica channel change
   BitStream& bitStream = message.GetData();
 
   // Write replica channel
-  bool result = replicaChannel->Serialize(bitStream, ReplicationPhase::Change, timestamp);
+  bool result = replicaChannel->Serialize(bitStream, ReplicationPhase::Change, timestamp, changedProperties);
   if (!result) // Unable?
   {
     Assert(false);
@@ -1968,6 +2003,16 @@ void Replicator::OnUpdate()
     replicaPropertyType->ConvergeNow();
   }
 
+  // For all links
+  forRange (PeerLink* link, links.All())
+  {
+    // Get replicator link
+    ReplicatorLink* replicatorLink = link->GetPlugin<ReplicatorLink>("ReplicatorLink");
+
+    // Send withheld changes that have come due
+    replicatorLink->ReplicateStaleChanges(now);
+  }
+
   //
   // Update End
   //
@@ -317,6 +317,30 @@ public:
   {
   }
 
+  /// Called before an accepted incoming replica channel change is read into
+  /// the replica channel's properties
+  virtual void OnReplicaChannelChangeReceiving(TimeMs timestamp, Replica* replica, ReplicaChannel* replicaChannel)
+  {
+  }
+  /// Called after an incoming replica channel change has been read into the
+  /// replica channel's properties, if any of them changed (before reacting to
+  /// the property changes, so the properties still compare against their last
+  /// values)
+  virtual void OnReplicaChannelChangeReceived(TimeMs timestamp, Replica* replica, ReplicaChannel* replicaChannel)
+  {
+  }
+
+  /// Returns how often, in frames, changes to the replica should be sent over
+  /// the specified link (1 sends every change immediately, 0 withholds all
+  /// changes because the replica is not relevant to the link)
+  /// Withheld changes are not lost, every replica property changed while
+  /// withheld is sent once the replica channel's accumulated priority comes due
+  /// for the link (after about as many frames as the interval)
+  virtual uint GetChangeInterval(ReplicatorLink* link, Replica* replica)
+  {
+    return 1;
+  }
+
   //
   // Link Interface
   //
@@ -452,6 +476,10 @@ public:
   static bool ShouldIncludeAccurateTimestampOnUninitialization(const ReplicaArray& replicas);
   static bool ShouldIncludeAccurateTimestampOnChange(ReplicaChannel* replicaChannel);
 
+  /// Returns true if the replica channel's changes should be delta encoded
+  /// against acknowledged baselines, else false
+  static bool ShouldUseBaselineDeltas(ReplicaChannel* replicaChannel);
+
   /// Returns the first appropriate timestamp found in the replicas array, else
   /// cInvalidMessageTimestamp
   static TimeMs GetInitializationTimestamp(const ReplicaArray& replicas);
@@ -490,11 +518,15 @@ public:
   bool RouteDestroy(const ReplicaArray& replicas, const Route& route, TimeMs timestamp);
 
   /// Routes a replica channel change
+  /// Links the replica is not due on are marked stale instead (see
+  /// GetChangeInterval)
   /// Returns true if successful, else false
   bool RouteChange(ReplicaChannel* replicaChannel, const Route& route, TimeMs timestamp);
   /// Serializes a replica channel change
+  /// Changed properties, if specified, flags the replica properties to write
+  /// instead of those that have changed now (used for stale replica channels)
   /// Returns true if successful, else false
-  bool SerializeChange(ReplicaChannel* replicaChannel, Message& message, TimeMs timestamp);
+  bool SerializeChange(ReplicaChannel* replicaChannel, Message& message, TimeMs timestamp, const Array<bool>* changedProperties = nullptr);
 
   /// [Server] Routes an interrupt command
   /// Returns true if successful, else false
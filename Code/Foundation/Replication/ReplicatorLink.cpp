@@ -4,8 +4,45 @@
 namespace Raverie
 {
 
+//                           ReplicaChannelBaseline //
+
+ReplicaChannelBaseline::ReplicaChannelBaseline() : mNextSequence(0), mLatestSequence(0), mHasLatest(false)
+{
+  for (uint i = 0; i < BaselineHistorySize; ++i)
+    mIsRecorded[i] = false;
+}
+
+ReplicaChannelState* ReplicaChannelBaseline::FindState(BaselineSequence sequence)
+{
+  uint index = (sequence.value() & (BaselineHistorySize - 1));
+  if (!mIsRecorded[index] || mSequences[index] != sequence) // Not recorded?
+    return nullptr;
+
+  return &mStates[index];
+}
+
+void ReplicaChannelBaseline::RecordState(BaselineSequence sequence, MoveReference<ReplicaChannelState> state)
+{
+  uint index = (sequence.value() & (BaselineHistorySize - 1));
+  mStates[index] = RaverieMove(state);
+  mSequences[index] = sequence;
+  mIsRecorded[index] = true;
+}
+
+//                            StaleReplicaChannel //
+
+StaleReplicaChannel::StaleReplicaChannel() : mPriority(0), mChangedProperties()
+{
+}
+
 //                               ReplicatorLink //
 
+/// Sorts scheduled replica channels by accumulated priority, highest first
+inline bool ScheduledReplicaChannelSorter(const ScheduledReplicaChannel& lhs, const ScheduledReplicaChannel& rhs)
+{
+  return lhs.first > rhs.first;
+}
+
 ReplicatorLink::ReplicatorLink(Replicator* replicator) :
     LinkPlugin(ReplicatorMessageType::Size),
     mReplicator(replicator),
@@ -17,6 +54,13 @@ ReplicatorLink::ReplicatorLink(Replicator* replicator) :
     mOutReplicaChannels(),
     mInReplicaChannels(),
     mInReplicaChannelsFlipped(),
+    mStaleReplicaChannels(),
+    mScheduledChannels(),
+    mScheduleChanges(false),
+    mQueuedChangeBits(0),
+    mOutBaselines(),
+    mInBaselines(),
+    mBaselineAcks(),
     mLastConnectRequestData(),
     mLastConnectResponseData(),
     mShouldSkipChangeReplication(false),
@@ -25,6 +69,15 @@ ReplicatorLink::ReplicatorLink(Replicator* replicator) :
 {
 }
 
+ReplicatorLink::~ReplicatorLink()
+{
+  // Delete all baselines
+  forRange (OutReplicaChannelBaselines::value_type& entry, mOutBaselines.All())
+    delete entry.second;
+  forRange (InReplicaChannelBaselines::value_type& entry, mInBaselines.All())
+    delete entry.second;
+}
+
 //
 // Operations
 //
@@ -178,6 +231,20 @@ bool ReplicatorLink::ShouldSkipChangeReplication() const
   return mShouldSkipChangeReplication;
 }
 
+bool ReplicatorLink::ShouldScheduleChanges() const
+{
+  return mScheduleChanges;
+}
+Bits ReplicatorLink::GetChangeBudget() const
+{
+  // Get frame info
+  PeerLink* link = GetLink();
+  Bits frameCapacity = Bits(float(link->GetOutgoingFrameCapacity()) * GetReplicator()->GetFrameFillSkip());
+  Bits frameSize = link->GetOutgoingFrameSize() + mQueuedChangeBits;
+
+  return frameCapacity - Math::Min(frameCapacity, frameSize);
+}
+
 //
 // Internal
 //
@@ -227,6 +294,9 @@ void ReplicatorLink::UpdateStart(TimeMs now)
 }
 void ReplicatorLink::UpdateEnd(TimeMs now)
 {
+  // Acknowledge replica channel states recorded this update
+  SendBaselineAcks();
+
   // See if we should warn the user about their outgoing bandwidth utilization
   // this frame
   {
@@ -1163,6 +1233,26 @@ bool ReplicatorLink::DeserializeChange(const Message& message, TimeMs timestamp)
   ReplicaId::value_type replicaId = replica->GetReplicaId().value();
   ReturnIf(!replicaId, false, "The ReplicaId was not valid");
 
+  // Delta encoded against a previously received state?
+  // (Read and recorded before deciding whether to accept it, since later
+  // changes may be encoded against it either way)
+  bool useBaselineDeltas = Replicator::ShouldUseBaselineDeltas(replicaChannel);
+  const ReplicaChannelState* receivedState = nullptr;
+  const ReplicaChannelState* previousState = nullptr;
+  if (useBaselineDeltas)
+  {
+    // Read replica channel state
+    if (!ReceiveBaselineChange(message.GetChannelId(), replicaChannel, bitStream, receivedState, previousState)) // Unable?
+      return false;
+
+    // Baseline no longer held, or out of date?
+    if (!receivedState)
+    {
+      // Ignore
+      return true;
+    }
+  }
+
   // Don't accept incoming changes for this replica or replica channel type?
   if (!replica->GetAcceptIncomingChanges() || !replicaChannelType->GetAcceptIncomingChanges())
   {
@@ -1182,12 +1272,24 @@ bool ReplicatorLink::DeserializeChange(const Message& message, TimeMs timestamp)
     }
   }
 
-  // Read replica channel
-  bool result = replicaChannel->Deserialize(bitStream, ReplicationPhase::Change, timestamp);
-  if (!result) // Unable?
+  // Notify replicator before the change is read
+  GetReplicator()->OnReplicaChannelChangeReceiving(timestamp, replica, replicaChannel);
+
+  // Delta encoded?
+  if (useBaselineDeltas)
   {
-    // Assert(false);
-    return false;
+    // Handle received replica channel state
+    replicaChannel->ReceiveState(*receivedState, previousState, timestamp);
+  }
+  else
+  {
+    // Read replica channel
+    bool result = replicaChannel->Deserialize(bitStream, ReplicationPhase::Change, timestamp);
+    if (!result) // Unable?
+    {
+      // Assert(false);
+      return false;
+    }
   }
 
   // Replica channel has not actually changed at all?
@@ -1197,6 +1299,9 @@ bool ReplicatorLink::DeserializeChange(const Message& message, TimeMs timestamp)
     return true;
   }
 
+  // Notify replicator of the received change
+  GetReplicator()->OnReplicaChannelChangeReceived(timestamp, replica, replicaChannel);
+
   // Determine if this replica channel's changes should be relayed
   bool shouldRelay = replicaChannel->ShouldRelay();
 
@@ -1249,9 +1354,385 @@ bool ReplicatorLink::SendChange(ReplicaChannel* replicaChannel, Message& message
   if (status.Failed()) // Unable?
     return false;
 
+  // Count against this frame's change budget
+  mQueuedChangeBits += message.GetTotalBits();
+
+  // Success
+  return true;
+}
+void ReplicatorLink::AddStaleReplicaChannel(ReplicaChannel* replicaChannel)
+{
+  // Get stale replica channel (keeps any priority already accumulated)
+  StaleReplicaChannel& staleChannel = mStaleReplicaChannels.FindOrInsert(replicaChannel);
+
+  // Remember which replica properties the withheld change modified
+  const ReplicaPropertySet& replicaProperties = replicaChannel->GetReplicaProperties();
+  staleChannel.mChangedProperties.Resize(replicaProperties.Size(), false);
+  for (size_t i = 0; i < replicaProperties.Size(); ++i)
+  {
+    if (replicaProperties[i]->HasChanged())
+      staleChannel.mChangedProperties[i] = true;
+  }
+}
+bool ReplicatorLink::RemoveStaleReplicaChannel(ReplicaChannel* replicaChannel)
+{
+  return mStaleReplicaChannels.EraseValue(replicaChannel).second;
+}
+bool ReplicatorLink::IsStaleReplicaChannel(ReplicaChannel* replicaChannel) const
+{
+  return mStaleReplicaChannels.FindPointer(replicaChannel) != nullptr;
+}
+bool ReplicatorLink::SendStaleChange(ReplicaChannel* replicaChannel, TimeMs timestamp)
+{
+  // Get stale replica channel
+  StaleReplicaChannel* staleChannel = mStaleReplicaChannels.FindPointer(replicaChannel);
+  if (!staleChannel) // Unable?
+  {
+    Assert(false);
+    return false;
+  }
+
+  bool result = true;
+
+  // Delta encode against this link's acknowledged baseline?
+  // (The delta covers every withheld change, since it is against a state the
+  // link is known to hold)
+  if (Replicator::ShouldUseBaselineDeltas(replicaChannel))
+  {
+    result = SendBaselineChange(replicaChannel, timestamp);
+  }
+  else
+  {
+    // Add any replica properties changed now
+    const ReplicaPropertySet& replicaProperties = replicaChannel->GetReplicaProperties();
+    Array<bool>& changedProperties = staleChannel->mChangedProperties;
+    changedProperties.Resize(replicaProperties.Size(), false);
+    for (size_t i = 0; i < replicaProperties.Size(); ++i)
+    {
+      if (replicaProperties[i]->HasChanged())
+        changedProperties[i] = true;
+    }
+
+    // Serialize every replica property changed since last sent to this link
+    Message message(ReplicatorMessageType::Change);
+    if (!GetReplicator()->SerializeChange(replicaChannel, message, timestamp, &changedProperties)) // Unable?
+    {
+      Assert(false);
+      result = false;
+    }
+    else
+    {
+      // Should include an accurate timestamp with this message?
+      if (Replicator::ShouldIncludeAccurateTimestampOnChange(replicaChannel))
+        message.SetTimestamp(timestamp);
+
+      // Send withheld changes
+      result = SendChange(replicaChannel, message);
+    }
+  }
+
+  // No longer stale
+  mStaleReplicaChannels.EraseValue(replicaChannel);
+  return result;
+}
+bool ReplicatorLink::ReplicateStaleChanges(TimeMs timestamp)
+{
+  // Nothing withheld?
+  if (mStaleReplicaChannels.Empty())
+  {
+    mScheduleChanges = false;
+    return true;
+  }
+
+  // Get replicator
+  Replicator* replicator = GetReplicator();
+
+  // For all stale replica channels
+  mScheduledChannels.Clear();
+  forRange (StaleReplicaChannels::value_type& staleChannel, mStaleReplicaChannels.All())
+  {
+    Replica* replica = staleChannel.first->GetReplica();
+
+    // Not relevant to this link?
+    uint changeInterval = replicator->GetChangeInterval(this, replica);
+    if (changeInterval == 0)
+      continue;
+
+    // Accumulate priority
+    // (Replicas that have waited longer, are due more often, or are weighted
+    // higher by the user come due first, but every replica comes due eventually)
+    float changePriority = Math::Max(replica->GetChangePriority(), 0.01f);
+    staleChannel.second.mPriority += changePriority / float(changeInterval);
+
+    // Due?
+    if (staleChannel.second.mPriority >= 1.0f)
+      mScheduledChannels.PushBack(ScheduledReplicaChannel(staleChannel.second.mPriority, staleChannel.first));
+  }
+
+  // Should skip change replication?
+  if (ShouldSkipChangeReplication())
+  {
+    mScheduleChanges = !mScheduledChannels.Empty();
+    return true;
+  }
+
+  // Highest accumulated priority first
+  Sort(mScheduledChannels.All(), ScheduledReplicaChannelSorter);
+
+  // For all due replica channels
+  bool result = true;
+  size_t sentCount = 0;
+  forRange (ScheduledReplicaChannel& scheduledChannel, mScheduledChannels.All())
+  {
+    // Change budget spent?
+    // (Always send at least one so the link keeps making progress)
+    if (sentCount != 0 && GetChangeBudget() == 0)
+      break;
+
+    ++sentCount;
+
+    // Send withheld changes
+    if (!SendStaleChange(scheduledChannel.second, timestamp)) // Unable?
+      result = false;
+  }
+
+  // Keep scheduling until every due change fits in the budget
+  mScheduleChanges = (sentCount < mScheduledChannels.Size());
+  mScheduledChannels.Clear();
+  return result;
+}
+bool ReplicatorLink::SendBaselineChange(ReplicaChannel* replicaChannel, TimeMs timestamp)
+{
+  // Get replica channel type
+  ReplicaChannelType* replicaChannelType = replicaChannel->GetReplicaChannelType();
+
+  Assert(HasReplica(replicaChannel->GetReplica()));
+
+  // Get message channel
+  MessageChannelId channelId = GetOutgoingReplicaChannel(replicaChannel);
+  if (channelId == 0) // Unable?
+  {
+    Assert(false);
+    return false;
+  }
+
+  // Get outgoing baseline (create as needed)
+  ReplicaChannelBaseline*& baseline = mOutBaselines.FindOrInsert(channelId, nullptr).first->second;
+  if (!baseline)
+    baseline = new ReplicaChannelBaseline();
+
+  // Acquire state sequence
+  BaselineSequence sequence = baseline->mNextSequence++;
+
+  // Get the latest state acknowledged as recorded remotely
+  // (As long as it's recent enough to still be held remotely)
+  const ReplicaChannelState* baselineState = nullptr;
+  if (baseline->mHasLatest && (sequence - baseline->mLatestSequence).value() < BaselineHistorySize)
+    baselineState = baseline->FindState(baseline->mLatestSequence);
+
+  // Write state sequence and baseline offset (if any)
+  Message message(ReplicatorMessageType::Change);
+  BitStream& bitStream = message.GetData();
+  bitStream.Write(sequence);
+  bitStream.Write(baselineState != nullptr);
+  if (baselineState)
+    bitStream.WriteQuantized((sequence - baseline->mLatestSequence).value(), BaselineSequence::value_type(1), BaselineSequence::value_type(BaselineHistorySize - 1));
+
+  // Write replica channel state delta
+  ReplicaChannelState sentState;
+  if (!replicaChannel->SerializeDelta(bitStream, baselineState, sentState)) // Unable?
+  {
+    Assert(false);
+    return false;
+  }
+
+  // Should include an accurate timestamp with this message?
+  if (Replicator::ShouldIncludeAccurateTimestampOnChange(replicaChannel))
+    message.SetTimestamp(timestamp);
+
+  // Send change message
+  // (Not receipted, a link-level ACK does not prove the state was recorded, so
+  // the state is only used as a baseline once acknowledged by the remote
+  // replicator)
+  Status status;
+  LinkPlugin::Send(status, message, (replicaChannelType->GetReliabilityMode() == ReliabilityMode::Reliable), channelId);
+  if (status.Failed()) // Unable?
+    return false;
+
+  // Count against this frame's change budget
+  mQueuedChangeBits += message.GetTotalBits();
+
+  // Record sent state
+  baseline->RecordState(sequence, RaverieMove(sentState));
+
   // Success
   return true;
 }
+bool ReplicatorLink::ReceiveBaselineChange(MessageChannelId channelId, ReplicaChannel* replicaChannel, const BitStream& bitStream, const ReplicaChannelState*& receivedState, const ReplicaChannelState*& previousState)
+{
+  receivedState = nullptr;
+  previousState = nullptr;
+
+  // Read state sequence
+  BaselineSequence sequence;
+  if (!bitStream.Read(sequence)) // Unable?
+    return false;
+
+  // Read baseline offset (if any)
+  bool hasBaseline;
+  if (!bitStream.Read(hasBaseline)) // Unable?
+    return false;
+  BaselineSequence::value_type baselineOffset = 0;
+  if (hasBaseline && !bitStream.ReadQuantized(baselineOffset, BaselineSequence::value_type(1), BaselineSequence::value_type(BaselineHistorySize - 1))) // Unable?
+    return false;
+
+  // Get incoming baseline (create as needed)
+  ReplicaChannelBaseline*& baseline = mInBaselines.FindOrInsert(replicaChannel, nullptr).first->second;
+  if (!baseline)
+    baseline = new ReplicaChannelBaseline();
+
+  // Find baseline state (if any)
+  const ReplicaChannelState* baselineState = nullptr;
+  if (hasBaseline)
+  {
+    baselineState = baseline->FindState(sequence - BaselineSequence(baselineOffset));
+    if (!baselineState) // No longer held?
+    {
+      // Ignore
+      // (Only possible if the change arrived after BaselineHistorySize newer
+      // changes had already been received)
+      return true;
+    }
+  }
+
+  // Read replica channel state delta
+  ReplicaChannelState state;
+  if (!replicaChannel->DeserializeDelta(bitStream, baselineState, state)) // Unable?
+    return false;
+
+  // Record received state
+  baseline->RecordState(sequence, RaverieMove(state));
+
+  // Acknowledge the newest recorded state at the end of the update
+  // (Only recorded states are acknowledged, so the remote replicator never
+  // encodes against a state we do not hold)
+  BaselineAcks::iterator ackIter = mBaselineAcks.FindIterator(channelId);
+  if (ackIter == mBaselineAcks.End())
+    mBaselineAcks.Insert(channelId, sequence);
+  else if (sequence > ackIter->second)
+    ackIter->second = sequence;
+
+  // Older than the latest received state?
+  // (Possible on unordered channels)
+  if (baseline->mHasLatest && !(sequence > baseline->mLatestSequence))
+  {
+    // Keep as a baseline, but ignore
+    // (Applying it would move the replica channel back in time)
+    return true;
+  }
+
+  receivedState = baseline->FindState(sequence);
+  if (baseline->mHasLatest)
+    previousState = baseline->FindState(baseline->mLatestSequence);
+  baseline->mLatestSequence = sequence;
+  baseline->mHasLatest = true;
+
+  // Success
+  return true;
+}
+bool ReplicatorLink::SendBaselineAcks()
+{
+  // Nothing recorded this update?
+  if (mBaselineAcks.Empty())
+    return true;
+
+  // Write the latest recorded state sequence of each message channel
+  Message message(ReplicatorMessageType::BaselineAcks);
+  BitStream& bitStream = message.GetData();
+  bitStream.Write(uint(mBaselineAcks.Size()));
+  forRange (BaselineAcks::value_type& ack, mBaselineAcks.All())
+  {
+    bitStream.Write(ack.first);
+    bitStream.Write(ack.second);
+  }
+  mBaselineAcks.Clear();
+
+  // Send acknowledgements
+  // (Unreliable, the next change received on each channel is acknowledged
+  // again anyway)
+  Status status;
+  LinkPlugin::Send(status, RaverieMove(message), false);
+  if (status.Failed()) // Unable?
+    return false;
+
+  // Success
+  return true;
+}
+bool ReplicatorLink::ReceiveBaselineAcks(const Message& message)
+{
+  Assert(message.GetType() == ReplicatorMessageType::BaselineAcks);
+
+  const BitStream& bitStream = message.GetData();
+
+  // Read acknowledgement count
+  uint ackCount;
+  if (!bitStream.Read(ackCount)) // Unable?
+    return false;
+
+  // For all acknowledgements
+  for (uint i = 0; i < ackCount; ++i)
+  {
+    // Read message channel and state sequence
+    MessageChannelId channelId;
+    BaselineSequence sequence;
+    if (!bitStream.Read(channelId) || !bitStream.Read(sequence)) // Unable?
+      return false;
+
+    // Get outgoing baseline
+    // (May have been closed since)
+    ReplicaChannelBaseline* baseline = mOutBaselines.FindValue(channelId, nullptr);
+    if (!baseline) // Unable?
+      continue;
+
+    // State no longer held locally?
+    if (!baseline->FindState(sequence))
+      continue;
+
+    // Newer than the latest acknowledged state?
+    if (!baseline->mHasLatest || sequence > baseline->mLatestSequence)
+    {
+      // Use as baseline for later changes
+      baseline->mLatestSequence = sequence;
+      baseline->mHasLatest = true;
+    }
+  }
+
+  // Success
+  return true;
+}
+void ReplicatorLink::RemoveBaseline(ReplicaChannel* replicaChannel, TransmissionDirection::Enum direction)
+{
+  // Outgoing?
+  if (direction == TransmissionDirection::Outgoing)
+  {
+    // Get outgoing message channel
+    MessageChannelId channelId = GetOutgoingReplicaChannel(replicaChannel);
+    if (channelId == 0) // Unable?
+      return;
+
+    // Delete outgoing baseline (if any)
+    delete mOutBaselines.FindValue(channelId, nullptr);
+    mOutBaselines.EraseValue(channelId);
+  }
+  // Incoming?
+  else
+  {
+    // Delete incoming baseline (if any)
+    delete mInBaselines.FindValue(replicaChannel, nullptr);
+    mInBaselines.EraseValue(replicaChannel);
+  }
+}
+
 bool ReplicatorLink::ReceiveChange(const Message& message)
 {
   Assert(message.GetType() == ReplicatorMessageType::Change);
@@ -1457,11 +1938,18 @@ void ReplicatorLink::CloseOutgoingReplicaChannel(ReplicaChannel* replicaChannel)
   if (iter == mOutReplicaChannels.End()) // Unable?
     return;
 
+  // Forget any sent states
+  // (Before the message channel is removed, sent states are mapped by it)
+  RemoveBaseline(replicaChannel, TransmissionDirection::Outgoing);
+
   // Close outgoing message channel
   LinkPlugin::GetLink()->CloseOutgoingChannel(iter->second);
 
   // Remove outgoing message channel
   mOutReplicaChannels.Erase(iter);
+
+  // Forget any withheld change
+  RemoveStaleReplicaChannel(replicaChannel);
 }
 MessageChannelId ReplicatorLink::GetOutgoingReplicaChannel(ReplicaChannel* replicaChannel) const
 {
@@ -1512,6 +2000,10 @@ void ReplicatorLink::ClearIncomingReplicaChannel(ReplicaChannel* replicaChannel)
 
   // Remove incoming message channel (in regular map)
   mInReplicaChannels.EraseValue(channelId);
+
+  // Forget any received states
+  RemoveBaseline(replicaChannel, TransmissionDirection::Incoming);
+  mBaselineAcks.EraseValue(channelId);
 }
 ReplicaChannel* ReplicatorLink::GetIncomingReplicaChannel(MessageChannelId channelId) const
 {
@@ -1523,6 +2015,13 @@ ReplicaChannel* ReplicatorLink::GetIncomingReplicaChannel(MessageChannelId chann
 // Link Plugin Interface
 //
 
+void ReplicatorLink::OnUpdate()
+{
+  // Queued changes have been sent in packets, which the outgoing frame size
+  // now counts
+  mQueuedChangeBits = 0;
+}
+
 void ReplicatorLink::OnConnectRequestSend(Message& message)
 {
   // Not client?
@@ -1842,6 +2341,10 @@ void ReplicatorLink::OnPluginMessageReceive(MoveReference<Message> message, bool
       ReceiveReverseReplicaChannels(message);
       break;
 
+    case ReplicatorMessageType::BaselineAcks:
+      ReceiveBaselineAcks(message);
+      break;
+
     default:
       Assert(false);
       break;
@@ -1893,6 +2396,10 @@ void ReplicatorLink::OnPluginMessageReceive(MoveReference<Message> message, bool
       continueProcessingCustomMessages = false;
       break;
 
+    case ReplicatorMessageType::BaselineAcks:
+      ReceiveBaselineAcks(message);
+      break;
+
     default:
       Assert(false);
       break;
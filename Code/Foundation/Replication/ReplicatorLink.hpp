@@ -4,6 +4,56 @@
 namespace Raverie
 {
 
+//                           ReplicaChannelBaseline //
+
+/// Replica Channel Baseline
+/// Recent states of a single replica channel sent to (or received from) a
+/// single link, kept so changes can be delta encoded against a state the
+/// remote peer is known to hold
+struct ReplicaChannelBaseline
+{
+  /// Constructor
+  ReplicaChannelBaseline();
+
+  /// Returns the recorded state with the specified sequence, else nullptr
+  ReplicaChannelState* FindState(BaselineSequence sequence);
+  /// Records the state with the specified sequence (replacing the state
+  /// recorded BaselineHistorySize sequences earlier, if any)
+  void RecordState(BaselineSequence sequence, MoveReference<ReplicaChannelState> state);
+
+  /// Data
+  ReplicaChannelState mStates[BaselineHistorySize]; /// Recorded states (indexed by sequence)
+  BaselineSequence mSequences[BaselineHistorySize]; /// Recorded state sequences
+  bool mIsRecorded[BaselineHistorySize];            /// Recorded state is valid?
+  BaselineSequence mNextSequence;                   /// [Outgoing] Next state sequence to send
+  BaselineSequence mLatestSequence;                 /// [Outgoing] Latest state sequence recorded remotely
+                                                    /// [Incoming] Latest received state sequence
+  bool mHasLatest;                                  /// Has latest state sequence?
+};
+
+//                            StaleReplicaChannel //
+
+/// Stale Replica Channel
+/// Changes of a single replica channel withheld from a single link, kept until
+/// the replica channel's accumulated priority comes due
+struct StaleReplicaChannel
+{
+  /// Constructor
+  StaleReplicaChannel();
+
+  /// Data
+  float mPriority;                /// Accumulated priority
+  Array<bool> mChangedProperties; /// Replica properties changed since last sent to the link
+                                  /// (indexed like the replica channel's replica properties)
+};
+
+/// Typedefs
+typedef ArrayMap<MessageChannelId, ReplicaChannelBaseline*> OutReplicaChannelBaselines;
+typedef ArrayMap<ReplicaChannel*, ReplicaChannelBaseline*> InReplicaChannelBaselines;
+typedef ArrayMap<MessageChannelId, BaselineSequence> BaselineAcks;
+typedef ArrayMap<ReplicaChannel*, StaleReplicaChannel> StaleReplicaChannels;
+typedef Pair<float, ReplicaChannel*> ScheduledReplicaChannel;
+
 //                               ReplicatorLink //
 
 /// Replicator Link Plugin
@@ -14,6 +64,9 @@ public:
   /// Constructor
   ReplicatorLink(Replicator* replicator);
 
+  /// Destructor
+  ~ReplicatorLink();
+
   //
   // Operations
   //
@@ -80,6 +133,15 @@ public:
   /// Returns true if change replication should be skipped for this link
   bool ShouldSkipChangeReplication() const;
 
+  /// Returns true if changes are being scheduled by priority for this link
+  /// (withheld changes were left unsent last frame because the link ran out
+  /// of outgoing bandwidth), else false
+  bool ShouldScheduleChanges() const;
+  /// Returns the outgoing bandwidth left for change replication this frame
+  /// (frame capacity up to the frame fill skip ratio, less everything already
+  /// sent, less changes queued since the outbox last sent)
+  Bits GetChangeBudget() const;
+
   //
   // Internal
   //
@@ -228,6 +290,50 @@ public:
   /// Returns true if successful, else false
   bool ReceiveChange(const Message& message);
 
+  /// Sends the replica channel's current state delta encoded against the
+  /// latest state this link acknowledged recording (else against nothing)
+  /// Returns true if successful, else false
+  bool SendBaselineChange(ReplicaChannel* replicaChannel, TimeMs timestamp);
+  /// Reads a replica channel state delta encoded against a state previously
+  /// received from this link, and records it so later changes may be encoded
+  /// against it (acknowledging it at the end of the update) Sets received
+  /// state (else nullptr if its baseline is no longer held, or it is older
+  /// than the latest received state, and the change must be ignored) and
+  /// previous state (the state received before it, else nullptr) Returns true
+  /// if successful, else false
+  bool ReceiveBaselineChange(MessageChannelId channelId, ReplicaChannel* replicaChannel, const BitStream& bitStream, const ReplicaChannelState*& receivedState, const ReplicaChannelState*& previousState);
+  /// Sends acknowledgements of the replica channel states recorded this
+  /// update (if any)
+  /// Returns true if successful, else false
+  bool SendBaselineAcks();
+  /// Handles acknowledgements of replica channel states recorded by this link
+  /// Returns true if successful, else false
+  bool ReceiveBaselineAcks(const Message& message);
+  /// Forgets all baseline states of the replica channel in the specified
+  /// direction
+  void RemoveBaseline(ReplicaChannel* replicaChannel, TransmissionDirection::Enum direction);
+
+  /// Marks the replica channel as stale (a change was withheld from this link)
+  /// Keeps any priority it has already accumulated, and adds the replica
+  /// properties changed by the withheld change
+  void AddStaleReplicaChannel(ReplicaChannel* replicaChannel);
+  /// Unmarks the replica channel as stale
+  /// Returns true if the replica channel was stale, else false
+  bool RemoveStaleReplicaChannel(ReplicaChannel* replicaChannel);
+  /// Returns true if the replica channel is stale, else false
+  bool IsStaleReplicaChannel(ReplicaChannel* replicaChannel) const;
+  /// Sends the stale replica channel's withheld changes, as a delta against
+  /// the acknowledged baseline if enabled, else as every replica property
+  /// changed since last sent to this link (including any changed now), then
+  /// unmarks it as stale
+  /// Returns true if successful, else false
+  bool SendStaleChange(ReplicaChannel* replicaChannel, TimeMs timestamp);
+  /// Accumulates priority for every stale replica channel relevant to this
+  /// link, then sends the withheld changes of those that have come due,
+  /// highest accumulated priority first, until the change budget is spent
+  /// Returns true if successful, else false
+  bool ReplicateStaleChanges(TimeMs timestamp);
+
   /// [Server] Sends an interrupt command
   /// Returns true if successful, else false
   bool SendInterrupt(Message& message);
@@ -286,6 +392,9 @@ public:
   // Link Plugin Interface
   //
 
+  /// Called after the link has sent its outgoing packets this update
+  void OnUpdate() override;
+
   /// Called after a connect request is sent
   void OnConnectRequestSend(Message& message) override;
   /// Called after a connect request is received
@@ -322,6 +431,17 @@ public:
                                                       /// to replica channel)
   InReplicaChannelsFlipped mInReplicaChannelsFlipped; /// Incoming replica channel map flipped
                                                       /// (replica channel to message channel ID)
+  StaleReplicaChannels mStaleReplicaChannels;         /// Outgoing replica channels with changes
+                                                      /// withheld from this link
+  Array<ScheduledReplicaChannel> mScheduledChannels;  /// Stale replica channels due this frame
+                                                      /// (reused between frames)
+  bool mScheduleChanges;                              /// Schedule changes by priority?
+  Bits mQueuedChangeBits;                             /// Change data queued since the outbox last sent
+  OutReplicaChannelBaselines mOutBaselines;           /// Replica channel states sent to this link
+                                                      /// (mapped by outgoing message channel ID)
+  InReplicaChannelBaselines mInBaselines;             /// Replica channel states received from this link
+  BaselineAcks mBaselineAcks;                         /// Latest replica channel states recorded this update
+                                                      /// (mapped by incoming message channel ID)
   ConnectRequestData mLastConnectRequestData;         /// Last connect request data sent/received
   ConnectResponseData mLastConnectResponseData;       /// Last connect response data sent/received
   bool mShouldSkipChangeReplication;                  /// Should skip change replication?
@@ -172,6 +172,10 @@ ResourceLibrary::ResourceLibrary()
   EventConnect(&mScriptProject, Raverie::Events::PostSyntaxer, &ResourceLibrary::OnScriptProjectPostSyntaxer, this);
   EventConnect(&mScriptProject, Raverie::Events::TypeParsed, &EngineLibraryExtensions::TypeParsedCallback);
 
+  // Scripts are recompiled every time any of them change, so only re-parse the
+  // scripts that actually changed
+  mScriptProject.CacheEntries = true;
+
   ObjectEvent toSend(this);
   Z::gResources->DispatchEvent(Events::ResourceLibraryConstructed, &toSend);
 }
@@ -517,7 +521,10 @@ bool ResourceLibrary::CompileScripts(HashSet<ResourceLibrary*>& modifiedLibrarie
       mScriptProject.AddCodeFromString(script->mText, script->GetOrigin(), script);
   }
 
-  mSwapScript.mPendingLibrary = mScriptProject.Compile(this->Name, dependencies, EvaluationMode::Project);
+  {
+    ProfileScopeArgs("CompileScripts", this->Name);
+    mSwapScript.mPendingLibrary = mScriptProject.Compile(this->Name, dependencies, EvaluationMode::Project);
+  }
 
   if (mSwapScript.mPendingLibrary != nullptr)
   {
@@ -1562,6 +1562,189 @@ Math::Vector4 BitStreamExtended::ReadReal4Quantized(const Math::Vector4& minValu
 // Event Operations
 //
 
+bool BitStreamExtended::IsSerializedEventProperty(Property* property)
+{
+  // Is the script source property?
+  if (property->Name == cScriptSource)
+    return false; // Skip property (we don't need to serialize this)
+
+  // Is the event ID property?
+  if (property->Name == cEventId)
+    return false; // Skip property (we manually serialize this)
+
+  // Is a net peer ID property?
+  if (property->HasAttribute(PropertyAttributes::cNetPeerId))
+    return false; // Skip property (will be set automatically by NetPeer after
+                  // receiving the event)
+
+  // Is a net property?
+  return property->HasAttribute(PropertyAttributes::cNetProperty) != nullptr;
+}
+
+void BitStreamExtended::WriteEventProperty(Property* property, Event* event)
+{
+  // (Should be a valid net property type)
+  Assert(IsValidNetPropertyType(property->PropertyType));
+
+  // Is Cog type?
+  if (property->PropertyType == RaverieTypeId(Cog))
+  {
+    // Get cog as net object ID
+    // (Using ReplicaId to take advantage of WriteQuantized)
+    ReplicaId netObjectId = GetNetPropertyCogAsNetObjectId(property, event);
+
+    // Write net object ID
+    BitStream::Write(netObjectId);
+  }
+  // Is CogPath type?
+  else if (property->PropertyType == RaverieTypeId(CogPath))
+  {
+    // Get cog path value
+    Any cogPathAny = property->GetValue(event);
+    if (!cogPathAny.IsHoldingValue()) // Unable?
+      DoNotifyError("BitStream",
+                    "Error getting CogPath NetProperty - Unable to get "
+                    "property instance value");
+    CogPath* cogPath = cogPathAny.Get<CogPath*>();
+
+    // Get cog path string
+    String cogPathString = cogPath ? cogPath->GetPath() : String();
+
+    // Write cog path string
+    BitStream::Write(cogPathString);
+  }
+  // Is any other type?
+  else
+  {
+    // Get any value
+    Any anyValue = property->GetValue(event);
+
+    // Attempt to convert basic any value to variant value
+    Variant variantValue = ConvertBasicAnyToVariant(anyValue);
+    if (variantValue.IsEmpty()) // Unable? (The any's stored type is not a
+                                // basic native type?)
+    {
+      // Assign the any value itself to the variant value
+      // (Some property types like enums, resources, and bitstream are
+      // expected to be wrapped in an any this way)
+      variantValue = anyValue;
+    }
+
+    // Is serialization supported for the underlying type?
+    if (BitStreamCanSerializeType(anyValue.StoredType))
+    {
+      // Write variant
+      BitStream::Write(variantValue);
+    }
+    else
+      DoNotifyError("BitStream",
+                    "Unable to serialize property - Serialization is not "
+                    "supported by the property type");
+  }
+}
+bool BitStreamExtended::ReadEventProperty(Property* property, Event* event, NetPeer* netPeer) const
+{
+  // (Should be a valid net property type)
+  Assert(IsValidNetPropertyType(property->PropertyType));
+
+  // Is Cog type?
+  if (property->PropertyType == RaverieTypeId(Cog))
+  {
+    // NetPeer not provided?
+    if (!netPeer)
+    {
+      DoNotifyError("BitStream",
+                    "Unable to serialize [NetProperty] Cog property - "
+                    "GameSession must have a NetPeer component");
+      return false;
+    }
+
+    // Read net object ID
+    // (Using ReplicaId to take advantage of ReadQuantized)
+    ReplicaId netObjectId;
+    if (!BitStream::Read(netObjectId)) // Unable?
+    {
+      Assert(false);
+      return false;
+    }
+
+    // Set cog as net object ID
+    SetNetPropertyCogAsNetObjectId(property, event, netPeer, netObjectId.value());
+  }
+  // Is CogPath type?
+  else if (property->PropertyType == RaverieTypeId(CogPath))
+  {
+    // Get cog path value
+    Any cogPathAny = property->GetValue(event);
+    if (!cogPathAny.IsHoldingValue()) // Unable?
+      DoNotifyError("BitStream",
+                    "Error getting CogPath NetProperty - Unable to get "
+                    "property instance value");
+    CogPath* cogPath = cogPathAny.Get<CogPath*>();
+
+    // Read cog path string
+    String cogPathString;
+    if (!BitStream::Read(cogPathString)) // Unable?
+    {
+      Assert(false);
+      return false;
+    }
+
+    // Set cog path string
+    if (cogPath)
+      cogPath->SetPath(cogPathString);
+  }
+  // Is any other type?
+  else
+  {
+    // Get any value
+    Any anyValue = property->GetValue(event);
+
+    // Attempt to convert basic any value to variant value
+    Variant variantValue = ConvertBasicAnyToVariant(anyValue);
+    if (variantValue.IsEmpty()) // Unable? (The any's stored type is not a
+                                // basic native type?)
+    {
+      // Assign the any value itself to the variant value
+      // (Some property types like enums, resources, and bitstream are
+      // expected to be wrapped in an any this way)
+      variantValue = anyValue;
+    }
+
+    // Is serialization supported for the underlying type?
+    if (BitStreamCanSerializeType(anyValue.StoredType))
+    {
+      // Read variant
+      if (!BitStream::Read(variantValue)) // Unable?
+      {
+        Assert(false);
+        return false;
+      }
+
+      // Attempt to convert basic variant value to any value
+      Any anyValue = ConvertBasicVariantToAny(variantValue);
+      if (!anyValue.IsHoldingValue()) // Unable? (The variant's stored type
+                                      // is not a basic native type?)
+      {
+        // Get the any value itself from the variant value
+        // (Some property types like enums, resources, and bitstream are
+        // expected to be wrapped in an any this way)
+        anyValue = variantValue.GetOrError<Any>();
+      }
+
+      // Set the property value
+      property->SetValue(event, anyValue);
+    }
+    else
+      DoNotifyError("BitStream",
+                    "Unable to serialize property - Serialization is not "
+                    "supported by the property type");
+  }
+
+  // Success
+  return true;
+}
+
 bool BitStreamExtended::WriteEvent(Event* event)
 {
   // Null event?
@@ -1586,93 +1769,18 @@ bool BitStreamExtended::WriteEvent(Event* event)
   BitStream::Write(eventType->Name); // TODO: Refactor this to use ItemCache
 
   // Write event ID
-  // (TODO: Optimize this with a lookup table)
+  // (NetEventTable replaces these strings with table indices for net events)
   BitStream::Write(event->EventId);
 
   //
   // Write Properties
   //
 
-  // For all properties
+  // For all serialized properties
   MemberRange<Property> properties = eventType->GetProperties(Members::InheritedInstanceExtension);
   forRange (Property* property, properties)
-  {
-    // Is the script source property?
-    if (property->Name == cScriptSource)
-      continue; // Skip property (we don't need to serialize this)
-
-    // Is the event ID property?
-    if (property->Name == cEventId)
-      continue; // Skip property (we manually serialize this above)
-
-    // Is a net peer ID property?
-    if (property->HasAttribute(PropertyAttributes::cNetPeerId))
-      continue; // Skip property (will be set automatically by NetPeer after
-                // receiving the event)
-
-    // Is a net property?
-    if (property->HasAttribute(PropertyAttributes::cNetProperty))
-    {
-      // (Should be a valid net property type)
-      Assert(IsValidNetPropertyType(property->PropertyType));
-
-      // Is Cog type?
-      if (property->PropertyType == RaverieTypeId(Cog))
-      {
-        // Get cog as net object ID
-        // (Using ReplicaId to take advantage of WriteQuantized)
-        ReplicaId netObjectId = GetNetPropertyCogAsNetObjectId(property, event);
-
-        // Write net object ID
-        BitStream::Write(netObjectId);
-      }
-      // Is CogPath type?
-      else if (property->PropertyType == RaverieTypeId(CogPath))
-      {
-        // Get cog path value
-        Any cogPathAny = property->GetValue(event);
-        if (!cogPathAny.IsHoldingValue()) // Unable?
-          DoNotifyError("BitStream",
-                        "Error getting CogPath NetProperty - Unable to get "
-                        "property instance value");
-        CogPath* cogPath = cogPathAny.Get<CogPath*>();
-
-        // Get cog path string
-        String cogPathString = cogPath ? cogPath->GetPath() : String();
-
-        // Write cog path string
-        BitStream::Write(cogPathString);
-      }
-      // Is any other type?
-      else
-      {
-        // Get any value
-        Any anyValue = property->GetValue(event);
-
-        // Attempt to convert basic any value to variant value
-        Variant variantValue = ConvertBasicAnyToVariant(anyValue);
-        if (variantValue.IsEmpty()) // Unable? (The any's stored type is not a
-                                    // basic native type?)
-        {
-          // Assign the any value itself to the variant value
-          // (Some property types like enums, resources, and bitstream are
-          // expected to be wrapped in an any this way)
-          variantValue = anyValue;
-        }
-
-        // Is serialization supported for the underlying type?
-        if (BitStreamCanSerializeType(anyValue.StoredType))
-        {
-          // Write variant
-          BitStream::Write(variantValue);
-        }
-        else
-          DoNotifyError("BitStream",
-                        "Unable to serialize property - Serialization is not "
-                        "supported by the property type");
-      }
-    }
-  }
+    if (IsSerializedEventProperty(property))
+      WriteEventProperty(property, event);
 
   // Success
   return true;
@@ -1718,124 +1826,12 @@ HandleOf<Event> BitStreamExtended::ReadEvent(GameSession* gameSession) const
   // Read Properties
   //
 
-  // For all properties
+  // For all serialized properties
   MemberRange<Property> properties = eventType->GetProperties(Members::InheritedInstanceExtension);
   forRange (Property* property, properties)
-  {
-    // Is the script source property?
-    if (property->Name == cScriptSource)
-      continue; // Skip property (we don't need to serialize this)
-
-    // Is the event ID property?
-    if (property->Name == cEventId)
-      continue; // Skip property (we manually serialize this above)
-
-    // Is a net peer ID property?
-    if (property->HasAttribute(PropertyAttributes::cNetPeerId))
-      continue; // Skip property (will be set automatically by NetPeer after
-                // receiving the event)
-
-    // Is a net property?
-    if (property->HasAttribute(PropertyAttributes::cNetProperty))
-    {
-      // (Should be a valid net property type)
-      Assert(IsValidNetPropertyType(property->PropertyType));
-
-      // Is Cog type?
-      if (property->PropertyType == RaverieTypeId(Cog))
-      {
-        // NetPeer not provided?
-        if (!netPeer)
-        {
-          DoNotifyError("BitStream",
-                        "Unable to serialize [NetProperty] Cog property - "
-                        "GameSession must have a NetPeer component");
-          return nullptr;
-        }
-
-        // Read net object ID
-        // (Using ReplicaId to take advantage of ReadQuantized)
-        ReplicaId netObjectId;
-        if (!BitStream::Read(netObjectId)) // Unable?
-        {
-          Assert(false);
-          return nullptr;
-        }
-
-        // Set cog as net object ID
-        SetNetPropertyCogAsNetObjectId(property, event, netPeer, netObjectId.value());
-      }
-      // Is CogPath type?
-      else if (property->PropertyType == RaverieTypeId(CogPath))
-      {
-        // Get cog path value
-        Any cogPathAny = property->GetValue(event);
-        if (!cogPathAny.IsHoldingValue()) // Unable?
-          DoNotifyError("BitStream",
-                        "Error getting CogPath NetProperty - Unable to get "
-                        "property instance value");
-        CogPath* cogPath = cogPathAny.Get<CogPath*>();
-
-        // Read cog path string
-        String cogPathString;
-        if (!BitStream::Read(cogPathString)) // Unable?
-        {
-          Assert(false);
-          return nullptr;
-        }
-
-        // Set cog path string
-        if (cogPath)
-          cogPath->SetPath(cogPathString);
-      }
-      // Is any other type?
-      else
-      {
-        // Get any value
-        Any anyValue = property->GetValue(event);
-
-        // Attempt to convert basic any value to variant value
-        Variant variantValue = ConvertBasicAnyToVariant(anyValue);
-        if (variantValue.IsEmpty()) // Unable? (The any's stored type is not a
-                                    // basic native type?)
-        {
-          // Assign the any value itself to the variant value
-          // (Some property types like enums, resources, and bitstream are
-          // expected to be wrapped in an any this way)
-          variantValue = anyValue;
-        }
-
-        // Is serialization supported for the underlying type?
-        if (BitStreamCanSerializeType(anyValue.StoredType))
-        {
-          // Read variant
-          if (!BitStream::Read(variantValue)) // Unable?
-          {
-            Assert(false);
-            return nullptr;
-          }
-
-          // Attempt to convert basic variant value to any value
-          Any anyValue = ConvertBasicVariantToAny(variantValue);
-          if (!anyValue.IsHoldingValue()) // Unable? (The variant's stored type
-                                          // is not a basic native type?)
-          {
-            // Get the any value itself from the variant value
-            // (Some property types like enums, resources, and bitstream are
-            // expected to be wrapped in an any this way)
-            anyValue = variantValue.GetOrError<Any>();
-          }
-
-          // Set the property value
-          property->SetValue(event, anyValue);
-        }
-        else
-          DoNotifyError("BitStream",
-                        "Unable to serialize property - Serialization is not "
-                        "supported by the property type");
-      }
-    }
-  }
+    if (IsSerializedEventProperty(property))
+      if (!ReadEventProperty(property, event, netPeer)) // Unable?
+        return nullptr;
 
   // Success
   return event;
@@ -333,6 +333,17 @@ public:
   /// Reads an event from the bitstream.
   /// Returns a new event if successful, else nullptr.
   HandleOf<Event> ReadEvent(GameSession* gameSession) const;
+
+  /// Returns true if the event property is serialized with the event, else
+  /// false.
+  static bool IsSerializedEventProperty(Property* property);
+
+  /// Writes an event's net property value to the bitstream.
+  void WriteEventProperty(Property* property, Event* event);
+
+  /// Reads an event's net property value from the bitstream.
+  /// Returns true if successful, else false.
+  bool ReadEventProperty(Property* property, Event* event, NetPeer* netPeer) const;
 };
 
 //                             Serialize Functions //
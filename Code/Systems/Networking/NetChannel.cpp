@@ -281,6 +281,11 @@ NetProperty* NetChannel::AddNetProperty(Component* component, Property* property
 
     // Get or add corresponding net property type
     netPropertyType = netPeer->GetOrAddReplicaPropertyType(netPropertyTypeName, nativeType, SerializeKnownExtendedVariant, GetComponentAnyProperty, SetComponentAnyProperty, netPropertyConfig);
+
+    // Basic arithmetic type?
+    // (Allows change detection to compare raw values instead of variants)
+    if (netPropertyType && nativeType->mIsBasicNativeTypeArithmetic)
+      netPropertyType->SetGetRawValueFn(GetComponentAnyPropertyRaw);
   }
 
   // Unable to get or add net property type?
@@ -440,6 +445,7 @@ RaverieDefineType(NetChannelType, builder, type)
   RaverieBindGetterSetterProperty(SerializationMode);
   RaverieBindGetterSetterProperty(ReliabilityMode);
   RaverieBindGetterSetterProperty(TransferMode);
+  RaverieBindGetterSetterProperty(UseBaselineDeltas);
   RaverieBindGetterSetterProperty(AccurateTimestampOnChange);
 }
 
@@ -479,6 +485,7 @@ void NetChannelType::ResetConfig()
     SetReplicateOnOffline();
     SetSerializationMode();
     SetTransferMode();
+    SetUseBaselineDeltas();
   }
 
   // Set runtime config options
@@ -509,6 +516,7 @@ void NetChannelType::SetConfig(NetChannelConfig* netChannelConfig)
     SetReplicateOnOffline(netChannelConfig->mReplicateOnOffline);
     SetSerializationMode(netChannelConfig->mSerializationMode);
     SetTransferMode(netChannelConfig->mTransferMode);
+    SetUseBaselineDeltas(netChannelConfig->mUseBaselineDeltas);
   }
 
   // Set runtime config options
@@ -782,6 +790,25 @@ TransferMode::Enum NetChannelType::GetTransferMode() const
   return ReplicaChannelType::GetTransferMode();
 }
 
+void NetChannelType::SetUseBaselineDeltas(bool useBaselineDeltas)
+{
+  // Already valid?
+  if (ReplicaChannelType::IsValid())
+  {
+    // Unable to modify configuration
+    DoNotifyError("NetChannelType",
+                  "Unable to modify this NetChannelType configuration option "
+                  "at game runtime");
+    return;
+  }
+
+  ReplicaChannelType::SetUseBaselineDeltas(useBaselineDeltas);
+}
+bool NetChannelType::GetUseBaselineDeltas() const
+{
+  return ReplicaChannelType::GetUseBaselineDeltas();
+}
+
 void NetChannelType::SetAccurateTimestampOnChange(bool accurateTimestampOnChange)
 {
   ReplicaChannelType::SetAccurateTimestampOnChange(accurateTimestampOnChange);
@@ -823,6 +850,7 @@ RaverieDefineType(NetChannelConfig, builder, type)
   RaverieBindFieldProperty(mSerializationMode);
   RaverieBindFieldProperty(mReliabilityMode);
   RaverieBindFieldProperty(mTransferMode);
+  RaverieBindFieldProperty(mUseBaselineDeltas);
   RaverieBindFieldProperty(mAccurateTimestampOnChange);
 }
 
@@ -847,6 +875,7 @@ void NetChannelConfig::Serialize(Serializer& stream)
   SerializeEnumNameDefault(SerializationMode, mSerializationMode, SerializationMode::Changed);
   SerializeEnumNameDefault(ReliabilityMode, mReliabilityMode, ReliabilityMode::Reliable);
   SerializeEnumNameDefault(TransferMode, mTransferMode, TransferMode::Ordered);
+  SerializeNameDefault(mUseBaselineDeltas, false);
   SerializeNameDefault(mAccurateTimestampOnChange, false);
 }
 
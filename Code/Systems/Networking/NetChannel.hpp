@@ -276,6 +276,13 @@ public:
   void SetTransferMode(TransferMode::Enum transferMode = TransferMode::Ordered);
   TransferMode::Enum GetTransferMode() const;
 
+  /// Controls whether or not net channel changes will be delta encoded
+  /// against the latest state each peer has acknowledged, instead of being
+  /// sent in full. (Saves bandwidth on frequently changing net channels;
+  /// ignored when the transfer mode is Sequenced) (Cannot be modified at game runtime)
+  void SetUseBaselineDeltas(bool useBaselineDeltas = false);
+  bool GetUseBaselineDeltas() const;
+
   /// Controls whether or not the net channel will serialize an accurate
   /// timestamp value when changed, or will instead accept an estimated
   /// timestamp value. (This setting may be overridden for net channels
@@ -412,6 +419,12 @@ public:
   /// changes to be sent reliably)
   TransferMode::Enum mTransferMode;
 
+  /// Controls whether or not net channel changes will be delta encoded
+  /// against the latest state each peer has acknowledged, instead of being
+  /// sent in full. (Saves bandwidth on frequently changing net channels;
+  /// ignored when the transfer mode is Sequenced)
+  bool mUseBaselineDeltas;
+
   /// Controls whether or not the net channel will serialize an accurate
   /// timestamp value when changed, or will instead accept an estimated
   /// timestamp value. (This setting may be overridden for net channels
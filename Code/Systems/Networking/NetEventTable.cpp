@@ -0,0 +1,372 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Raverie
+{
+
+/// Returns true if both bitstreams contain identical bits written, else false.
+inline bool HasSameBitsWritten(const BitStream& lhs, const BitStream& rhs)
+{
+  // Different sizes?
+  if (lhs.GetBitsWritten() != rhs.GetBitsWritten())
+    return false;
+
+  // (Bits beyond those written are always zero, so whole bytes can be compared)
+  return lhs.GetBytesWritten() == 0 || memcmp(lhs.GetData(), rhs.GetData(), lhs.GetBytesWritten()) == 0;
+}
+
+//                                NetEventTable //
+
+NetEventTable::NetEventTable() :
+    mStringIndices(),
+    mStrings(),
+    mPreviousProperties(),
+    mResetPending(false),
+    mAwaitingReset(false),
+    mCanUndo(false),
+    mUndoStringCount(0),
+    mUndoResetPending(false),
+    mUndoEventTypeName(),
+    mUndoProperties(),
+    mUndoHadProperties(false)
+{
+}
+
+bool NetEventTable::WriteEvent(BitStreamExtended& bitStream, Event* event)
+{
+  // Null event?
+  if (!event)
+  {
+    Assert(false);
+    return false;
+  }
+
+  // Get event type
+  BoundType* eventType = RaverieVirtualTypeId(event);
+  if (!eventType)
+  {
+    Assert(false);
+    return false;
+  }
+
+  // Remember the table state in case this event is never sent
+  BeginUndo();
+
+  // Write reset flag
+  // (Tells the remote table to clear itself before reading this event)
+  bitStream.Write(mResetPending);
+  mResetPending = false;
+
+  // Write event type name and event ID
+  WriteString(bitStream, eventType->Name);
+  WriteString(bitStream, event->EventId);
+
+  // Get the net property values of the previous event of this type
+  BeginUndoProperties(eventType->Name);
+  Array<BitStream>& previousProperties = mPreviousProperties[eventType->Name];
+
+  //
+  // Write Properties
+  //
+
+  // For all serialized properties
+  uint propertyIndex = 0;
+  MemberRange<Property> properties = eventType->GetProperties(Members::InheritedInstanceExtension);
+  forRange (Property* property, properties)
+  {
+    if (!BitStreamExtended::IsSerializedEventProperty(property))
+      continue;
+
+    // Serialize property value on its own
+    BitStreamExtended propertyBits;
+    propertyBits.WriteEventProperty(property, event);
+
+    // Unchanged since the previous event of this type?
+    if (propertyIndex < previousProperties.Size() && HasSameBitsWritten(propertyBits, previousProperties[propertyIndex]))
+    {
+      // Write unchanged flag only
+      bitStream.Write(true);
+    }
+    else
+    {
+      // Write changed flag and property value
+      bitStream.Write(false);
+      bitStream.AppendAll(propertyBits);
+
+      // Remember property value for the next event of this type
+      if (propertyIndex < previousProperties.Size())
+        previousProperties[propertyIndex] = propertyBits;
+      else
+        previousProperties.PushBack(propertyBits);
+    }
+
+    ++propertyIndex;
+  }
+
+  // Success
+  return true;
+}
+void NetEventTable::UndoLastEvent()
+{
+  // Nothing to undo?
+  if (!mCanUndo)
+    return;
+  mCanUndo = false;
+
+  // Forget strings interned by the last event
+  while (mStrings.Size() > mUndoStringCount)
+  {
+    mStringIndices.Erase(mStrings.Back());
+    mStrings.PopBack();
+  }
+
+  // Restore the previous properties of the last event's type
+  if (!mUndoEventTypeName.Empty())
+  {
+    if (mUndoHadProperties)
+      mPreviousProperties[mUndoEventTypeName] = RaverieMove(mUndoProperties);
+    else
+      mPreviousProperties.Erase(mUndoEventTypeName);
+  }
+
+  mResetPending = mUndoResetPending;
+  mUndoEventTypeName = String();
+  mUndoProperties.Clear();
+}
+HandleOf<Event> NetEventTable::ReadEvent(const BitStreamExtended& bitStream, GameSession* gameSession)
+{
+  // Get NetPeer (if available)
+  NetPeer* netPeer = gameSession->has(NetPeer);
+
+  // Read reset flag
+  bool reset = false;
+  if (!bitStream.Read(reset)) // Unable?
+  {
+    Assert(false);
+    return nullptr;
+  }
+
+  // Remote table was reset before this event?
+  if (reset)
+  {
+    // Reset to match
+    Clear();
+    mAwaitingReset = false;
+  }
+  // Awaiting reset?
+  else if (mAwaitingReset)
+  {
+    // Drop event
+    // (Written against table state we no longer have)
+    return nullptr;
+  }
+
+  // Read event type name
+  String eventTypeName;
+  if (!ReadString(bitStream, eventTypeName)) // Unable?
+  {
+    Assert(false);
+    return nullptr;
+  }
+
+  // Get event type
+  BoundType* eventType = MetaDatabase::GetInstance()->FindType(eventTypeName);
+  if (!eventType)
+  {
+    Assert(false);
+    return nullptr;
+  }
+
+  // Create event
+  HandleOf<Event> eventHandle = ExecutableState::CallingState->AllocateDefaultConstructed<Event>(eventType);
+  Event* event = eventHandle;
+  if (!event) // Unable?
+  {
+    Assert(false);
+    return nullptr;
+  }
+
+  // Read event ID
+  if (!ReadString(bitStream, event->EventId)) // Unable?
+  {
+    Assert(false);
+    return nullptr;
+  }
+
+  // Get the net property values of the previous event of this type
+  Array<BitStream>& previousProperties = mPreviousProperties[eventTypeName];
+
+  //
+  // Read Properties
+  //
+
+  // For all serialized properties
+  uint propertyIndex = 0;
+  MemberRange<Property> properties = eventType->GetProperties(Members::InheritedInstanceExtension);
+  forRange (Property* property, properties)
+  {
+    if (!BitStreamExtended::IsSerializedEventProperty(property))
+      continue;
+
+    // Read unchanged flag
+    bool unchanged = false;
+    if (!bitStream.Read(unchanged)) // Unable?
+    {
+      Assert(false);
+      return nullptr;
+    }
+
+    // Unchanged since the previous event of this type?
+    if (unchanged)
+    {
+      // (Previous value should have been received)
+      if (propertyIndex >= previousProperties.Size())
+      {
+        Assert(false);
+        return nullptr;
+      }
+
+      // Read property value from the previous event
+      BitStreamExtended propertyBits(previousProperties[propertyIndex]);
+      if (!propertyBits.ReadEventProperty(property, event, netPeer)) // Unable?
+        return nullptr;
+    }
+    else
+    {
+      // Read property value
+      Bits propertyStart = bitStream.GetBitsRead();
+      if (!bitStream.ReadEventProperty(property, event, netPeer)) // Unable?
+        return nullptr;
+      Bits propertyEnd = bitStream.GetBitsRead();
+
+      // Remember property value for the next event of this type
+      BitStream propertyBits;
+      bitStream.SetBitsRead(propertyStart);
+      propertyBits.Append(bitStream, propertyEnd - propertyStart);
+      Assert(bitStream.GetBitsRead() == propertyEnd);
+
+      if (propertyIndex < previousProperties.Size())
+        previousProperties[propertyIndex] = RaverieMove(propertyBits);
+      else
+        previousProperties.PushBack(RaverieMove(propertyBits));
+    }
+
+    ++propertyIndex;
+  }
+
+  // Success
+  return event;
+}
+
+void NetEventTable::Reset()
+{
+  Clear();
+  mResetPending = true;
+}
+void NetEventTable::AwaitReset()
+{
+  Clear();
+  mAwaitingReset = true;
+}
+bool NetEventTable::IsAwaitingReset() const
+{
+  return mAwaitingReset;
+}
+
+uint NetEventTable::GetStringCount() const
+{
+  return mStrings.Size();
+}
+
+void NetEventTable::Clear()
+{
+  mStringIndices.Clear();
+  mStrings.Clear();
+  mPreviousProperties.Clear();
+
+  // (Undoing past a clear would leave the table out of sync)
+  mCanUndo = false;
+  mUndoEventTypeName = String();
+  mUndoProperties.Clear();
+}
+
+void NetEventTable::BeginUndo()
+{
+  mCanUndo = true;
+  mUndoStringCount = mStrings.Size();
+  mUndoResetPending = mResetPending;
+  mUndoEventTypeName = String();
+  mUndoProperties.Clear();
+  mUndoHadProperties = false;
+}
+void NetEventTable::BeginUndoProperties(StringParam eventTypeName)
+{
+  mUndoEventTypeName = eventTypeName;
+
+  // (Bitstreams share their data until written, so this copy is cheap)
+  Array<BitStream>* previousProperties = mPreviousProperties.FindPointer(eventTypeName);
+  mUndoHadProperties = (previousProperties != nullptr);
+  if (previousProperties)
+    mUndoProperties = *previousProperties;
+}
+
+void NetEventTable::WriteString(BitStreamExtended& bitStream, StringParam value)
+{
+  // Already interned?
+  if (uint* index = mStringIndices.FindPointer(value))
+  {
+    // Write interned flag and table index
+    bitStream.Write(true);
+    bitStream.WriteQuantized(*index, uint(0), NetEventTableMaxStrings - 1);
+    return;
+  }
+
+  // Write full string
+  bitStream.Write(false);
+  bitStream.Write(value);
+
+  // Intern string (if there's room)
+  if (mStrings.Size() < NetEventTableMaxStrings)
+  {
+    mStringIndices.Insert(value, mStrings.Size());
+    mStrings.PushBack(value);
+  }
+}
+bool NetEventTable::ReadString(const BitStreamExtended& bitStream, String& value)
+{
+  // Read interned flag
+  bool interned = false;
+  if (!bitStream.Read(interned)) // Unable?
+    return false;
+
+  // Interned?
+  if (interned)
+  {
+    // Read table index
+    uint index = 0;
+    if (!bitStream.ReadQuantized(index, uint(0), NetEventTableMaxStrings - 1)) // Unable?
+      return false;
+
+    // (Index should have been interned)
+    if (index >= mStrings.Size())
+      return false;
+
+    value = mStrings[index];
+    return true;
+  }
+
+  // Read full string
+  if (!bitStream.Read(value)) // Unable?
+    return false;
+
+  // Intern string (if there's room)
+  if (mStrings.Size() < NetEventTableMaxStrings)
+  {
+    mStringIndices.Insert(value, mStrings.Size());
+    mStrings.PushBack(value);
+  }
+
+  return true;
+}
+
+} // namespace Raverie
@@ -0,0 +1,85 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Raverie
+{
+
+/// Maximum number of strings interned by a net event table.
+/// (Strings beyond this are always written in full)
+static const uint NetEventTableMaxStrings = 1024;
+
+//                                NetEventTable //
+
+/// Compresses net events sent in one direction over a single link.
+/// Event type names and event IDs are interned the first time they are sent,
+/// after which they are written as small table indices. Net properties that are
+/// unchanged since the previous event of the same type are written as a single
+/// bit. Requires both ends to process the same net events in the same order,
+/// which the link's reliable, ordered command channel guarantees. A written
+/// event that is never sent must be undone, and a table that fails to read an
+/// event must be reset on both ends before reading any more.
+class NetEventTable
+{
+public:
+  /// Constructor.
+  NetEventTable();
+
+  /// Writes the net event to the bitstream (updating the table).
+  /// Returns true if successful, else false.
+  bool WriteEvent(BitStreamExtended& bitStream, Event* event);
+  /// Undoes the table changes made by the last written event.
+  /// (Used when the event could not be sent, so the remote table never sees it)
+  void UndoLastEvent();
+
+  /// Reads a net event from the bitstream (updating the table).
+  /// Returns a new event if successful, else nullptr (including while awaiting
+  /// a reset, in which case the event is dropped).
+  HandleOf<Event> ReadEvent(const BitStreamExtended& bitStream, GameSession* gameSession);
+
+  /// [Outgoing] Clears the table, and tells the remote table to clear itself
+  /// with the next written event.
+  void Reset();
+  /// [Incoming] Clears the table, and drops every event until one written after
+  /// the remote table was reset arrives.
+  void AwaitReset();
+  /// [Incoming] Returns true if events are being dropped until the remote table
+  /// is reset, else false.
+  bool IsAwaitingReset() const;
+
+  /// Returns the number of strings interned.
+  uint GetStringCount() const;
+
+  /// Removes every interned string and previous event.
+  void Clear();
+
+private:
+  /// Writes the string as a table index if interned, else in full (interning
+  /// it if there's room).
+  void WriteString(BitStreamExtended& bitStream, StringParam value);
+  /// Reads a string written by WriteString (interning it if there's room).
+  /// Returns true if successful, else false.
+  bool ReadString(const BitStreamExtended& bitStream, String& value);
+
+  /// Remembers the table state before the current event changes it.
+  void BeginUndo();
+  /// Remembers the previous properties of the current event's type before
+  /// they change.
+  void BeginUndoProperties(StringParam eventTypeName);
+
+  // Data
+  HashMap<String, uint> mStringIndices;                  ///< Interned string indices.
+  Array<String> mStrings;                                ///< Interned strings by index.
+  HashMap<String, Array<BitStream>> mPreviousProperties; ///< Serialized net property values of the previous event, by event type name.
+  bool mResetPending;                                    ///< [Outgoing] Next event tells the remote table to reset?
+  bool mAwaitingReset;                                   ///< [Incoming] Dropping events until the remote table resets?
+
+  // Undo Data
+  bool mCanUndo;                    ///< Has table state from before the last event?
+  uint mUndoStringCount;            ///< Interned string count before the last event.
+  bool mUndoResetPending;           ///< Reset pending before the last event?
+  String mUndoEventTypeName;        ///< Event type name of the last event (if its properties were reached).
+  Array<BitStream> mUndoProperties; ///< Previous properties of that event type before the last event.
+  bool mUndoHadProperties;          ///< Had previous properties of that event type before the last event?
+};
+
+} // namespace Raverie
@@ -35,6 +35,8 @@ RaverieDefineType(NetObject, builder, type)
   RaverieBindGetterSetterProperty(DetectOutgoingChanges);
   RaverieBindGetterSetterProperty(AcceptIncomingChanges);
   RaverieBindGetterSetterProperty(AllowNapping);
+  RaverieBindGetterSetterProperty(AlwaysRelevant);
+  RaverieBindGetterSetterProperty(ChangePriority);
   RaverieBindGetterSetterProperty(AccurateTimestampOnOnline);
   RaverieBindGetterSetterProperty(AccurateTimestampOnChange);
   RaverieBindGetterSetterProperty(AccurateTimestampOnOffline);
@@ -91,7 +93,7 @@ RaverieDefineType(NetObject, builder, type)
   RaverieBindFieldProperty(mNetPropertyInfos);
 }
 
-NetObject::NetObject() : Replica(), Component(), mInitLevelResourceIdName(), mIsAncestor(false), mFamilyTreeId(0), mIsOnline(false), mNetUserOwnerUserId(0), mAutomaticChannel(), mNetPropertyInfos()
+NetObject::NetObject() : Replica(), Component(), mInitLevelResourceIdName(), mIsAncestor(false), mFamilyTreeId(0), mIsOnline(false), mNetUserOwnerUserId(0), mAlwaysRelevant(false), mAutomaticChannel(), mNetPropertyInfos()
 {
   ResetConfig();
 }
@@ -119,6 +121,8 @@ void NetObject::Serialize(Serializer& stream)
   SerializeNameDefault(mDetectOutgoingChanges, GetDetectOutgoingChanges());
   SerializeNameDefault(mAcceptIncomingChanges, GetAcceptIncomingChanges());
   SerializeNameDefault(mAllowNapping, GetAllowNapping());
+  SerializeNameDefault(mAlwaysRelevant, false);
+  SerializeNameDefault(mChangePriority, 1.0f);
   stream.SerializeFieldDefault("AccurateTimestampOnOnline", mAccurateTimestampOnInitialization, accurateTimestampsByDefault);
   SerializeNameDefault(mAccurateTimestampOnChange, accurateTimestampsByDefault);
   stream.SerializeFieldDefault("AccurateTimestampOnOffline", mAccurateTimestampOnUninitialization, accurateTimestampsByDefault);
@@ -1059,6 +1063,11 @@ void NetObject::HandleNetObjectOnline()
   // Set net object as online
   mIsOnline = true;
 
+  // Track net object in its net space's snapshot history
+  NetSpace* netSpace = GetNetSpace();
+  if (netSpace && IsClientOrServer())
+    netSpace->AddSnapshotNetObject(this);
+
   // Create event
   NetObjectOnline event;
   event.mGameSession = GetGameSession();
@@ -1154,6 +1163,10 @@ void NetObject::HandleNetObjectOffline()
     GetNetPeer()->RemoveNetObjectFromFamilyTree(this);
   }
 
+  // Stop tracking net object in its net space's snapshot history
+  if (netSpace)
+    netSpace->RemoveSnapshotNetObject(this);
+
   // Set net object as offline
   mIsOnline = false;
 }
@@ -1212,6 +1225,8 @@ void NetObject::ResetConfig()
   SetDetectOutgoingChanges();
   SetAcceptIncomingChanges();
   SetAllowNapping();
+  SetAlwaysRelevant();
+  SetChangePriority();
   SetAccurateTimestampOnOnline();
   SetAccurateTimestampOnChange();
   SetAccurateTimestampOnOffline();
@@ -1244,6 +1259,24 @@ bool NetObject::GetAllowNapping() const
   return Replica::GetAllowNapping();
 }
 
+void NetObject::SetAlwaysRelevant(bool alwaysRelevant)
+{
+  mAlwaysRelevant = alwaysRelevant;
+}
+bool NetObject::GetAlwaysRelevant() const
+{
+  return mAlwaysRelevant;
+}
+
+void NetObject::SetChangePriority(float changePriority)
+{
+  Replica::SetChangePriority(changePriority);
+}
+float NetObject::GetChangePriority() const
+{
+  return Replica::GetChangePriority();
+}
+
 void NetObject::SetAccurateTimestampOnOnline(bool accurateTimestampOnOnline)
 {
   Replica::SetAccurateTimestampOnInitialization(accurateTimestampOnOnline);
@@ -142,6 +142,18 @@ public:
   void SetAllowNapping(bool allowNapping = true);
   bool GetAllowNapping() const;
 
+  /// Controls whether or not the net object is relevant to every client
+  /// regardless of the net space's interest management settings (such as game
+  /// state objects that every client needs to see change).
+  void SetAlwaysRelevant(bool alwaysRelevant = false);
+  bool GetAlwaysRelevant() const;
+
+  /// Controls how strongly the net object competes for outgoing bandwidth
+  /// when a link has more changes due than it can send in a frame.
+  /// Higher values are sent sooner, lower values wait longer.
+  void SetChangePriority(float changePriority = 1);
+  float GetChangePriority() const;
+
   /// Controls whether or not the net object will serialize an accurate
   /// timestamp value when brought online, or will instead accept an estimated
   /// timestamp value.
@@ -439,6 +451,7 @@ public:
                                                 ///< to (either as an ancestor or descendant).
   bool mIsOnline;                               ///< Is online? (Between the NetObjectOnline/Offline scope?).
   NetUserId mNetUserOwnerUserId;                ///< User ID of our net user owner.
+  bool mAlwaysRelevant;                         ///< Relevant to every client regardless of interest management?
   HandleOf<NetChannelConfig> mAutomaticChannel; ///< Automatic net channel configuration resource
                                                 ///< applied to net properties by default.
   NetPropertyInfoArray mNetPropertyInfos;       ///< Net property infos added through
@@ -3439,7 +3439,7 @@ bool NetPeer::RemoveNetObjectFromFamilyTree(NetObject* netObject)
 // Internal
 //
 
-bool NetPeer::SerializeNetEvent(BitStreamExtended& bitStream, Event* netEvent, Cog* destination)
+bool NetPeer::SerializeNetEvent(BitStreamExtended& bitStream, Event* netEvent, Cog* destination, NetEventTable* netEventTable)
 {
   // Get destination net object ID
   // (Using ReplicaId to take advantage of WriteQuantized)
@@ -3452,9 +3452,11 @@ bool NetPeer::SerializeNetEvent(BitStreamExtended& bitStream, Event* netEvent, C
     return false;
 
   // Write event
+  if (netEventTable)
+    return netEventTable->WriteEvent(bitStream, netEvent);
   return bitStream.WriteEvent(netEvent);
 }
-bool NetPeer::DeserializeNetEvent(const BitStreamExtended& bitStream, Event*& netEvent, Cog*& destination, NetPeerId netPeerId)
+bool NetPeer::DeserializeNetEvent(const BitStreamExtended& bitStream, Event*& netEvent, Cog*& destination, NetPeerId netPeerId, NetEventTable* netEventTable)
 {
   // Read destination net object ID
   // (Using ReplicaId to take advantage of ReadQuantized)
@@ -3473,7 +3475,12 @@ bool NetPeer::DeserializeNetEvent(const BitStreamExtended& bitStream, Event*& ne
     destination = GetNetObject(destinationId.value());
 
   // Read event
-  netEvent = bitStream.ReadEvent(static_cast<GameSession*>(GetOwner()));
+  // (Always read, even without a destination, to keep the net event table in
+  // sync)
+  if (netEventTable)
+    netEvent = netEventTable->ReadEvent(bitStream, static_cast<GameSession*>(GetOwner()));
+  else
+    netEvent = bitStream.ReadEvent(static_cast<GameSession*>(GetOwner()));
   if (!netEvent) // Unable?
   {
     netEvent = nullptr;
@@ -3618,7 +3625,7 @@ bool NetPeer::DispatchLocalInternal(StringParam netEventId, Event* netEvent, Cog
   // Serialize net event
   netEvent->EventId = netEventId;
   BitStreamExtended bitStream;
-  if (!SerializeNetEvent(bitStream, netEvent, writeDestination)) // Unable?
+  if (!SerializeNetEvent(bitStream, netEvent, writeDestination, nullptr)) // Unable?
   {
     Assert(false);
     return false;
@@ -3633,7 +3640,7 @@ bool NetPeer::DispatchLocalInternal(StringParam netEventId, Event* netEvent, Cog
   // Deserialize net event
   Event* readNetEvent = nullptr;
   Cog* readDestination = nullptr;
-  if (!DeserializeNetEvent(bitStream, readNetEvent, readDestination, ourNetPeerId)) // Unable?
+  if (!DeserializeNetEvent(bitStream, readNetEvent, readDestination, ourNetPeerId, nullptr)) // Unable?
   {
     Assert(false);
     return false;
@@ -3674,15 +3681,6 @@ bool NetPeer::DispatchRemoteInternal(StringParam netEventId, Event* netEvent, Ne
   if (!ValidateNetEvent(netEventId, netEvent, TransmissionDirection::Outgoing))
     return false;
 
-  // Serialize net event
-  netEvent->EventId = netEventId;
-  BitStreamExtended bitStream;
-  if (!SerializeNetEvent(bitStream, netEvent, writeDestination)) // Unable?
-  {
-    Assert(false);
-    return false;
-  }
-
   // Get link
   PeerLink* link = Replicator::GetLink(netPeerId);
   if (!link) // Unable?
@@ -3691,6 +3689,17 @@ bool NetPeer::DispatchRemoteInternal(StringParam netEventId, Event* netEvent, Ne
     return false;
   }
 
+  // Serialize net event
+  netEvent->EventId = netEventId;
+  NetEventTable& netEventTable = link->GetUserData<NetLinkData>()->mOutgoingNetEventTable;
+  BitStreamExtended bitStream;
+  if (!SerializeNetEvent(bitStream, netEvent, writeDestination, &netEventTable)) // Unable?
+  {
+    Assert(false);
+    netEventTable.UndoLastEvent();
+    return false;
+  }
+
   // Create network event message
   Message netEventMessage(NetPeerMessageType::NetEvent, bitStream);
 
@@ -3699,6 +3708,9 @@ bool NetPeer::DispatchRemoteInternal(StringParam netEventId, Event* netEvent, Ne
   link->GetPlugin<ReplicatorLink>("ReplicatorLink")->Send(status, netEventMessage);
   if (status.Failed()) // Unable?
   {
+    // (The remote table will never see this event)
+    netEventTable.UndoLastEvent();
+
     Warn("Unable to net dispatch event - Error sending message (%s)", status.Message.c_str());
     return false;
   }
@@ -3731,30 +3743,44 @@ bool NetPeer::DispatchBroadcastInternal(StringParam netEventId, Event* netEvent,
   if (!ValidateNetEvent(netEventId, netEvent, TransmissionDirection::Outgoing))
     return false;
 
-  // Serialize net event
+  // Set event ID
   netEvent->EventId = netEventId;
-  BitStreamExtended bitStream;
-  if (!SerializeNetEvent(bitStream, netEvent, writeDestination)) // Unable?
-  {
-    Assert(false);
-    return false;
-  }
 
   // Get links
   PeerLinkSet links = Replicator::GetLinks();
+
+  // Serialize net event for every link before sending to any
+  // (Compressed separately for each link, against what that link has already
+  // received)
+  Array<BitStreamExtended> bitStreams;
+  bitStreams.Resize(links.Size());
+  for (size_t i = 0; i < links.Size(); ++i)
+  {
+    if (!SerializeNetEvent(bitStreams[i], netEvent, writeDestination, &links[i]->GetUserData<NetLinkData>()->mOutgoingNetEventTable)) // Unable?
+    {
+      Assert(false);
+
+      // Send to none of them
+      for (size_t j = 0; j <= i; ++j)
+        links[j]->GetUserData<NetLinkData>()->mOutgoingNetEventTable.UndoLastEvent();
+      return false;
+    }
+  }
+
   bool result = links.Empty();
   Status status;
-  forRange (PeerLink* link, links.All())
+  for (size_t i = 0; i < links.Size(); ++i)
   {
     // Get replicator link
+    PeerLink* link = links[i];
     ReplicatorLink* replicatorLink = link->GetPlugin<ReplicatorLink>("ReplicatorLink");
 
     // Create network event message
-    Message netEventMessage(NetPeerMessageType::NetEvent, bitStream);
+    Message netEventMessage(NetPeerMessageType::NetEvent, bitStreams[i]);
 
     // Send network event message
     Status linkSendStatus;
-    replicatorLink->Send(status, netEventMessage);
+    replicatorLink->Send(linkSendStatus, netEventMessage);
     if (linkSendStatus.Succeeded())
     {
       result = true;
@@ -3763,7 +3789,11 @@ bool NetPeer::DispatchBroadcastInternal(StringParam netEventId, Event* netEvent,
       HandleNetEventSent(netEvent, destination, replicatorLink->GetReplicatorId().value());
     }
     else
+    {
+      // (This link's remote table will never see this event)
+      link->GetUserData<NetLinkData>()->mOutgoingNetEventTable.UndoLastEvent();
       status.SetFailed(linkSendStatus.Message);
+    }
   }
   // At least one send succeeded?
   if (result)
@@ -4502,6 +4532,44 @@ void NetPeer::OnReplicaChannelPropertyChange(
   }
 }
 
+void NetPeer::OnReplicaChannelChangeReceiving(TimeMs timestamp, Replica* replica, ReplicaChannel* replicaChannel)
+{
+  // Get net object
+  NetObject* netObject = static_cast<NetObject*>(replica);
+
+  // Let the net space prepare the net object's snapshot history (if any)
+  if (NetSpace* netSpace = netObject->GetNetSpace())
+    netSpace->ClientOnReceivingChange(netObject);
+}
+void NetPeer::OnReplicaChannelChangeReceived(TimeMs timestamp, Replica* replica, ReplicaChannel* replicaChannel)
+{
+  // Get net object
+  NetObject* netObject = static_cast<NetObject*>(replica);
+
+  // Let the net space record the change in the net object's snapshot history
+  // (if any)
+  if (NetSpace* netSpace = netObject->GetNetSpace())
+    netSpace->ClientOnReceivedChange(netObject, replicaChannel, timestamp);
+}
+
+uint NetPeer::GetChangeInterval(ReplicatorLink* link, Replica* replica)
+{
+  // Only the server filters change replication by relevance
+  if (!IsServer())
+    return 1;
+
+  // Get net object
+  NetObject* netObject = static_cast<NetObject*>(replica);
+
+  // Not in a net space? (Such as the net peer itself)
+  NetSpace* netSpace = netObject->GetNetSpace();
+  if (!netSpace)
+    return 1;
+
+  // Let the net space decide
+  return netSpace->GetChangeInterval(link->GetReplicatorId().value(), netObject);
+}
+
 //
 // Replicator Link Interface
 //
@@ -4859,9 +4927,21 @@ bool NetPeer::ProcessReceivedCustomMessage(PeerLink* link, Message& message)
       // Deserialize net event
       Event* netEvent = nullptr;
       Cog* destination = nullptr;
-      if (!netPeer->DeserializeNetEvent(static_cast<BitStreamExtended&>(message.GetData()), netEvent, destination,
-                                        theirNetPeerId)) // Unable?
+      NetEventTable& netEventTable = link->GetUserData<NetLinkData>()->mIncomingNetEventTable;
+      if (!netPeer->DeserializeNetEvent(static_cast<BitStreamExtended&>(message.GetData()), netEvent, destination, theirNetPeerId, &netEventTable)) // Unable?
       {
+        // Not already awaiting a reset?
+        // (Our table may be partially updated by this event, so it can no
+        // longer read what the remote table writes)
+        if (!netEventTable.IsAwaitingReset())
+        {
+          // Reset both tables
+          netEventTable.AwaitReset();
+          Message resetMessage(NetPeerMessageType::NetEventTableReset);
+          Status status;
+          replicatorLink->Send(status, resetMessage);
+        }
+
         // Continue
         return true;
       }
@@ -4878,6 +4958,14 @@ bool NetPeer::ProcessReceivedCustomMessage(PeerLink* link, Message& message)
     }
     break;
 
+    case NetPeerMessageType::NetEventTableReset:
+    {
+      // Reset our outgoing table to match their incoming table
+      // (Tells their table the reset happened with our next net event)
+      link->GetUserData<NetLinkData>()->mOutgoingNetEventTable.Reset();
+    }
+    break;
+
     case NetPeerMessageType::NetUserAddRequest:
     {
       // Is server?
@@ -618,11 +618,13 @@ public:
   //
 
   /// Serializes the net event.
-  /// Returns true if successful, else false.
-  bool SerializeNetEvent(BitStreamExtended& bitStream, Event* netEvent, Cog* destination);
+  /// The event is compressed with the link's net event table if provided, else
+  /// written in full. Returns true if successful, else false.
+  bool SerializeNetEvent(BitStreamExtended& bitStream, Event* netEvent, Cog* destination, NetEventTable* netEventTable);
   /// Deserializes the net event.
-  /// Returns true if successful, else false.
-  bool DeserializeNetEvent(const BitStreamExtended& bitStream, Event*& netEvent, Cog*& destination, NetPeerId netPeerId);
+  /// The event is decompressed with the link's net event table if provided,
+  /// else read in full. Returns true if successful, else false.
+  bool DeserializeNetEvent(const BitStreamExtended& bitStream, Event*& netEvent, Cog*& destination, NetPeerId netPeerId, NetEventTable* netEventTable);
 
   /// Handles behavior when a dispatched net event is sent.
   void HandleNetEventSent(Event* netEvent, Cog* destination, NetPeerId netPeerId);
@@ -703,6 +705,17 @@ public:
   void OnReplicaChannelPropertyChange(
       TimeMs timestamp, ReplicationPhase::Enum replicationPhase, Replica* replica, ReplicaChannel* replicaChannel, ReplicaProperty* replicaProperty, TransmissionDirection::Enum direction) override;
 
+  /// Called before an accepted incoming replica channel change is read.
+  void OnReplicaChannelChangeReceiving(TimeMs timestamp, Replica* replica, ReplicaChannel* replicaChannel) override;
+  /// Called after an incoming replica channel change has been read, if any of
+  /// its properties changed.
+  void OnReplicaChannelChangeReceived(TimeMs timestamp, Replica* replica, ReplicaChannel* replicaChannel) override;
+
+  /// Returns how often, in frames, changes to the replica should be sent over
+  /// the specified link (determined by the net space's interest management
+  /// settings).
+  uint GetChangeInterval(ReplicatorLink* link, Replica* replica) override;
+
   //
   // Replicator Link Interface
   //
@@ -918,7 +931,9 @@ public:
   /// Constructor.
   NetLinkData();
 
-  // TODO: Use this or remove it
+  // Data
+  NetEventTable mOutgoingNetEventTable; ///< Compresses net events sent to the remote peer.
+  NetEventTable mIncomingNetEventTable; ///< Decompresses net events received from the remote peer.
 };
 
 } // namespace Raverie
@@ -0,0 +1,229 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Raverie
+{
+
+//                              NetObjectSnapshot //
+
+NetObjectSnapshot::NetObjectSnapshot() : mNetObjectId(0), mTranslation(Vec3::cZero), mRotation(Quat::cIdentity), mScale(1, 1, 1)
+{
+}
+NetObjectSnapshot::NetObjectSnapshot(NetObjectId netObjectId, Transform* transform) :
+    mNetObjectId(netObjectId),
+    mTranslation(transform->GetTranslation()),
+    mRotation(transform->GetRotation()),
+    mScale(transform->GetScale())
+{
+}
+
+bool NetObjectSnapshot::operator==(NetObjectId rhs) const
+{
+  return mNetObjectId == rhs;
+}
+bool NetObjectSnapshot::operator<(NetObjectId rhs) const
+{
+  return mNetObjectId < rhs;
+}
+
+bool NetObjectSnapshot::HasSameTransform(const NetObjectSnapshot& rhs) const
+{
+  return mTranslation == rhs.mTranslation && mRotation == rhs.mRotation && mScale == rhs.mScale;
+}
+
+void NetObjectSnapshot::ApplyTo(Transform* transform) const
+{
+  transform->SetTranslation(mTranslation);
+  transform->SetRotation(mRotation);
+  transform->SetScale(mScale);
+}
+
+//                              NetSpaceSnapshot //
+
+NetSpaceSnapshot::NetSpaceSnapshot() : mTimestamp(0), mNetObjects()
+{
+}
+
+const NetObjectSnapshot* NetSpaceSnapshot::FindNetObject(NetObjectId netObjectId) const
+{
+  size_t index = LowerBound(netObjectId);
+
+  // Not found?
+  if (index == mNetObjects.Size() || !(mNetObjects[index] == netObjectId))
+    return nullptr;
+
+  return &mNetObjects[index];
+}
+
+void NetSpaceSnapshot::SetNetObject(const NetObjectSnapshot& netObjectSnapshot)
+{
+  size_t index = LowerBound(netObjectSnapshot.mNetObjectId);
+
+  // Already holds this net object?
+  if (index < mNetObjects.Size() && mNetObjects[index] == netObjectSnapshot.mNetObjectId)
+    mNetObjects[index] = netObjectSnapshot;
+  else
+    mNetObjects.InsertAt(index, netObjectSnapshot);
+}
+
+size_t NetSpaceSnapshot::LowerBound(NetObjectId netObjectId) const
+{
+  // Binary search the sorted net object snapshots
+  size_t begin = 0;
+  size_t end = mNetObjects.Size();
+  while (begin < end)
+  {
+    size_t middle = (begin + end) / 2;
+    if (mNetObjects[middle] < netObjectId)
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+
+  return begin;
+}
+
+//                             NetSnapshotHistory //
+
+NetSnapshotHistory::NetSnapshotHistory() : mSnapshots(), mCapacity(0), mOldest(0), mCount(0)
+{
+}
+
+void NetSnapshotHistory::SetCapacity(uint capacity)
+{
+  mCapacity = capacity;
+  Clear();
+}
+uint NetSnapshotHistory::GetCapacity() const
+{
+  return mCapacity;
+}
+
+uint NetSnapshotHistory::GetCount() const
+{
+  return mCount;
+}
+const NetSpaceSnapshot& NetSnapshotHistory::GetSnapshot(uint index) const
+{
+  Assert(index < mCount);
+  return mSnapshots[(mOldest + index) % mCapacity];
+}
+const NetSpaceSnapshot* NetSnapshotHistory::GetNewest() const
+{
+  if (mCount == 0)
+    return nullptr;
+
+  return &GetSnapshot(mCount - 1);
+}
+
+void NetSnapshotHistory::Clear()
+{
+  mSnapshots.Clear();
+  mOldest = 0;
+  mCount = 0;
+}
+
+NetSpaceSnapshot& NetSnapshotHistory::Record(TimeMs timestamp)
+{
+  Assert(mCapacity != 0);
+
+  // Keep timestamps in order
+  if (const NetSpaceSnapshot* newest = GetNewest())
+    timestamp = Math::Max(timestamp, newest->mTimestamp);
+
+  // Get the next slot in the ring buffer
+  NetSpaceSnapshot* snapshot = nullptr;
+  if (mSnapshots.Size() < mCapacity)
+  {
+    // Grow until we reach capacity
+    snapshot = &mSnapshots.PushBack();
+    ++mCount;
+  }
+  else
+  {
+    // Replace the oldest snapshot
+    snapshot = &mSnapshots[mOldest];
+    mOldest = (mOldest + 1) % mCapacity;
+  }
+
+  // (Clearing keeps the capacity of the net object array from the reused
+  // snapshot)
+  snapshot->mTimestamp = timestamp;
+  snapshot->mNetObjects.Clear();
+  return *snapshot;
+}
+
+void NetSnapshotHistory::Record(TimeMs timestamp, const NetObjectSnapshot& netObjectSnapshot)
+{
+  // Not newer than the newest snapshot?
+  // (Several net objects usually change at the same time)
+  if (mCount != 0)
+  {
+    NetSpaceSnapshot& newest = mSnapshots[(mOldest + mCount - 1) % mCapacity];
+    if (timestamp <= newest.mTimestamp)
+    {
+      newest.SetNetObject(netObjectSnapshot);
+      return;
+    }
+  }
+
+  Record(timestamp).mNetObjects.PushBack(netObjectSnapshot);
+}
+
+bool NetSnapshotHistory::Sample(NetObjectId netObjectId, TimeMs timestamp, NetObjectSnapshot& result) const
+{
+  // Find the newest snapshot at or before the timestamp
+  // (Binary search over the ring buffer in time order)
+  uint begin = 0;
+  uint end = mCount;
+  while (begin < end)
+  {
+    uint middle = (begin + end) / 2;
+    if (GetSnapshot(middle).mTimestamp <= timestamp)
+      begin = middle + 1;
+    else
+      end = middle;
+  }
+
+  // Find the nearest snapshots on either side of the timestamp holding the net
+  // object
+  uint beforeIndex = begin;
+  const NetObjectSnapshot* before = nullptr;
+  while (!before && beforeIndex > 0)
+    before = GetSnapshot(--beforeIndex).FindNetObject(netObjectId);
+
+  uint afterIndex = begin;
+  const NetObjectSnapshot* after = nullptr;
+  for (; afterIndex < mCount; ++afterIndex)
+  {
+    after = GetSnapshot(afterIndex).FindNetObject(netObjectId);
+    if (after)
+      break;
+  }
+
+  // Only one side available?
+  // (Before the net object appeared, after it disappeared, or outside of the
+  // history)
+  if (!before || !after)
+  {
+    const NetObjectSnapshot* nearest = before ? before : after;
+    if (!nearest)
+      return false;
+
+    result = *nearest;
+    return true;
+  }
+
+  // Interpolate between the two snapshots
+  TimeMs beforeTimestamp = GetSnapshot(beforeIndex).mTimestamp;
+  TimeMs afterTimestamp = GetSnapshot(afterIndex).mTimestamp;
+  float t = float(timestamp - beforeTimestamp) / float(afterTimestamp - beforeTimestamp);
+
+  result.mNetObjectId = netObjectId;
+  result.mTranslation = Math::Lerp(before->mTranslation, after->mTranslation, t);
+  result.mRotation = Math::Slerp(before->mRotation, after->mRotation, t);
+  result.mScale = Math::Lerp(before->mScale, after->mScale, t);
+  return true;
+}
+
+} // namespace Raverie
@@ -0,0 +1,107 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Raverie
+{
+
+//                              NetObjectSnapshot //
+
+/// The local transform of a net object at one point in time.
+struct NetObjectSnapshot
+{
+  /// Constructors.
+  NetObjectSnapshot();
+  NetObjectSnapshot(NetObjectId netObjectId, Transform* transform);
+
+  /// Comparison Operators (compares net object IDs).
+  bool operator==(NetObjectId rhs) const;
+  bool operator<(NetObjectId rhs) const;
+
+  /// Returns true if the transform values are identical, else false.
+  bool HasSameTransform(const NetObjectSnapshot& rhs) const;
+
+  /// Writes the snapshot's values to the transform.
+  void ApplyTo(Transform* transform) const;
+
+  // Data
+  NetObjectId mNetObjectId; ///< Net object the snapshot was taken of.
+  Vec3 mTranslation;        ///< Local translation.
+  Quat mRotation;           ///< Local rotation.
+  Vec3 mScale;              ///< Local scale.
+};
+
+//                              NetSpaceSnapshot //
+
+/// The transforms of every tracked net object in a net space at one point in
+/// time.
+struct NetSpaceSnapshot
+{
+  /// Constructor.
+  NetSpaceSnapshot();
+
+  /// Returns the snapshot of the specified net object, else nullptr.
+  const NetObjectSnapshot* FindNetObject(NetObjectId netObjectId) const;
+  /// Adds the net object snapshot, replacing any existing snapshot of the same
+  /// net object (keeps net object snapshots sorted by ID).
+  void SetNetObject(const NetObjectSnapshot& netObjectSnapshot);
+  /// Returns the index of the first net object snapshot not ordered before the
+  /// specified net object ID.
+  size_t LowerBound(NetObjectId netObjectId) const;
+
+  // Data
+  TimeMs mTimestamp;                    ///< Time the snapshot was taken at.
+  Array<NetObjectSnapshot> mNetObjects; ///< Net object snapshots (sorted by net object ID).
+};
+
+//                             NetSnapshotHistory //
+
+/// A fixed capacity ring buffer of net space snapshots ordered by timestamp.
+/// Once full, recording a new snapshot replaces the oldest one (reusing its
+/// memory). Transforms can be sampled at any time within the history, which
+/// is used to interpolate remote net objects and to rewind queries.
+/// A snapshot need not hold every net object (clients only record the net
+/// objects changed at that time), sampling uses the nearest snapshots that
+/// hold the net object.
+class NetSnapshotHistory
+{
+public:
+  /// Constructor.
+  NetSnapshotHistory();
+
+  /// Number of snapshots kept (clears the history when changed).
+  void SetCapacity(uint capacity);
+  uint GetCapacity() const;
+
+  /// Returns the number of snapshots currently recorded.
+  uint GetCount() const;
+  /// Returns the snapshot at the specified index (0 is the oldest).
+  const NetSpaceSnapshot& GetSnapshot(uint index) const;
+  /// Returns the newest snapshot, else nullptr if nothing has been recorded.
+  const NetSpaceSnapshot* GetNewest() const;
+
+  /// Removes every snapshot.
+  void Clear();
+
+  /// Begins a new, empty snapshot at the specified timestamp and returns it so
+  /// it can be filled in (net object snapshots must be added in ID order).
+  /// Timestamps earlier than the newest snapshot's are clamped to it.
+  NetSpaceSnapshot& Record(TimeMs timestamp);
+  /// Records a single net object's snapshot at the specified timestamp.
+  /// Timestamps at or before the newest snapshot's are recorded into it.
+  void Record(TimeMs timestamp, const NetObjectSnapshot& netObjectSnapshot);
+
+  /// Samples the specified net object's transform at the specified timestamp,
+  /// interpolating between the snapshots on either side of it. Timestamps
+  /// outside of the history are clamped to it (there is no extrapolation).
+  /// Returns true if the net object was found in the history, else false.
+  bool Sample(NetObjectId netObjectId, TimeMs timestamp, NetObjectSnapshot& result) const;
+
+private:
+  // Data
+  Array<NetSpaceSnapshot> mSnapshots; ///< Snapshot ring buffer.
+  uint mCapacity;                     ///< Number of snapshots kept.
+  uint mOldest;                       ///< Index of the oldest snapshot in the ring buffer.
+  uint mCount;                        ///< Number of snapshots recorded.
+};
+
+} // namespace Raverie
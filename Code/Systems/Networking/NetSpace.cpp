@@ -25,16 +25,64 @@ RaverieDefineType(NetSpace, builder, type)
   // Bind space interface
   RaverieBindGetterProperty(NetObjectCount)->Add(new EditInGameFilter);
   RaverieBindGetterProperty(NetUserCount)->Add(new EditInGameFilter);
+
+  // Bind interest management interface
+  RaverieBindGetterSetterProperty(InterestManagement);
+  RaverieBindGetterSetterProperty(RelevanceRadius);
+  RaverieBindGetterSetterProperty(FullRateRadius);
+  RaverieBindGetterSetterProperty(MaxChangeInterval);
+
+  // Bind snapshot history interface
+  RaverieBindGetterSetterProperty(SnapshotHistory);
+  RaverieBindGetterSetterProperty(SnapshotCapacity);
+  RaverieBindGetterSetterProperty(InterpolationDelay);
+  RaverieBindOverloadedMethod(RewindCastRay, RaverieInstanceOverload(CastResultsRange, const Ray&, uint, float));
+  RaverieBindOverloadedMethod(RewindCastRay, RaverieInstanceOverload(CastResultsRange, const Ray&, uint, float, CastFilter&));
 }
 
-NetSpace::NetSpace() : NetObject(), mPendingNetObjects(), mPendingNetLevelStarted(false), mReadyChildMap(), mDelayedParentMap()
+NetSpace::NetSpace() :
+    NetObject(),
+    mPendingNetObjects(),
+    mPendingNetLevelStarted(false),
+    mReadyChildMap(),
+    mDelayedParentMap(),
+    mInterestManagement(false),
+    mRelevanceRadius(100),
+    mFullRateRadius(25),
+    mMaxChangeInterval(8),
+    mViewerFrameId(uint64(-1)),
+    mViewerPositions(),
+    mSnapshotHistory(false),
+    mSnapshotCapacity(64),
+    mInterpolationDelay(0.1f),
+    mSnapshots(),
+    mSnapshotNetObjects(),
+    mReceivedTransforms()
 {
+  mSnapshots.SetCapacity(mSnapshotCapacity);
 }
 
 //
 // Component Interface
 //
 
+void NetSpace::Serialize(Serializer& stream)
+{
+  // Serialize as net object
+  NetObject::Serialize(stream);
+
+  // Serialize interest management settings
+  SerializeNameDefault(mInterestManagement, false);
+  SerializeNameDefault(mRelevanceRadius, 100.0f);
+  SerializeNameDefault(mFullRateRadius, 25.0f);
+  SerializeNameDefault(mMaxChangeInterval, 8u);
+
+  // Serialize snapshot history settings
+  SerializeNameDefault(mSnapshotHistory, false);
+  SerializeNameDefault(mSnapshotCapacity, 64u);
+  SerializeNameDefault(mInterpolationDelay, 0.1f);
+}
+
 void NetSpace::Initialize(CogInitializer& initializer)
 {
   // Get owner
@@ -47,6 +95,9 @@ void NetSpace::Initialize(CogInitializer& initializer)
   // Initialize as net object
   NetObject::Initialize(initializer);
 
+  // Size the snapshot history
+  SetSnapshotCapacity(mSnapshotCapacity);
+
   // Connect event handlers
   ConnectThisTo(owner, Events::LevelStarted, OnLevelStarted);
 }
@@ -85,6 +136,10 @@ void NetSpace::ClientOnEngineUpdate(UpdateEvent* event)
     }
     mPendingNetLevelStarted = false;
   }
+
+  // Interpolate remote net objects
+  if (mSnapshotHistory)
+    ClientUpdateSnapshots();
 }
 void NetSpace::ServerOnEngineUpdate(UpdateEvent* event)
 {
@@ -172,6 +227,10 @@ void NetSpace::ServerOnEngineUpdate(UpdateEvent* event)
     }
     mPendingNetLevelStarted = false;
   }
+
+  // Record net object transforms for rewinding
+  if (mSnapshotHistory)
+    ServerRecordSnapshot();
 }
 void NetSpace::OfflineOnEngineUpdate(UpdateEvent* event)
 {
@@ -419,6 +478,337 @@ void NetSpace::ClearDelayedAttachments()
   mDelayedParentMap.Clear();
 }
 
+//
+// Interest Management Interface
+//
+
+void NetSpace::SetInterestManagement(bool interestManagement)
+{
+  mInterestManagement = interestManagement;
+}
+bool NetSpace::GetInterestManagement() const
+{
+  return mInterestManagement;
+}
+
+void NetSpace::SetRelevanceRadius(float relevanceRadius)
+{
+  mRelevanceRadius = Math::Max(relevanceRadius, 0.0f);
+}
+float NetSpace::GetRelevanceRadius() const
+{
+  return mRelevanceRadius;
+}
+
+void NetSpace::SetFullRateRadius(float fullRateRadius)
+{
+  mFullRateRadius = Math::Max(fullRateRadius, 0.0f);
+}
+float NetSpace::GetFullRateRadius() const
+{
+  return mFullRateRadius;
+}
+
+void NetSpace::SetMaxChangeInterval(uint maxChangeInterval)
+{
+  mMaxChangeInterval = Math::Max(maxChangeInterval, 1u);
+}
+uint NetSpace::GetMaxChangeInterval() const
+{
+  return mMaxChangeInterval;
+}
+
+uint NetSpace::GetChangeInterval(NetPeerId netPeerId, NetObject* netObject)
+{
+  // Interest management disabled?
+  if (!mInterestManagement)
+    return 1;
+
+  // Always relevant?
+  if (netObject->GetAlwaysRelevant() || netObject->IsNetSpace() || netObject->IsNetUser() || netObject->IsOwnedByPeer(netPeerId))
+    return 1;
+
+  // Not spatial?
+  Transform* transform = netObject->GetOwner()->has(Transform);
+  if (!transform)
+    return 1;
+
+  // Client has nothing to measure relevance from?
+  // (Such as before their net users have spawned anything, replicate
+  // everything as usual)
+  const Array<Vec3>& viewerPositions = GetViewerPositions(netPeerId);
+  if (viewerPositions.Empty())
+    return 1;
+
+  // Find the distance to the nearest viewer
+  Vec3 position = transform->GetWorldTranslation();
+  float nearestDistanceSq = Math::PositiveMax();
+  forRange (const Vec3& viewerPosition, viewerPositions.All())
+    nearestDistanceSq = Math::Min(nearestDistanceSq, Math::DistanceSq(position, viewerPosition));
+
+  // Beyond the relevance radius?
+  if (nearestDistanceSq > mRelevanceRadius * mRelevanceRadius)
+    return 0;
+
+  // Within the full rate radius?
+  float nearestDistance = Math::Sqrt(nearestDistanceSq);
+  if (nearestDistance <= mFullRateRadius || mRelevanceRadius <= mFullRateRadius)
+    return 1;
+
+  // Scale the interval up linearly towards the relevance radius
+  float t = (nearestDistance - mFullRateRadius) / (mRelevanceRadius - mFullRateRadius);
+  return 1 + uint(t * float(mMaxChangeInterval - 1) + 0.5f);
+}
+
+const Array<Vec3>& NetSpace::GetViewerPositions(NetPeerId netPeerId)
+{
+  // Get net peer
+  NetPeer* netPeer = GetNetPeer();
+
+  // New frame?
+  // (Viewers move, so gather their positions again)
+  uint64 frameId = netPeer->GetLocalFrameId();
+  if (frameId != mViewerFrameId)
+  {
+    mViewerPositions.Clear();
+    mViewerFrameId = frameId;
+  }
+
+  // Already gathered this frame?
+  Array<Vec3>* viewerPositions = mViewerPositions.FindPointer(netPeerId);
+  if (viewerPositions)
+    return *viewerPositions;
+
+  // Gather the positions of the net objects owned by the client's net users in
+  // this space
+  Space* space = GetSpace();
+  viewerPositions = &mViewerPositions.FindOrInsert(netPeerId);
+  forRange (Cog* netUserCog, netPeer->GetUsersAddedByPeer(netPeerId))
+  {
+    NetUser* netUser = netUserCog->has(NetUser);
+    if (!netUser)
+      continue;
+
+    forRange (Cog* cog, netUser->GetOwnedNetObjects())
+    {
+      // Not in this space?
+      if (cog->GetSpace() != space)
+        continue;
+
+      if (Transform* transform = cog->has(Transform))
+        viewerPositions->PushBack(transform->GetWorldTranslation());
+    }
+  }
+
+  return *viewerPositions;
+}
+
+//
+// Snapshot History Interface
+//
+
+void NetSpace::SetSnapshotHistory(bool snapshotHistory)
+{
+  mSnapshotHistory = snapshotHistory;
+
+  // Start over from the current state
+  ResetSnapshots();
+}
+bool NetSpace::GetSnapshotHistory() const
+{
+  return mSnapshotHistory;
+}
+
+void NetSpace::SetSnapshotCapacity(uint snapshotCapacity)
+{
+  // (At least two snapshots are needed to interpolate)
+  mSnapshotCapacity = Math::Max(snapshotCapacity, 2u);
+  mSnapshots.SetCapacity(mSnapshotCapacity);
+  ResetSnapshots();
+}
+uint NetSpace::GetSnapshotCapacity() const
+{
+  return mSnapshotCapacity;
+}
+
+void NetSpace::SetInterpolationDelay(float interpolationDelay)
+{
+  mInterpolationDelay = Math::Max(interpolationDelay, 0.0f);
+}
+float NetSpace::GetInterpolationDelay() const
+{
+  return mInterpolationDelay;
+}
+
+const NetSnapshotHistory& NetSpace::GetSnapshots() const
+{
+  return mSnapshots;
+}
+
+CastResultsRange NetSpace::RewindCastRay(const Ray& worldRay, uint maxCount, float rewindTime)
+{
+  CastFilter filter;
+  return RewindCastRay(worldRay, maxCount, rewindTime, filter);
+}
+CastResultsRange NetSpace::RewindCastRay(const Ray& worldRay, uint maxCount, float rewindTime, CastFilter& filter)
+{
+  TimeMs now = GetNetPeer()->GetLocalTime();
+  return CastRayAtTime(worldRay, maxCount, now - FloatSecondsToTimeMs(rewindTime), filter);
+}
+CastResultsRange NetSpace::CastRayAtTime(const Ray& worldRay, uint maxCount, TimeMs timestamp, CastFilter& filter)
+{
+  PhysicsSpace* physicsSpace = GetOwner()->has(PhysicsSpace);
+  ReturnIf(physicsSpace == nullptr, CastResultsRange(), "Cannot cast a ray in a net space without a PhysicsSpace.");
+
+  // Nothing to rewind?
+  if (!mSnapshotHistory || mSnapshots.GetCount() == 0)
+    return physicsSpace->CastRay(worldRay, maxCount, filter);
+
+  // Rewind every tracked net object to where it was at the timestamp
+  // (Remembering where they are now so they can be put back afterwards)
+  Array<Transform*> rewoundTransforms;
+  Array<NetObjectSnapshot> presentTransforms;
+  forRange (NetObject* netObject, mSnapshotNetObjects.Values())
+  {
+    NetObjectSnapshot pastTransform;
+    if (!mSnapshots.Sample(netObject->GetNetObjectId(), timestamp, pastTransform))
+      continue;
+
+    Transform* transform = netObject->GetOwner()->has(Transform);
+    rewoundTransforms.PushBack(transform);
+    presentTransforms.PushBack(NetObjectSnapshot(netObject->GetNetObjectId(), transform));
+    pastTransform.ApplyTo(transform);
+  }
+
+  // Cast against the rewound state
+  // (Casting commits the moved colliders to the broad phase first)
+  CastResultsRange results = physicsSpace->CastRay(worldRay, maxCount, filter);
+
+  // Put everything back
+  for (size_t i = 0; i < rewoundTransforms.Size(); ++i)
+    presentTransforms[i].ApplyTo(rewoundTransforms[i]);
+  physicsSpace->FlushPhysicsQueue();
+
+  return results;
+}
+
+void NetSpace::AddSnapshotNetObject(NetObject* netObject)
+{
+  // Not a net object with a transform?
+  // (The net space itself is not tracked)
+  Transform* transform = netObject->GetOwner()->has(Transform);
+  if (netObject->IsNetSpace() || !transform)
+    return;
+
+  NetObjectId netObjectId = netObject->GetNetObjectId();
+  mSnapshotNetObjects.InsertOrAssign(netObjectId, netObject);
+
+  // Is client?
+  if (IsClient())
+  {
+    // The net object comes online with its initial received transform
+    NetObjectSnapshot received(netObjectId, transform);
+    mReceivedTransforms.InsertOrAssign(netObjectId, received);
+    if (mSnapshotHistory && netObject->IsClientButNotMine())
+      mSnapshots.Record(GetNetPeer()->GetLocalTime(), received);
+  }
+}
+void NetSpace::RemoveSnapshotNetObject(NetObject* netObject)
+{
+  NetObjectId netObjectId = netObject->GetNetObjectId();
+  mSnapshotNetObjects.EraseValue(netObjectId);
+  mReceivedTransforms.EraseValue(netObjectId);
+}
+
+void NetSpace::ResetSnapshots()
+{
+  mSnapshots.Clear();
+
+  // Is client with a snapshot history?
+  // (Start from the latest received transforms, so there is something to
+  // sample before the next change arrives)
+  if (mSnapshotHistory && GetNetPeer() && IsClient() && mSnapshots.GetCapacity() != 0)
+  {
+    TimeMs now = GetNetPeer()->GetLocalTime();
+    forRange (NetObjectSnapshot& received, mReceivedTransforms.Values())
+      mSnapshots.Record(now, received);
+  }
+}
+
+void NetSpace::ServerRecordSnapshot()
+{
+  // Record every tracked net object's current transform
+  // (Tracked net objects are kept sorted by ID, the order snapshots store them
+  // in)
+  NetSpaceSnapshot& snapshot = mSnapshots.Record(GetNetPeer()->GetLocalTime());
+  snapshot.mNetObjects.Reserve(mSnapshotNetObjects.Size());
+  forRange (NetObject* netObject, mSnapshotNetObjects.Values())
+    snapshot.mNetObjects.PushBack(NetObjectSnapshot(netObject->GetNetObjectId(), netObject->GetOwner()->has(Transform)));
+}
+
+void NetSpace::ClientOnReceivingChange(NetObject* netObject)
+{
+  // Not interpolating this net object?
+  if (!mSnapshotHistory || !netObject->IsClientButNotMine())
+    return;
+
+  // Not tracked?
+  NetObjectSnapshot* received = mReceivedTransforms.FindPointer(netObject->GetNetObjectId());
+  if (!received)
+    return;
+
+  // Put back the latest received transform in place of our interpolated one
+  // (Changes may only contain some of the transform's net properties, the rest
+  // must read as their last received values, not interpolated ones)
+  received->ApplyTo(netObject->GetOwner()->has(Transform));
+}
+void NetSpace::ClientOnReceivedChange(NetObject* netObject, ReplicaChannel* replicaChannel, TimeMs timestamp)
+{
+  // Not tracked?
+  NetObjectSnapshot* received = mReceivedTransforms.FindPointer(netObject->GetNetObjectId());
+  if (!received)
+    return;
+
+  // Did the change modify any of the net object's transform net properties?
+  bool transformChanged = false;
+  forRange (ReplicaProperty* replicaProperty, replicaChannel->GetReplicaProperties().All())
+  {
+    if (replicaProperty->HasChangedAtAll() && replicaProperty->GetName().StartsWith("Transform_"))
+    {
+      transformChanged = true;
+      break;
+    }
+  }
+  if (!transformChanged)
+    return;
+
+  // Remember the received transform
+  *received = NetObjectSnapshot(netObject->GetNetObjectId(), netObject->GetOwner()->has(Transform));
+
+  // Record it at the time it was changed
+  if (mSnapshotHistory && netObject->IsClientButNotMine())
+    mSnapshots.Record(timestamp, *received);
+}
+
+void NetSpace::ClientUpdateSnapshots()
+{
+  // Apply every remote net object's transform interpolated at the
+  // interpolation delay
+  TimeMs sampleTime = GetNetPeer()->GetLocalTime() - FloatSecondsToTimeMs(mInterpolationDelay);
+  forRange (NetObject* netObject, mSnapshotNetObjects.Values())
+  {
+    // Our own net objects are driven locally, not interpolated
+    if (!netObject->IsClientButNotMine())
+      continue;
+
+    NetObjectSnapshot sample;
+    if (!mSnapshots.Sample(netObject->GetNetObjectId(), sampleTime, sample))
+      continue;
+
+    sample.ApplyTo(netObject->GetOwner()->has(Transform));
+  }
+}
+
 //
 // Object Interface
 //
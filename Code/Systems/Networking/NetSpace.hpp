@@ -20,6 +20,8 @@ public:
   // Component Interface
   //
 
+  /// Serializes the component.
+  void Serialize(Serializer& stream) override;
   /// Initializes the component.
   void Initialize(CogInitializer& initializer) override;
 
@@ -66,6 +68,102 @@ public:
   /// [Client] Clears all delayed attachments.
   void ClearDelayedAttachments();
 
+  //
+  // Interest Management Interface
+  //
+
+  /// Controls whether or not the server only replicates net object changes to
+  /// the clients they are relevant to, sending changes to distant net objects
+  /// less often. Relevance is measured from the net objects owned by each
+  /// client's net users in this space. Net objects without a transform, net
+  /// users, and net objects owned by the client are always relevant.
+  void SetInterestManagement(bool interestManagement = false);
+  bool GetInterestManagement() const;
+
+  /// Distance from a client's nearest net user owned object beyond which net
+  /// objects are not relevant to that client (their changes are withheld until
+  /// they become relevant again).
+  void SetRelevanceRadius(float relevanceRadius = 100);
+  float GetRelevanceRadius() const;
+
+  /// Distance from a client's nearest net user owned object within which net
+  /// object changes are sent every frame. Beyond it, changes are sent less
+  /// often the further away the net object is.
+  void SetFullRateRadius(float fullRateRadius = 25);
+  float GetFullRateRadius() const;
+
+  /// Number of frames between change replication for net objects at the edge
+  /// of the relevance radius.
+  void SetMaxChangeInterval(uint maxChangeInterval = 8);
+  uint GetMaxChangeInterval() const;
+
+  /// [Server] Returns how often, in frames, changes to the net object should
+  /// be sent to the specified client (0 if the net object is not relevant to
+  /// the client).
+  uint GetChangeInterval(NetPeerId netPeerId, NetObject* netObject);
+
+  /// [Server] Returns the world positions of the net objects owned by the
+  /// specified client's net users in this space (gathered once per frame).
+  const Array<Vec3>& GetViewerPositions(NetPeerId netPeerId);
+
+  //
+  // Snapshot History Interface
+  //
+
+  /// Controls whether or not a history of net object transforms is recorded in
+  /// this space. The server records every frame so queries can be rewound to
+  /// where net objects were in the past (lag compensation). Clients record the
+  /// transform changes they receive and display remote net objects
+  /// interpolated between them, which keeps their motion smooth even when
+  /// changes are sent at a low rate.
+  void SetSnapshotHistory(bool snapshotHistory = false);
+  bool GetSnapshotHistory() const;
+
+  /// Number of snapshots kept in the history (the server records one per frame,
+  /// clients one per received change).
+  void SetSnapshotCapacity(uint snapshotCapacity = 64);
+  uint GetSnapshotCapacity() const;
+
+  /// [Client] How far in the past, in seconds, remote net objects are
+  /// displayed. Should cover the time between changes plus latency so there
+  /// is always a newer snapshot to interpolate towards.
+  void SetInterpolationDelay(float interpolationDelay = 0.1f);
+  float GetInterpolationDelay() const;
+
+  /// Returns the recorded snapshot history.
+  const NetSnapshotHistory& GetSnapshots() const;
+
+  /// [Server] Finds all colliders in the space that a ray hits, with net objects
+  /// rewound to where they were the given number of seconds ago. Returns up to
+  /// maxCount number of objects.
+  CastResultsRange RewindCastRay(const Ray& worldRay, uint maxCount, float rewindTime);
+  CastResultsRange RewindCastRay(const Ray& worldRay, uint maxCount, float rewindTime, CastFilter& filter);
+  /// [Server] Finds all colliders in the space that a ray hits, with net objects
+  /// rewound to where they were at the given local timestamp.
+  CastResultsRange CastRayAtTime(const Ray& worldRay, uint maxCount, TimeMs timestamp, CastFilter& filter);
+
+  /// Starts tracking the net object in the snapshot history (if it has a
+  /// transform). Called as the net object comes online.
+  void AddSnapshotNetObject(NetObject* netObject);
+  /// Stops tracking the net object in the snapshot history. Called as the net
+  /// object goes offline.
+  void RemoveSnapshotNetObject(NetObject* netObject);
+  /// Clears the snapshot history (clients start it over from the latest
+  /// received transforms).
+  void ResetSnapshots();
+
+  /// [Server] Records a snapshot of every tracked net object's transform.
+  void ServerRecordSnapshot();
+  /// [Client] Restores the net object's latest received transform before an
+  /// incoming change is read.
+  void ClientOnReceivingChange(NetObject* netObject);
+  /// [Client] Records the net object's received transform at the change's
+  /// timestamp, if the change modified it.
+  void ClientOnReceivedChange(NetObject* netObject, ReplicaChannel* replicaChannel, TimeMs timestamp);
+  /// [Client] Applies remote net object transforms interpolated at the
+  /// interpolation delay.
+  void ClientUpdateSnapshots();
+
   //
   // Object Interface
   //
@@ -85,6 +183,18 @@ public:
   bool mPendingNetLevelStarted;                                   ///< Delayed net level started event.
   ArrayMap<NetObjectId, NetObjectId> mReadyChildMap;              ///< Maps a ready child to a delayed parent.
   ArrayMap<NetObjectId, ArraySet<NetObjectId>> mDelayedParentMap; ///< Maps a delayed parent to ready children.
+  bool mInterestManagement;                                       ///< Filter change replication by relevance?
+  float mRelevanceRadius;                                         ///< Distance beyond which net objects are not relevant.
+  float mFullRateRadius;                                          ///< Distance within which changes are sent every frame.
+  uint mMaxChangeInterval;                                        ///< Change interval at the relevance radius.
+  uint64 mViewerFrameId;                                          ///< [Server] Frame the viewer positions were gathered on.
+  ArrayMap<NetPeerId, Array<Vec3>> mViewerPositions;              ///< [Server] Viewer positions for each client.
+  bool mSnapshotHistory;                                          ///< Record a net object transform history?
+  uint mSnapshotCapacity;                                         ///< Number of snapshots kept.
+  float mInterpolationDelay;                                      ///< [Client] Interpolation delay in seconds.
+  NetSnapshotHistory mSnapshots;                                  ///< Recorded net object transform history.
+  ArrayMap<NetObjectId, NetObject*> mSnapshotNetObjects;          ///< Online net objects the history tracks.
+  ArrayMap<NetObjectId, NetObjectSnapshot> mReceivedTransforms;   ///< [Client] Latest received transform of each tracked net object.
 };
 
 } // namespace Raverie
@@ -38,8 +38,28 @@ bool IsValidNetPeerIdPropertyType(Type* propertyType)
 
 //                                 Network Types //
 
-ComponentPropertyInstanceData::ComponentPropertyInstanceData(String propertyName, Component* component) : mPropertyName(propertyName), mComponent(component)
-{
+ComponentPropertyInstanceData::ComponentPropertyInstanceData(String propertyName, Component* component) :
+    mPropertyName(propertyName),
+    mComponent(component),
+    mProperty(nullptr),
+    mNativeType(nullptr),
+    mFieldData(nullptr)
+{
+  if (!component)
+    return;
+
+  // Get property instance
+  mProperty = RaverieVirtualTypeId(component)->GetProperty(propertyName);
+  if (!mProperty) // Unable?
+    return;
+
+  mNativeType = RaverieTypeToBasicNativeType(mProperty->PropertyType);
+
+  // Instance field?
+  // (Its value can be read in place, without calling the getter)
+  Field* field = Type::DynamicCast<Field*>(mProperty);
+  if (field && !field->IsStatic)
+    mFieldData = Handle(component).Dereference() + field->Offset;
 }
 
 //
@@ -200,12 +220,10 @@ void SetNetObjectParentProperty(const Variant& value, Variant& propertyData)
 Variant GetComponentCogProperty(const Variant& propertyData)
 {
   // Get associated property instance data
-  String propertyName = propertyData.GetOrError<ComponentPropertyInstanceData>().mPropertyName;
   Component* component = propertyData.GetOrError<ComponentPropertyInstanceData>().mComponent;
-  BoundType* componentBoundType = RaverieVirtualTypeId(component);
 
   // Get property instance
-  Property* property = componentBoundType->GetProperty(propertyName);
+  Property* property = propertyData.GetOrError<ComponentPropertyInstanceData>().mProperty;
   if (!property) // Unable?
     return Variant();
 
@@ -215,13 +233,11 @@ Variant GetComponentCogProperty(const Variant& propertyData)
 void SetComponentCogProperty(const Variant& value, Variant& propertyData)
 {
   // Get associated property instance data
-  String propertyName = propertyData.GetOrError<ComponentPropertyInstanceData>().mPropertyName;
   Component* component = propertyData.GetOrError<ComponentPropertyInstanceData>().mComponent;
-  BoundType* componentBoundType = RaverieVirtualTypeId(component);
   NetObject* netObject = component->GetOwner()->has(NetObject);
 
   // Get property instance
-  Property* property = componentBoundType->GetProperty(propertyName);
+  Property* property = propertyData.GetOrError<ComponentPropertyInstanceData>().mProperty;
   if (!property) // Unable?
     return;
 
@@ -236,12 +252,10 @@ void SetComponentCogProperty(const Variant& value, Variant& propertyData)
 Variant GetComponentCogPathProperty(const Variant& propertyData)
 {
   // Get associated property instance data
-  String propertyName = propertyData.GetOrError<ComponentPropertyInstanceData>().mPropertyName;
   Component* component = propertyData.GetOrError<ComponentPropertyInstanceData>().mComponent;
-  BoundType* componentBoundType = RaverieVirtualTypeId(component);
 
   // Get property instance
-  Property* property = componentBoundType->GetProperty(propertyName);
+  Property* property = propertyData.GetOrError<ComponentPropertyInstanceData>().mProperty;
   if (!property) // Unable?
     return Variant();
 
@@ -264,12 +278,10 @@ Variant GetComponentCogPathProperty(const Variant& propertyData)
 void SetComponentCogPathProperty(const Variant& value, Variant& propertyData)
 {
   // Get associated property instance data
-  String propertyName = propertyData.GetOrError<ComponentPropertyInstanceData>().mPropertyName;
   Component* component = propertyData.GetOrError<ComponentPropertyInstanceData>().mComponent;
-  BoundType* componentBoundType = RaverieVirtualTypeId(component);
 
   // Get property instance
-  Property* property = componentBoundType->GetProperty(propertyName);
+  Property* property = propertyData.GetOrError<ComponentPropertyInstanceData>().mProperty;
   if (!property) // Unable?
     return;
 
@@ -297,12 +309,10 @@ void SetComponentCogPathProperty(const Variant& value, Variant& propertyData)
 Variant GetComponentAnyProperty(const Variant& propertyData)
 {
   // Get associated property instance data
-  String propertyName = propertyData.GetOrError<ComponentPropertyInstanceData>().mPropertyName;
   Component* component = propertyData.GetOrError<ComponentPropertyInstanceData>().mComponent;
-  BoundType* componentBoundType = RaverieVirtualTypeId(component);
 
   // Get property instance
-  Property* property = componentBoundType->GetProperty(propertyName);
+  Property* property = propertyData.GetOrError<ComponentPropertyInstanceData>().mProperty;
   if (!property) // Unable?
     return Variant();
 
@@ -326,12 +336,10 @@ Variant GetComponentAnyProperty(const Variant& propertyData)
 void SetComponentAnyProperty(const Variant& value, Variant& propertyData)
 {
   // Get associated property instance data
-  String propertyName = propertyData.GetOrError<ComponentPropertyInstanceData>().mPropertyName;
   Component* component = propertyData.GetOrError<ComponentPropertyInstanceData>().mComponent;
-  BoundType* componentBoundType = RaverieVirtualTypeId(component);
 
   // Get property instance
-  Property* property = componentBoundType->GetProperty(propertyName);
+  Property* property = propertyData.GetOrError<ComponentPropertyInstanceData>().mProperty;
   if (!property) // Unable?
     return;
 
@@ -352,6 +360,40 @@ void SetComponentAnyProperty(const Variant& value, Variant& propertyData)
   // Set the property value
   property->SetValue(component, anyValue);
 }
+bool GetComponentAnyPropertyRaw(const Variant& propertyData, NativeType* nativeType, void* value)
+{
+  // Get associated property instance data
+  // (Property resolved when the net property was added)
+  const ComponentPropertyInstanceData& instanceData = propertyData.GetOrError<ComponentPropertyInstanceData>();
+  Property* property = instanceData.mProperty;
+
+  // The property's type is not the expected basic native type?
+  if (!property || instanceData.mNativeType != nativeType)
+    return false;
+
+  // Instance field?
+  if (instanceData.mFieldData)
+  {
+    // Copy the property value in place
+    memcpy(value, instanceData.mFieldData, nativeType->mTypeSize);
+    return true;
+  }
+
+  // Call the getter directly
+  // (Skips constructing an any of both the component and the value)
+  if (!property->Get || property->IsStatic)
+    return false;
+  Call call(property->Get);
+  call.SetHandle(Call::This, instanceData.mComponent);
+  ExceptionReport report;
+  call.Invoke(report);
+  if (report.HasThrownExceptions()) // Unable?
+    return false;
+
+  // Copy the property value
+  memcpy(value, call.GetReturnUnchecked(), nativeType->mTypeSize);
+  return true;
+}
 
 //
 // Helper Methods
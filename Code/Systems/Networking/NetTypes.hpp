@@ -80,11 +80,15 @@ typedef uint FamilyTreeId;
 struct ComponentPropertyInstanceData
 {
   /// Constructor.
+  /// Resolves the property once (the component's type outlives the component).
   ComponentPropertyInstanceData(String propertyName = String(), Component* component = nullptr);
 
   // Data
   String mPropertyName;
   Component* mComponent;
+  Property* mProperty;     ///< Component's property (else nullptr if not found).
+  NativeType* mNativeType; ///< Property's basic native type (else nullptr if not a basic native type).
+  const byte* mFieldData;  ///< Property's value within the component, if it is an instance field (else nullptr).
 };
 
 //
@@ -134,6 +138,8 @@ void SetComponentCogPathProperty(const Variant& value, Variant& propertyData);
 // Serialized Data Type: A Basic Native Type or Any
 Variant GetComponentAnyProperty(const Variant& propertyData);
 void SetComponentAnyProperty(const Variant& value, Variant& propertyData);
+// Raw Data Type: A Basic Arithmetic Native Type
+bool GetComponentAnyPropertyRaw(const Variant& propertyData, NativeType* nativeType, void* value);
 
 //
 // Helper Methods
@@ -178,7 +184,7 @@ static const NetUserAddResponse::Type NetUserAddResponseMax = NetUserAddResponse
 static const Bits NetUserAddResponseBits = BITS_NEEDED_TO_REPRESENT(NetUserAddResponseMax);
 
 /// NetPeer protocol message types.
-DeclareEnum12(NetPeerMessageType,
+DeclareEnum13(NetPeerMessageType,
               NetEvent,             /// Network dispatch event.
               NetUserAddRequest,    /// Network user add request.
               NetUserAddResponse,   /// Network user add response.
@@ -190,7 +196,8 @@ DeclareEnum12(NetPeerMessageType,
               NetHostPing,          /// Network host ping.
               NetHostPong,          /// Network host pong.
               NetHostRecordList,    /// Network host record list.
-              NetHostPublish);      ///< Network host publish.
+              NetHostPublish,       ///< Network host publish.
+              NetEventTableReset);  /// Network event table reset request.
 
 //
 // NetPeer Protocol Message Types
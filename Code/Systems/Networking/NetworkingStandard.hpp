@@ -63,6 +63,7 @@ class NetPeer;
 // NetPeer Includes
 #include "BitStreamExtended.hpp"
 #include "EventBundle.hpp"
+#include "NetEventTable.hpp"
 #include "NetHostRecord.hpp"
 #include "NetTypes.hpp"
 #include "NetEvents.hpp"
@@ -71,6 +72,7 @@ class NetPeer;
 #include "NetChannel.hpp"
 #include "NetObject.hpp"
 #include "NetUser.hpp"
+#include "NetSnapshot.hpp"
 #include "NetSpace.hpp"
 #include "NetPeerConnectionInterface.hpp"
 #include "NetPeerMessageInterface.hpp"
@@ -107,6 +107,58 @@ bool CollisionManager::ForceTestCollision(ColliderPair& pair, ManifoldArray& man
   return mInternals->mCollisionTable.Collide(pair.Top, pair.Bot, &manifolds);
 }
 
+bool CollisionManager::TestSpeculativeCollision(ColliderPair& pair, real dt, ManifoldArray& manifolds)
+{
+  Collider* collider1 = pair.Top;
+  Collider* collider2 = pair.Bot;
+
+  // Only simple convex shapes have support functions to compute distance with
+  if (collider1->GetColliderType() > Collider::cConvexMesh || collider2->GetColliderType() > Collider::cConvexMesh)
+    return false;
+  // Ghosts never resolve so there's nothing to gain from contacting early
+  if (collider1->GetGhost() || collider2->GetGhost())
+    return false;
+  if (!collider1->ShouldCollide(collider2))
+    return false;
+
+  Vec3 velocity1 = Vec3::cZero;
+  Vec3 velocity2 = Vec3::cZero;
+  if (RigidBody* body1 = collider1->GetActiveBody())
+    velocity1 = body1->mVelocity;
+  if (RigidBody* body2 = collider2->GetActiveBody())
+    velocity2 = body2->mVelocity;
+
+  // Nothing can close the gap if the bodies aren't moving relative to each other
+  Vec3 relativeVelocity = velocity1 - velocity2;
+  real maxApproach = Math::Length(relativeVelocity) * dt;
+  if (maxApproach == real(0.0))
+    return false;
+
+  Intersection::SupportShape a = collider1->GetSupportShape();
+  Intersection::SupportShape b = collider2->GetSupportShape();
+  Intersection::Gjk gjk;
+  Intersection::Manifold iManifold;
+  if (!gjk.ClosestPoints(&a, &b, &iManifold))
+    return false;
+
+  // Only keep the contact if the bodies are approaching along the normal and
+  // can cover the gap before the next iteration
+  real separation = -iManifold.Points[0].Depth;
+  real approachSpeed = Math::Dot(relativeVelocity, iManifold.Normal);
+  if (approachSpeed <= real(0.0) || separation > approachSpeed * dt)
+    return false;
+
+  ColliderPair manifoldPair;
+  manifoldPair.A = collider1;
+  manifoldPair.B = collider2;
+
+  Manifold* manifold = &manifolds.PushBack();
+  manifold->ContactId = 0;
+  manifold->SetPair(manifoldPair);
+  IntersectionToPhysicsManifoldFull(&iManifold, manifold);
+  return true;
+}
+
 bool CollisionManager::CollideShapes(Aabb& aabb, Collider* aabbCollider, Collider* otherCollider, Manifold* manifold)
 {
   return mInternals->mAabbLookups.Collide(aabb, aabbCollider, otherCollider, manifold);
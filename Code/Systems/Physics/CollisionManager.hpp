@@ -33,6 +33,10 @@ public:
   bool TestCollision(ColliderPair& pair, ManifoldArray& manifolds);
   // Tests collision, doesn't care about static or asleep objects when testing.
   bool ForceTestCollision(ColliderPair& pair, ManifoldArray& manifolds);
+  /// Generates a speculative contact for two separated convex colliders that
+  /// are closing fast enough to touch within dt. The contact has a negative
+  /// penetration equal to the current separation.
+  bool TestSpeculativeCollision(ColliderPair& pair, real dt, ManifoldArray& manifolds);
 
   // these two functions are not currently in use due to a refactor, however
   // they might become useful again when performing a collision test between
@@ -237,6 +237,10 @@ void Contact::ComputeMolecules(MoleculeWalker& fragments)
   real velocityThreshold = mSolver->mSolverConfig->mVelocityRestitutionThreshold;
   real baumgarte = GetLinearBaumgarte();
 
+  PhysicsSpace* space = GetCollider(0)->mSpace;
+  bool speculative = space->GetSpeculativeContacts();
+  real dt = space->mIterationDt;
+
   for (uint i = 0; i < contactCount; ++i)
   {
     ManifoldPoint& contact = mManifold->Contacts[i];
@@ -271,6 +275,11 @@ void Contact::ComputeMolecules(MoleculeWalker& fragments)
 
     ComputeContactFragments(this, fragments, 3, fragmentData, restitutionBias);
 
+    // A speculative contact isn't touching yet, so instead of pushing the
+    // bodies apart only let them approach by the remaining gap this step.
+    if (speculative && contact.Penetration < real(0.0))
+      fragments[0].mBias = -contact.Penetration / dt;
+
     fragments += 3;
   }
 }
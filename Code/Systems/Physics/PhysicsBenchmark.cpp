@@ -0,0 +1,195 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Raverie
+{
+
+namespace PhysicsBenchmarkPhases
+{
+
+// The profile records created by the timestep (see PhysicsSpace) along with
+// the key each one is reported under.
+const cstr cRecordNames[] = {"Velocity Integration", "BroadPhase", "NarrowPhase", "Islands", "PreSolveEvents", "ResolutionPhase", "Position Integration", "SolvePositions", "Iteration"};
+const cstr cKeys[] = {"integrateVelocity", "broadPhase", "narrowPhase", "islands", "preSolve", "solve", "integratePosition", "solvePositions", "total"};
+// The index of the phase each record's scope is nested in, or -1. A nested
+// phase's time is taken out of its parent's so no time is reported twice
+// (Islands runs inside NarrowPhase). The total is left inclusive.
+const int cParentIndices[] = {-1, -1, -1, 2, -1, -1, -1, -1, -1};
+const uint cCount = sizeof(cRecordNames) / sizeof(cstr);
+
+Profile::Record* FindRecord(cstr name)
+{
+  Array<Profile::Record*>::range records = Profile::ProfileSystem::Instance->GetRecords();
+  for (; !records.Empty(); records.PopFront())
+  {
+    if (records.Front()->GetName() == name)
+      return records.Front();
+  }
+  return nullptr;
+}
+
+Profile::ProfileTime GetTotalTime(cstr name)
+{
+  Profile::Record* record = FindRecord(name);
+  if (record == nullptr)
+    return 0;
+  return record->GetTotalTime();
+}
+
+} // namespace PhysicsBenchmarkPhases
+
+RaverieDefineType(PhysicsBenchmark, builder, type)
+{
+  RaverieBindDocumented();
+
+  RaverieBindMethod(CreateScene);
+  RaverieBindMethod(Run);
+}
+
+void PhysicsBenchmark::CreateScene(Space* space, PhysicsBenchmarkScene::Enum scene, int size)
+{
+  ReturnIf(space == nullptr, , "Cannot create a benchmark scene in a null space.");
+  ReturnIf(space->has(PhysicsSpace) == nullptr, , "Cannot create a benchmark scene in a space without a PhysicsSpace.");
+  size = Math::Max(size, 1);
+
+  // Every scene sits on the same large static ground box
+  Cog* ground = CreateBody(space, "BoxCollider", Vec3(0, -0.5f, 0), false);
+  ground->has(Transform)->SetScale(Vec3(1000, 1, 1000));
+
+  if (scene == PhysicsBenchmarkScene::BoxPyramid)
+    CreateBoxPyramid(space, size);
+  else if (scene == PhysicsBenchmarkScene::SphereRain)
+    CreateSphereRain(space, size);
+  else if (scene == PhysicsBenchmarkScene::JointChain)
+    CreateJointChain(space, size);
+  else if (scene == PhysicsBenchmarkScene::DebrisPile)
+    CreateDebrisPile(space, size);
+}
+
+String PhysicsBenchmark::Run(Space* space, int frames, float dt)
+{
+  ReturnIf(space == nullptr, String(), "Cannot run a benchmark in a null space.");
+  PhysicsSpace* physicsSpace = space->has(PhysicsSpace);
+  ReturnIf(physicsSpace == nullptr, String(), "Cannot run a benchmark in a space without a PhysicsSpace.");
+
+  using namespace PhysicsBenchmarkPhases;
+
+  // The records accumulate for the lifetime of the program so only report the
+  // time that was added while the benchmark ran
+  Profile::ProfileTime startTimes[cCount];
+  for (uint i = 0; i < cCount; ++i)
+    startTimes[i] = GetTotalTime(cRecordNames[i]);
+
+  Profile::ProfileTime startTime = Profile::ProfileSystem::Instance->GetTime();
+  for (int i = 0; i < frames; ++i)
+  {
+    UpdateEvent updateEvent(dt, dt, dt * i, dt * i);
+    physicsSpace->SystemLogicUpdate(&updateEvent);
+  }
+  Profile::ProfileTime elapsed = Profile::ProfileSystem::Instance->GetTime() - startTime;
+
+  JsonBuilder builder;
+  builder.Begin(JsonType::Object);
+  builder.Key("frames");
+  builder.Value(frames);
+  builder.Key("dt");
+  builder.Value((double)dt);
+  builder.Key("elapsedMs");
+  builder.Value(Profile::ProfileSystem::Instance->GetTimeInSeconds(elapsed) * 1000.0);
+
+  // Per phase totals in milliseconds, excluding the time of nested phases
+  Profile::ProfileTime times[cCount];
+  for (uint i = 0; i < cCount; ++i)
+    times[i] = GetTotalTime(cRecordNames[i]) - startTimes[i];
+  for (uint i = 0; i < cCount; ++i)
+  {
+    if (cParentIndices[i] != -1)
+      times[cParentIndices[i]] -= times[i];
+  }
+
+  builder.Key("phasesMs");
+  builder.Begin(JsonType::Object);
+  for (uint i = 0; i < cCount; ++i)
+  {
+    Profile::ProfileTime time = times[i];
+    builder.Key(cKeys[i]);
+    builder.Value(Profile::ProfileSystem::Instance->GetTimeInSeconds(time) * 1000.0);
+  }
+  builder.End();
+
+  builder.End();
+  return builder.ToString();
+}
+
+Cog* PhysicsBenchmark::CreateBody(Space* space, StringParam colliderName, Vec3Param position, bool dynamic)
+{
+  // Start from a bare transform so no graphical resources get involved
+  Cog* cog = space->CreateAt(CoreArchetypes::Transform, position);
+  cog->AddComponentByName(colliderName);
+  if (dynamic)
+    cog->AddComponentByName("RigidBody");
+  return cog;
+}
+
+void PhysicsBenchmark::CreateBoxPyramid(Space* space, int size)
+{
+  // A single pyramid of unit boxes with the given base width
+  for (int row = 0; row < size; ++row)
+  {
+    int count = size - row;
+    float startX = -0.5f * (count - 1);
+    for (int i = 0; i < count; ++i)
+      CreateBody(space, "BoxCollider", Vec3(startX + i, 0.5f + row, 0), true);
+  }
+}
+
+void PhysicsBenchmark::CreateSphereRain(Space* space, int size)
+{
+  // Spheres scattered over a volume above the ground that all fall at once.
+  // A fixed seed keeps every run of the scene identical.
+  Math::Random random(size);
+  float extent = Math::Sqrt(float(size));
+  for (int i = 0; i < size; ++i)
+  {
+    Vec3 position;
+    position.x = random.FloatRange(-extent, extent);
+    position.y = random.FloatRange(2.0f, 2.0f + extent * 2.0f);
+    position.z = random.FloatRange(-extent, extent);
+    CreateBody(space, "SphereCollider", position, true);
+  }
+}
+
+void PhysicsBenchmark::CreateJointChain(Space* space, int size)
+{
+  // A horizontal chain of boxes hanging from a static anchor that swings down
+  float height = float(size) + 2.0f;
+  Cog* previous = CreateBody(space, "BoxCollider", Vec3(0, height, 0), false);
+
+  JointCreator creator;
+  for (int i = 1; i <= size; ++i)
+  {
+    Vec3 position(float(i), height, 0);
+    Cog* link = CreateBody(space, "BoxCollider", position, true);
+    link->has(Transform)->SetScale(Vec3(0.5f));
+    creator.CreateWorldPoints(previous, link, "StickJoint", position - Vec3(1, 0, 0), position);
+    previous = link;
+  }
+}
+
+void PhysicsBenchmark::CreateDebrisPile(Space* space, int size)
+{
+  // Mixed shapes dropped in a column so they settle into a pile, which is
+  // mostly narrow phase and island cost
+  cstr colliders[] = {"BoxCollider", "SphereCollider", "CapsuleCollider", "CylinderCollider"};
+  Math::Random random(size);
+  for (int i = 0; i < size; ++i)
+  {
+    Vec3 position;
+    position.x = random.FloatRange(-2.0f, 2.0f);
+    position.y = 1.0f + i * 0.5f;
+    position.z = random.FloatRange(-2.0f, 2.0f);
+    CreateBody(space, colliders[i % 4], position, true);
+  }
+}
+
+} // namespace Raverie
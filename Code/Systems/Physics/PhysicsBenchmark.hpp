@@ -0,0 +1,36 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Raverie
+{
+
+/// The canned scenes that PhysicsBenchmark can build.
+DeclareEnum4(PhysicsBenchmarkScene, BoxPyramid, SphereRain, JointChain, DebrisPile);
+
+/// Builds canned physics scenes and steps a space's physics directly so that
+/// the cost of a timestep can be measured repeatably, without the rest of the
+/// engine's update running. Timings come from the profile records of each
+/// phase of the timestep and are reported as Json so runs can be compared.
+class PhysicsBenchmark
+{
+public:
+  RaverieDeclareType(PhysicsBenchmark, TypeCopyMode::ReferenceType);
+
+  /// Fills the space with the given scene on top of a static ground box.
+  /// Size scales the object count (the base width of the pyramid, the number
+  /// of spheres, the number of chain links, etc...).
+  static void CreateScene(Space* space, PhysicsBenchmarkScene::Enum scene, int size);
+  /// Steps the space's physics the given number of frames with a fixed dt and
+  /// returns the time spent in each phase of the timestep as a Json object.
+  /// Nested phases are reported on their own and not in their parent's time.
+  static String Run(Space* space, int frames, float dt);
+
+private:
+  static Cog* CreateBody(Space* space, StringParam colliderName, Vec3Param position, bool dynamic);
+  static void CreateBoxPyramid(Space* space, int size);
+  static void CreateSphereRain(Space* space, int size);
+  static void CreateJointChain(Space* space, int size);
+  static void CreateDebrisPile(Space* space, int size);
+};
+
+} // namespace Raverie
@@ -87,7 +87,7 @@ void PhysicsQueue::ProcessQueue(BroadPhaseBatch& staticBatch, BroadPhaseBatch& d
 
 void PhysicsQueue::ColliderToBroadPhaseData(Collider* collider, BroadPhaseData& data)
 {
-  data.mAabb = collider->mAabb;
+  data.mAabb = collider->mSpace->GetBroadPhaseAabb(collider);
   data.mClientData = (void*)collider;
   data.mBoundingSphere = collider->mBoundingSphere;
 }
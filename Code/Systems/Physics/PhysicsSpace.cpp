@@ -107,6 +107,52 @@ bool ClientPairSorter(ClientPair& a, ClientPair& b)
   return pairA > pairB;
 }
 
+// 64-bit FNV-1a over the raw bits of the given data. Hashing the bits (rather
+// than values) means any rounding difference between two simulations shows up.
+void HashStateBytes(u64& hash, const void* data, size_t size)
+{
+  const byte* bytes = static_cast<const byte*>(data);
+  for (size_t i = 0; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+}
+
+u64 HashBodyState(RigidBody& body)
+{
+  u64 hash = 14695981039346656037ull;
+  HashStateBytes(hash, &body.mCenterOfMass, sizeof(body.mCenterOfMass));
+  HashStateBytes(hash, &body.mRotationQuat, sizeof(body.mRotationQuat));
+  HashStateBytes(hash, &body.mVelocity, sizeof(body.mVelocity));
+  HashStateBytes(hash, &body.mAngularVelocity, sizeof(body.mAngularVelocity));
+  return hash;
+}
+
+// The state hash of one body along with the id it is ordered by
+struct BodyStateHash
+{
+  u32 mId;
+  u64 mHash;
+};
+
+bool BodyStateHashSorter(const BodyStateHash& a, const BodyStateHash& b)
+{
+  return a.mId < b.mId;
+}
+
+void HashBodyStates(RigidBodyList& bodies, Array<BodyStateHash>& hashes)
+{
+  RigidBodyList::range range = bodies.All();
+  for (; !range.Empty(); range.PopFront())
+  {
+    RigidBody& body = range.Front();
+    BodyStateHash& bodyHash = hashes.PushBack();
+    bodyHash.mId = body.GetOwner()->GetRuntimeId();
+    bodyHash.mHash = HashBodyState(body);
+  }
+}
+
 RaverieDefineType(PhysicsSpace, builder, type)
 {
   RaverieBindSetup(SetupMode::DefaultSerialization);
@@ -125,6 +171,7 @@ RaverieDefineType(PhysicsSpace, builder, type)
   RaverieBindGetterSetterProperty(AllowSleep);
   RaverieBindGetterSetterProperty(Mode2D);
   RaverieBindGetterSetterProperty(Deterministic);
+  RaverieBindGetterSetterProperty(SpeculativeContacts);
   RaverieBindGetterSetterProperty(CollisionTable);
   RaverieBindGetterSetterProperty(PhysicsSolverConfig);
 
@@ -138,6 +185,7 @@ RaverieDefineType(PhysicsSpace, builder, type)
   RaverieBindMethod(RemoveHierarchyPairFilter);
 
   RaverieBindMethod(FlushPhysicsQueue);
+  RaverieBindMethod(ComputeStateHash);
 
   // Ray Cast
   RaverieBindOverloadedMethod(CastRayFirst, RaverieInstanceOverload(CastResult, const Ray&));
@@ -508,6 +556,41 @@ void PhysicsSpace::SetDeterministic(bool state)
   mStateFlags.SetState(PhysicsSpaceFlags::Deterministic, state);
 }
 
+s64 PhysicsSpace::ComputeStateHash()
+{
+  Array<BodyStateHash> hashes;
+  HashBodyStates(mRigidBodies, hashes);
+  HashBodyStates(mInactiveRigidBodies, hashes);
+  HashBodyStates(mMovingKinematicBodies, hashes);
+  HashBodyStates(mStoppedKinematicBodies, hashes);
+  HashBodyStates(mInactiveKinematicBodies, hashes);
+
+  // The body lists are re-ordered as bodies sleep and wake, so combine the
+  // per-body hashes in the order the bodies' objects were created. Only the
+  // order of the ids is used (not their values), so two simulations that create
+  // the same objects in the same order match even if their ids differ. Sorting
+  // by body keeps identity, so two bodies swapping states changes the hash.
+  Sort(hashes.All(), &BodyStateHashSorter);
+
+  u64 hash = 14695981039346656037ull;
+  forRange (BodyStateHash& bodyHash, hashes.All())
+    HashStateBytes(hash, &bodyHash.mHash, sizeof(bodyHash.mHash));
+  return static_cast<s64>(hash);
+}
+
+bool PhysicsSpace::GetSpeculativeContacts() const
+{
+  return mStateFlags.IsSet(PhysicsSpaceFlags::SpeculativeContacts);
+}
+
+void PhysicsSpace::SetSpeculativeContacts(bool state)
+{
+  mStateFlags.SetState(PhysicsSpaceFlags::SpeculativeContacts, state);
+
+  // Wake everything up so the broadphase bounds are refreshed
+  ForceAwakeDynamicColliders();
+}
+
 CollisionGroupInstance* PhysicsSpace::GetCollisionGroupInstance(ResourceId groupId) const
 {
   return mCollisionTable->GetGroupInstance(groupId);
@@ -549,6 +632,7 @@ void PhysicsSpace::FixCollisionTable(CollisionTable* table)
 {
   mCollisionTable = table;
   FixColliderCollisionGroups(mDynamicColliders);
+  FixColliderCollisionGroups(mDormantColliders);
   FixColliderCollisionGroups(mStaticColliders);
 }
 
@@ -751,9 +835,21 @@ void PhysicsSpace::BroadPhase()
   {
     Collider& collider = range.Front();
 
-    // If the object is asleep or flagged as static, there's no reason to test
-    // it for collision.
-    if ((collider.IsAsleep() && !collider.mState.IsSet(ColliderFlags::Uninitialized)) || collider.IsStatic())
+    // If the object is asleep there's no reason to test it for collision.
+    // Awake objects still find it through the dynamic broadphase, so park it
+    // in the dormant list to keep it out of every later per-step pass until
+    // its body wakes up.
+    if (collider.IsAsleep() && !collider.mState.IsSet(ColliderFlags::Uninitialized))
+    {
+      range.PopFront();
+      ColliderList::Unlink(&collider);
+      collider.mState.SetFlag(ColliderFlags::Dormant);
+      mDormantColliders.PushBack(&collider);
+      continue;
+    }
+
+    // Objects flagged as static don't need to be tested either
+    if (collider.IsStatic())
     {
       range.PopFront();
       continue;
@@ -786,6 +882,8 @@ void PhysicsSpace::NarrowPhase()
   Array<NodePointerPair> Collisions;
   Collisions.SetAllocator(allocator);
 
+  bool speculative = GetSpeculativeContacts();
+
   uint size = mPossiblePairs.Size();
   for (unsigned pairIndex = 0; pairIndex < size; ++pairIndex)
   {
@@ -795,8 +893,17 @@ void PhysicsSpace::NarrowPhase()
     // Convert the proxy to a collider
     ColliderPair pair(collider1, collider2);
 
-    // Test for collision
-    if (!mCollisionManager->TestCollision(pair, tempManifolds))
+    // Test for collision. If the pair isn't touching yet it may still be close
+    // enough to collide within this timestep, in which case a speculative
+    // contact is generated so the solver can stop it at the surface.
+    bool collided = mCollisionManager->TestCollision(pair, tempManifolds);
+    if (!collided && speculative)
+    {
+      tempManifolds.Clear();
+      collided = mCollisionManager->TestSpeculativeCollision(pair, mIterationDt, tempManifolds);
+    }
+
+    if (!collided)
     {
       tempManifolds.Clear();
       continue;
@@ -823,7 +930,10 @@ void PhysicsSpace::NarrowPhase()
   mBroadPhase->RecordFrameResults(Collisions);
 
   // We have all connections for the frame so build the islands.
-  mIslandManager->BuildIslands(mDynamicColliders);
+  {
+    ProfileScopeTree("Islands", "NarrowPhase", Color::LightSalmon);
+    mIslandManager->BuildIslands(mDynamicColliders);
+  }
 }
 
 void PhysicsSpace::PreSolve(real dt)
@@ -1268,12 +1378,7 @@ void PhysicsSpace::SetAllowSleep(bool allowSleep)
 {
   mStateFlags.SetState(PhysicsSpaceFlags::AllowSleep, allowSleep);
 
-  ColliderList::range range = mDynamicColliders.All();
-  while (!range.Empty())
-  {
-    range.Front().ForceAwake();
-    range.PopFront();
-  }
+  ForceAwakeDynamicColliders();
 }
 
 void PhysicsSpace::SerializeBroadPhases(Serializer& stream)
@@ -1563,6 +1668,11 @@ void PhysicsSpace::ComponentStateChange(RigidBody* body)
     mMovingKinematicBodies.PushBack(body);
   else
     mRigidBodies.PushBack(body);
+
+  // A body that just woke up has to bring its colliders back into the
+  // per-step working set
+  if (!body->IsAsleep())
+    RestoreDormantColliders(body);
 }
 
 void PhysicsSpace::AddComponent(Joint* joint)
@@ -1622,6 +1732,7 @@ void PhysicsSpace::RemoveComponent(Collider* collider)
 void PhysicsSpace::ComponentStateChange(Collider* collider)
 {
   ColliderList::Unlink(collider);
+  collider->mState.ClearFlag(ColliderFlags::Dormant);
 
   if (!collider->GetActiveBody())
     mStaticColliders.PushBack(collider);
@@ -1664,6 +1775,79 @@ void PhysicsSpace::RemoveGlobalEffect(PhysicsEffect* effect)
   mGlobalEffects.Erase(effect);
 }
 
+void PhysicsSpace::RestoreDormantColliders(RigidBody* body)
+{
+  // Static child bodies are driven by this body, so their colliders may have
+  // been parked on its behalf. Kinematic and dynamic children wake on their own.
+  Array<RigidBody*> bodyStack;
+  bodyStack.PushBack(body);
+
+  while (!bodyStack.Empty())
+  {
+    RigidBody* currentBody = bodyStack.Back();
+    bodyStack.PopBack();
+
+    RigidBody::BodyRange bodies = currentBody->mChildBodies.All();
+    for (; !bodies.Empty(); bodies.PopFront())
+    {
+      RigidBody* childBody = &bodies.Front();
+      if (childBody->GetStatic())
+        bodyStack.PushBack(childBody);
+    }
+
+    RigidBody::CompositeColliderRange colliders = currentBody->mColliders.All();
+    for (; !colliders.Empty(); colliders.PopFront())
+    {
+      Collider* collider = &colliders.Front();
+      if (!collider->mState.IsSet(ColliderFlags::Dormant))
+        continue;
+
+      ColliderList::Unlink(collider);
+      collider->mState.ClearFlag(ColliderFlags::Dormant);
+      mDynamicColliders.PushBack(collider);
+    }
+  }
+}
+
+void PhysicsSpace::ForceAwakeDynamicColliders()
+{
+  // Waking a dormant collider moves it back into the dynamic list, so bring
+  // them all back first and then walk the one list
+  while (!mDormantColliders.Empty())
+  {
+    Collider* collider = &mDormantColliders.Front();
+    ColliderList::Unlink(collider);
+    collider->mState.ClearFlag(ColliderFlags::Dormant);
+    mDynamicColliders.PushBack(collider);
+  }
+
+  ColliderList::range range = mDynamicColliders.All();
+  for (; !range.Empty(); range.PopFront())
+    range.Front().ForceAwake();
+}
+
+Aabb PhysicsSpace::GetBroadPhaseAabb(Collider* collider) const
+{
+  Aabb aabb = collider->mAabb;
+  if (!GetSpeculativeContacts())
+    return aabb;
+
+  RigidBody* body = collider->GetActiveBody();
+  if (body == nullptr || body->GetStatic())
+    return aabb;
+
+  // Sweep the aabb by how far the body will travel this iteration
+  Vec3 displacement = body->mVelocity * mIterationDt;
+  for (uint i = 0; i < 3; ++i)
+  {
+    if (displacement[i] > real(0.0))
+      aabb.mMax[i] += displacement[i];
+    else
+      aabb.mMin[i] += displacement[i];
+  }
+  return aabb;
+}
+
 void PhysicsSpace::QueuePhysicsNode(PhysicsNode* node)
 {
   mNodeManager->AddNode(node);
@@ -1689,6 +1873,15 @@ BroadPhasePackage* PhysicsSpace::ReplaceBroadPhase(BroadPhasePackage* newBroadPh
     r.PopFront();
   }
 
+  // Remove all dormant colliders from the broadphase
+  r = mDormantColliders.All();
+  while (!r.Empty())
+  {
+    Collider* collider = &r.Front();
+    RemovalAction action(collider);
+    r.PopFront();
+  }
+
   // Remove all static colliders from the broadphase
   r = mStaticColliders.All();
   while (!r.Empty())
@@ -1713,6 +1906,14 @@ BroadPhasePackage* PhysicsSpace::ReplaceBroadPhase(BroadPhasePackage* newBroadPh
     r.PopFront();
   }
 
+  r = mDormantColliders.All();
+  while (!r.Empty())
+  {
+    Collider* collider = &r.Front();
+    InsertionAction action(collider);
+    r.PopFront();
+  }
+
   r = mStaticColliders.All();
   while (!r.Empty())
   {
@@ -1834,16 +2035,21 @@ void PhysicsSpace::DrawColliders()
 
   bool onTop = mDebugDrawFlags.IsSet(PhysicsSpaceDebugDrawFlags::DrawOnTop);
 
-  ColliderList::range range = mDynamicColliders.All();
-
-  while (!range.Empty())
+  // Draw both the awake and the dormant dynamic colliders
+  ColliderList* lists[] = {&mDynamicColliders, &mDormantColliders};
+  for (uint i = 0; i < 2; ++i)
   {
-    gDebugDraw->Add(Debug::Obb(range.Front().mAabb).Color(Color::MintCream).OnTop(onTop));
-    gDebugDraw->Add(Debug::Sphere(range.Front().mBoundingSphere).OnTop(onTop));
-    ContactRange contacts = FilterContactRange(&range.Front());
-    for (; !contacts.Empty(); contacts.PopFront())
-      contacts.Front().GetConstraint().DebugDraw();
-    range.PopFront();
+    ColliderList::range range = lists[i]->All();
+
+    while (!range.Empty())
+    {
+      gDebugDraw->Add(Debug::Obb(range.Front().mAabb).Color(Color::MintCream).OnTop(onTop));
+      gDebugDraw->Add(Debug::Sphere(range.Front().mBoundingSphere).OnTop(onTop));
+      ContactRange contacts = FilterContactRange(&range.Front());
+      for (; !contacts.Empty(); contacts.PopFront())
+        contacts.Front().GetConstraint().DebugDraw();
+      range.PopFront();
+    }
   }
 }
 
@@ -1881,7 +2087,7 @@ void PhysicsSpace::DrawInactiveObjects()
 
 void PhysicsSpace::ColliderToBroadPhaseData(Collider* collider, BroadPhaseData& data)
 {
-  data.mAabb = collider->mAabb;
+  data.mAabb = GetBroadPhaseAabb(collider);
   data.mClientData = (void*)collider;
   data.mBoundingSphere = collider->mBoundingSphere;
 }
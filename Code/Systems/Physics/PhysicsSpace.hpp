@@ -7,7 +7,7 @@ namespace Raverie
 class BroadPhasePackage;
 typedef Array<Collider*> ColliderArray;
 
-DeclareBitField3(PhysicsSpaceFlags, AllowSleep, Mode2D, Deterministic);
+DeclareBitField4(PhysicsSpaceFlags, AllowSleep, Mode2D, Deterministic, SpeculativeContacts);
 
 namespace Tags
 {
@@ -130,9 +130,19 @@ public:
   /// InheritFromSpace then it will use this value.
   bool GetMode2D() const;
   void SetMode2D(bool state);
-  /// Performs extra work to help enforce determinism in the simulation.
+  /// Performs extra work to help enforce determinism in the simulation, such
+  /// as processing collision pairs in a fixed order. ComputeStateHash can be
+  /// used to check whether two simulations have diverged.
   bool GetDeterministic() const;
   void SetDeterministic(bool state);
+  /// Generates contacts for bodies that are about to touch within the next
+  /// timestep instead of waiting for them to overlap. Dynamic broad-phase
+  /// bounds are expanded by each body's velocity so fast objects don't tunnel,
+  /// which typically allows a lower SubStepCount. Collision events may be sent
+  /// slightly before the objects actually touch and restitution is only
+  /// applied once they do.
+  bool GetSpeculativeContacts() const;
+  void SetSpeculativeContacts(bool state);
 
   /// Helper for a collider. Returns this space's instance for a CollisionGroup.
   CollisionGroupInstance* GetCollisionGroupInstance(ResourceId groupId) const;
@@ -159,6 +169,11 @@ public:
   /// Forces all queued computations in physics to be updated now. Should only
   /// be used for debugging.
   void FlushPhysicsQueue();
+  /// Hashes the position, orientation and velocities of every rigid body in
+  /// this space. Two simulations that are bit-for-bit identical produce the
+  /// same value, which allows lockstep peers to detect desyncs cheaply. Bodies
+  /// are combined in the order their objects were created.
+  s64 ComputeStateHash();
   /// Updates all queues for pending physics calculation. Beforehand, it also
   /// recomputes the world matrix values so that everything is in the right
   /// spot.
@@ -320,6 +335,11 @@ public:
   /// Queues the given physics node as having modifications
   void QueuePhysicsNode(PhysicsNode* node);
 
+  /// Returns the aabb a collider should use in broadphase. When speculative
+  /// contacts are enabled this is swept by the body's velocity over one
+  /// iteration.
+  Aabb GetBroadPhaseAabb(Collider* collider) const;
+
   /// Find the island that a collider is in (for debug purposes).
   typedef InList<Collider, &Collider::mIslandLink> IslandColliderList;
   IslandColliderList::range GetAllInIsland(Collider* collider);
@@ -373,6 +393,11 @@ private:
 
   /// Helper to get broadphase data for a collider
   void ColliderToBroadPhaseData(Collider* collider, BroadPhaseData& data);
+  /// Moves the dormant colliders driven by this (now awake) body back into the
+  /// dynamic collider list.
+  void RestoreDormantColliders(RigidBody* body);
+  /// Force wakes every dynamic collider, including the dormant ones.
+  void ForceAwakeDynamicColliders();
 
   int mDrawLevel;
   BitField<PhysicsSpaceFlags::Enum> mStateFlags;
@@ -409,6 +434,10 @@ private:
   // Separate dynamic and static components to reduce queries.
   ColliderList mDynamicColliders;
   ColliderList mStaticColliders;
+  /// Colliders whose active body is asleep. They are parked here by the
+  /// broadphase so the per-step passes only walk awake colliders, and they are
+  /// moved back into mDynamicColliders when their body wakes up.
+  ColliderList mDormantColliders;
   RegionList mRegions;
 
   typedef InList<PhysicsCar, &PhysicsCar::SpaceLink> CarList;
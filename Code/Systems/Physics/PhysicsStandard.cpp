@@ -39,6 +39,7 @@ RaverieDefineEnum(CollisionFilterBlockType);
 RaverieDefineEnum(SpringDebugDrawMode);
 RaverieDefineEnum(SpringDebugDrawType);
 RaverieDefineEnum(SpringSortOrder);
+RaverieDefineEnum(PhysicsBenchmarkScene);
 
 // Bind the joint types special because they're generated using the #define
 // #include trick
@@ -88,6 +89,7 @@ RaverieDefineStaticLibrary(PhysicsLibrary)
   RaverieInitializeEnum(SpringDebugDrawMode);
   RaverieInitializeEnum(SpringDebugDrawType);
   RaverieInitializeEnum(SpringSortOrder);
+  RaverieInitializeEnum(PhysicsBenchmarkScene);
   RaverieInitializeEnum(JointTypes);
 
   // Meta Components
@@ -202,6 +204,7 @@ RaverieDefineStaticLibrary(PhysicsLibrary)
   RaverieInitializeType(JointCreator);
   RaverieInitializeType(DynamicMotor);
   RaverieInitializeType(PhysicsRaycastProvider);
+  RaverieInitializeType(PhysicsBenchmark);
   RaverieInitializeTypeAs(ContactPoint, "ContactPoint");
   RaverieInitializeType(ContactGraphEdge);
   RaverieInitializeType(JointGraphEdge);
@@ -160,6 +160,7 @@ public:
 #include "PhysicsNode.hpp"
 #include "PhysicsQueueManager.hpp"
 #include "PhysicsRaycastProvider.hpp"
+#include "PhysicsBenchmark.hpp"
 #include "Integrators.hpp"
 #include "PhysicsEngine.hpp"
 // Debug
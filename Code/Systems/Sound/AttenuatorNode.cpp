@@ -106,15 +106,15 @@ bool AttenuatorNode::GetOutputSamples(BufferType* outputBuffer, const unsigned n
 {
   unsigned bufferSize = outputBuffer->Size();
 
-  // Get input and return if there is no data
-  if (!AccumulateInputSamples(bufferSize, numberOfChannels, listener))
-    return false;
+  // Get input (without any, the attenuation is still updated below)
+  bool hasInput = AccumulateInputSamples(bufferSize, numberOfChannels, listener);
 
   // If no listener then no attenuation
   if (!listener)
   {
-    mInputSamplesThreaded.Swap(*outputBuffer);
-    return true;
+    if (hasInput)
+      mInputSamplesThreaded.Swap(*outputBuffer);
+    return hasInput;
   }
 
   // Get the relative position with the listener
@@ -129,11 +129,6 @@ bool AttenuatorNode::GetOutputSamples(BufferType* outputBuffer, const unsigned n
   else
     distance /= listener->GetAttenuationScale();
 
-  // If we are outside the max distance and the minimum volume is zero, there is
-  // no audio
-  if (distance >= mAttenEndDist.Get(AudioThreads::MixThread) && mMinimumVolume.Get(AudioThreads::MixThread) == 0.0f)
-    return false;
-
   float attenuatedVolume;
   // If the distance is further than the attenuation end distance, the volume is
   // the end volume
@@ -157,6 +152,15 @@ bool AttenuatorNode::GetOutputSamples(BufferType* outputBuffer, const unsigned n
 
   AttenuationPerListener& listenerData = *DataPerListener[listener];
 
+  // If there is no input (such as when the input is virtual), or we are outside
+  // the max distance and the minimum volume is zero, there is no audio. The
+  // volume is still stored so the inputs know how audible they would be.
+  if (!hasInput || (distance >= mAttenEndDist.Get(AudioThreads::MixThread) && mMinimumVolume.Get(AudioThreads::MixThread) == 0.0f))
+  {
+    listenerData.PreviousVolume = attenuatedVolume;
+    return false;
+  }
+
   // Apply volume adjustment to each frame of samples
   InterpolatingObject volume;
   volume.SetValues(listenerData.PreviousVolume, attenuatedVolume, bufferSize / numberOfChannels);
@@ -199,6 +203,11 @@ float AttenuatorNode::GetVolumeChangeFromOutputsThreaded()
   forRange (HandleOf<SoundNode> node, GetOutputs(AudioThreads::MixThread)->All())
     volume += node->GetVolumeChangeFromOutputsThreaded();
 
+  // If this node has not been evaluated for any listener yet, its attenuation
+  // is unknown, so don't reduce the volume
+  if (DataPerListener.Empty())
+    return volume;
+
   // If there are multiple listeners, the sounds they hear are added together
   float attenuatorVolume = 0.0f;
   forRange (AttenuationPerListener* data, DataPerListener.Values())
@@ -48,6 +48,18 @@ bool AudioIOInterface::Initialize(bool initOutput, bool initInput)
   return returnValue;
 }
 
+void AudioIOInterface::InitializeOffline(unsigned sampleRate, unsigned channels)
+{
+  StreamInfo& outputInfo = StreamInfoList[StreamTypes::Output];
+  outputInfo.mChannels = channels;
+  outputInfo.mSampleRate = sampleRate;
+
+  InitializeOutputBuffers();
+
+  // There is no device to start, so the stream is always running
+  outputInfo.mStatus = StreamStatus::Started;
+}
+
 bool AudioIOInterface::StartStreams(bool startOutput, bool startInput)
 {
   if (!startOutput && !startInput)
@@ -144,7 +156,8 @@ void AudioIOInterface::SetOutputLatencyThreaded(AudioLatency::Enum newLatency)
 
 void AudioIOInterface::InitializeOutputBuffers()
 {
-  unsigned size = GetBufferSize(cAudioSampleRate, cAudioChannels);
+  StreamInfo& outputInfo = StreamInfoList[StreamTypes::Output];
+  unsigned size = GetBufferSize(outputInfo.mSampleRate, outputInfo.mChannels);
 
   OutputBufferSizePerLatency[AudioLatency::Low] = size;
   OutputBufferSizePerLatency[AudioLatency::High] = size * 4;
@@ -154,7 +167,8 @@ void AudioIOInterface::InitializeOutputBuffers()
 
 void AudioIOInterface::InitializeInputBuffers()
 {
-  unsigned size = GetBufferSize(cAudioSampleRate, cAudioChannels);
+  StreamInfo& inputInfo = StreamInfoList[StreamTypes::Input];
+  unsigned size = GetBufferSize(inputInfo.mSampleRate, inputInfo.mChannels);
 
   InitializeRingBuffer(InputRingBuffer, InputBuffer, size * 2);
 }
@@ -174,7 +188,7 @@ unsigned AudioIOInterface::GetBufferSize(unsigned sampleRate, unsigned channels)
   return size;
 }
 
-void AudioIOInterface::InitializeRingBuffer(RingBuffer& ringBuffer, float* buffer, unsigned size)
+void AudioIOInterface::InitializeRingBuffer(RingBuffer& ringBuffer, float*& buffer, unsigned size)
 {
   // If the buffer already exists, delete it
   if (buffer)
@@ -41,6 +41,10 @@ public:
 
   // Initializes the input and/or output streams, depending on parameters
   bool Initialize(bool initOutput, bool initInput);
+  // Initializes and starts the output stream at the given sample rate and
+  // number of channels without an audio device. Nothing reads the output, it
+  // is taken directly from the OutputRingBuffer (see AudioMixer::MixOffline).
+  void InitializeOffline(unsigned sampleRate, unsigned channels);
   // Starts the output and/or input streams, depending on parameters
   bool StartStreams(bool startOutput, bool startInput);
   // Stops the output and/or input streams, depending on parameters
@@ -101,8 +105,9 @@ private:
   // Determines a power of two size for buffers depending on the provided sample
   // rate
   unsigned GetBufferSize(unsigned sampleRate, unsigned channels);
-  // Initializes the specified RingBuffer at the specified size
-  void InitializeRingBuffer(RingBuffer& ringBuffer, float* buffer, unsigned size);
+  // Initializes the specified RingBuffer at the specified size, replacing the
+  // buffer it used
+  void InitializeRingBuffer(RingBuffer& ringBuffer, float*& buffer, unsigned size);
 };
 
 } // namespace Raverie
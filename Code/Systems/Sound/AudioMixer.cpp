@@ -17,15 +17,47 @@ AudioTask::AudioTask(Functor* function, HandleOf<SoundNode> node) : mFunction(fu
 {
 }
 
-AudioTask::AudioTask(const AudioTask& other) : mFunction(other.mFunction), mObject(other.mObject)
+AudioTask::AudioTask(const AudioTask& other) : mFunction(nullptr)
 {
-  const_cast<AudioTask&>(other).mFunction = nullptr;
+  TakeFrom(const_cast<AudioTask&>(other));
 }
 
 AudioTask::~AudioTask()
 {
-  if (mFunction)
+  Release();
+}
+
+void AudioTask::TakeFrom(AudioTask& other)
+{
+  ErrorIf(mFunction, "Audio task already has a functor");
+  ErrorIf(other.IsFunctorInline(), "Inline functors can't be moved to another task");
+
+  mFunction = other.mFunction;
+  mObject = other.mObject;
+  other.mFunction = nullptr;
+  other.mObject = HandleOf<SoundNode>();
+}
+
+bool AudioTask::IsFunctorInline()
+{
+  return mFunction && (void*)mFunction == (void*)mFunctorData;
+}
+
+void AudioTask::Execute()
+{
+  ErrorIf(!mFunction, "Functor pointer is null");
+  mFunction->Execute();
+}
+
+void AudioTask::Release()
+{
+  if (IsFunctorInline())
+    mFunction->~Functor();
+  else if (mFunction)
     delete mFunction;
+
+  mFunction = nullptr;
+  mObject = HandleOf<SoundNode>();
 }
 
 // Audio Mixer
@@ -34,10 +66,12 @@ AudioMixer::AudioMixer() :
     mSystemChannels(2),
     mMixVersionThreaded(0),
     mMinimumVolumeThresholdThreaded(0.015f),
+    mMaxRealVoicesThreaded(0),
     mSendMicrophoneInputData(cFalse),
     FinalOutputNode(nullptr),
-    mMixThreadTaskWriteIndex(0),
-    mGameThreadTaskWriteIndex(0),
+    TasksForMixThread(TaskQueueCapacity),
+    TasksForGameThread(TaskQueueCapacity),
+    FinishedTasksThreaded(TaskQueueCapacity),
     mShuttingDown(cFalse),
     mVolume(1.0f),
     mPeakVolumeLastMix(0.0f),
@@ -45,12 +79,17 @@ AudioMixer::AudioMixer() :
     mPreviousPeakVolumeThreaded(0.0f),
     mPreviousRMSVolumeThreaded(0),
     mResamplingThreaded(false),
+    mOutputIOThreaded(&AudioIO),
     mMuted(cFalse),
     mMutingThreaded(false),
     mPeakInputVolume(0.0f),
     mSendMicrophoneInputCompressed(false),
     mSendMicrophoneInputUncompressed(false)
 {
+  // Audio device sample rate conversion affects every sound, so it always uses
+  // the filtered resampling
+  OutputResampler.SetQuality(ResampleQuality::High);
+  InputResampler.SetQuality(ResampleQuality::High);
 }
 
 OsInt StartMix(void* mixer)
@@ -66,6 +105,9 @@ void AudioMixer::StartMixing(Status& status)
   if (!AudioIO.Initialize(true, false))
     status.SetFailed(AudioIO.GetStreamErrorMessage(StreamTypes::Output));
 
+  // Offline mixes use the same format as the audio output until told otherwise
+  OfflineIO.InitializeOffline(AudioIO.GetStreamSampleRate(StreamTypes::Output), AudioIO.GetStreamChannels(StreamTypes::Output));
+
   CheckForResamplingThreaded();
 
   // Create output nodes
@@ -126,12 +168,7 @@ void AudioMixer::Update()
   // If not threaded, run decoding tasks and mix loop
   if (!ThreadingEnabled)
   {
-    for (unsigned i = 0; i < MaxDecodingTasksToRun && !DecodingTasks.Empty(); ++i)
-    {
-      DecodingTasks.Front()->RunDecodingTask();
-      DecodingTasks.PopFront();
-    }
-
+    RunDecodingTasks(MaxDecodingTasksToRun);
     MixLoopThreaded();
   }
 
@@ -184,18 +221,112 @@ void AudioMixer::MixLoopThreaded()
   } while (running && Raverie::ThreadingEnabled);
 }
 
+unsigned AudioMixer::MixOffline(BufferType* output, double* mixSeconds)
+{
+  ReturnIf(ThreadingEnabled, 0, "Offline mixing is only available when the audio mix is not threaded");
+  ReturnIf(!FinalOutputNode, 0, "Audio mixing has not been started");
+
+  // Decode everything that is waiting so streaming Sounds keep up with a mix
+  // that runs faster than real time
+  RunDecodingTasks(DecodingTasks.Size());
+
+  // Mix into the offline interface, leaving the audio device's output alone.
+  // All previous offline output was taken, so the mix fills the whole buffer.
+  mOutputIOThreaded = &OfflineIO;
+  CheckForResamplingThreaded();
+  OfflineIO.OutputRingBuffer.ResetBuffer();
+  Profile::ProfileTime startTime = Profile::ProfileSystem::Instance->GetTime();
+  MixLoopThreaded();
+  if (mixSeconds)
+  {
+    Profile::ProfileTime elapsed = Profile::ProfileSystem::Instance->GetTime() - startTime;
+    *mixSeconds += Profile::ProfileSystem::Instance->GetTimeInSeconds(elapsed);
+  }
+  mOutputIOThreaded = &AudioIO;
+  CheckForResamplingThreaded();
+
+  unsigned samples = OfflineIO.OutputRingBuffer.GetReadAvailable();
+  unsigned start = output->Size();
+  output->Resize(start + samples);
+  OfflineIO.OutputRingBuffer.Read(output->Data() + start, samples);
+
+  // Execute tasks from the mix
+  HandleTasks();
+
+  return samples / OfflineIO.GetStreamChannels(StreamTypes::Output);
+}
+
+void AudioMixer::SetOfflineOutputFormat(unsigned sampleRate, unsigned channels)
+{
+  ReturnIf(sampleRate == 0 || channels == 0 || channels > 8, , "Offline output needs a sample rate and 1 to 8 channels");
+
+  OfflineIO.InitializeOffline(sampleRate, channels);
+}
+
 void AudioMixer::AddTask(Functor* task, HandleOf<SoundNode> node)
 {
-  MixThreadTasksLock.Lock();
-  TasksForMixThread[mMixThreadTaskWriteIndex].PushBack(AudioTask(task, node));
-  MixThreadTasksLock.Unlock();
+  // Tasks must stay in order, so only use the queue if nothing is waiting in
+  // the overflow list
+  MoveOverflowTasks(MixThreadTaskOverflow, TasksForMixThread);
+  AudioTask* queueTask = nullptr;
+  if (MixThreadTaskOverflow.Empty())
+    queueTask = TasksForMixThread.BeginWrite();
+
+  if (queueTask)
+  {
+    queueTask->mFunction = task;
+    queueTask->mObject = node;
+    TasksForMixThread.EndWrite();
+  }
+  else
+  {
+    MixThreadTaskOverflow.PushBack(AudioTask(task, node));
+  }
 }
 
 void AudioMixer::AddTaskThreaded(Functor* task, HandleOf<SoundNode> node)
 {
-  GameThreadTasksLock.Lock();
-  TasksForGameThread[mGameThreadTaskWriteIndex].PushBack(AudioTask(task, node));
-  GameThreadTasksLock.Unlock();
+  MoveOverflowTasks(GameThreadTaskOverflowThreaded, TasksForGameThread);
+  AudioTask* queueTask = nullptr;
+  if (GameThreadTaskOverflowThreaded.Empty())
+    queueTask = TasksForGameThread.BeginWrite();
+
+  if (queueTask)
+  {
+    queueTask->mFunction = task;
+    queueTask->mObject = node;
+    TasksForGameThread.EndWrite();
+  }
+  else
+  {
+    GameThreadTaskOverflowThreaded.PushBack(AudioTask(task, node));
+  }
+}
+
+void AudioMixer::SubmitTaskThreaded()
+{
+  // If the overflow list is empty the task was written to the queue
+  if (GameThreadTaskOverflowThreaded.Empty())
+    TasksForGameThread.EndWrite();
+}
+
+void AudioMixer::MoveOverflowTasks(Array<AudioTask>& overflow, LockFreeQueue<AudioTask>& queue)
+{
+  if (overflow.Empty())
+    return;
+
+  unsigned movedCount = 0;
+  for (; movedCount < overflow.Size(); ++movedCount)
+  {
+    AudioTask* queueTask = queue.BeginWrite();
+    if (!queueTask)
+      break;
+
+    queueTask->TakeFrom(overflow[movedCount]);
+    queue.EndWrite();
+  }
+
+  overflow.Erase(overflow.SubRange(0, movedCount));
 }
 
 void AudioMixer::SetLatency(AudioLatency::Enum latency)
@@ -267,6 +398,21 @@ void AudioMixer::SetMinimumVolumeThreshold(const float volume)
   AddTask(CreateFunctor(&AudioMixer::mMinimumVolumeThresholdThreaded, this, volume), nullptr);
 }
 
+void AudioMixer::SetMaxRealVoices(const int maxVoices)
+{
+  AddTask(CreateFunctor(&AudioMixer::mMaxRealVoicesThreaded, this, Math::Max(maxVoices, 0)), nullptr);
+}
+
+void AudioMixer::SetStreamingCacheSize(const unsigned megabytes)
+{
+  AddTask(CreateFunctor(&DecodedPageCache::SetMemoryBudget, &PageCacheThreaded, (size_t)megabytes * 1024 * 1024), nullptr);
+}
+
+void AudioMixer::AddVoiceThreaded(SoundInstance* instance)
+{
+  VoicesThreaded.PushBack(instance);
+}
+
 void AudioMixer::SetSendUncompressedMicInput(const bool sendInput)
 {
   if (sendInput == mSendMicrophoneInputUncompressed)
@@ -325,15 +471,19 @@ bool AudioMixer::MixCurrentInstancesThreaded()
   if (!FinalOutputNode)
     return mShuttingDown.Get() == cFalse;
 
-  // Find out how many samples we can write to the ring buffer
-  unsigned samplesNeeded = AudioIO.OutputRingBuffer.GetWriteAvailable();
+  AudioIOInterface& outputIO = *mOutputIOThreaded;
+
+  // Save the number of channels in the audio output
+  unsigned outputChannels = outputIO.GetStreamChannels(StreamTypes::Output);
+
+  // Find out how many samples we can write to the ring buffer (in whole frames)
+  unsigned samplesNeeded = outputIO.OutputRingBuffer.GetWriteAvailable();
+  samplesNeeded -= samplesNeeded % outputChannels;
 
   // Check to make sure there is available write space
   if (samplesNeeded == 0)
     return true;
 
-  // Save the number of channels in the audio output
-  unsigned outputChannels = AudioIO.GetStreamChannels(StreamTypes::Output);
   // Number of frames in the output
   unsigned outputFrames = samplesNeeded / outputChannels;
 
@@ -359,6 +509,12 @@ bool AudioMixer::MixCurrentInstancesThreaded()
   // Resize BufferForOutput to match samples needed
   BufferForOutput.Resize(mixFrames * mixChannels);
 
+  // Decide which instances will process audio in this mix
+  UpdateVoicesThreaded(mixFrames);
+
+  // Find which parts of the node structure can be shared by all listeners
+  FinalOutputNode->UpdateListenerDependenceThreaded();
+
   // Get samples from output node
   bool isThereData = FinalOutputNode->GetOutputSamples(&BufferForOutput, mixChannels, nullptr, true);
 
@@ -461,7 +617,7 @@ bool AudioMixer::MixCurrentInstancesThreaded()
     }
 
     // Copy the data to the ring buffer
-    AudioIO.OutputRingBuffer.Write(MixedOutput.Data(), MixedOutput.Size());
+    outputIO.OutputRingBuffer.Write(MixedOutput.Data(), MixedOutput.Size());
 
     return false;
   }
@@ -478,52 +634,77 @@ bool AudioMixer::MixCurrentInstancesThreaded()
   }
 
   // Copy the data to the ring buffer
-  AudioIO.OutputRingBuffer.Write(MixedOutput.Data(), MixedOutput.Size());
+  outputIO.OutputRingBuffer.Write(MixedOutput.Data(), MixedOutput.Size());
 
   // Still running, return true
   return true;
 }
 
-int SwapBufferIndexes(int* index)
-{
-  int current = *index;
-  *index = (current + 1) % 2;
-  return current;
-}
-
 void AudioMixer::HandleTasksThreaded()
 {
-  MixThreadTasksLock.Lock();
-  TaskListType& list = TasksForMixThread[SwapBufferIndexes(&mMixThreadTaskWriteIndex)];
-  MixThreadTasksLock.Unlock();
+  // Move any tasks for the game thread that didn't fit in the queue last time
+  MoveOverflowTasks(GameThreadTaskOverflowThreaded, TasksForGameThread);
 
-  forRange (AudioTask& task, list.All())
+  // Only run the tasks that are already in the queue, in case the game thread
+  // keeps adding more
+  for (unsigned count = TasksForMixThread.GetCount(); count > 0; --count)
   {
-    ErrorIf(!task.mFunction, "Functor pointer is null");
-    task.mFunction->Execute();
-  }
+    AudioTask* task = TasksForMixThread.Peek();
+    task->Execute();
+
+    // Send the task back so its memory is freed on the game thread (if there
+    // is no room it has to be freed here)
+    AudioTask* finishedTask = nullptr;
+    if (!task->IsFunctorInline())
+      finishedTask = FinishedTasksThreaded.BeginWrite();
+
+    if (finishedTask)
+    {
+      finishedTask->TakeFrom(*task);
+      FinishedTasksThreaded.EndWrite();
+    }
+    else
+    {
+      task->Release();
+    }
 
-  list.Clear();
+    TasksForMixThread.Pop();
+  }
 }
 
 void AudioMixer::HandleTasks()
 {
-  GameThreadTasksLock.Lock();
-  TaskListType& list = TasksForGameThread[SwapBufferIndexes(&mGameThreadTaskWriteIndex)];
-  GameThreadTasksLock.Unlock();
+  // Move any tasks for the mix thread that didn't fit in the queue last time
+  MoveOverflowTasks(MixThreadTaskOverflow, TasksForMixThread);
 
-  forRange (AudioTask& task, list.All())
+  for (unsigned count = TasksForGameThread.GetCount(); count > 0; --count)
   {
-    ErrorIf(!task.mFunction, "Functor pointer is null");
-    task.mFunction->Execute();
+    AudioTask* task = TasksForGameThread.Peek();
+    task->Execute();
+    task->Release();
+    TasksForGameThread.Pop();
   }
 
-  list.Clear();
+  // Free the tasks the mix thread has finished
+  while (AudioTask* task = FinishedTasksThreaded.Peek())
+  {
+    task->Release();
+    FinishedTasksThreaded.Pop();
+  }
+}
+
+void AudioMixer::RunDecodingTasks(unsigned maxTasks)
+{
+  for (unsigned i = 0; i < maxTasks && !DecodingTasks.Empty(); ++i)
+  {
+    DecodingTasks.Front()->RunDecodingTask();
+    DecodingTasks.PopFront();
+  }
 }
 
 void AudioMixer::CheckForResamplingThreaded()
 {
-  unsigned outputSampleRate = AudioIO.GetStreamSampleRate(StreamTypes::Output);
+  unsigned outputSampleRate = mOutputIOThreaded->GetStreamSampleRate(StreamTypes::Output);
 
   if (cSystemSampleRate != outputSampleRate)
   {
@@ -714,6 +895,84 @@ void AudioMixer::SetSendMicInput(bool turnOn)
     mSendMicrophoneInputData.Set(0);
 }
 
+void AudioMixer::UpdateVoicesThreaded(unsigned mixFrames)
+{
+  AudibleVoicesThreaded.Clear();
+
+  for (unsigned i = 0; i < VoicesThreaded.Size();)
+  {
+    SoundInstance* instance = VoicesThreaded[i];
+
+    // Remove finished instances from the list
+    if (!instance || instance->mFinished.Get() == cTrue)
+    {
+      VoicesThreaded[i] = VoicesThreaded.Back();
+      VoicesThreaded.PopBack();
+      continue;
+    }
+    ++i;
+
+    // Paused instances don't process audio, so they don't use up a voice
+    if (instance->mPaused.Get() == cTrue)
+      continue;
+
+    // Instances too quiet to be heard are always virtual
+    instance->mAudibilityThreaded = instance->GetAudibilityThreaded(mixFrames);
+    if (instance->mAudibilityThreaded < mMinimumVolumeThresholdThreaded)
+      instance->SetVirtualThreaded(true);
+    else
+      AudibleVoicesThreaded.PushBack(instance);
+  }
+
+  // Sort the audible instances so the most important get the real voices
+  Sort(AudibleVoicesThreaded.All(), VoiceSortThreaded);
+
+  CueVoiceCountsThreaded.Clear();
+  TagVoiceCountsThreaded.Clear();
+  int realVoices = 0;
+
+  forRange (SoundInstance* instance, AudibleVoicesThreaded.All())
+  {
+    // Check the overall limit
+    bool isReal = mMaxRealVoicesThreaded == 0 || realVoices < mMaxRealVoicesThreaded;
+
+    // Check the limit of the SoundCue that played this instance
+    if (isReal && instance->mVoiceGroupMaxReal > 0)
+      isReal = CueVoiceCountsThreaded.FindValue(instance->mVoiceGroupId, 0) < instance->mVoiceGroupMaxReal;
+
+    // Check the limits of all tags on this instance
+    for (unsigned i = 0; isReal && i < instance->TagListThreaded.Size(); ++i)
+    {
+      TagObject* tag = instance->TagListThreaded[i];
+      int maxVoices = tag->mMaxRealVoices.Get(AudioThreads::MixThread);
+      if (maxVoices > 0 && TagVoiceCountsThreaded.FindValue(tag, 0) >= maxVoices)
+        isReal = false;
+    }
+
+    // Count the real voice against every limit
+    if (isReal)
+    {
+      ++realVoices;
+      if (instance->mVoiceGroupMaxReal > 0)
+        CueVoiceCountsThreaded[instance->mVoiceGroupId] += 1;
+      forRange (TagObject* tag, instance->TagListThreaded.All())
+        TagVoiceCountsThreaded[tag] += 1;
+    }
+
+    instance->SetVirtualThreaded(!isReal);
+  }
+}
+
+bool AudioMixer::VoiceSortThreaded(SoundInstance* left, SoundInstance* right)
+{
+  int leftPriority = left->mPriority.Get(AudioThreads::MixThread);
+  int rightPriority = right->mPriority.Get(AudioThreads::MixThread);
+  if (leftPriority != rightPriority)
+    return leftPriority > rightPriority;
+
+  return left->mAudibilityThreaded > right->mAudibilityThreaded;
+}
+
 // Audio Frame
 
 namespace AudioChannelTranslation
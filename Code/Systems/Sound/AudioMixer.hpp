@@ -7,16 +7,58 @@ namespace Raverie
 
 // Audio Task
 
+// A function to run on the other audio thread. Small functors can be created
+// inside the task itself, so a task written directly into a queue slot doesn't
+// allocate any memory.
 class AudioTask
 {
 public:
+  // Functors up to this size can be stored inside the task
+  static const unsigned cInlineFunctorSize = 64;
+
   AudioTask();
   AudioTask(Functor* function, HandleOf<SoundNode> node);
+  // Takes the functor from the other task (it must not be stored inline)
   AudioTask(const AudioTask& other);
   ~AudioTask();
 
+  // Creates a functor of this type for the task, inside the task if allowed
+  // and if it fits, otherwise on the heap
+  template <typename FunctorType>
+  FunctorType* CreateFunctor(bool allowInline)
+  {
+    ErrorIf(mFunction, "Audio task already has a functor");
+
+    FunctorType* functor;
+    if (allowInline && sizeof(FunctorType) <= cInlineFunctorSize)
+      functor = new (mFunctorData) FunctorType();
+    else
+      functor = new FunctorType();
+
+    mFunction = functor;
+    return functor;
+  }
+  // Takes the functor and node from the other task (its functor must not be
+  // stored inline)
+  void TakeFrom(AudioTask& other);
+  // Returns true if the functor is stored inside the task
+  bool IsFunctorInline();
+  // Runs the task's functor
+  void Execute();
+  // Destroys the functor and releases the node so the task can be reused
+  void Release();
+
   Functor* mFunction;
   HandleOf<SoundNode> mObject;
+
+private:
+  AudioTask& operator=(const AudioTask&);
+
+  union
+  {
+    byte mFunctorData[cInlineFunctorSize];
+    MaxAlignmentType mFunctorDataAligned[RaverieAlignCount(cInlineFunctorSize)];
+  };
 };
 
 // Audio Mixer
@@ -34,10 +76,57 @@ public:
   void Update();
   // Looping function on the mix thread to handle tasks and mix output
   void MixLoopThreaded();
+  // Runs one mix into OfflineIO instead of the audio device's output and
+  // appends the mixed samples to the buffer, at the OfflineIO sample rate and
+  // number of channels. Returns the number of frames mixed. Only available when
+  // the mix is not threaded (the mix runs on the calling thread). If mixSeconds
+  // is not null, the time spent mixing is added to it (decoding and task
+  // handling around the mix are not counted).
+  unsigned MixOffline(BufferType* output, double* mixSeconds = nullptr);
+  // Sets the sample rate and number of channels used by MixOffline
+  void SetOfflineOutputFormat(unsigned sampleRate, unsigned channels);
   // Adds a task from the main thread for the mix thread to handle
   void AddTask(Functor* task, HandleOf<SoundNode> node);
   // Adds a task from the mix thread for the main thread to handle
   void AddTaskThreaded(Functor* task, HandleOf<SoundNode> node);
+  // Adds a task from the mix thread for the main thread to handle, creating
+  // the functor directly in the queue so no memory is allocated
+  template <typename ReturnType, typename InstanceType>
+  void AddTaskThreaded(ReturnType (InstanceType::*functionPointer)(), InstanceType* instance, HandleOf<SoundNode> node)
+  {
+    auto functor = CreateTaskThreaded<FunctorInstance0<ReturnType, InstanceType>>(node);
+    functor->mFunctionPointer = functionPointer;
+    functor->mInstance = instance;
+    SubmitTaskThreaded();
+  }
+  template <typename ReturnType, typename InstanceType, typename P0>
+  void AddTaskThreaded(ReturnType (InstanceType::*functionPointer)(P0), InstanceType* instance, P0 p0, HandleOf<SoundNode> node)
+  {
+    auto functor = CreateTaskThreaded<FunctorInstance1<ReturnType, InstanceType, P0>>(node);
+    functor->mFunctionPointer = functionPointer;
+    functor->mInstance = instance;
+    functor->mP0 = p0;
+    SubmitTaskThreaded();
+  }
+  template <typename ReturnType, typename InstanceType, typename P0, typename P1>
+  void AddTaskThreaded(ReturnType (InstanceType::*functionPointer)(P0, P1), InstanceType* instance, P0 p0, P1 p1, HandleOf<SoundNode> node)
+  {
+    auto functor = CreateTaskThreaded<FunctorInstance2<ReturnType, InstanceType, P0, P1>>(node);
+    functor->mFunctionPointer = functionPointer;
+    functor->mInstance = instance;
+    functor->mP0 = p0;
+    functor->mP1 = p1;
+    SubmitTaskThreaded();
+  }
+  // Adds a task from the mix thread for the main thread to set a value
+  template <typename PointerType, typename ValueType>
+  void AddTaskThreaded(PointerType* pointer, ValueType value, HandleOf<SoundNode> node)
+  {
+    auto functor = CreateTaskThreaded<FunctorSetPointer<PointerType, ValueType>>(node);
+    functor->mPointer = pointer;
+    functor->mValue = value;
+    SubmitTaskThreaded();
+  }
   // Sets whether to use the high or low latency values
   void SetLatency(AudioLatency::Enum latency);
   // Starts the input stream if it is not already started. Returns false if
@@ -63,6 +152,13 @@ public:
   float GetRMSOutputVolume();
   // Sets the minimum volume at which SoundInstances will process audio.
   void SetMinimumVolumeThreshold(const float volume);
+  // Sets the maximum number of SoundInstances that will process audio at once
+  // (zero for no limit). The rest will be virtual.
+  void SetMaxRealVoices(const int maxVoices);
+  // Adds a playing SoundInstance to the list used for the voice limits
+  void AddVoiceThreaded(SoundInstance* instance);
+  // Sets the maximum memory used by decoded pages of streaming assets
+  void SetStreamingCacheSize(const unsigned megabytes);
   // If true, events will be sent with microphone input data as float samples
   void SetSendUncompressedMicInput(const bool sendInput);
   // If true, events will be sent with compressed microphone input data as bytes
@@ -81,6 +177,9 @@ public:
   // If a SoundInstance is below this threshold it will keep its place but not
   // process any audio.
   float mMinimumVolumeThresholdThreaded;
+  // The maximum number of SoundInstances that will process audio at once (zero
+  // for no limit).
+  int mMaxRealVoicesThreaded;
   // Audio input data for the current mix, matching the current output sample
   // rate and channels
   Array<float> InputBuffer;
@@ -91,10 +190,17 @@ public:
   // The maximum number of decoding tasks that will be processed on one update
   // (this number is arbitrary and can be changed)
   static const unsigned MaxDecodingTasksToRun = 10;
+  // The number of tasks each task queue can hold before tasks are added to
+  // its overflow list
+  static const unsigned TaskQueueCapacity = 1024;
+  // Decoded pages of streaming assets, shared between their instances
+  DecodedPageCache PageCacheThreaded;
   // The node that all audio is attached to
   HandleOf<OutputNode> FinalOutputNode;
   // The interface for audio input and output
   AudioIOInterface AudioIO;
+  // The output interface used by MixOffline, which has no audio device
+  AudioIOInterface OfflineIO;
 
 private:
   // Adds current sounds into the output buffer. Will return false when the
@@ -104,6 +210,9 @@ private:
   void HandleTasksThreaded();
   // Switches buffer pointers and executes all tasks for the main thread.
   void HandleTasks();
+  // Runs up to the specified number of decoding tasks when the system is not
+  // threaded
+  void RunDecodingTasks(unsigned maxTasks);
   // Checks for resampling and resets variables if applicable
   void CheckForResamplingThreaded();
   // Gets the current input data from the AudioIO and adjusts if necessary to
@@ -116,8 +225,34 @@ private:
   void DispatchMicrophoneInput();
   // Turns on and off sending microphone input
   void SetSendMicInput(bool turnOn);
+  // Decides which SoundInstances will be real and which will be virtual for
+  // the next mix, using their audibility, priority, and the voice limits
+  void UpdateVoicesThreaded(unsigned mixFrames);
+  // Sorts higher priority and then louder SoundInstances first
+  static bool VoiceSortThreaded(SoundInstance* left, SoundInstance* right);
+  // Starts a task for the main thread in the next queue slot (or the overflow
+  // list if the queue is full) and returns its functor to be filled in
+  template <typename FunctorType>
+  FunctorType* CreateTaskThreaded(HandleOf<SoundNode> node)
+  {
+    // Tasks must stay in order, so only use the queue if nothing is waiting in
+    // the overflow list
+    AudioTask* task = nullptr;
+    if (GameThreadTaskOverflowThreaded.Empty())
+      task = TasksForGameThread.BeginWrite();
+
+    bool inQueue = task != nullptr;
+    if (!inQueue)
+      task = &GameThreadTaskOverflowThreaded.PushBack();
 
-  typedef Array<AudioTask> TaskListType;
+    task->mObject = node;
+    // Tasks in the overflow list are moved later, so they can't be inline
+    return task->CreateFunctor<FunctorType>(inQueue);
+  }
+  // Passes the task started by CreateTaskThreaded to the main thread
+  void SubmitTaskThreaded();
+  // Moves as many tasks from the overflow list into the queue as will fit
+  static void MoveOverflowTasks(Array<AudioTask>& overflow, LockFreeQueue<AudioTask>& queue);
 
   // Array used to accumulate samples for output
   BufferType BufferForOutput;
@@ -130,14 +265,17 @@ private:
   // For low frequency channel on 5.1 or 7.1 mix
   // Must be pointer because relies on audio system in constructor
   LowPassFilter* LowPass;
-  // Read and write task buffers for the mix thread
-  TaskListType TasksForMixThread[2];
-  // Lock used for switching mix thread task buffers
-  ThreadLock MixThreadTasksLock;
-  // Read and write task buffers for the game thread
-  TaskListType TasksForGameThread[2];
-  // Lock used for switching game thread task buffers
-  ThreadLock GameThreadTasksLock;
+  // Tasks from the game thread for the mix thread to run
+  LockFreeQueue<AudioTask> TasksForMixThread;
+  // Tasks from the mix thread for the game thread to run
+  LockFreeQueue<AudioTask> TasksForGameThread;
+  // Tasks the mix thread has run, sent back so their memory is freed on the
+  // game thread
+  LockFreeQueue<AudioTask> FinishedTasksThreaded;
+  // Tasks from the game thread that didn't fit in the mix thread queue
+  Array<AudioTask> MixThreadTaskOverflow;
+  // Tasks from the mix thread that didn't fit in the game thread queue
+  Array<AudioTask> GameThreadTaskOverflowThreaded;
   // Resampler object used to resample mixed output
   Resampler OutputResampler;
   // Encoder to use for compressed microphone input
@@ -148,11 +286,16 @@ private:
   RingBuffer InputDataBuffer;
   // Stored microphone input samples when sending compressed input
   Array<float> PreviousInputSamples;
+  // All playing SoundInstances, used for the voice limits
+  Array<HandleOf<SoundInstance>> VoicesThreaded;
+  // SoundInstances loud enough to be heard in the current mix, sorted by
+  // priority and audibility
+  Array<SoundInstance*> AudibleVoicesThreaded;
+  // Number of real voices per SoundCue in the current mix
+  HashMap<ResourceId, int> CueVoiceCountsThreaded;
+  // Number of real voices per SoundTag in the current mix
+  HashMap<TagObject*, int> TagVoiceCountsThreaded;
 
-  // Index of the mix thread task buffer to write to
-  int mMixThreadTaskWriteIndex;
-  // Index of the game thread task buffer to write to
-  int mGameThreadTaskWriteIndex;
   // To tell the system to shut down once everything stops.
   ThreadedInt mShuttingDown;
   // Overall system volume.
@@ -168,6 +311,9 @@ private:
   // If true the output is being resampled to match the sample rate of the
   // device
   bool mResamplingThreaded;
+  // The interface the mix writes its output to (AudioIO, or OfflineIO during
+  // MixOffline)
+  AudioIOInterface* mOutputIOThreaded;
   // If true, audio will be processed normally but will not be sent to the
   // output device
   ThreadedInt mMuted;
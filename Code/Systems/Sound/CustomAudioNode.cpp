@@ -175,7 +175,7 @@ bool CustomAudioNode::GetOutputSamples(BufferType* outputBuffer, const unsigned
     if (!mWaitingForSamplesThreaded)
     {
       mWaitingForSamplesThreaded = true;
-      Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&CustomAudioNode::DispatchSamplesEvent, this, mMinimumSamplesNeededInBuffersThreaded * 2), this);
+      Z::gSound->Mixer.AddTaskThreaded(&CustomAudioNode::DispatchSamplesEvent, this, mMinimumSamplesNeededInBuffersThreaded * 2, this);
     }
     return false;
   }
@@ -245,7 +245,7 @@ bool CustomAudioNode::GetOutputSamples(BufferType* outputBuffer, const unsigned
     mWaitingForSamplesThreaded = true;
     unsigned samplesNeeded = mMinimumSamplesNeededInBuffersThreaded - mTotalSamplesInBuffersThreaded + mMinimumSamplesNeededInBuffersThreaded;
     samplesNeeded -= samplesNeeded % channels;
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&CustomAudioNode::DispatchSamplesEvent, this, samplesNeeded), this);
+    Z::gSound->Mixer.AddTaskThreaded(&CustomAudioNode::DispatchSamplesEvent, this, samplesNeeded, this);
   }
 
   return true;
@@ -264,7 +264,7 @@ void CustomAudioNode::AddBufferThreaded(SampleBuffer* newBuffer)
   {
     unsigned samplesNeeded = mMinimumSamplesNeededInBuffersThreaded - mTotalSamplesInBuffersThreaded + mMinimumSamplesNeededInBuffersThreaded;
     samplesNeeded -= samplesNeeded % mChannels.Get(AudioThreads::MixThread);
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&CustomAudioNode::DispatchSamplesEvent, this, samplesNeeded), this);
+    Z::gSound->Mixer.AddTaskThreaded(&CustomAudioNode::DispatchSamplesEvent, this, samplesNeeded, this);
   }
 }
 
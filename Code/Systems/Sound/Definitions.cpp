@@ -34,6 +34,26 @@ void AudioConstants::AppendToBuffer(BufferType* destinationBuffer, const BufferT
   memcpy(destinationBuffer->Data() + destIndex, sourceBuffer.Data() + sourceStartIndex, sizeof(float) * numberOfSamples);
 }
 
+void AudioConstants::ScaleBuffer(const float* source, float* destination, float volume, unsigned numberOfSamples)
+{
+  for (unsigned i = 0; i < numberOfSamples; ++i)
+    destination[i] = source[i] * volume;
+}
+
+void AudioConstants::MixBuffer(const float* source, float* destination, float volume, unsigned numberOfSamples)
+{
+  for (unsigned i = 0; i < numberOfSamples; ++i)
+    destination[i] += source[i] * volume;
+}
+
+void AudioConstants::BlendBuffer(const float* source, float* destination, float sourceAmount, unsigned numberOfSamples)
+{
+  float destinationAmount = 1.0f - sourceAmount;
+
+  for (unsigned i = 0; i < numberOfSamples; ++i)
+    destination[i] = (source[i] * sourceAmount) + (destination[i] * destinationAmount);
+}
+
 float AudioConstants::PitchToSemitones(float pitch)
 {
   if (pitch == 0)
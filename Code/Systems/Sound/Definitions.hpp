@@ -50,6 +50,15 @@ bool IsWithinLimit(float valueToCheck, float centralValue, float limit);
 
 void AppendToBuffer(BufferType* destinationBuffer, const BufferType& sourceBuffer, unsigned sourceStartIndex, unsigned numberOfSamples);
 
+// Block operations on interleaved samples
+
+// destination = source * volume (source and destination may be the same buffer)
+void ScaleBuffer(const float* source, float* destination, float volume, unsigned numberOfSamples);
+// destination += source * volume
+void MixBuffer(const float* source, float* destination, float volume, unsigned numberOfSamples);
+// destination = (source * sourceAmount) + (destination * (1 - sourceAmount))
+void BlendBuffer(const float* source, float* destination, float sourceAmount, unsigned numberOfSamples);
+
 float PitchToSemitones(float pitch);
 
 float SemitonesToPitch(float semitone);
@@ -62,6 +71,10 @@ float DecibelsToVolume(float decibels);
 
 // These helpers exist to fix template order issues by forcing implementation in the cpp files.
 void SetThreadedValue(Functor* task, AudioThreads::Enum threadCalledOn);
+// Sets a main thread value from the mix thread without allocating memory
+// (implemented after the SoundSystem)
+template <typename T>
+void SetThreadedValueFromMixThread(T* pointer, T value);
 
 template <typename T>
 class Threaded
@@ -88,7 +101,7 @@ public:
     if (threadCalledOn == AudioThreads::MainThread)
       SetThreadedValue(CreateFunctor(&mValues[AudioThreads::MixThread], value), threadCalledOn);
     else
-      SetThreadedValue(CreateFunctor(&mValues[AudioThreads::MainThread], value), threadCalledOn);
+      SetThreadedValueFromMixThread(&mValues[AudioThreads::MainThread], value);
   }
 
   void SetDirectly(T value)
@@ -80,30 +80,30 @@ bool VolumeNode::GetOutputSamples(BufferType* outputBuffer, const unsigned numbe
     return false;
 
   // Apply volume adjustment
-  for (BufferRange outputRange = outputBuffer->All(), inputRange = mInputSamplesThreaded.All(); !outputRange.Empty();)
+  // (The volume changes every frame while it is being interpolated)
+  unsigned index = 0;
+  for (; index < bufferSize && CurrentData.mInterpolating; index += numberOfChannels)
   {
-    // Check if the volume is being interpolated
-    if (CurrentData.mInterpolating)
-    {
-      // Get the current volume and increase the index
-      mVolume.Set(Interpolator.ValueAtIndex(CurrentData.mIndex++), AudioThreads::MixThread);
+    // Get the current volume and increase the index
+    mVolume.Set(Interpolator.ValueAtIndex(CurrentData.mIndex++), AudioThreads::MixThread);
 
-      // Check if the interpolation is finished
-      if (CurrentData.mIndex >= Interpolator.GetTotalFrames())
+    // Check if the interpolation is finished
+    if (CurrentData.mIndex >= Interpolator.GetTotalFrames())
+    {
+      CurrentData.mInterpolating = false;
+      if (firstRequest)
       {
-        CurrentData.mInterpolating = false;
-        if (firstRequest)
-        {
-          Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundNode::DispatchEventFromMixThread, (SoundNode*)this, Events::AudioInterpolationDone), this);
-        }
+        Z::gSound->Mixer.AddTaskThreaded(&SoundNode::DispatchEventFromMixThread, (SoundNode*)this, Events::AudioInterpolationDone, this);
       }
     }
 
-    // Apply the volume multiplier to all samples
-    for (unsigned j = 0; j < numberOfChannels; ++j, outputRange.PopFront(), inputRange.PopFront())
-      outputRange.Front() = inputRange.Front() * mVolume.Get(AudioThreads::MixThread);
+    // Apply the volume multiplier to all samples in the frame
+    ScaleBuffer(mInputSamplesThreaded.Data() + index, outputBuffer->Data() + index, mVolume.Get(AudioThreads::MixThread), numberOfChannels);
   }
 
+  // Apply the constant volume to the rest of the samples
+  ScaleBuffer(mInputSamplesThreaded.Data() + index, outputBuffer->Data() + index, mVolume.Get(AudioThreads::MixThread), bufferSize - index);
+
   AddBypassThreaded(outputBuffer);
 
   return true;
@@ -247,7 +247,7 @@ bool PanningNode::GetOutputSamples(BufferType* outputBuffer, const unsigned numb
         {
           CurrentData.mInterpolating = false;
           if (firstRequest)
-            Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundNode::DispatchEventFromMixThread, (SoundNode*)this, Events::AudioInterpolationDone), this);
+            Z::gSound->Mixer.AddTaskThreaded(&SoundNode::DispatchEventFromMixThread, (SoundNode*)this, Events::AudioInterpolationDone, this);
         }
       }
 
@@ -475,7 +475,7 @@ bool LowPassNode::GetOutputSamples(BufferType* outputBuffer, const unsigned numb
   }
 
   // Apply filter
-  filter->ProcessBuffer(mInputSamplesThreaded.Data(), outputBuffer->Data(), numberOfChannels, bufferSize);
+  filter->ProcessBlock(mInputSamplesThreaded.Data(), outputBuffer->Data(), bufferSize / numberOfChannels, numberOfChannels);
 
   AddBypassThreaded(outputBuffer);
 
@@ -565,8 +565,7 @@ bool HighPassNode::GetOutputSamples(BufferType* outputBuffer, const unsigned num
   }
 
   // Apply filter
-  for (unsigned i = 0; i < bufferSize; i += numberOfChannels)
-    filter->ProcessFrame(mInputSamplesThreaded.Data() + i, outputBuffer->Data() + i, numberOfChannels);
+  filter->ProcessBlock(mInputSamplesThreaded.Data(), outputBuffer->Data(), bufferSize / numberOfChannels, numberOfChannels);
 
   AddBypassThreaded(outputBuffer);
 
@@ -661,8 +660,7 @@ bool BandPassNode::GetOutputSamples(BufferType* outputBuffer, const unsigned num
   }
 
   // Apply filter
-  for (unsigned i = 0; i < bufferSize; i += numberOfChannels)
-    filter->ProcessFrame(mInputSamplesThreaded.Data() + i, outputBuffer->Data() + i, numberOfChannels);
+  filter->ProcessBlock(mInputSamplesThreaded.Data(), outputBuffer->Data(), bufferSize / numberOfChannels, numberOfChannels);
 
   AddBypassThreaded(outputBuffer);
 
@@ -995,6 +993,170 @@ void ReverbNode::InterpolateWetValueThreaded(float value, float time)
     filter->InterpolateWetLevel(value, time);
 }
 
+// Convolution Reverb Node
+
+RaverieDefineType(ConvolutionReverbNode, builder, type)
+{
+  RaverieBindDocumented();
+
+  RaverieBindGetterSetter(ImpulseResponse);
+  RaverieBindGetterSetter(WetValue);
+  RaverieBindMethod(InterpolateWetValue);
+}
+
+ConvolutionReverbNode::ConvolutionReverbNode(StringParam name, unsigned ID) :
+    SimpleCollapseNode(name, ID, false, false),
+    mWetLevelValue(0.5f),
+    mSpectraThreaded(nullptr),
+    mOutputFinishedThreaded(true)
+{
+}
+
+ConvolutionReverbNode::~ConvolutionReverbNode()
+{
+  DeleteFiltersThreaded();
+  delete mSpectraThreaded;
+}
+
+HandleOf<Sound> ConvolutionReverbNode::GetImpulseResponse()
+{
+  return mImpulseResponse;
+}
+
+void ConvolutionReverbNode::SetImpulseResponse(HandleOf<Sound> sound)
+{
+  mImpulseResponse = sound;
+  Z::gSound->Mixer.AddTask(CreateFunctor(&ConvolutionReverbNode::SetImpulseResponseThreaded, this, sound), this);
+}
+
+float ConvolutionReverbNode::GetWetValue()
+{
+  return mWetLevelValue.Get(AudioThreads::MainThread);
+}
+
+void ConvolutionReverbNode::SetWetValue(float value)
+{
+  value = Math::Clamp(value, 0.0f, 1.0f);
+  mWetLevelValue.Set(value, AudioThreads::MainThread);
+  Z::gSound->Mixer.AddTask(CreateFunctor(&ConvolutionReverbNode::SetWetValueThreaded, this, value), this);
+}
+
+void ConvolutionReverbNode::InterpolateWetValue(float value, float time)
+{
+  value = Math::Clamp(value, 0.0f, 1.0f);
+  mWetLevelValue.Set(value, AudioThreads::MainThread);
+  Z::gSound->Mixer.AddTask(CreateFunctor(&ConvolutionReverbNode::InterpolateWetValueThreaded, this, value, time), this);
+}
+
+bool ConvolutionReverbNode::GetOutputSamples(BufferType* outputBuffer, const unsigned numberOfChannels, ListenerNode* listener, const bool firstRequest)
+{
+  unsigned bufferSize = outputBuffer->Size();
+
+  // Get input
+  bool isThereInput = AccumulateInputSamples(bufferSize, numberOfChannels, listener);
+
+  // No input and the filter has no output
+  if (!isThereInput && mOutputFinishedThreaded)
+    return false;
+
+  // No impulse response, so pass the input through
+  if (!mSpectraThreaded)
+  {
+    mOutputFinishedThreaded = true;
+    if (!isThereInput)
+      return false;
+
+    mInputSamplesThreaded.Swap(*outputBuffer);
+    AddBypassThreaded(outputBuffer);
+    return true;
+  }
+
+  // Check if the listener is in the map
+  ConvolutionReverb* filter = FiltersPerListener.FindValue(listener, nullptr);
+  if (!filter)
+  {
+    filter = new ConvolutionReverb(mSpectraThreaded);
+    filter->SetWetLevel(mWetLevelValue.Get(AudioThreads::MixThread));
+    FiltersPerListener[listener] = filter;
+  }
+
+  bool hasOutput = filter->ProcessBuffer(mInputSamplesThreaded.Data(), outputBuffer->Data(), numberOfChannels, bufferSize);
+
+  if (!isThereInput && !hasOutput)
+    mOutputFinishedThreaded = true;
+  else
+    mOutputFinishedThreaded = false;
+
+  AddBypassThreaded(outputBuffer);
+
+  return true;
+}
+
+void ConvolutionReverbNode::RemoveListenerThreaded(SoundEvent* event)
+{
+  ListenerNode* listener = (ListenerNode*)event->mPointer;
+
+  if (FiltersPerListener.FindValue(listener, nullptr))
+  {
+    delete FiltersPerListener[listener];
+    FiltersPerListener.Erase(listener);
+  }
+}
+
+void ConvolutionReverbNode::SetImpulseResponseThreaded(HandleOf<Sound> sound)
+{
+  SoundAsset* asset = sound ? sound->mAsset : nullptr;
+  if (!asset || asset->mFrameCount == 0)
+  {
+    SetSpectraThreaded(nullptr);
+    return;
+  }
+
+  unsigned channels = asset->mChannels;
+  unsigned frames = Math::Min(asset->mFrameCount, cMaxImpulseSeconds * (unsigned)cSystemSampleRate);
+
+  // Get the audio samples from the asset and send them to the main thread
+  BufferType* samples = new BufferType;
+  asset->AppendSamplesThreaded(samples, 0, frames * channels, cNodeID);
+  Z::gSound->Mixer.AddTaskThreaded(&ConvolutionReverbNode::CreateSpectra, this, samples, channels, this);
+}
+
+void ConvolutionReverbNode::CreateSpectra(BufferType* samples, unsigned channels)
+{
+  ImpulseResponseSpectra* spectra = new ImpulseResponseSpectra(samples->Data(), samples->Size() / channels, channels, cPartitionFrames);
+  delete samples;
+
+  Z::gSound->Mixer.AddTask(CreateFunctor(&ConvolutionReverbNode::SetSpectraThreaded, this, spectra), this);
+}
+
+void ConvolutionReverbNode::SetSpectraThreaded(ImpulseResponseSpectra* spectra)
+{
+  // The filters use the spectra, so they are created again when needed
+  DeleteFiltersThreaded();
+
+  delete mSpectraThreaded;
+  mSpectraThreaded = spectra;
+}
+
+void ConvolutionReverbNode::SetWetValueThreaded(float value)
+{
+  forRange (ConvolutionReverb* filter, FiltersPerListener.Values())
+    filter->SetWetLevel(value);
+}
+
+void ConvolutionReverbNode::InterpolateWetValueThreaded(float value, float time)
+{
+  forRange (ConvolutionReverb* filter, FiltersPerListener.Values())
+    filter->InterpolateWetLevel(value, time);
+}
+
+void ConvolutionReverbNode::DeleteFiltersThreaded()
+{
+  forRange (ConvolutionReverb* filter, FiltersPerListener.Values())
+    delete filter;
+  FiltersPerListener.Clear();
+}
+
 // Delay Node
 
 RaverieDefineType(DelayNode, builder, type)
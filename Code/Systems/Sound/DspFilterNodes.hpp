@@ -384,6 +384,68 @@ private:
   FilterMapType FiltersPerListener;
 };
 
+// Convolution Reverb Node
+
+/// Applies reverb to audio generated by its input SoundNodes by convolving it
+/// with an impulse response: a Sound recording of how a space responds to a
+/// short sound. This can produce realistic room acoustics at a fixed cost per
+/// mix, which does not depend on the ImpulseResponse's length once it is
+/// loaded. The output is delayed by about 5 milliseconds.
+class ConvolutionReverbNode : public SimpleCollapseNode
+{
+public:
+  RaverieDeclareType(ConvolutionReverbNode, TypeCopyMode::ReferenceType);
+
+  ConvolutionReverbNode(StringParam name, unsigned ID);
+  ~ConvolutionReverbNode();
+
+  /// The Sound resource used as the impulse response. Its volume is normalized,
+  /// and only the first 10 seconds are used. If there is no impulse response
+  /// the audio is not changed.
+  HandleOf<Sound> GetImpulseResponse();
+  void SetImpulseResponse(HandleOf<Sound> sound);
+  /// The percentage of the node's output (0 - 1.0) which has the reverb filter
+  /// applied to it. Setting this property to 0 will stop all reverb
+  /// calculations.
+  float GetWetValue();
+  void SetWetValue(float value);
+  /// Interpolates the WetValue property from its current value to the value
+  /// passed in as the first parameter, over the number of seconds passed in as
+  /// the second parameter.
+  void InterpolateWetValue(float value, float time);
+
+  // The number of frames in each partition of the impulse response
+  static const unsigned cPartitionFrames = 256;
+  // The longest impulse response that will be used, in seconds
+  static const unsigned cMaxImpulseSeconds = 10;
+
+private:
+  bool GetOutputSamples(BufferType* outputBuffer, const unsigned numberOfChannels, ListenerNode* listener, const bool firstRequest) override;
+  void RemoveListenerThreaded(SoundEvent* event) override;
+  // Gets the impulse response's samples (must be done on the mix thread)
+  void SetImpulseResponseThreaded(HandleOf<Sound> sound);
+  // Creates the impulse response spectra from the samples on the main thread,
+  // so the transforms don't delay the mix
+  void CreateSpectra(BufferType* samples, unsigned channels);
+  void SetSpectraThreaded(ImpulseResponseSpectra* spectra);
+  void SetWetValueThreaded(float value);
+  void InterpolateWetValueThreaded(float value, float time);
+  // Deletes the filters for all listeners
+  void DeleteFiltersThreaded();
+
+  // The impulse response Sound
+  HandleOf<Sound> mImpulseResponse;
+  // The current wet level (0 - 1.0f)
+  Threaded<float> mWetLevelValue;
+  // The spectra of the impulse response, shared by all filters
+  ImpulseResponseSpectra* mSpectraThreaded;
+  // Whether the reverb tail has finished
+  bool mOutputFinishedThreaded;
+  // The filter used for calculations
+  typedef Raverie::HashMap<ListenerNode*, ConvolutionReverb*> FilterMapType;
+  FilterMapType FiltersPerListener;
+};
+
 // Delay Node
 
 /// Applies a delay filter to audio generated by its input SoundNodes
@@ -485,6 +485,13 @@ void StreamingDecoder::DecodingLoopThreaded()
   }
 }
 
+void StreamingDecoder::RunDecodingTask()
+{
+  // Unlike the base class, each section is decoded only when requested, the
+  // same as the decoding thread
+  DecodePacketThreaded();
+}
+
 int StreamingDecoder::GetNextPacket(byte* packetData)
 {
   if (mCompressedData)
@@ -94,7 +94,7 @@ public:
   // getting packet fails or if the end of the data was reached.
   virtual int GetNextPacket(byte* packetData) = 0;
   // Called to decode the next packet when the system is not threaded
-  void RunDecodingTask();
+  virtual void RunDecodingTask();
   // Requests the next chunk of decoded data
   void DecodeNextSection();
 
@@ -173,6 +173,9 @@ public:
   // Fills in the provided buffer with the next packet data. Returns -1 if
   // getting packet fails or if the end of the data was reached.
   int GetNextPacket(byte* packetData) override;
+  // Called to decode the next packet when the system is not threaded (only
+  // decodes the packets that were requested)
+  void RunDecodingTask() override;
   // Resets streaming decoding to the beginning
   void Reset();
 
@@ -42,6 +42,40 @@ float BiQuad::DoBiQuad(const float x)
   return y;
 }
 
+void BiQuad::ProcessBlock(const float* input, float* output, const unsigned frames, const unsigned stride)
+{
+  // Keep the history in locals while filtering the block
+  float x1 = x_1;
+  float x2 = x_2;
+  float y1 = y_1;
+  float y2 = y_2;
+
+  for (unsigned i = 0, index = 0; i < frames; ++i, index += stride)
+  {
+    float x = input[index];
+    float y = (a0 * x) + (a1 * x1) + (a2 * x2) - (b1 * y1) - (b2 * y2);
+
+    y2 = y1;
+    y1 = y;
+    x2 = x1;
+    x1 = x;
+
+    output[index] = y;
+  }
+
+  x_1 = x1;
+  x_2 = x2;
+  y_1 = y1;
+  y_2 = y2;
+}
+
+void BiQuad::ProcessChannels(BiQuad* biQuadsPerChannel, const float* input, float* output, const unsigned frames, const unsigned numChannels)
+{
+  // Filter each channel of the interleaved buffer with its own BiQuad
+  for (unsigned channel = 0; channel < numChannels; ++channel)
+    biQuadsPerChannel[channel].ProcessBlock(input + channel, output + channel, frames, numChannels);
+}
+
 void BiQuad::AddHistoryTo(BiQuad& otherFilter)
 {
   otherFilter.x_1 += x_1;
@@ -303,16 +337,21 @@ void LowPassFilter::ProcessFrame(const float* input, float* output, const unsign
   }
 }
 
-void LowPassFilter::ProcessBuffer(const float* input, float* output, const unsigned numChannels, const unsigned numSamples)
+void LowPassFilter::ProcessBlock(const float* input, float* output, const unsigned frames, const unsigned numChannels)
 {
   if (CutoffFrequency > 20000.0f)
   {
-    memcpy(output, input, sizeof(float) * numSamples);
+    if (output != input)
+      memcpy(output, input, sizeof(float) * frames * numChannels);
     return;
   }
 
-  for (unsigned i = 0; i < numSamples; i += numChannels)
-    ProcessFrame(input + i, output + i, numChannels);
+  BiQuad::ProcessChannels(BiQuadsPerChannel, input, output, frames, numChannels);
+}
+
+void LowPassFilter::ProcessBuffer(const float* input, float* output, const unsigned numChannels, const unsigned numSamples)
+{
+  ProcessBlock(input, output, numSamples / numChannels, numChannels);
 }
 
 float LowPassFilter::GetCutoffFrequency()
@@ -372,6 +411,18 @@ void HighPassFilter::ProcessFrame(const float* input, float* output, const unsig
   }
 }
 
+void HighPassFilter::ProcessBlock(const float* input, float* output, const unsigned frames, const unsigned numChannels)
+{
+  if (CutoffFrequency < 20.0f)
+  {
+    if (output != input)
+      memcpy(output, input, sizeof(float) * frames * numChannels);
+    return;
+  }
+
+  BiQuad::ProcessChannels(BiQuadsPerChannel, input, output, frames, numChannels);
+}
+
 // Band Pass Filter
 
 BandPassFilter::BandPassFilter() : Quality(0.669f), CentralFreq(1000.0f)
@@ -420,6 +471,37 @@ void BandPassFilter::ProcessFrame(const float* input, float* output, const unsig
   }
 }
 
+void BandPassFilter::ProcessBlock(const float* input, float* output, const unsigned frames, const unsigned numChannels)
+{
+  float inputFactor = AlphaHP * (1 - AlphaLP);
+  float output1Factor = AlphaHP + AlphaLP;
+  float output2Factor = AlphaLP * AlphaHP;
+
+  for (unsigned channel = 0; channel < numChannels; ++channel)
+  {
+    // Keep the history in locals while filtering the channel
+    float previousInput = PreviousInput[channel];
+    float previousOutput1 = PreviousOutput1[channel];
+    float previousOutput2 = PreviousOutput2[channel];
+
+    for (unsigned i = 0, index = channel; i < frames; ++i, index += numChannels)
+    {
+      float inputSample = input[index];
+      float outputSample = (inputFactor * (inputSample - previousInput)) + (output1Factor * previousOutput1) - (output2Factor * previousOutput2);
+
+      previousInput = inputSample;
+      previousOutput2 = previousOutput1;
+      previousOutput1 = outputSample;
+
+      output[index] = outputSample;
+    }
+
+    PreviousInput[channel] = previousInput;
+    PreviousOutput1[channel] = previousOutput1;
+    PreviousOutput2[channel] = previousOutput2;
+  }
+}
+
 void BandPassFilter::ResetFrequencies()
 {
   HighPassCutoff = (2.0f * CentralFreq * Quality) / (Math::Sqrt(4.0f * Quality * Quality + 1.0f) + 1.0f);
@@ -1139,40 +1221,56 @@ Equalizer::Equalizer(float* values)
 
 void Equalizer::ProcessBuffer(const float* input, float* output, const unsigned numChannels, const unsigned bufferSize)
 {
-  Raverie::Array<float> resultSamples(numChannels);
+  unsigned frames = bufferSize / numChannels;
+  mBandSamples.Resize(bufferSize);
 
-  for (unsigned i = 0; i < bufferSize; i += numChannels)
-  {
-    LowPass.ProcessFrame(input + i, resultSamples.Data(), numChannels);
-    if (!LowPassInterpolator.Finished())
-      mBandGains[EqualizerBands::Below80] = LowPassInterpolator.NextValue();
-    for (unsigned j = 0; j < numChannels; ++j)
-      output[i + j] = resultSamples[j] * mBandGains[EqualizerBands::Below80];
+  // Filter the whole buffer one band at a time, summing the results into the
+  // output (the first band sets the output)
+  LowPass.ProcessBlock(input, mBandSamples.Data(), frames, numChannels);
+  ApplyBandGain(EqualizerBands::Below80, LowPassInterpolator, output, frames, numChannels);
 
-    Band1.ProcessFrame(input + i, resultSamples.Data(), numChannels);
-    if (!Band1Interpolator.Finished())
-      mBandGains[EqualizerBands::At150] = Band1Interpolator.NextValue();
-    for (unsigned j = 0; j < numChannels; ++j)
-      output[i + j] += resultSamples[j] * mBandGains[EqualizerBands::At150];
+  Band1.ProcessBlock(input, mBandSamples.Data(), frames, numChannels);
+  ApplyBandGain(EqualizerBands::At150, Band1Interpolator, output, frames, numChannels);
 
-    Band2.ProcessFrame(input + i, resultSamples.Data(), numChannels);
-    if (!Band2Interpolator.Finished())
-      mBandGains[EqualizerBands::At600] = Band2Interpolator.NextValue();
-    for (unsigned j = 0; j < numChannels; ++j)
-      output[i + j] += resultSamples[j] * mBandGains[EqualizerBands::At600];
+  Band2.ProcessBlock(input, mBandSamples.Data(), frames, numChannels);
+  ApplyBandGain(EqualizerBands::At600, Band2Interpolator, output, frames, numChannels);
 
-    Band3.ProcessFrame(input + i, resultSamples.Data(), numChannels);
-    if (!Band3Interpolator.Finished())
-      mBandGains[EqualizerBands::At2500] = Band3Interpolator.NextValue();
-    for (unsigned j = 0; j < numChannels; ++j)
-      output[i + j] += resultSamples[j] * mBandGains[EqualizerBands::At2500];
+  Band3.ProcessBlock(input, mBandSamples.Data(), frames, numChannels);
+  ApplyBandGain(EqualizerBands::At2500, Band3Interpolator, output, frames, numChannels);
 
-    HighPass.ProcessFrame(input + i, resultSamples.Data(), numChannels);
-    if (!HighPassInterpolator.Finished())
-      mBandGains[EqualizerBands::Above5000] = HighPassInterpolator.NextValue();
-    for (unsigned j = 0; j < numChannels; ++j)
-      output[i + j] += resultSamples[j] * mBandGains[EqualizerBands::Above5000];
+  HighPass.ProcessBlock(input, mBandSamples.Data(), frames, numChannels);
+  ApplyBandGain(EqualizerBands::Above5000, HighPassInterpolator, output, frames, numChannels);
+}
+
+void Equalizer::ApplyBandGain(EqualizerBands::Enum whichBand, InterpolatingObject& interpolator, float* output, const unsigned frames, const unsigned numChannels)
+{
+  bool firstBand = whichBand == EqualizerBands::Below80;
+  float& gain = mBandGains[whichBand];
+  const float* bandSamples = mBandSamples.Data();
+
+  // The gain changes every frame while interpolating
+  unsigned frame = 0;
+  for (; frame < frames && !interpolator.Finished(); ++frame)
+  {
+    gain = interpolator.NextValue();
+
+    unsigned index = frame * numChannels;
+    for (unsigned j = 0; j < numChannels; ++j, ++index)
+    {
+      if (firstBand)
+        output[index] = bandSamples[index] * gain;
+      else
+        output[index] += bandSamples[index] * gain;
+    }
   }
+
+  // The gain is constant for the rest of the buffer
+  unsigned startIndex = frame * numChannels;
+  unsigned remainingSamples = (frames * numChannels) - startIndex;
+  if (firstBand)
+    ScaleBuffer(bandSamples + startIndex, output + startIndex, gain, remainingSamples);
+  else
+    MixBuffer(bandSamples + startIndex, output + startIndex, gain, remainingSamples);
 }
 
 float Equalizer::GetBandGain(EqualizerBands::Enum whichBand)
@@ -1559,140 +1657,373 @@ void FFT::DoFFT(ComplexNumber* samples, const int numberOfSamples, const bool fo
   }
 }
 
-// Transform Convolver
+// Split Complex FFT
 
-int NextPowerOf2(const int& value)
+SplitComplexFFT::SplitComplexFFT() : mSize(0)
 {
-  int nextPowerOf2 = 1;
-  while (nextPowerOf2 < value)
-    nextPowerOf2 *= 2;
+}
+
+void SplitComplexFFT::SetSize(unsigned size)
+{
+  ErrorIf((size & (size - 1)) != 0, "FFT size must be a power of two");
+  mSize = size;
+
+  unsigned bits = 0;
+  while ((1u << bits) < size)
+    ++bits;
 
-  return nextPowerOf2;
+  // Bit reversal table
+  mReverseTable.Resize(size);
+  for (unsigned i = 0; i < size; ++i)
+  {
+    unsigned reversed = 0;
+    for (unsigned bit = 0; bit < bits; ++bit)
+    {
+      if (i & (1 << bit))
+        reversed |= 1 << (bits - 1 - bit);
+    }
+    mReverseTable[i] = reversed;
+  }
+
+  // Twiddle factors for each stage
+  unsigned tableSize = Math::Max(size, 1u) - 1;
+  mCosines.Resize(tableSize);
+  mForwardSines.Resize(tableSize);
+  mBackwardSines.Resize(tableSize);
+  for (unsigned half = 1; half < size; half *= 2)
+  {
+    for (unsigned k = 0; k < half; ++k)
+    {
+      float angle = Math::cPi * k / half;
+      mCosines[half - 1 + k] = Math::Cos(angle);
+      mForwardSines[half - 1 + k] = -Math::Sin(angle);
+      mBackwardSines[half - 1 + k] = Math::Sin(angle);
+    }
+  }
 }
 
-FFTConvolver::FFTConvolver() : mBlockSize(0), mSegmentCount(0), mBufferPosition(0), mCurrentSegment(0)
+unsigned SplitComplexFFT::GetSize() const
 {
+  return mSize;
 }
 
-FFTConvolver::~FFTConvolver()
+void SplitComplexFFT::Forward(float* real, float* imaginary) const
 {
-  Reset();
+  Transform(real, imaginary, mForwardSines);
 }
 
-bool FFTConvolver::Initialize(int blockSize, const float* impulseResponse, int irLength)
+void SplitComplexFFT::Backward(float* real, float* imaginary) const
 {
-  Reset();
+  Transform(real, imaginary, mBackwardSines);
+
+  float scale = 1.0f / mSize;
+  for (unsigned i = 0; i < mSize; ++i)
+  {
+    real[i] *= scale;
+    imaginary[i] *= scale;
+  }
+}
+
+void SplitComplexFFT::Transform(float* real, float* imaginary, const Array<float>& sines) const
+{
+  // Put the values in bit reversed order
+  for (unsigned i = 0; i < mSize; ++i)
+  {
+    unsigned j = mReverseTable[i];
+    if (i < j)
+    {
+      Math::Swap(real[i], real[j]);
+      Math::Swap(imaginary[i], imaginary[j]);
+    }
+  }
 
-  // if (blockSize == 0)
-  //  return false;
+  // Combine pairs of transforms, doubling their size each stage
+  for (unsigned half = 1; half < mSize; half *= 2)
+  {
+    const float* stageCosines = mCosines.Data() + (half - 1);
+    const float* stageSines = sines.Data() + (half - 1);
 
-  //// Remove zeros at end of impulse response
-  // while (irLength > 0 && Math::Abs(impulseResponse[irLength - 1]) <
-  // 0.000001f)
-  //  --irLength;
+    for (unsigned start = 0; start < mSize; start += half * 2)
+    {
+      float* firstReal = real + start;
+      float* firstImaginary = imaginary + start;
+      float* secondReal = firstReal + half;
+      float* secondImaginary = firstImaginary + half;
 
-  // if (irLength == 0)
-  //  return true;
+      for (unsigned k = 0; k < half; ++k)
+      {
+        float tReal = stageCosines[k] * secondReal[k] - stageSines[k] * secondImaginary[k];
+        float tImaginary = stageCosines[k] * secondImaginary[k] + stageSines[k] * secondReal[k];
 
-  mBlockSize = NextPowerOf2(blockSize);
+        secondReal[k] = firstReal[k] - tReal;
+        secondImaginary[k] = firstImaginary[k] - tImaginary;
+        firstReal[k] += tReal;
+        firstImaginary[k] += tImaginary;
+      }
+    }
+  }
+}
 
-  mStoredInputBuffer.Resize(mBlockSize);
-  mBufferPosition = 0;
+// Impulse Response Spectra
 
-  mSegmentCount = (int)((float)irLength / (float)mBlockSize);
-  mCurrentSegment = 0;
-  for (int i = 0; i < mSegmentCount; ++i)
-    mSegments.PushBack(ComplexListType(mBlockSize));
+ImpulseResponseSpectra::ImpulseResponseSpectra(const float* samples, unsigned frames, unsigned channels, unsigned partitionFrames) :
+    mPartitionFrames(partitionFrames),
+    mPartitionCount(Math::Max((frames + partitionFrames - 1) / partitionFrames, 1u)),
+    mSpectrumSize(partitionFrames + 1),
+    mChannels(Math::Max(channels, 1u))
+{
+  // Each transform covers two partitions so the convolution doesn't wrap around
+  unsigned transformSize = partitionFrames * 2;
+  mFFT.SetSize(transformSize);
 
-  for (int i = 0; i < mSegmentCount; ++i)
+  // Find the channel with the most energy
+  float maxEnergy = 0.0f;
+  for (unsigned channel = 0; channel < channels; ++channel)
   {
-    int remaining = irLength - (i * mBlockSize);
-    int sizeToProcess;
-    if (remaining >= mBlockSize)
-      sizeToProcess = mBlockSize;
-    else
-      sizeToProcess = remaining;
-    mSegmentsIR.PushBack(ComplexListType(sizeToProcess));
-    FFT::Forward(impulseResponse + (i * mBlockSize), mSegmentsIR.Back().Data(), sizeToProcess);
+    float energy = 0.0f;
+    for (unsigned frame = 0; frame < frames; ++frame)
+    {
+      float sample = samples[(frame * channels) + channel];
+      energy += sample * sample;
+    }
+    maxEnergy = Math::Max(maxEnergy, energy);
   }
+  float scale = maxEnergy > 0.0f ? 1.0f / Math::Sqrt(maxEnergy) : 0.0f;
+
+  mReal.Resize(mChannels * mPartitionCount * mSpectrumSize, 0.0f);
+  mImaginary.Resize(mChannels * mPartitionCount * mSpectrumSize, 0.0f);
 
-  mConvolvedSamples.Resize(mBlockSize);
-  mOverlap.Resize(mBlockSize);
+  Array<float> real(transformSize);
+  Array<float> imaginary(transformSize);
+  for (unsigned channel = 0; channel < channels; ++channel)
+  {
+    for (unsigned partition = 0; partition < mPartitionCount; ++partition)
+    {
+      // Copy this partition's samples, followed by zeros
+      memset(real.Data(), 0, sizeof(float) * transformSize);
+      memset(imaginary.Data(), 0, sizeof(float) * transformSize);
+      unsigned firstFrame = partition * partitionFrames;
+      for (unsigned frame = firstFrame; frame < frames && frame < firstFrame + partitionFrames; ++frame)
+        real[frame - firstFrame] = samples[(frame * channels) + channel] * scale;
+
+      mFFT.Forward(real.Data(), imaginary.Data());
+
+      // Keep the non-redundant half of the spectrum
+      unsigned offset = ((channel * mPartitionCount) + partition) * mSpectrumSize;
+      memcpy(mReal.Data() + offset, real.Data(), sizeof(float) * (partitionFrames + 1));
+      memcpy(mImaginary.Data() + offset, imaginary.Data(), sizeof(float) * (partitionFrames + 1));
+    }
+  }
+}
 
-  return true;
+const float* ImpulseResponseSpectra::GetReal(unsigned channel, unsigned partition) const
+{
+  return mReal.Data() + ((channel * mPartitionCount) + partition) * mSpectrumSize;
 }
 
-void FFTConvolver::ProcessBuffer(const float* input, float* output, int length)
+const float* ImpulseResponseSpectra::GetImaginary(unsigned channel, unsigned partition) const
 {
-  if (mSegmentCount == 0)
+  return mImaginary.Data() + ((channel * mPartitionCount) + partition) * mSpectrumSize;
+}
+
+// Partitioned Convolver
+
+PartitionedConvolver::PartitionedConvolver(const ImpulseResponseSpectra* impulseResponse, unsigned channel) :
+    mImpulseResponse(impulseResponse),
+    mChannel(channel % impulseResponse->mChannels),
+    mBlockPosition(0),
+    mDelayLineIndex(0)
+{
+  unsigned partitionFrames = mImpulseResponse->mPartitionFrames;
+  unsigned delayLineSize = mImpulseResponse->mPartitionCount * mImpulseResponse->mSpectrumSize;
+
+  mInputBlock.Resize(partitionFrames * 2, 0.0f);
+  mOutputBlock.Resize(partitionFrames, 0.0f);
+  mDelayLineReal.Resize(delayLineSize, 0.0f);
+  mDelayLineImaginary.Resize(delayLineSize, 0.0f);
+  mReal.Resize(partitionFrames * 2, 0.0f);
+  mImaginary.Resize(partitionFrames * 2, 0.0f);
+  mSumReal.Resize(mImpulseResponse->mSpectrumSize, 0.0f);
+  mSumImaginary.Resize(mImpulseResponse->mSpectrumSize, 0.0f);
+}
+
+void PartitionedConvolver::ProcessBuffer(const float* input, float* output, unsigned frames, unsigned stride)
+{
+  unsigned partitionFrames = mImpulseResponse->mPartitionFrames;
+  for (unsigned frame = 0; frame < frames; ++frame)
   {
-    memset(output, 0, sizeof(float) * length);
-    return;
+    // The input goes into the second half of the block, and the output comes
+    // from the previous block's result
+    mInputBlock[partitionFrames + mBlockPosition] = input[frame * stride];
+    output[frame * stride] = mOutputBlock[mBlockPosition];
+
+    ++mBlockPosition;
+    if (mBlockPosition == partitionFrames)
+    {
+      ProcessBlock();
+      mBlockPosition = 0;
+    }
   }
+}
 
-  int samplesProcessed = 0;
-  while (samplesProcessed < length)
-  {
-    // Process either the rest of the input or the amount that will fit in the
-    // stored input buffer
-    int processing = Math::Min(length - samplesProcessed, mBlockSize - mBufferPosition);
-    // Copy input samples into the stored buffer
-    memcpy(mStoredInputBuffer.Data() + mBufferPosition, input + samplesProcessed, sizeof(float) * processing);
+void PartitionedConvolver::Reset()
+{
+  memset(mInputBlock.Data(), 0, sizeof(float) * mInputBlock.Size());
+  memset(mOutputBlock.Data(), 0, sizeof(float) * mOutputBlock.Size());
+  memset(mDelayLineReal.Data(), 0, sizeof(float) * mDelayLineReal.Size());
+  memset(mDelayLineImaginary.Data(), 0, sizeof(float) * mDelayLineImaginary.Size());
+  mBlockPosition = 0;
+  mDelayLineIndex = 0;
+}
+
+void PartitionedConvolver::ProcessBlock()
+{
+  const ImpulseResponseSpectra& impulseResponse = *mImpulseResponse;
+  unsigned partitionFrames = impulseResponse.mPartitionFrames;
+  unsigned transformSize = partitionFrames * 2;
+  unsigned spectrumSize = impulseResponse.mSpectrumSize;
+  unsigned partitionCount = impulseResponse.mPartitionCount;
+
+  // Transform the previous and current input blocks
+  memcpy(mReal.Data(), mInputBlock.Data(), sizeof(float) * transformSize);
+  memset(mImaginary.Data(), 0, sizeof(float) * transformSize);
+  impulseResponse.mFFT.Forward(mReal.Data(), mImaginary.Data());
+
+  // Add the spectrum to the delay line, replacing the oldest one
+  mDelayLineIndex = (mDelayLineIndex == 0) ? partitionCount - 1 : mDelayLineIndex - 1;
+  memcpy(mDelayLineReal.Data() + (mDelayLineIndex * spectrumSize), mReal.Data(), sizeof(float) * (partitionFrames + 1));
+  memcpy(mDelayLineImaginary.Data() + (mDelayLineIndex * spectrumSize), mImaginary.Data(), sizeof(float) * (partitionFrames + 1));
 
-    // Forward FFT
-    FFT::Forward(mStoredInputBuffer.Data(), mSegments[mCurrentSegment].Data(), mBlockSize);
+  // Multiply each partition of the impulse response with the input spectrum
+  // from that many blocks ago and add them together
+  float* sumReal = mSumReal.Data();
+  float* sumImaginary = mSumImaginary.Data();
+  memset(sumReal, 0, sizeof(float) * spectrumSize);
+  memset(sumImaginary, 0, sizeof(float) * spectrumSize);
+  for (unsigned partition = 0; partition < partitionCount; ++partition)
+  {
+    unsigned delayIndex = (mDelayLineIndex + partition) % partitionCount;
+    const float* inputReal = mDelayLineReal.Data() + (delayIndex * spectrumSize);
+    const float* inputImaginary = mDelayLineImaginary.Data() + (delayIndex * spectrumSize);
+    const float* filterReal = impulseResponse.GetReal(mChannel, partition);
+    const float* filterImaginary = impulseResponse.GetImaginary(mChannel, partition);
 
-    // Complex multiplication
-    if (mBufferPosition == 0)
+    for (unsigned i = 0; i < spectrumSize; ++i)
     {
-      for (int i = 1; i < mSegmentCount; ++i)
-      {
-        int index = (mCurrentSegment + i) % mSegmentCount;
-        for (int j = 0; j < mBlockSize; ++j)
-          mConvolvedSamples[j] = mSegmentsIR[i][j] * mSegments[index][j];
-      }
+      sumReal[i] += inputReal[i] * filterReal[i] - inputImaginary[i] * filterImaginary[i];
+      sumImaginary[i] += inputReal[i] * filterImaginary[i] + inputImaginary[i] * filterReal[i];
     }
-    for (int i = 0; i < mBlockSize; ++i)
-      mConvolvedSamples[i] += mSegments[mCurrentSegment][i] * mSegmentsIR[0][i];
+  }
+
+  // Rebuild the full spectrum (the second half mirrors the first because the
+  // output is real)
+  for (unsigned i = 0; i <= partitionFrames; ++i)
+  {
+    mReal[i] = sumReal[i];
+    mImaginary[i] = sumImaginary[i];
+  }
+  for (unsigned i = partitionFrames + 1; i < transformSize; ++i)
+  {
+    mReal[i] = sumReal[transformSize - i];
+    mImaginary[i] = -sumImaginary[transformSize - i];
+  }
+  impulseResponse.mFFT.Backward(mReal.Data(), mImaginary.Data());
+
+  // The second half of the result is the output for this block (the first half
+  // has wrapped around)
+  memcpy(mOutputBlock.Data(), mReal.Data() + partitionFrames, sizeof(float) * partitionFrames);
 
-    // Backward FFT
-    FFT::Backward(mConvolvedSamples.Data(), mBlockSize);
+  // The current block becomes the previous block
+  memcpy(mInputBlock.Data(), mInputBlock.Data() + partitionFrames, sizeof(float) * partitionFrames);
+}
+
+// Convolution Reverb
+
+ConvolutionReverb::ConvolutionReverb(const ImpulseResponseSpectra* impulseResponse) :
+    mImpulseResponse(impulseResponse),
+    mSilentFrames(0),
+    mBypassed(false),
+    WetValue(0.5f)
+{
+}
 
-    // Add overlap
-    for (int i = 0; i < processing; ++i)
-      output[samplesProcessed + i] = mConvolvedSamples[mBufferPosition + i].mReal + mOverlap[mBufferPosition + i].mReal;
+ConvolutionReverb::~ConvolutionReverb()
+{
+  forRange (PartitionedConvolver* convolver, mConvolvers.All())
+    delete convolver;
+}
 
-    // If input buffer full, go to next block
-    mBufferPosition += processing;
-    if (mBufferPosition >= mBlockSize)
+bool ConvolutionReverb::ProcessBuffer(const float* input, float* output, const unsigned numChannels, const unsigned bufferSize)
+{
+  unsigned frames = bufferSize / numChannels;
+
+  // Only process if reverb is turned on
+  if (WetValue <= 0.0f && WetValueInterpolator.Finished())
+  {
+    if (output != input)
+      memcpy(output, input, sizeof(float) * bufferSize);
+
+    // Clear the convolvers so old audio isn't heard when the reverb is turned
+    // back on
+    if (!mBypassed)
     {
-      mBufferPosition = 0;
+      forRange (PartitionedConvolver* convolver, mConvolvers.All())
+        convolver->Reset();
+      mBypassed = true;
+    }
+    mSilentFrames = 0;
+    return false;
+  }
+  mBypassed = false;
 
-      // Save the overlap
-      memcpy(mOverlap.Data(), mConvolvedSamples.Data() + mBlockSize, sizeof(ComplexNumber) * mBlockSize);
+  // Create a convolver for each new channel
+  while (mConvolvers.Size() < numChannels)
+    mConvolvers.PushBack(new PartitionedConvolver(mImpulseResponse, mConvolvers.Size()));
 
-      // Update current segment
-      --mCurrentSegment;
-      if (mCurrentSegment < 0)
-        mCurrentSegment = mSegmentCount - 1;
+  // Keep track of how long the input has been silent
+  bool hasInput = false;
+  for (unsigned i = 0; i < bufferSize; ++i)
+  {
+    if (input[i] != 0.0f)
+    {
+      hasInput = true;
+      break;
     }
+  }
+  if (hasInput)
+    mSilentFrames = 0;
+  else
+    mSilentFrames += frames;
+
+  // Convolve each channel
+  mWetSamples.Resize(bufferSize);
+  for (unsigned channel = 0; channel < numChannels; ++channel)
+    mConvolvers[channel]->ProcessBuffer(input + channel, mWetSamples.Data() + channel, frames, numChannels);
 
-    samplesProcessed += processing;
+  // Mix the convolved and dry samples
+  for (unsigned i = 0; i < bufferSize; i += numChannels)
+  {
+    if (!WetValueInterpolator.Finished())
+      WetValue = WetValueInterpolator.NextValue();
+
+    for (unsigned channel = 0; channel < numChannels; ++channel)
+      output[i + channel] = ((1.0f - WetValue) * input[i + channel]) + (WetValue * mWetSamples[i + channel]);
   }
+
+  // The tail has finished once the whole impulse response (plus the block
+  // delay) has passed since the input stopped
+  unsigned tailFrames = (mImpulseResponse->mPartitionCount + 1) * mImpulseResponse->mPartitionFrames;
+  return mSilentFrames < tailFrames;
 }
 
-void FFTConvolver::Reset()
+void ConvolutionReverb::SetWetLevel(const float wetLevel)
 {
-  mBlockSize = 0;
-  mSegmentCount = 0;
-  mBufferPosition = 0;
-  mCurrentSegment = 0;
+  WetValue = wetLevel;
+}
 
-  mStoredInputBuffer.Clear();
-  mSegments.Clear();
-  mSegmentsIR.Clear();
-  mConvolvedSamples.Clear();
-  mOverlap.Clear();
+void ConvolutionReverb::InterpolateWetLevel(const float newWetLevel, const float time)
+{
+  WetValueInterpolator.SetValues(WetValue, newWetLevel, (unsigned)(time * cSystemSampleRate));
 }
 
 // ADSR envelope
@@ -24,8 +24,13 @@ public:
   void FlushDelays();
   void SetValues(const float a0, const float a1, const float a2, const float b1, const float b2);
   float DoBiQuad(const float x);
+  // Filters one channel of an interleaved buffer (stride is the number of channels)
+  void ProcessBlock(const float* input, float* output, const unsigned frames, const unsigned stride);
   void AddHistoryTo(BiQuad& otherFilter);
 
+  // Filters every channel of an interleaved buffer with its own BiQuad
+  static void ProcessChannels(BiQuad* biQuadsPerChannel, const float* input, float* output, const unsigned frames, const unsigned numChannels);
+
 private:
   float x_1;
   float x_2;
@@ -154,6 +159,7 @@ public:
   LowPassFilter();
 
   void ProcessFrame(const float* input, float* output, const unsigned numChannels);
+  void ProcessBlock(const float* input, float* output, const unsigned frames, const unsigned numChannels);
   void ProcessBuffer(const float* input, float* output, const unsigned numChannels, const unsigned numSamples);
 
   float GetCutoffFrequency();
@@ -178,6 +184,7 @@ public:
   HighPassFilter();
 
   void ProcessFrame(const float* input, float* output, const unsigned numChannels);
+  void ProcessBlock(const float* input, float* output, const unsigned frames, const unsigned numChannels);
 
   void SetCutoffFrequency(const float value);
   void MergeWith(HighPassFilter& otherFilter);
@@ -200,6 +207,7 @@ public:
   BandPassFilter();
 
   void ProcessFrame(const float* input, float* output, const unsigned numChannels);
+  void ProcessBlock(const float* input, float* output, const unsigned frames, const unsigned numChannels);
 
   void SetFrequency(const float frequency);
   void SetQuality(const float Q);
@@ -508,7 +516,11 @@ private:
   InterpolatingObject Band2Interpolator;
   InterpolatingObject Band3Interpolator;
 
+  // Output of the band currently being processed
+  BufferType mBandSamples;
+
   void SetFilterData();
+  void ApplyBandGain(EqualizerBands::Enum whichBand, InterpolatingObject& interpolator, float* output, const unsigned frames, const unsigned numChannels);
 };
 
 // Reverb Filter
@@ -613,32 +625,149 @@ private:
   static void DoFFT(ComplexNumber* samples, const int numberOfSamples, const bool forward);
 };
 
-// Transform Convolver
+// Split Complex FFT
 
-class FFTConvolver
+// A fast Fourier transform of a fixed size which keeps the real and imaginary
+// values in separate arrays, so that the butterflies can be calculated for four
+// values at once. The bit reversal and twiddle factor tables are created when
+// the size is set.
+class SplitComplexFFT
 {
 public:
-  FFTConvolver();
-  ~FFTConvolver();
+  SplitComplexFFT();
+
+  // The size must be a power of two
+  void SetSize(unsigned size);
+  unsigned GetSize() const;
+  // Transforms the values in place
+  void Forward(float* real, float* imaginary) const;
+  // Transforms the values in place and scales them by 1 / size
+  void Backward(float* real, float* imaginary) const;
 
-  bool Initialize(int blockSize, const float* impulseResponse, int irLength);
-  void ProcessBuffer(const float* input, float* output, int length);
+private:
+  void Transform(float* real, float* imaginary, const Array<float>& sines) const;
+
+  unsigned mSize;
+  // The bit reversed index for each index
+  Array<unsigned> mReverseTable;
+  // The twiddle factors for each stage, one after another (the stage which
+  // combines transforms of size N starts at index N - 1)
+  Array<float> mCosines;
+  Array<float> mForwardSines;
+  Array<float> mBackwardSines;
+};
+
+// Impulse Response Spectra
+
+// The spectra of an impulse response split into equal partitions, for each of
+// its channels. Only the non-redundant half of each spectrum is kept. Created
+// once and shared by all convolvers using the impulse response.
+class ImpulseResponseSpectra
+{
+public:
+  // The samples are interleaved. The impulse response is scaled so that the
+  // channel with the most energy has an energy of one.
+  ImpulseResponseSpectra(const float* samples, unsigned frames, unsigned channels, unsigned partitionFrames);
+
+  // Returns the real values of a partition's spectrum
+  const float* GetReal(unsigned channel, unsigned partition) const;
+  // Returns the imaginary values of a partition's spectrum
+  const float* GetImaginary(unsigned channel, unsigned partition) const;
+
+  // The number of frames in each partition
+  unsigned mPartitionFrames;
+  // The number of partitions in each channel
+  unsigned mPartitionCount;
+  // The number of values kept in each spectrum (the non-redundant half)
+  unsigned mSpectrumSize;
+  // The number of channels in the impulse response
+  unsigned mChannels;
+  // Transform of two partitions, used by everything using these spectra
+  SplitComplexFFT mFFT;
+
+private:
+  Array<float> mReal;
+  Array<float> mImaginary;
+};
+
+// Partitioned Convolver
+
+// Convolves one channel of audio with an impulse response using uniformly
+// partitioned overlap-save convolution. The audio is processed in partition
+// sized blocks, so the output is delayed by one partition. The cost of each
+// block is one forward and one backward transform plus one spectrum
+// multiplication per partition.
+class PartitionedConvolver
+{
+public:
+  // The impulse response's channel is the specified channel wrapped to its
+  // number of channels
+  PartitionedConvolver(const ImpulseResponseSpectra* impulseResponse, unsigned channel);
+
+  // Replaces the frames in the output with the convolved input. The stride is
+  // the number of samples between frames, to process interleaved buffers.
+  void ProcessBuffer(const float* input, float* output, unsigned frames, unsigned stride);
+  // Clears all audio from the convolver
   void Reset();
 
 private:
-  int mBlockSize;
-  int mSegmentCount;
-  Raverie::Array<float> mStoredInputBuffer;
-  int mBufferPosition;
-  int mCurrentSegment;
-  typedef Raverie::Array<ComplexNumber> ComplexListType;
-  Raverie::Array<ComplexListType> mSegments;
-  Raverie::Array<ComplexListType> mSegmentsIR;
-  ComplexListType mConvolvedSamples;
-  ComplexListType mOverlap;
+  // Convolves the current input block
+  void ProcessBlock();
+
+  const ImpulseResponseSpectra* mImpulseResponse;
+  unsigned mChannel;
+  // The previous and current blocks of input
+  Array<float> mInputBlock;
+  // The convolved output for the current block
+  Array<float> mOutputBlock;
+  // The position in the current block
+  unsigned mBlockPosition;
+  // The spectra of the most recent input blocks, one for each partition
+  Array<float> mDelayLineReal;
+  Array<float> mDelayLineImaginary;
+  // The delay line index of the newest spectrum
+  unsigned mDelayLineIndex;
+  // Working values for the transforms
+  Array<float> mReal;
+  Array<float> mImaginary;
+  // The accumulated spectrum of the output
+  Array<float> mSumReal;
+  Array<float> mSumImaginary;
 };
 
-static int NextPowerOf2(const int& value);
+// Convolution Reverb
+
+// Applies a partitioned convolver to each channel and mixes the result with
+// the dry input using the wet level
+class ConvolutionReverb
+{
+public:
+  ConvolutionReverb(const ImpulseResponseSpectra* impulseResponse);
+  ~ConvolutionReverb();
+
+  // Returns false once the reverb tail has finished
+  bool ProcessBuffer(const float* input, float* output, const unsigned numChannels, const unsigned bufferSize);
+
+  // Sets the fraction of output that is filtered (0 - 1.0)
+  void SetWetLevel(const float wetLevel);
+  // Sets the fraction of filtered output over the specified number of seconds
+  void InterpolateWetLevel(const float newWetLevel, const float time);
+
+private:
+  const ImpulseResponseSpectra* mImpulseResponse;
+  // One convolver per channel
+  Array<PartitionedConvolver*> mConvolvers;
+  // The convolved samples for the current buffer
+  BufferType mWetSamples;
+  // The number of frames since the input last had audio
+  unsigned mSilentFrames;
+  // If true, the convolvers are not being used because the wet level is zero
+  bool mBypassed;
+  // The value of the wet level
+  float WetValue;
+  // Used to interpolate the wet level
+  InterpolatingObject WetValueInterpolator;
+};
 
 // Envelope Settings
 
@@ -143,7 +143,7 @@ bool InterpolatingObject::Finished(HandleOf<SoundNode> nodeForEvent)
     if (nodeForEvent)
     {
       // Notify the external object that the interpolation is done
-      Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundNode::DispatchEventFromMixThread, *nodeForEvent, Events::AudioInterpolationDone), nodeForEvent);
+      Z::gSound->Mixer.AddTaskThreaded(&SoundNode::DispatchEventFromMixThread, *nodeForEvent, Events::AudioInterpolationDone, nodeForEvent);
     }
 
     return true;
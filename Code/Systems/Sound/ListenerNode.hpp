@@ -54,6 +54,11 @@ public:
 
 private:
   bool GetOutputSamples(BufferType* outputBuffer, const unsigned numberOfChannels, ListenerNode* listener, const bool firstRequest) override;
+  // Inputs are always requested for this listener
+  bool ProvidesListenerThreaded() override
+  {
+    return true;
+  }
   void SetPositionDataThreaded(ListenerWorldPositionInfo positionInfo);
   void SetActiveThreaded(bool active);
 
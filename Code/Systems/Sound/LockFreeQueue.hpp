@@ -7,161 +7,217 @@ namespace Raverie
 
 // Lock Free Queue
 
+// A fixed capacity ring buffer queue with one writer thread and one reader
+// thread. All slots are created up front, so writing and reading never allocate
+// memory or take a lock.
 template <typename T>
 class LockFreeQueue
 {
-private:
-  struct Node
+public:
+  // The capacity is rounded up to a power of two
+  LockFreeQueue(unsigned capacity = 64) : mReadIndex(0), mWriteIndex(0)
   {
-    Node(T value) : Value(value), Next(nullptr)
-    {
-    }
+    ErrorIf(capacity == 0, "Queue capacity must be at least one");
+    mCapacity = NextPowerOfTwo(capacity - 1);
+    mSlots = new T[mCapacity];
+  }
 
-    T Value;
-    Node* Next;
-  };
+  ~LockFreeQueue()
+  {
+    delete[] mSlots;
+  }
 
-public:
-  // Create the dummy node
-  LockFreeQueue()
+  // Copies the object into the queue. Returns false if the queue is full.
+  bool Write(const T& object)
   {
-    First = Last = new Node(T());
+    T* slot = BeginWrite();
+    if (!slot)
+      return false;
+
+    *slot = object;
+    EndWrite();
+    return true;
   }
 
-  ~LockFreeQueue()
+  // Copies the oldest object out of the queue. Returns false if the queue is
+  // empty.
+  bool Read(T& result)
   {
-    Clear();
+    T* slot = Peek();
+    if (!slot)
+      return false;
 
-    // The Clear function does not remove the dummy node
-    delete First;
+    result = *slot;
+    Pop();
+    return true;
   }
 
-  void Write(const T& object)
+  // Writer only: returns the next free slot so an object can be written in
+  // place, or null if the queue is full. The slot is not seen by the reader
+  // until EndWrite is called.
+  T* BeginWrite()
   {
-    // Create the new object
-    Last->Next = new Node(object);
-    // Set the Last pointer
-    AtomicStore((void**)&Last, Last->Next);
+    unsigned writeIndex = mWriteIndex.Load();
+    if (writeIndex - mReadIndex.Load() >= mCapacity)
+      return nullptr;
+
+    return &mSlots[writeIndex & (mCapacity - 1)];
   }
 
-  bool Read(T& result)
+  // Writer only: passes the slot returned by BeginWrite to the reader
+  void EndWrite()
   {
-    // Check if there is anything on the queue
-    if (!AtomicCompareExchange((void**)&First, (void*)Last, (void*)Last))
-    {
-      // Store the pointers
-      Node* firstNode = First;
-      Node* nextNode = First->Next;
-      // Get the value from the next node
-      result = nextNode->Value;
-      // Move the First pointer forward
-      First = First->Next;
-      // Delete the old First node
-      delete firstNode;
-
-      return true;
-    }
+    mWriteIndex.Store(mWriteIndex.Load() + 1);
+  }
+
+  // Reader only: returns the oldest slot so it can be used in place, or null
+  // if the queue is empty
+  T* Peek()
+  {
+    unsigned readIndex = mReadIndex.Load();
+    if (readIndex == mWriteIndex.Load())
+      return nullptr;
 
-    return false;
+    return &mSlots[readIndex & (mCapacity - 1)];
+  }
+
+  // Reader only: gives the slot returned by Peek back to the writer
+  void Pop()
+  {
+    mReadIndex.Store(mReadIndex.Load() + 1);
+  }
+
+  // Returns the number of objects currently in the queue
+  unsigned GetCount()
+  {
+    return mWriteIndex.Load() - mReadIndex.Load();
+  }
+
+  unsigned GetCapacity()
+  {
+    return mCapacity;
   }
 
   // This function assumes that nothing is currently writing to the queue
   void Clear()
   {
-    // Delete anything remaining on the queue
-    while (First != Last)
-    {
-      Node* temp = First;
-      First = temp->Next;
-      delete temp;
-    }
+    mReadIndex.Store(mWriteIndex.Load());
   }
 
 private:
-  // Only touched by reader
-  Node* First;
-  // Shared by writer and reader
-  Node* Last;
+  LockFreeQueue(const LockFreeQueue&);
+  LockFreeQueue& operator=(const LockFreeQueue&);
+
+  // The ring buffer of slots
+  T* mSlots;
+  // The number of slots, always a power of two
+  unsigned mCapacity;
+  // Only changed by the reader
+  Atomic<unsigned> mReadIndex;
+  // Only changed by the writer
+  Atomic<unsigned> mWriteIndex;
 };
 
 // Multiple Writer Queue
 
+// A fixed capacity ring buffer queue with any number of writer threads and one
+// reader thread. Each slot has a sequence number that tells writers whether it
+// is free and tells the reader whether it has been written, so writers only
+// need to compete for the write index.
 template <typename T>
 class MultipleWriterQueue
 {
 private:
-  struct Node
+  struct Slot
   {
-    Node(T value) : Value(value), Next(nullptr)
-    {
-    }
-
+    Atomic<unsigned> Sequence;
     T Value;
-    Node* Next;
   };
 
 public:
-  // Create the dummy node
-  MultipleWriterQueue() : WriteLock(0)
+  // The capacity is rounded up to a power of two
+  MultipleWriterQueue(unsigned capacity = 64) : mReadIndex(0), mWriteIndex(0)
   {
-    First = Last = new Node(T());
+    ErrorIf(capacity == 0, "Queue capacity must be at least one");
+    mCapacity = NextPowerOfTwo(capacity - 1);
+    mSlots = new Slot[mCapacity];
+
+    // Each slot is free for the first write index that maps to it
+    for (unsigned i = 0; i < mCapacity; ++i)
+      mSlots[i].Sequence.Store(i);
   }
 
   ~MultipleWriterQueue()
   {
-    // Delete anything remaining on the queue
-    while (First)
-    {
-      Node* temp = First;
-      First = temp->Next;
-      delete temp;
-    }
+    delete[] mSlots;
   }
 
-  void Write(const T& object)
+  // Copies the object into the queue. Returns false if the queue is full.
+  bool Write(const T& object)
   {
-    // Create the new object
-    Node* temp = new Node(object);
-    // Get access (wait until WriteLock is 0 and then set it to 1)
-    while (AtomicCompareExchange(&WriteLock, 1, 0))
+    unsigned writeIndex = mWriteIndex.Load();
+    Slot* slot = nullptr;
+    while (true)
     {
+      slot = &mSlots[writeIndex & (mCapacity - 1)];
+      int difference = (int)(slot->Sequence.Load() - writeIndex);
+
+      // The slot is free for this index, so try to claim it
+      if (difference == 0)
+      {
+        // CompareExchange returns whether the exchange took place (not the
+        // previous value)
+        if (mWriteIndex.CompareExchange(writeIndex + 1, writeIndex))
+          break;
+
+        writeIndex = mWriteIndex.Load();
+      }
+      // The slot has not been read since the last time around, so the queue is
+      // full
+      else if (difference < 0)
+      {
+        return false;
+      }
+      // Another writer claimed this index first
+      else
+      {
+        writeIndex = mWriteIndex.Load();
+      }
     }
-    // Set pointer on last object
-    Last->Next = temp;
-    // Set the Last pointer (shared with reader)
-    AtomicStore((void**)&Last, temp);
-    // Release access
-    AtomicStore(&WriteLock, 0);
+
+    slot->Value = object;
+    // Tell the reader the slot is ready
+    slot->Sequence.Store(writeIndex + 1);
+    return true;
   }
 
+  // Copies the oldest object out of the queue. Returns false if the queue is
+  // empty.
   bool Read(T& result)
   {
-    // Check if there is anything on the queue
-    if (!AtomicCompareExchange((void**)&First, (void*)Last, (void*)Last))
-    {
-      // Store the pointers
-      Node* firstNode = First;
-      Node* nextNode = First->Next;
-      // Get the value from the next node
-      result = nextNode->Value;
-      // Move the First pointer forward
-      First = First->Next;
-      // Delete the old First node
-      delete firstNode;
-
-      return true;
-    }
-
-    return false;
+    Slot& slot = mSlots[mReadIndex & (mCapacity - 1)];
+    if (slot.Sequence.Load() != mReadIndex + 1)
+      return false;
+
+    result = slot.Value;
+    // Free the slot for the write index one time around the ring from here
+    slot.Sequence.Store(mReadIndex + mCapacity);
+    ++mReadIndex;
+    return true;
   }
 
 private:
-  // Only touched by reader
-  Node* First;
-  // Shared by writers and reader
-  Node* Last;
+  MultipleWriterQueue(const MultipleWriterQueue&);
+  MultipleWriterQueue& operator=(const MultipleWriterQueue&);
+
+  // The ring buffer of slots
+  Slot* mSlots;
+  // The number of slots, always a power of two
+  unsigned mCapacity;
+  // Only touched by the reader
+  unsigned mReadIndex;
   // Shared by writers
-  s32 WriteLock;
+  Atomic<unsigned> mWriteIndex;
 };
 
 } // namespace Raverie
@@ -9,7 +9,14 @@ using namespace AudioConstants;
 
 // Pitch Change Handler
 
-PitchChangeHandler::PitchChangeHandler() : mPitchCents(0), mPitchFactor(1.0f), mFramesToInterpolate(0), mInputFrameCount(0), mInputSampleCount(0), mChannels(0)
+PitchChangeHandler::PitchChangeHandler() :
+    mPitchCents(0),
+    mPitchFactor(1.0f),
+    mFramesToInterpolate(0),
+    mInputFrameCount(0),
+    mInputSampleCount(0),
+    mChannels(0),
+    mQuality(ResampleQuality::Linear)
 {
   ResetLastSamples();
 }
@@ -73,7 +80,9 @@ void PitchChangeHandler::ProcessBuffer(BufferType* inputBuffer, BufferType* outp
   unsigned outputBufferSize = outputBuffer->Size();
 
   // Not shifting pitch, don't need to do any more
-  if (outputBufferSize == mInputSampleCount)
+  // (the High quality filter delays its output, so it is always used to keep
+  // the delay the same)
+  if (outputBufferSize == mInputSampleCount && mQuality == ResampleQuality::Linear)
   {
     inputBuffer->Swap(*outputBuffer);
     if (CurrentData.mInterpolating)
@@ -86,6 +95,25 @@ void PitchChangeHandler::ProcessBuffer(BufferType* inputBuffer, BufferType* outp
     return;
   }
 
+  if (mQuality == ResampleQuality::High)
+    InterpolateHighQuality(inputBuffer, outputBuffer);
+  else
+    InterpolateLinear(inputBuffer, outputBuffer);
+
+  // Keep only the fractional portion of the pitch index
+  CurrentData.mPitchFrameIndex -= mInputFrameCount;
+  // Make sure the integer portion isn't negative
+  if (CurrentData.mPitchFrameIndex < 0)
+    CurrentData.mPitchFrameIndex -= (int)CurrentData.mPitchFrameIndex;
+
+  // Save last frame of samples
+  memcpy(CurrentData.LastSamples, inputBuffer->Data() + (mInputSampleCount - mChannels), sizeof(float) * mChannels);
+}
+
+void PitchChangeHandler::InterpolateLinear(BufferType* inputBuffer, BufferType* outputBuffer)
+{
+  unsigned outputBufferSize = outputBuffer->Size();
+
   // Get the integer portion for the frame index
   int frameIndex = (int)CurrentData.mPitchFrameIndex;
   // Previous frame index starts at -1
@@ -129,32 +157,78 @@ void PitchChangeHandler::ProcessBuffer(BufferType* inputBuffer, BufferType* outp
       outputRange.Front() = firstSample + ((secondSample - firstSample) * ((float)CurrentData.mPitchFrameIndex - frameIndex));
     }
 
-    // If currently interpolating, get updated pitch factor
-    if (CurrentData.mInterpolating)
-    {
-      ++CurrentData.mInterpolationFramesProcessed;
-      mPitchFactor = PitchInterpolator.ValueAtIndex(CurrentData.mInterpolationFramesProcessed);
-
-      // Check if the interpolation is finished
-      if (CurrentData.mInterpolationFramesProcessed >= mFramesToInterpolate)
-        CurrentData.mInterpolating = false;
-    }
+    AdvanceFrame();
 
-    // Advance the pitch index
-    CurrentData.mPitchFrameIndex += (double)mPitchFactor;
     // Update the frame indexes
     frameIndex = (int)CurrentData.mPitchFrameIndex;
     previousFrameIndex = frameIndex - 1;
   }
+}
 
-  // Keep only the fractional portion of the pitch index
-  CurrentData.mPitchFrameIndex -= mInputFrameCount;
-  // Make sure the integer portion isn't negative
-  if (CurrentData.mPitchFrameIndex < 0)
-    CurrentData.mPitchFrameIndex -= (int)CurrentData.mPitchFrameIndex;
+void PitchChangeHandler::InterpolateHighQuality(BufferType* inputBuffer, BufferType* outputBuffer)
+{
+  const unsigned cTaps = PolyphaseFilterBank::cTaps;
+  const PolyphaseFilterBank& filterBank = PolyphaseFilterBank::GetInstance();
+  unsigned outputBufferSize = outputBuffer->Size();
+  unsigned channelSize = cTaps + mInputFrameCount;
 
-  // Save last frame of samples
-  memcpy(CurrentData.LastSamples, inputBuffer->Data() + (mInputSampleCount - mChannels), sizeof(float) * mChannels);
+  // Separate the channels, each starting with its history, so the filter can
+  // read the frames of a channel directly
+  mChannelSamples.Resize(channelSize * mChannels);
+  for (unsigned channel = 0; channel < mChannels; ++channel)
+  {
+    float* channelSamples = mChannelSamples.Data() + (channel * channelSize);
+    memcpy(channelSamples, CurrentData.History[channel], sizeof(float) * cTaps);
+    for (unsigned frame = 0; frame < mInputFrameCount; ++frame)
+      channelSamples[cTaps + frame] = (*inputBuffer)[(frame * mChannels) + channel];
+  }
+
+  // Step through all frames in the output buffer
+  for (unsigned outputFrameIndex = 0; outputFrameIndex + mChannels <= outputBufferSize; outputFrameIndex += mChannels)
+  {
+    unsigned frameIndex = (unsigned)CurrentData.mPitchFrameIndex;
+    float* outputFrame = outputBuffer->Data() + outputFrameIndex;
+
+    // Check if this frame would go past the end of the buffer
+    if (frameIndex >= mInputFrameCount)
+    {
+      // Copy the previous output frame
+      if (outputFrameIndex >= mChannels)
+        memcpy(outputFrame, outputFrame - mChannels, sizeof(float) * mChannels);
+      else
+        memset(outputFrame, 0, sizeof(float) * mChannels);
+      continue;
+    }
+
+    // Filter the frames around the position for each channel (the filter
+    // starts at the frame index because of the history before the input)
+    float fraction = (float)(CurrentData.mPitchFrameIndex - frameIndex);
+    for (unsigned channel = 0; channel < mChannels; ++channel)
+      outputFrame[channel] = filterBank.Interpolate(mChannelSamples.Data() + (channel * channelSize) + frameIndex, fraction);
+
+    AdvanceFrame();
+  }
+
+  // Save the last frames of each channel for the next buffer
+  for (unsigned channel = 0; channel < mChannels; ++channel)
+    memcpy(CurrentData.History[channel], mChannelSamples.Data() + (channel * channelSize) + mInputFrameCount, sizeof(float) * cTaps);
+}
+
+void PitchChangeHandler::AdvanceFrame()
+{
+  // If currently interpolating, get updated pitch factor
+  if (CurrentData.mInterpolating)
+  {
+    ++CurrentData.mInterpolationFramesProcessed;
+    mPitchFactor = PitchInterpolator.ValueAtIndex(CurrentData.mInterpolationFramesProcessed);
+
+    // Check if the interpolation is finished
+    if (CurrentData.mInterpolationFramesProcessed >= mFramesToInterpolate)
+      CurrentData.mInterpolating = false;
+  }
+
+  // Advance the pitch index
+  CurrentData.mPitchFrameIndex += (double)mPitchFactor;
 }
 
 float PitchChangeHandler::GetPitchFactor()
@@ -190,6 +264,7 @@ void PitchChangeHandler::SetPitchFactor(float factor, float timeToInterpolate)
 void PitchChangeHandler::ResetLastSamples()
 {
   memset(CurrentData.LastSamples, 0, sizeof(float) * cMaxChannels);
+  memset(CurrentData.History, 0, sizeof(CurrentData.History));
 }
 
 void PitchChangeHandler::ResetToStartOfMix()
@@ -202,9 +277,28 @@ bool PitchChangeHandler::Interpolating()
   return CurrentData.mInterpolating;
 }
 
+void PitchChangeHandler::SetQuality(ResampleQuality::Enum quality)
+{
+  if (quality == mQuality)
+    return;
+
+  mQuality = quality;
+
+  // The history was not kept up to date under the previous setting, so start
+  // the filter over from silence rather than from stale frames
+  memset(CurrentData.History, 0, sizeof(CurrentData.History));
+  memset(PreviousData.History, 0, sizeof(PreviousData.History));
+}
+
+ResampleQuality::Enum PitchChangeHandler::GetQuality()
+{
+  return mQuality;
+}
+
 PitchChangeHandler::Data::Data() : mInterpolationFramesProcessed(0), mInterpolating(false), mPitchFrameIndex(0.0), mBufferSizeFraction(0.0)
 {
   memset(LastSamples, 0, sizeof(float) * cMaxChannels);
+  memset(History, 0, sizeof(History));
 }
 
 PitchChangeHandler::Data& PitchChangeHandler::Data::operator=(const Data& other)
@@ -214,6 +308,7 @@ PitchChangeHandler::Data& PitchChangeHandler::Data::operator=(const Data& other)
   mPitchFrameIndex = other.mPitchFrameIndex;
   mBufferSizeFraction = other.mBufferSizeFraction;
   memcpy(LastSamples, other.LastSamples, sizeof(float) * cMaxChannels);
+  memcpy(History, other.History, sizeof(History));
 
   return *this;
 }
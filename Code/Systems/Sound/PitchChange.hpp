@@ -36,8 +36,21 @@ public:
   void ResetToStartOfMix();
   // Returns true if the pitch is currently being interpolated
   bool Interpolating();
+  // Sets how the audio samples are interpolated (clears the High quality
+  // filter's history when changed)
+  void SetQuality(ResampleQuality::Enum quality);
+  // Returns how the audio samples are interpolated
+  ResampleQuality::Enum GetQuality();
 
 private:
+  // Interpolates between the two frames around each position
+  void InterpolateLinear(BufferType* inputBuffer, BufferType* outputBuffer);
+  // Filters the frames around each position with the polyphase filter bank
+  // (delays the output by half of the filter's frames)
+  void InterpolateHighQuality(BufferType* inputBuffer, BufferType* outputBuffer);
+  // Moves the pitch frame index forward by one output frame
+  void AdvanceFrame();
+
   int mPitchCents;
   float mPitchFactor;
   unsigned mInputFrameCount;
@@ -45,6 +58,10 @@ private:
   unsigned mChannels;
   InterpolatingObject PitchInterpolator;
   unsigned mFramesToInterpolate;
+  ResampleQuality::Enum mQuality;
+  // The history and input samples of each channel, one channel after another,
+  // used by the High quality setting
+  BufferType mChannelSamples;
 
   class Data
   {
@@ -55,6 +72,8 @@ private:
     unsigned mInterpolationFramesProcessed;
     bool mInterpolating;
     float LastSamples[AudioConstants::cMaxChannels];
+    // The last frames of each channel, used by the High quality filter
+    float History[AudioConstants::cMaxChannels][PolyphaseFilterBank::cTaps];
     double mPitchFrameIndex;
     double mBufferSizeFraction;
   };
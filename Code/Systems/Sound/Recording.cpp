@@ -150,7 +150,7 @@ bool RecordingNode::GetOutputSamples(BufferType* outputBuffer, const unsigned nu
       memset(outputBuffer->Data(), 0, sizeof(float) * outputBuffer->Size());
 
     Raverie::Array<float>* buffer = new Raverie::Array<float>(*outputBuffer);
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&RecordingNode::WriteBuffer, this, buffer, numberOfChannels), this);
+    Z::gSound->Mixer.AddTaskThreaded(&RecordingNode::WriteBuffer, this, buffer, numberOfChannels, this);
   }
 
   return isThereOutput;
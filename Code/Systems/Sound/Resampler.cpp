@@ -5,9 +5,84 @@
 namespace Raverie
 {
 
-Resampler::Resampler() : ResampleFactor(0), ResampleFrameIndex(0), BufferFraction(0), InputSamples(nullptr), InputFrames(0), InputChannels(0)
+// Polyphase Filter Bank
+
+const PolyphaseFilterBank& PolyphaseFilterBank::GetInstance()
+{
+  static PolyphaseFilterBank filterBank;
+  return filterBank;
+}
+
+PolyphaseFilterBank::PolyphaseFilterBank()
+{
+  // Keep the cutoff slightly below the Nyquist frequency so the filter's
+  // transition band doesn't reach it
+  const float cutoff = 0.9f;
+  const float halfTaps = cTaps / 2.0f;
+
+  for (unsigned phase = 0; phase <= cPhases; ++phase)
+  {
+    float fraction = (float)phase / cPhases;
+    float sum = 0.0f;
+
+    for (unsigned tap = 0; tap < cTaps; ++tap)
+    {
+      // Distance from the position to this tap's frame
+      float distance = (float)tap - (halfTaps - 1.0f) - fraction;
+
+      // Sinc function
+      float x = Math::cPi * cutoff * distance;
+      float value = (x == 0.0f) ? cutoff : cutoff * Math::Sin(x) / x;
+
+      // Blackman window across the width of the filter
+      float windowPosition = Math::Clamp((distance + halfTaps) / cTaps, 0.0f, 1.0f);
+      value *= 0.42f - 0.5f * Math::Cos(Math::cTwoPi * windowPosition) + 0.08f * Math::Cos(2.0f * Math::cTwoPi * windowPosition);
+
+      mCoefficients[phase][tap] = value;
+      sum += value;
+    }
+
+    // Normalize each phase so that it doesn't change the volume
+    for (unsigned tap = 0; tap < cTaps; ++tap)
+      mCoefficients[phase][tap] /= sum;
+  }
+}
+
+float PolyphaseFilterBank::Interpolate(const float* samples, float fraction) const
+{
+  // Find the phases on either side of the fraction
+  float position = fraction * cPhases;
+  unsigned phase = Math::Min((unsigned)position, cPhases - 1);
+  float phaseFraction = position - phase;
+  const float* firstCoefficients = mCoefficients[phase];
+  const float* secondCoefficients = mCoefficients[phase + 1];
+
+  // Apply the coefficients of both phases to the samples
+  float firstValue = 0.0f;
+  float secondValue = 0.0f;
+  for (unsigned i = 0; i < cTaps; ++i)
+  {
+    firstValue += samples[i] * firstCoefficients[i];
+    secondValue += samples[i] * secondCoefficients[i];
+  }
+
+  // Interpolate between the phases
+  return firstValue + ((secondValue - firstValue) * phaseFraction);
+}
+
+// Resampler
+
+Resampler::Resampler() :
+    Quality(ResampleQuality::Linear),
+    ResampleFactor(0),
+    ResampleFrameIndex(0),
+    BufferFraction(0),
+    InputSamples(nullptr),
+    InputFrames(0),
+    InputChannels(0)
 {
   memset(PreviousFrame, 0, sizeof(float) * AudioConstants::cMaxChannels);
+  memset(History, 0, sizeof(History));
 }
 
 void Resampler::SetFactor(double factor)
@@ -15,6 +90,11 @@ void Resampler::SetFactor(double factor)
   ResampleFactor = factor;
 }
 
+void Resampler::SetQuality(ResampleQuality::Enum quality)
+{
+  Quality = quality;
+}
+
 unsigned Resampler::GetOutputFrameCount(unsigned inputFrames)
 {
   // Get initial frame count
@@ -33,6 +113,22 @@ void Resampler::SetInputBuffer(const float* inputSamples, unsigned frameCount, u
   InputFrames = frameCount;
   InputChannels = channels;
   ResampleFrameIndex = ResampleFrameIndex - (int)ResampleFrameIndex;
+
+  if (Quality == ResampleQuality::High)
+  {
+    // Separate the channels, each starting with its history, so the filter can
+    // read the frames of a channel directly
+    const unsigned cTaps = PolyphaseFilterBank::cTaps;
+    unsigned channelSize = cTaps + frameCount;
+    ChannelSamples.Resize(channelSize * channels);
+    for (unsigned channel = 0; channel < channels; ++channel)
+    {
+      float* channelSamples = ChannelSamples.Data() + (channel * channelSize);
+      memcpy(channelSamples, History[channel], sizeof(float) * cTaps);
+      for (unsigned frame = 0; frame < frameCount; ++frame)
+        channelSamples[cTaps + frame] = inputSamples[(frame * channels) + channel];
+    }
+  }
 }
 
 bool Resampler::GetNextFrame(float* output)
@@ -59,9 +155,21 @@ bool Resampler::GetNextFrame(float* output)
   // Get the pointer to the second frame
   const float* secondFrame(InputSamples + sampleIndex);
 
-  // Interpolate between the two frames for each channel
-  for (unsigned i = 0; i < InputChannels; ++i)
-    output[i] = firstFrame[i] + ((secondFrame[i] - firstFrame[i]) * (float)(ResampleFrameIndex - frameIndex));
+  if (Quality == ResampleQuality::High)
+  {
+    // Filter the frames around the position for each channel (the filter
+    // starts at the frame index because of the history before the input)
+    const PolyphaseFilterBank& filterBank = PolyphaseFilterBank::GetInstance();
+    unsigned channelSize = PolyphaseFilterBank::cTaps + InputFrames;
+    for (unsigned i = 0; i < InputChannels; ++i)
+      output[i] = filterBank.Interpolate(ChannelSamples.Data() + (i * channelSize) + frameIndex, (float)(ResampleFrameIndex - frameIndex));
+  }
+  else
+  {
+    // Interpolate between the two frames for each channel
+    for (unsigned i = 0; i < InputChannels; ++i)
+      output[i] = firstFrame[i] + ((secondFrame[i] - firstFrame[i]) * (float)(ResampleFrameIndex - frameIndex));
+  }
 
   // Advance the frame index
   ResampleFrameIndex += ResampleFactor;
@@ -71,6 +179,14 @@ bool Resampler::GetNextFrame(float* output)
   {
     // Get the last frame of samples in the buffer
     memcpy(PreviousFrame, InputSamples + ((InputFrames - 1) * InputChannels), sizeof(float) * InputChannels);
+
+    // Save the last frames of each channel for the filter
+    if (Quality == ResampleQuality::High)
+    {
+      unsigned channelSize = PolyphaseFilterBank::cTaps + InputFrames;
+      for (unsigned i = 0; i < InputChannels; ++i)
+        memcpy(History[i], ChannelSamples.Data() + (i * channelSize) + InputFrames, sizeof(float) * PolyphaseFilterBank::cTaps);
+    }
     return false;
   }
   else
@@ -5,18 +5,63 @@
 namespace Raverie
 {
 
+// How audio is interpolated when it is resampled or pitch shifted. Linear
+// interpolates between two frames and is the cheapest, High uses a windowed sinc
+// filter which removes most of the distortion but costs more.
+DeclareEnum2(ResampleQuality, Linear, High);
+
+// Polyphase Filter Bank
+
+// Windowed sinc filter coefficients for evenly spaced fractional positions
+// between two frames. Calculated once and shared by everything that resamples.
+class PolyphaseFilterBank
+{
+public:
+  // The number of frames used for each interpolated sample (half on each side
+  // of the position)
+  static const unsigned cTaps = 16;
+  // The number of fractional positions with their own coefficients
+  static const unsigned cPhases = 256;
+
+  static const PolyphaseFilterBank& GetInstance();
+
+  // Returns the value at the fractional position between samples[cTaps / 2 - 1]
+  // and samples[cTaps / 2]. The cTaps samples must be contiguous values of a
+  // single channel.
+  float Interpolate(const float* samples, float fraction) const;
+
+private:
+  PolyphaseFilterBank();
+
+  // Has one extra phase so that positions past the last phase can be
+  // interpolated
+  float mCoefficients[cPhases + 1][cTaps];
+};
+
+// Resampler
+
 class Resampler
 {
 public:
   Resampler();
 
   void SetFactor(double factor);
+  // Sets how the frames are interpolated. The High quality setting delays the
+  // output by half of the filter's frames.
+  void SetQuality(ResampleQuality::Enum quality);
   unsigned GetOutputFrameCount(unsigned inputFrames);
   void SetInputBuffer(const float* inputSamples, unsigned frameCount, unsigned channels);
   bool GetNextFrame(float* output);
 
 private:
   float PreviousFrame[AudioConstants::cMaxChannels];
+  // The last frames of each channel from the previous buffer, used by the
+  // filter at the start of the next buffer
+  float History[AudioConstants::cMaxChannels][PolyphaseFilterBank::cTaps];
+  // The history and input samples of each channel, one channel after another,
+  // used by the High quality setting
+  BufferType ChannelSamples;
+  ResampleQuality::Enum Quality;
   double ResampleFactor;
   double ResampleFrameIndex;
   double BufferFraction;
@@ -114,38 +114,140 @@ void DecompressedSoundAsset::DecodingCallback(DecodedPacket* packet)
   AtomicExchange((s32*)&mSamplesAvailableShared, (s32)(mSamplesAvailableShared + samplesCopied));
 }
 
-// Streaming Data Per Instance
+// Decoded Page Cache
+
+DecodedPageCache::DecodedPageCache() : mMemoryUsed(0), mMemoryBudget(16 * 1024 * 1024)
+{
+}
+
+DecodedPageCache::~DecodedPageCache()
+{
+  while (!mLeastRecentlyUsedList.Empty())
+    RemovePage(&mLeastRecentlyUsedList.Front());
+}
+
+DecodedPage* DecodedPageCache::FindPage(unsigned assetID, unsigned pageIndex)
+{
+  DecodedPage* page = mPages.FindValue(GetKey(assetID, pageIndex), nullptr);
+  if (!page)
+    return nullptr;
+
+  // Move the page to the back of the list, since it is now the most recently
+  // used
+  InList<DecodedPage>::Unlink(page);
+  mLeastRecentlyUsedList.PushBack(page);
+  page->mLastUsedMixVersion = Z::gSound->Mixer.mMixVersionThreaded;
+
+  return page;
+}
+
+bool DecodedPageCache::HasPage(unsigned assetID, unsigned pageIndex)
+{
+  return mPages.ContainsKey(GetKey(assetID, pageIndex));
+}
+
+void DecodedPageCache::AddPage(unsigned assetID, unsigned pageIndex, BufferType& samples)
+{
+  u64 key = GetKey(assetID, pageIndex);
+  if (mPages.ContainsKey(key))
+    return;
+
+  DecodedPage* page = new DecodedPage(key);
+  page->mSamples.Swap(samples);
+  page->mLastUsedMixVersion = Z::gSound->Mixer.mMixVersionThreaded;
+
+  mPages.Insert(key, page);
+  mLeastRecentlyUsedList.PushBack(page);
+  mMemoryUsed += page->mSamples.Size() * sizeof(float);
+
+  RemoveOldPages();
+}
+
+void DecodedPageCache::RemoveAssetPages(unsigned assetID)
+{
+  InList<DecodedPage>::range pages = mLeastRecentlyUsedList.All();
+  while (!pages.Empty())
+  {
+    DecodedPage* page = &pages.Front();
+    pages.PopFront();
+
+    if ((unsigned)(page->mKey >> 32) == assetID)
+      RemovePage(page);
+  }
+}
+
+void DecodedPageCache::SetMemoryBudget(size_t bytes)
+{
+  mMemoryBudget = bytes;
+  RemoveOldPages();
+}
+
+void DecodedPageCache::RemoveOldPages()
+{
+  unsigned mixVersion = Z::gSound->Mixer.mMixVersionThreaded;
+
+  // The list is in order of use, so stop at the first page used in this mix
+  while (mMemoryUsed > mMemoryBudget && !mLeastRecentlyUsedList.Empty() && mLeastRecentlyUsedList.Front().mLastUsedMixVersion != mixVersion)
+    RemovePage(&mLeastRecentlyUsedList.Front());
+}
+
+void DecodedPageCache::RemovePage(DecodedPage* page)
+{
+  mMemoryUsed -= page->mSamples.Size() * sizeof(float);
+  mPages.Erase(page->mKey);
+  mLeastRecentlyUsedList.Erase(page);
+  delete page;
+}
+
+u64 DecodedPageCache::GetKey(unsigned assetID, unsigned pageIndex)
+{
+  return ((u64)assetID << 32) | (u64)pageIndex;
+}
+
+// Streaming Decode Cursor
 
 static void StreamingDecodingCallback(DecodedPacket* packet, void* data)
 {
-  ((StreamingDataPerInstance*)data)->DecodingCallback(packet);
+  ((StreamingDecodeCursor*)data)->DecodingCallback(packet);
 }
 
-StreamingDataPerInstance::StreamingDataPerInstance(Status& status, File* inputFile, ThreadLock* lock, unsigned channels, unsigned frames, unsigned instanceID) :
-    mDecoder(status, inputFile, lock, channels, frames, StreamingDecodingCallback, this), mPreviousSamples(0), mInstanceID(instanceID)
+StreamingDecodeCursor::StreamingDecodeCursor(Status& status, File* inputFile, ThreadLock* lock, unsigned channels, unsigned frames) :
+    mDecoder(status, inputFile, lock, channels, frames, StreamingDecodingCallback, this), mDecodedPacketQueue(cMaxQueuedPages),
+    mNextPageIndex(0),
+    mRequestedPages(0),
+    mTargetPages(0),
+    mFirstCachedPage(0),
+    mReferenceCount(0)
 {
 }
 
-StreamingDataPerInstance::StreamingDataPerInstance(Status& status, byte* inputData, unsigned dataSize, unsigned channels, unsigned frames, unsigned instanceID) :
-    mDecoder(status, inputData, dataSize, channels, frames, StreamingDecodingCallback, this), mPreviousSamples(0), mInstanceID(instanceID)
+StreamingDecodeCursor::StreamingDecodeCursor(Status& status, byte* inputData, unsigned dataSize, unsigned channels, unsigned frames) :
+    mDecoder(status, inputData, dataSize, channels, frames, StreamingDecodingCallback, this), mDecodedPacketQueue(cMaxQueuedPages),
+    mNextPageIndex(0),
+    mRequestedPages(0),
+    mTargetPages(0),
+    mFirstCachedPage(0),
+    mReferenceCount(0)
 {
 }
 
-void StreamingDataPerInstance::Reset()
+void StreamingDecodeCursor::RequestPages(unsigned endPageIndex)
 {
-  mDecoder.Reset();
-  mPreviousSamples = 0;
+  mTargetPages = Math::Max(mTargetPages, endPageIndex);
 
-  // Clear any existing data from the decoded packet queue
-  DecodedPacket packet;
-  while (mDecodedPacketQueue.Read(packet))
+  // Each request decodes one packet, which is one page. Only request as many
+  // pages as the queue can hold, the rest are requested as pages are received.
+  while (mRequestedPages < mTargetPages && mRequestedPages - mNextPageIndex < cMaxQueuedPages)
   {
+    mDecoder.DecodeNextSection();
+    ++mRequestedPages;
   }
 }
 
-void StreamingDataPerInstance::DecodingCallback(DecodedPacket* packet)
+void StreamingDecodeCursor::DecodingCallback(DecodedPacket* packet)
 {
-  mDecodedPacketQueue.Write(*packet);
+  bool written = mDecodedPacketQueue.Write(*packet);
+  ErrorIf(!written, "Requested more streaming pages than the decoded packet queue can hold");
 }
 
 // Streaming Sound Asset
@@ -154,7 +256,11 @@ RaverieDefineType(StreamingSoundAsset, builder, Type)
 {
 }
 
-StreamingSoundAsset::StreamingSoundAsset(Status& status, const String& fileName, AudioFileLoadType::Enum loadType, const String& assetName) : SoundAsset(assetName, true), mFileName(fileName)
+// Used to give each streaming asset a unique ID in the page cache
+static Atomic<u32> sNextStreamingCacheID(1);
+
+StreamingSoundAsset::StreamingSoundAsset(Status& status, const String& fileName, AudioFileLoadType::Enum loadType, const String& assetName) :
+    SoundAsset(assetName, true), mFileName(fileName), mCacheID(sNextStreamingCacheID.FetchAdd(1)), mPageCount(0)
 {
   FileHeader header;
   unsigned fileSize = PacketDecoder::OpenAndReadHeader(status, fileName, &mInputFile, &header);
@@ -182,18 +288,31 @@ StreamingSoundAsset::StreamingSoundAsset(Status& status, const String& fileName,
   mChannels = header.Channels;
   mFrameCount = header.SamplesPerChannel;
   mFileLength = (float)mFrameCount / (float)AudioConstants::cSystemSampleRate;
+  // Every packet has the same number of frames (the last one is padded)
+  mPageCount = (mFrameCount + AudioFileEncoder::cPacketFrames - 1) / AudioFileEncoder::cPacketFrames;
 }
 
 StreamingSoundAsset::~StreamingSoundAsset()
 {
-  // Delete any existing instance data objects (though this shouldn't happen
-  // normally since assets shouldn't be deleted when there are any instances)
+  // Delete any existing instance data and cursor objects (though this shouldn't
+  // happen normally since assets shouldn't be deleted when there are any
+  // instances)
   while (!mDataPerInstanceList.Empty())
   {
     StreamingDataPerInstance* data = &mDataPerInstanceList.Front();
     mDataPerInstanceList.PopFront();
     delete data;
   }
+  while (!mCursorList.Empty())
+  {
+    StreamingDecodeCursor* cursor = &mCursorList.Front();
+    mCursorList.PopFront();
+    delete cursor;
+  }
+
+  // Remove this asset's pages from the cache on the mix thread
+  if (Z::gSound)
+    Z::gSound->Mixer.AddTask(CreateFunctor(&DecodedPageCache::RemoveAssetPages, &Z::gSound->Mixer.PageCacheThreaded, mCacheID), nullptr);
 }
 
 void StreamingSoundAsset::AppendSamplesThreaded(BufferType* buffer, const unsigned frameIndex, unsigned samplesRequested, unsigned instanceID)
@@ -202,6 +321,7 @@ void StreamingSoundAsset::AppendSamplesThreaded(BufferType* buffer, const unsign
   unsigned originalBufferSize = buffer->Size();
   // Resize the buffer to hold the new samples
   buffer->Resize(originalBufferSize + samplesRequested);
+  float* outputBuffer = buffer->Data() + originalBufferSize;
 
   // Get the data for this instance
   StreamingDataPerInstance* data = GetInstanceData(instanceID);
@@ -210,62 +330,68 @@ void StreamingSoundAsset::AppendSamplesThreaded(BufferType* buffer, const unsign
     ErrorIf(true, "Instance data was not created on a streaming asset");
 
     // If it doesn't exist, set the requested samples to zero and return
-    memset(buffer->Data() + originalBufferSize, 0, sizeof(float) * samplesRequested);
+    memset(outputBuffer, 0, sizeof(float) * samplesRequested);
     return;
   }
 
+  // Move any newly decoded pages into the cache
+  ReceiveDecodedPagesThreaded();
+
   // Translate from frames to sample location
+  unsigned pageSamples = AudioFileEncoder::cPacketFrames * mChannels;
   unsigned sampleIndex = frameIndex * mChannels;
-  // Adjust the sample index to be within the current buffer
-  sampleIndex -= data->mPreviousSamples;
 
-  CopySamplesIntoBuffer(buffer->Data() + originalBufferSize, sampleIndex, samplesRequested, data);
+  // Make sure the pages for these samples and the ones after them are decoded
+  PrefetchPagesThreaded(sampleIndex / pageSamples, data);
+
+  DecodedPageCache& cache = Z::gSound->Mixer.PageCacheThreaded;
+  while (samplesRequested > 0)
+  {
+    unsigned pageIndex = sampleIndex / pageSamples;
+    unsigned pageSampleIndex = sampleIndex - (pageIndex * pageSamples);
+    unsigned samplesToCopy = Math::Min(samplesRequested, pageSamples - pageSampleIndex);
+
+    // Copy the samples from the page if it's been decoded, otherwise set them
+    // to zero
+    DecodedPage* page = cache.FindPage(mCacheID, pageIndex);
+    if (page && pageSampleIndex + samplesToCopy <= page->mSamples.Size())
+      memcpy(outputBuffer, page->mSamples.Data() + pageSampleIndex, sizeof(float) * samplesToCopy);
+    else
+      memset(outputBuffer, 0, sizeof(float) * samplesToCopy);
+
+    outputBuffer += samplesToCopy;
+    sampleIndex += samplesToCopy;
+    samplesRequested -= samplesToCopy;
+  }
 }
 
 void StreamingSoundAsset::ResetStreamingFile(unsigned instanceID)
 {
+  // Pages are read by index, so the instance only needs to stop following its
+  // cursor (the next read will find or create one for the new position)
   StreamingDataPerInstance* data = GetInstanceData(instanceID);
   if (data)
-  {
-    data->Reset();
-    data->mDecoder.DecodeNextSection();
-  }
+    ReleaseCursorThreaded(data);
 }
 
 void StreamingSoundAsset::OnAddInstanceThreaded(unsigned instanceID)
 {
-  Raverie::Status status;
-  StreamingDataPerInstance* data = nullptr;
-
-  // If there is data in the buffer, create the instance data for streaming from
-  // memory
-  if (!mInputFileData.Empty())
-    data = new StreamingDataPerInstance(status, mInputFileData.Data(), mInputFileData.Size(), mChannels, mFrameCount, instanceID);
-  // Otherwise, check if the file name is set
-  else if (!mFileName.Empty())
+  // If streaming from file and the input file is not open (because there are
+  // no current instances) open it
+  if (mInputFileData.Empty() && !mInputFile.IsOpen())
   {
-    // If the input file is not open (because there are no current instances)
-    // open it
-    if (!mInputFile.IsOpen())
-    {
-      mInputFile.Open(mFileName, Raverie::FileMode::Read, Raverie::FileAccessPattern::Sequential);
-      ErrorIf(!mInputFile.IsOpen(), "Could not open streaming audio file to play a new instance");
-      if (!mInputFile.IsOpen())
-        return;
-    }
+    ErrorIf(mFileName.Empty(), "No data or file name to play streaming audio asset");
+    if (mFileName.Empty())
+      return;
 
-    // Create the instance data for streaming from file
-    data = new StreamingDataPerInstance(status, &mInputFile, &mLock, mChannels, mFrameCount, instanceID);
+    mInputFile.Open(mFileName, Raverie::FileMode::Read, Raverie::FileAccessPattern::Sequential);
+    ErrorIf(!mInputFile.IsOpen(), "Could not open streaming audio file to play a new instance");
+    if (!mInputFile.IsOpen())
+      return;
   }
 
-  ErrorIf(!data, "No data or file name to play streaming audio asset");
-
-  // If there was a problem creating the instance data, delete it
-  if (status.Failed())
-    delete data;
-  // Make sure the data object was created before adding it to the list
-  else if (data)
-    mDataPerInstanceList.PushBack(data);
+  // Cursors are created when the instance first reads samples
+  mDataPerInstanceList.PushBack(new StreamingDataPerInstance(instanceID));
 }
 
 void StreamingSoundAsset::OnRemoveInstanceThreaded(unsigned instanceID)
@@ -274,11 +400,13 @@ void StreamingSoundAsset::OnRemoveInstanceThreaded(unsigned instanceID)
   StreamingDataPerInstance* data = GetInstanceData(instanceID);
   if (data)
   {
-    // Remove it from the list and delete it
+    // Stop using its cursor, then remove it from the list and delete it
+    ReleaseCursorThreaded(data);
     mDataPerInstanceList.Erase(data);
     delete data;
 
     // If there are no current instances playing, close the input file
+    // (decoded pages stay in the cache in case the asset is played again)
     if (mDataPerInstanceList.Empty())
       mInputFile.Close();
   }
@@ -295,44 +423,115 @@ Raverie::StreamingDataPerInstance* StreamingSoundAsset::GetInstanceData(unsigned
   return nullptr;
 }
 
-void StreamingSoundAsset::CopySamplesIntoBuffer(float* outputBuffer, unsigned sampleIndex, unsigned samplesRequested, StreamingDataPerInstance* data)
+void StreamingSoundAsset::ReceiveDecodedPagesThreaded()
 {
-  // Check if the requested index is past the end of the Samples buffer
-  while (sampleIndex >= data->mSamples.Size())
+  DecodedPageCache& cache = Z::gSound->Mixer.PageCacheThreaded;
+
+  forRange (StreamingDecodeCursor& cursor, mCursorList.All())
   {
-    DecodedPacket packet;
-    // If there are no packets available, set the buffer to zero and return
-    if (!data->mDecodedPacketQueue.Read(packet))
+    while (DecodedPacket* packet = cursor.mDecodedPacketQueue.Peek())
     {
-      // Trigger another decoded buffer
-      data->mDecoder.DecodeNextSection();
+      // Pages before the first one needed were only decoded for history
+      if (cursor.mNextPageIndex >= cursor.mFirstCachedPage)
+        cache.AddPage(mCacheID, cursor.mNextPageIndex, packet->mSamples);
+
+      cursor.mDecodedPacketQueue.Pop();
+      ++cursor.mNextPageIndex;
+    }
+
+    // Request any pages that didn't fit in the queue
+    cursor.RequestPages(cursor.mTargetPages);
+  }
+}
 
-      memset(outputBuffer, 0, sizeof(float) * samplesRequested);
+void StreamingSoundAsset::PrefetchPagesThreaded(unsigned pageIndex, StreamingDataPerInstance* data)
+{
+  DecodedPageCache& cache = Z::gSound->Mixer.PageCacheThreaded;
+
+  unsigned endPageIndex = Math::Min(pageIndex + cPrefetchPages, mPageCount);
+  for (; pageIndex < endPageIndex; ++pageIndex)
+  {
+    // Nothing to do if this page was already decoded
+    if (cache.HasPage(mCacheID, pageIndex))
+      continue;
+
+    // Find the best cursor to decode this page
+    StreamingDecodeCursor* cursor = GetCursorForPageThreaded(pageIndex);
+    if (!cursor)
       return;
+
+    // If it's different from the instance's current cursor, switch to it
+    if (cursor != data->mCursor)
+    {
+      ++cursor->mReferenceCount;
+      ReleaseCursorThreaded(data);
+      data->mCursor = cursor;
     }
 
-    // Increase the previous samples variable
-    data->mPreviousSamples += data->mSamples.Size();
-    // Adjust the sampleIndex
-    sampleIndex -= data->mSamples.Size();
-    // Remove the old samples
-    data->mSamples.Clear();
-    // Move the decoded data into the Samples buffer
-    data->mSamples.Swap(packet.mSamples);
-
-    // Trigger another decoded buffer
-    data->mDecoder.DecodeNextSection();
+    // Request decoding through this page
+    cursor->RequestPages(pageIndex + 1);
   }
+}
 
-  // Copy either the number of samples requested or the samples available,
-  // whichever is smaller
-  unsigned samplesCopied = Math::Min(samplesRequested, (unsigned)(data->mSamples.Size() - sampleIndex));
-  memcpy(outputBuffer, data->mSamples.Data() + sampleIndex, sizeof(float) * samplesCopied);
+StreamingDecodeCursor* StreamingSoundAsset::GetCursorForPageThreaded(unsigned pageIndex)
+{
+  // Look for the cursor closest to the page that hasn't passed it
+  StreamingDecodeCursor* closestCursor = nullptr;
+  forRange (StreamingDecodeCursor& cursor, mCursorList.All())
+  {
+    if (cursor.mNextPageIndex <= pageIndex && (!closestCursor || cursor.mNextPageIndex > closestCursor->mNextPageIndex))
+      closestCursor = &cursor;
+  }
+
+  if (closestCursor)
+  {
+    // Make sure this page will be added to the cache
+    closestCursor->mFirstCachedPage = Math::Min(closestCursor->mFirstCachedPage, pageIndex);
+    return closestCursor;
+  }
 
-  // If we did not copy enough samples, keep trying (in case there is another
-  // decoded buffer available)
-  if (samplesCopied < samplesRequested)
-    CopySamplesIntoBuffer(outputBuffer + samplesCopied, sampleIndex + samplesCopied, samplesRequested - samplesCopied, data);
+  // Otherwise create a new cursor, which starts at the beginning of the file
+  // since the decoders rely on the history of previous packets
+  Status status;
+  StreamingDecodeCursor* cursor = nullptr;
+  if (!mInputFileData.Empty())
+    cursor = new StreamingDecodeCursor(status, mInputFileData.Data(), mInputFileData.Size(), mChannels, mFrameCount);
+  else if (mInputFile.IsOpen())
+    cursor = new StreamingDecodeCursor(status, &mInputFile, &mLock, mChannels, mFrameCount);
+
+  ErrorIf(!cursor, "No data or open file to play streaming audio asset");
+
+  // If there was a problem creating the cursor, delete it
+  if (status.Failed())
+  {
+    delete cursor;
+    return nullptr;
+  }
+
+  if (cursor)
+  {
+    cursor->mFirstCachedPage = pageIndex;
+    mCursorList.PushBack(cursor);
+  }
+
+  return cursor;
+}
+
+void StreamingSoundAsset::ReleaseCursorThreaded(StreamingDataPerInstance* data)
+{
+  StreamingDecodeCursor* cursor = data->mCursor;
+  if (!cursor)
+    return;
+
+  data->mCursor = nullptr;
+
+  // Delete the cursor if no other instances are using it
+  --cursor->mReferenceCount;
+  if (cursor->mReferenceCount == 0)
+  {
+    mCursorList.Erase(cursor);
+    delete cursor;
+  }
 }
 
 } // namespace Raverie
@@ -76,33 +76,125 @@ private:
   volatile unsigned mSamplesAvailableShared;
 };
 
-// Streaming Data Per Instance
+// Decoded Page
 
-class StreamingDataPerInstance
+// One decoded packet of a streaming asset, shared by all of its instances
+class DecodedPage
+{
+public:
+  DecodedPage(u64 key) : mKey(key), mLastUsedMixVersion(0)
+  {
+  }
+
+  // The interleaved decoded samples
+  BufferType mSamples;
+  // The key of this page in the cache (asset ID and page index)
+  u64 mKey;
+  // The mix version when this page was last read
+  unsigned mLastUsedMixVersion;
+
+  Link<DecodedPage> link;
+};
+
+// Decoded Page Cache
+
+// Decoded pages of all streaming assets, keyed by asset and page index, so
+// instances of the same asset don't decode the same audio again. When the
+// memory budget is exceeded the least recently used pages are removed. Only
+// used on the mix thread.
+class DecodedPageCache
+{
+public:
+  DecodedPageCache();
+  ~DecodedPageCache();
+
+  // Returns the page and marks it as recently used, or returns null if it is
+  // not in the cache
+  DecodedPage* FindPage(unsigned assetID, unsigned pageIndex);
+  // Returns true if the page is in the cache
+  bool HasPage(unsigned assetID, unsigned pageIndex);
+  // Adds a decoded page, taking the samples from the provided buffer. Does
+  // nothing if the page is already in the cache.
+  void AddPage(unsigned assetID, unsigned pageIndex, BufferType& samples);
+  // Removes all pages belonging to an asset
+  void RemoveAssetPages(unsigned assetID);
+  // Sets the maximum amount of memory used by the decoded pages
+  void SetMemoryBudget(size_t bytes);
+
+private:
+  // Removes the least recently used pages until the cache is within its budget
+  // (pages used in the current mix are never removed)
+  void RemoveOldPages();
+  // Removes and deletes a single page
+  void RemovePage(DecodedPage* page);
+  // Combines the asset ID and page index into the key used by the map
+  static u64 GetKey(unsigned assetID, unsigned pageIndex);
+
+  // Map of keys to pages
+  HashMap<u64, DecodedPage*> mPages;
+  // All pages, ordered from the least to the most recently used
+  InList<DecodedPage> mLeastRecentlyUsedList;
+  // The memory currently used by decoded samples, in bytes
+  size_t mMemoryUsed;
+  // The maximum memory to use for decoded samples, in bytes
+  size_t mMemoryBudget;
+};
+
+// Streaming Decode Cursor
+
+// Decodes the packets of a streaming asset in order and adds them to the page
+// cache. Instances reading near the same position share a cursor.
+class StreamingDecodeCursor
 {
 public:
   // The file object must be already open, and will not be closed by this
-  // decoder
-  StreamingDataPerInstance(Status& status, File* inputFile, ThreadLock* lock, unsigned channels, unsigned frames, unsigned instanceID);
+  // cursor
+  StreamingDecodeCursor(Status& status, File* inputFile, ThreadLock* lock, unsigned channels, unsigned frames);
   // The input data buffer must already exist, and will not be deleted by this
-  // decoder
-  StreamingDataPerInstance(Status& status, byte* inputData, unsigned dataSize, unsigned channels, unsigned frames, unsigned instanceID);
+  // cursor
+  StreamingDecodeCursor(Status& status, byte* inputData, unsigned dataSize, unsigned channels, unsigned frames);
 
-  // Resets the data to start streaming from the beginning of the file
-  void Reset();
+  // Requests pages from the decoder until the page before the end index, as
+  // far as there is room in the decoded packet queue
+  void RequestPages(unsigned endPageIndex);
   // Called by the decoder to pass off decoded samples
   void DecodingCallback(DecodedPacket* packet);
 
-  // The current buffer of decoded samples
-  BufferType mSamples;
-  // Keeps track of previously played samples to translate indexes
-  unsigned mPreviousSamples;
+  // The most pages that can be waiting in the decoded packet queue
+  static const unsigned cMaxQueuedPages = 32;
+
   // The decoder object
   StreamingDecoder mDecoder;
+  // The list of decoded packets to move into the cache
+  LockFreeQueue<DecodedPacket> mDecodedPacketQueue;
+  // The index of the next page that will be read from the queue
+  unsigned mNextPageIndex;
+  // The number of pages requested from the decoder
+  unsigned mRequestedPages;
+  // The number of pages that should be requested once there is room
+  unsigned mTargetPages;
+  // Pages before this index are only decoded to keep the decoder history, and
+  // are not added to the cache
+  unsigned mFirstCachedPage;
+  // The number of instances currently reading through this cursor
+  unsigned mReferenceCount;
+
+  Link<StreamingDecodeCursor> link;
+};
+
+// Streaming Data Per Instance
+
+class StreamingDataPerInstance
+{
+public:
+  StreamingDataPerInstance(unsigned instanceID) : mInstanceID(instanceID), mCursor(nullptr)
+  {
+  }
+
   // The ID of the instance associated with this data
   unsigned mInstanceID;
-  // The list of decoded packets to process
-  LockFreeQueue<DecodedPacket> mDecodedPacketQueue;
+  // The cursor decoding the pages this instance is reading, if any
+  StreamingDecodeCursor* mCursor;
 
   Link<StreamingDataPerInstance> link;
 };
@@ -127,15 +219,29 @@ public:
   // Removes data for a specific instance.
   void OnRemoveInstanceThreaded(unsigned instanceID) override;
 
+  // The number of pages decoded ahead of the current read position
+  static const unsigned cPrefetchPages = 4;
+
 private:
   // Looks for a specific instance ID in the data list. Returns null if not
   // found.
   StreamingDataPerInstance* GetInstanceData(unsigned instanceID);
-  // Copies available decoded samples into the provided buffer
-  void CopySamplesIntoBuffer(float* outputBuffer, unsigned sampleIndex, unsigned samplesRequested, StreamingDataPerInstance* data);
+  // Moves the pages decoded by all cursors into the cache
+  void ReceiveDecodedPagesThreaded();
+  // Makes sure the pages from the specified index through the prefetch range
+  // are either in the cache or will be decoded
+  void PrefetchPagesThreaded(unsigned pageIndex, StreamingDataPerInstance* data);
+  // Returns the cursor closest to the page that hasn't passed it, creating a
+  // new cursor if there isn't one. Returns null if a cursor can't be created.
+  StreamingDecodeCursor* GetCursorForPageThreaded(unsigned pageIndex);
+  // Stops the instance from reading through its cursor, deleting the cursor if
+  // no other instances are using it
+  void ReleaseCursorThreaded(StreamingDataPerInstance* data);
 
   // Decoded data per instance
   InList<StreamingDataPerInstance> mDataPerInstanceList;
+  // Cursors currently decoding this asset
+  InList<StreamingDecodeCursor> mCursorList;
   // If streaming from file, the file object to keep open
   File mInputFile;
   // The name of the file
@@ -144,6 +250,10 @@ private:
   Array<byte> mInputFileData;
   // Used to lock when reading from the input file
   ThreadLock mLock;
+  // The ID used for this asset's pages in the page cache
+  unsigned mCacheID;
+  // The number of pages (packets) in the file
+  unsigned mPageCount;
 };
 
 } // namespace Raverie
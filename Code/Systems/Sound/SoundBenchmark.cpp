@@ -0,0 +1,290 @@
+// MIT Licensed (see LICENSE.md).
+#include "Precompiled.hpp"
+
+namespace Raverie
+{
+
+namespace SoundBenchmarkSettings
+{
+
+// Blocks mixed after the voices start, before timing, so that play tasks and
+// the first decoding of each Sound are not counted
+const int cWarmUpBlocks = 4;
+// Distance of the SoundEmitters from the SoundListener in positional graphs
+const float cEmitterRadius = 2.0f;
+
+} // namespace SoundBenchmarkSettings
+
+namespace SoundBenchmarkWav
+{
+
+// The largest value of a 16 bit sample
+const float cMaxSampleValue = (float)((1 << 15) - 1);
+
+// The header of a 16 bit PCM wav file
+struct Header
+{
+  char riff_chunk[4];
+  unsigned chunk_size;
+  char wave_fmt[4];
+  char fmt_chunk[4];
+  unsigned fmt_chunk_size;
+  unsigned short audio_format;
+  unsigned short number_of_channels;
+  unsigned sampling_rate;
+  unsigned bytes_per_second;
+  unsigned short bytes_per_sample;
+  unsigned short bits_per_sample;
+  char data_chunk[4];
+  unsigned data_chunk_size;
+};
+
+} // namespace SoundBenchmarkWav
+
+RaverieDefineType(SoundBenchmark, builder, type)
+{
+  RaverieBindDocumented();
+
+  RaverieBindMethod(Run);
+  RaverieBindMethod(RenderToFile);
+  RaverieBindMethod(SetOutputFormat);
+}
+
+String SoundBenchmark::Run(Space* space, Sound* sound, int voices, SoundBenchmarkGraph::Enum graph, int blocks)
+{
+  ReturnIf(ThreadingEnabled, String(), "The sound benchmark can only run when the audio mix is not threaded.");
+  ReturnIf(space == nullptr, String(), "Cannot run a sound benchmark in a null space.");
+  SoundSpace* soundSpace = space->has(SoundSpace);
+  ReturnIf(soundSpace == nullptr, String(), "Cannot run a sound benchmark in a space without a SoundSpace.");
+  ReturnIf(sound == nullptr, String(), "Cannot run a sound benchmark without a Sound.");
+
+  using namespace SoundBenchmarkSettings;
+
+  voices = Math::Max(voices, 0);
+  blocks = Math::Max(blocks, 1);
+  bool positional = graph == SoundBenchmarkGraph::Positional || graph == SoundBenchmarkGraph::Full;
+
+  // Positional graphs need a listener to pan and attenuate for
+  Array<Cog*> cogs;
+  if (positional)
+  {
+    Cog* listenerCog = space->CreateAt(CoreArchetypes::Transform, Vec3::cZero);
+    listenerCog->AddComponentByName("SoundListener");
+    cogs.PushBack(listenerCog);
+  }
+
+  // Time the mix without any voices so it can be taken out of the per voice
+  // cost
+  unsigned framesPerBlock = 0;
+  MixBlocks(cWarmUpBlocks, framesPerBlock);
+  double baseSeconds = MixBlocks(blocks, framesPerBlock);
+
+  // Every voice loops the same Sound
+  HandleOf<SoundCue> cue = SoundCue::CreateRuntime();
+  cue->AddSoundEntry(sound, 1.0f);
+  cue->SetPlayMode(SoundPlayMode::Looping);
+  if (positional)
+  {
+    if (SoundAttenuator* attenuator = SoundAttenuatorManager::FindOrNull("DefaultAttenuation"))
+      cue->SetAttenuator(attenuator);
+  }
+
+  Array<HandleOf<SoundInstance>> instances;
+  Array<HandleOf<SoundNode>> nodes;
+  for (int i = 0; i < voices; ++i)
+  {
+    // Create the filter nodes for this voice, in processing order
+    Array<SoundNode*> chain;
+    if (graph == SoundBenchmarkGraph::Filtered || graph == SoundBenchmarkGraph::Full)
+    {
+      chain.PushBack(SoundSystem::LowPassNode());
+      chain.PushBack(SoundSystem::HighPassNode());
+    }
+    if (graph == SoundBenchmarkGraph::Reverb || graph == SoundBenchmarkGraph::Full)
+      chain.PushBack(SoundSystem::ReverbNode());
+
+    forRange (SoundNode* node, chain.All())
+      nodes.PushBack(node);
+
+    HandleOf<SoundInstance> instance;
+    if (positional)
+    {
+      // Spread the emitters around the listener so the panning differs
+      float angle = Math::cTwoPi * i / voices;
+      Vec3 position(Math::Cos(angle) * cEmitterRadius, 0, Math::Sin(angle) * cEmitterRadius);
+      Cog* emitterCog = space->CreateAt(CoreArchetypes::Transform, position);
+      emitterCog->AddComponentByName("SoundEmitter");
+      cogs.PushBack(emitterCog);
+      SoundEmitter* emitter = emitterCog->has(SoundEmitter);
+
+      // Filter the emitter's output so attenuation and panning happen first
+      SoundNode* previous = emitter->GetSoundNodeOutput();
+      forRange (SoundNode* node, chain.All())
+      {
+        previous->InsertNodeAfter(node);
+        previous = node;
+      }
+
+      instance = emitter->PlayCue(cue);
+    }
+    else
+    {
+      // Connect the chain to the SoundSpace from the back and play into the
+      // front of it
+      SoundNode* output = soundSpace->GetSoundNodeInput();
+      for (int j = (int)chain.Size() - 1; j >= 0; --j)
+      {
+        output->AddInputNode(chain[j]);
+        output = chain[j];
+      }
+
+      instance = cue->PlayCue(soundSpace, output, false);
+    }
+
+    if (instance)
+      instances.PushBack(instance);
+  }
+
+  MixBlocks(cWarmUpBlocks, framesPerBlock);
+  double seconds = MixBlocks(blocks, framesPerBlock);
+
+  // Voices beyond the real voice limit are virtual and cost almost nothing, so
+  // the per voice cost only counts the real ones
+  int virtualVoices = 0;
+  forRange (HandleOf<SoundInstance>& instance, instances.All())
+  {
+    SoundInstance* soundInstance = instance;
+    if (soundInstance && soundInstance->GetIsVirtual())
+      ++virtualVoices;
+  }
+
+  // Remove everything that was created
+  forRange (HandleOf<SoundInstance>& instance, instances.All())
+  {
+    if (SoundInstance* soundInstance = instance)
+      soundInstance->Stop();
+  }
+  forRange (HandleOf<SoundNode>& node, nodes.All())
+  {
+    if (SoundNode* soundNode = node)
+    {
+      soundNode->RemoveAllInputs();
+      soundNode->RemoveAllOutputs();
+    }
+  }
+  forRange (Cog* cog, cogs.All())
+    cog->Destroy();
+  // Let the mix handle the removals
+  MixBlocks(1, framesPerBlock);
+
+  // The time available to mix one block in real time
+  unsigned sampleRate = Z::gSound->Mixer.OfflineIO.GetStreamSampleRate(StreamTypes::Output);
+  double budgetUs = framesPerBlock * 1000000.0 / sampleRate;
+  double baseUsPerBlock = baseSeconds * 1000000.0 / blocks;
+  double usPerBlock = seconds * 1000000.0 / blocks;
+  int realVoices = (int)instances.Size() - virtualVoices;
+  double usPerVoice = realVoices > 0 ? Math::Max(usPerBlock - baseUsPerBlock, 0.0) / realVoices : 0.0;
+  int maxRealTimeVoices = usPerVoice > 0.0 ? (int)((budgetUs - baseUsPerBlock) / usPerVoice) : 0;
+
+  JsonBuilder builder;
+  builder.Begin(JsonType::Object);
+  builder.Key("voices");
+  builder.Value(voices);
+  builder.Key("virtualVoices");
+  builder.Value(virtualVoices);
+  builder.Key("graph");
+  builder.Value(SoundBenchmarkGraph::Names[graph]);
+  builder.Key("blocks");
+  builder.Value(blocks);
+  builder.Key("blockFrames");
+  builder.Value((int)framesPerBlock);
+  builder.Key("sampleRate");
+  builder.Value((int)sampleRate);
+  builder.Key("budgetUs");
+  builder.Value(budgetUs);
+  builder.Key("baseUsPerBlock");
+  builder.Value(baseUsPerBlock);
+  builder.Key("usPerBlock");
+  builder.Value(usPerBlock);
+  builder.Key("usPerVoice");
+  builder.Value(usPerVoice);
+  builder.Key("maxRealTimeVoices");
+  builder.Value(Math::Max(maxRealTimeVoices, 0));
+  builder.End();
+  return builder.ToString();
+}
+
+bool SoundBenchmark::RenderToFile(StringParam fileName, float seconds)
+{
+  ReturnIf(ThreadingEnabled, false, "Audio can only be rendered to a file when the audio mix is not threaded.");
+  ReturnIf(seconds <= 0.0f, false, "The length of audio to render must be positive.");
+
+  AudioIOInterface& offlineIO = Z::gSound->Mixer.OfflineIO;
+  unsigned channels = offlineIO.GetStreamChannels(StreamTypes::Output);
+  unsigned sampleRate = offlineIO.GetStreamSampleRate(StreamTypes::Output);
+  unsigned totalFrames = (unsigned)(seconds * sampleRate);
+
+  // Mix until there is enough audio, as fast as possible
+  BufferType samples;
+  samples.Reserve(totalFrames * channels);
+  while (samples.Size() < totalFrames * channels)
+  {
+    if (Z::gSound->Mixer.MixOffline(&samples) == 0)
+      return false;
+  }
+  samples.Resize(totalFrames * channels);
+
+  File file;
+  file.Open(fileName, FileMode::Write, FileAccessPattern::Sequential);
+  ReturnIf(!file.IsOpen(), false, "Could not open the file to render audio to.");
+
+  unsigned dataSize = totalFrames * channels * sizeof(short);
+  SoundBenchmarkWav::Header header = {{'R', 'I', 'F', 'F'},
+                                      36 + dataSize,
+                                      {'W', 'A', 'V', 'E'},
+                                      {'f', 'm', 't', ' '},
+                                      16,                                         // fmt chunk size
+                                      1,                                          // audio format
+                                      (unsigned short)channels,                   // number of channels
+                                      sampleRate,                                 // sampling rate
+                                      sampleRate * channels * sizeof(short),      // bytes per second
+                                      (unsigned short)(channels * sizeof(short)), // bytes per frame
+                                      16,                                         // bits per sample
+                                      {'d', 'a', 't', 'a'},
+                                      dataSize};
+  file.Write(reinterpret_cast<byte*>(&header), sizeof(header));
+
+  // Convert from float to short
+  Array<short> shortSamples(samples.Size());
+  for (unsigned i = 0; i < samples.Size(); ++i)
+    shortSamples[i] = (short)(Math::Clamp(samples[i], -1.0f, 1.0f) * SoundBenchmarkWav::cMaxSampleValue);
+  file.Write(reinterpret_cast<byte*>(shortSamples.Data()), dataSize);
+
+  file.Close();
+  return true;
+}
+
+void SoundBenchmark::SetOutputFormat(int sampleRate, int channels)
+{
+  ReturnIf(sampleRate <= 0, , "The offline sample rate must be positive.");
+  ReturnIf(channels < 1 || channels > 8, , "Offline output must have 1 to 8 channels.");
+
+  Z::gSound->Mixer.SetOfflineOutputFormat((unsigned)sampleRate, (unsigned)channels);
+}
+
+double SoundBenchmark::MixBlocks(int blocks, unsigned& framesPerBlock)
+{
+  BufferType output;
+
+  double seconds = 0.0;
+  for (int i = 0; i < blocks; ++i)
+  {
+    // (Clearing keeps the capacity, so only the first block allocates)
+    output.Clear();
+    framesPerBlock = Z::gSound->Mixer.MixOffline(&output, &seconds);
+  }
+
+  return seconds;
+}
+
+} // namespace Raverie
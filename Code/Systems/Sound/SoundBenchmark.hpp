@@ -0,0 +1,42 @@
+// MIT Licensed (see LICENSE.md).
+#pragma once
+
+namespace Raverie
+{
+
+/// The node graphs that SoundBenchmark can play each voice through.
+/// Direct: straight into the SoundSpace. Filtered: low and high pass filters.
+/// Reverb: a ReverbNode. Positional: a SoundEmitter with attenuation and
+/// panning. Full: a SoundEmitter whose output goes through the filters and
+/// then the reverb.
+DeclareEnum5(SoundBenchmarkGraph, Direct, Filtered, Reverb, Positional, Full);
+
+/// Mixes audio offline, into an output with no audio device behind it, so the
+/// cost of the mix can be measured repeatably and audio can be rendered faster
+/// than real time. Only available when the audio mix is not threaded. Results
+/// are reported as Json so runs can be compared.
+class SoundBenchmark
+{
+public:
+  RaverieDeclareType(SoundBenchmark, TypeCopyMode::ReferenceType);
+
+  /// Plays the Sound on the given number of looping voices, each through its
+  /// own copy of the node graph, and mixes the given number of blocks offline.
+  /// Returns the time per block, the time per real voice, and the number of
+  /// voices that would fit in the real time budget of a block as a Json object.
+  static String Run(Space* space, Sound* sound, int voices, SoundBenchmarkGraph::Enum graph, int blocks);
+  /// Mixes the given number of seconds of the current audio offline and
+  /// writes them to a 16 bit wav file. Returns false if the file could not be
+  /// written.
+  static bool RenderToFile(StringParam fileName, float seconds);
+  /// Sets the sample rate and number of channels (1 to 8) that offline mixes
+  /// produce. Defaults to the format of the audio output.
+  static void SetOutputFormat(int sampleRate, int channels);
+
+private:
+  // Mixes the blocks offline and returns the time spent mixing in seconds
+  // (not counting decoding and task handling between mixes)
+  static double MixBlocks(int blocks, unsigned& framesPerBlock);
+};
+
+} // namespace Raverie
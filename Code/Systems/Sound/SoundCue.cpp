@@ -274,6 +274,9 @@ RaverieDefineType(SoundCue, builder, type)
   RaverieBindGetterSetterProperty(PitchVariation)->Add(new EditorSlider(0.0f, 1.0f, 0.1f))->RaverieFilterNotBool(mUseSemitoneVariation);
   RaverieBindGetterSetterProperty(SemitoneVariation)->Add(new EditorSlider(0.0f, 12.0f, 0.1f))->RaverieFilterBool(mUseSemitoneVariation);
   RaverieBindGetterSetterProperty(Attenuator);
+  RaverieBindGetterSetterProperty(Priority);
+  RaverieBindGetterSetterProperty(MaxRealVoices);
+  RaverieBindGetterSetterProperty(ResampleQuality);
   RaverieBindFieldProperty(mShowMusicOptions)->AddAttribute(PropertyAttributes::cInvalidatesObject);
   RaverieBindGetterSetterProperty(BeatsPerMinute)->RaverieFilterBool(mShowMusicOptions);
   RaverieBindGetterSetterProperty(TimeSigBeats)->RaverieFilterBool(mShowMusicOptions);
@@ -308,6 +311,9 @@ SoundCue::SoundCue() :
     mBeatsPerMinute(0),
     mTimeSigBeats(0),
     mTimeSigValue(0),
+    mPriority(0),
+    mMaxRealVoices(0),
+    mResampleQuality(ResampleQuality::Linear),
     mUseSemitoneVariation(false),
     mUseDecibelVariation(false),
     mSoundIndex(0)
@@ -321,6 +327,12 @@ SoundCue::~SoundCue()
 {
 }
 
+HandleOf<SoundCue> SoundCue::CreateRuntime()
+{
+  SoundCue* cue = SoundCueManager::CreateRuntime();
+  return cue;
+}
+
 void SoundCue::Serialize(Serializer& stream)
 {
   SerializeEnumNameDefault(SoundPlayMode, mPlayMode, SoundPlayMode::Single);
@@ -336,6 +348,9 @@ void SoundCue::Serialize(Serializer& stream)
   SerializeNameDefault(mBeatsPerMinute, 0.0f);
   SerializeNameDefault(mTimeSigBeats, 0.0f);
   SerializeNameDefault(mTimeSigValue, 0.0f);
+  SerializeNameDefault(mPriority, 0);
+  SerializeNameDefault(mMaxRealVoices, 0);
+  SerializeEnumNameDefault(ResampleQuality, mResampleQuality, ResampleQuality::Linear);
 
   SerializeName(Sounds);
   SerializeNameDefault(SoundTags, Array<SoundTagEntry>());
@@ -490,6 +505,36 @@ void SoundCue::SetAttenuator(SoundAttenuator* attenuation)
   mAttenuator = attenuation;
 }
 
+int SoundCue::GetPriority()
+{
+  return mPriority;
+}
+
+void SoundCue::SetPriority(int priority)
+{
+  mPriority = priority;
+}
+
+int SoundCue::GetMaxRealVoices()
+{
+  return mMaxRealVoices;
+}
+
+void SoundCue::SetMaxRealVoices(int maxVoices)
+{
+  mMaxRealVoices = Math::Max(maxVoices, 0);
+}
+
+ResampleQuality::Enum SoundCue::GetResampleQuality()
+{
+  return mResampleQuality;
+}
+
+void SoundCue::SetResampleQuality(ResampleQuality::Enum quality)
+{
+  mResampleQuality = quality;
+}
+
 void SoundCue::AddSoundEntry(Sound* sound, float weight)
 {
   SoundEntry& soundEntry = Sounds.PushBack();
@@ -623,6 +668,11 @@ HandleOf<SoundInstance> SoundCue::PlayCue(SoundSpace* space, HandleOf<SoundNode>
   if (mTimeSigBeats > 0 && mTimeSigValue > 0)
     instance->SetTimeSignature(mTimeSigBeats, mTimeSigValue);
 
+  // Set the voice limit settings on the instance
+  instance->SetPriority(mPriority);
+  instance->SetVoiceGroup(mResourceId, mMaxRealVoices);
+  instance->SetResampleQuality(mResampleQuality);
+
   // Send the pre-play event
   SoundInstanceEvent event(instance);
   DispatchEvent(Events::SoundCuePrePlay, &event);
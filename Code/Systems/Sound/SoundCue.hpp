@@ -150,6 +150,9 @@ public:
   SoundCue();
   ~SoundCue();
 
+  /// Creates a SoundCue that only exists at runtime.
+  static HandleOf<SoundCue> CreateRuntime();
+
   void Serialize(Serializer& serializer) override;
   void Unload() override;
 
@@ -238,6 +241,21 @@ public:
   /// sound will not be attenuated.
   SoundAttenuator* GetAttenuator();
   void SetAttenuator(SoundAttenuator* attenuation);
+  /// When there are more playing SoundInstances than the real voice limits
+  /// allow, those with a lower priority will become virtual (keep their
+  /// position but not process audio) before those with a higher priority.
+  int GetPriority();
+  void SetPriority(int priority);
+  /// If this value is greater than zero, only this many SoundInstances played
+  /// by this SoundCue will process audio at once. The rest, starting with the
+  /// lowest priority and quietest, will be virtual.
+  int GetMaxRealVoices();
+  void SetMaxRealVoices(int maxVoices);
+  /// How SoundInstances played by this SoundCue resample their audio when the
+  /// pitch is changed. High keeps more of the sound's quality and is best for
+  /// music, Linear is cheaper and is good enough for short or distant sounds.
+  ResampleQuality::Enum GetResampleQuality();
+  void SetResampleQuality(ResampleQuality::Enum quality);
   /// Adds a new SoundEntry to this SoundCue.
   void AddSoundEntry(Sound* sound, float weight);
   /// Adds a new SoundTagEntry to this SoundCue.
@@ -268,6 +286,9 @@ private:
   float mBeatsPerMinute;
   float mTimeSigBeats;
   float mTimeSigValue;
+  int mPriority;
+  int mMaxRealVoices;
+  ResampleQuality::Enum mResampleQuality;
 };
 
 // Sound Cue Manager
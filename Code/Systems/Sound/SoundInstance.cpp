@@ -135,11 +135,11 @@ void MusicNotificationObject::ProcessAndNotify(float currentTime, SoundInstance*
       mBeatsCount = 0;
 
       // Send notification
-      Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicBar), instance);
+      Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicBar, instance);
     }
 
     // Send notification
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicBeat), instance);
+    Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicBeat, instance);
   }
 
   // Check for eighth notes
@@ -151,26 +151,26 @@ void MusicNotificationObject::ProcessAndNotify(float currentTime, SoundInstance*
     ++mEighthNoteCount;
 
     // Send notification for eighth note
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicEighthNote), instance);
+    Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicEighthNote, instance);
 
     // Check for other note values
 
     // Check for quarter note
     if (mEighthNoteCount % 2 == 0)
     {
-      Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicQuarterNote), instance);
+      Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicQuarterNote, instance);
     }
 
     // Check for half note
     if (mEighthNoteCount % 4 == 0)
     {
-      Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicHalfNote), instance);
+      Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicHalfNote, instance);
     }
 
     // Check for whole note
     if (mEighthNoteCount % 8 == 0)
     {
-      Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicWholeNote), instance);
+      Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicWholeNote, instance);
     }
   }
 }
@@ -192,12 +192,12 @@ void MusicNotificationObject::ResetBeats(float currentTime, SoundInstance* insta
     mBeatsCount = 0;
     mEighthNoteCount = 0;
 
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicBar), instance);
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicBeat), instance);
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicWholeNote), instance);
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicEighthNote), instance);
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicQuarterNote), instance);
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicHalfNote), instance);
+    Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicBar, instance);
+    Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicBeat, instance);
+    Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicWholeNote, instance);
+    Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicEighthNote, instance);
+    Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicQuarterNote, instance);
+    Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, instance, Events::MusicHalfNote, instance);
   }
   else
   {
@@ -237,6 +237,9 @@ RaverieDefineType(SoundInstance, builder, type)
   RaverieBindGetterSetter(CrossFadeLoopTail);
   RaverieBindGetterSetter(CustomEventTime);
   RaverieBindGetter(SoundName);
+  RaverieBindGetterSetter(Priority);
+  RaverieBindGetterSetter(ResampleQuality);
+  RaverieBindGetter(IsVirtual);
 
   RaverieBindEvent(Events::SoundLooped, SoundInstanceEvent);
   RaverieBindEvent(Events::SoundStopped, SoundInstanceEvent);
@@ -266,6 +269,11 @@ SoundInstance::SoundInstance(Status& status, SoundSpace* space, SoundAsset* asse
     mNotifyTime(0.0f),
     mCustomNotifySent(false),
     mPitchSemitones(0.0f),
+    mPriority(0),
+    mResampleQuality(ResampleQuality::Linear),
+    mVirtual(false),
+    mVoiceGroupId(0),
+    mVoiceGroupMaxReal(0),
     mFrameIndexThreaded(0),
     mPausingThreaded(false),
     mStoppingThreaded(false),
@@ -278,7 +286,8 @@ SoundInstance::SoundInstance(Status& status, SoundSpace* space, SoundAsset* asse
     mLoopEndFrameThreaded(asset->mFrameCount),
     mLoopTailFramesThreaded(0),
     PausingModifierThreaded(nullptr),
-    mSavedOutputVersionThreaded(Z::gSound->Mixer.mMixVersionThreaded - 1)
+    mSavedOutputVersionThreaded(Z::gSound->Mixer.mMixVersionThreaded - 1),
+    mAudibilityThreaded(0.0f)
 {
   Fade.mInstanceID = cNodeID;
 
@@ -555,10 +564,48 @@ String SoundInstance::GetSoundName()
     return "";
 }
 
+int SoundInstance::GetPriority()
+{
+  return mPriority.Get(AudioThreads::MainThread);
+}
+
+void SoundInstance::SetPriority(int priority)
+{
+  mPriority.Set(priority, AudioThreads::MainThread);
+}
+
+ResampleQuality::Enum SoundInstance::GetResampleQuality()
+{
+  return mResampleQuality;
+}
+
+void SoundInstance::SetResampleQuality(ResampleQuality::Enum quality)
+{
+  if (quality == mResampleQuality)
+    return;
+
+  mResampleQuality = quality;
+  Z::gSound->Mixer.AddTask(CreateFunctor(&SoundInstance::SetResampleQualityThreaded, this, quality), this);
+}
+
+bool SoundInstance::GetIsVirtual()
+{
+  return mVirtual.Get(AudioThreads::MainThread);
+}
+
+void SoundInstance::SetVoiceGroup(ResourceId cueId, int maxRealVoices)
+{
+  mVoiceGroupId = cueId;
+  mVoiceGroupMaxReal = Math::Max(maxRealVoices, 0);
+}
+
 void SoundInstance::Play(bool loop, SoundNode* outputNode, bool startPaused)
 {
   SetLooping(loop);
 
+  // Add the instance to the mixer's voice list so the voice limits apply to it
+  Z::gSound->Mixer.AddTask(CreateFunctor(&AudioMixer::AddVoiceThreaded, &Z::gSound->Mixer, this), this);
+
   // If there is an output node, add the instance as input
   if (outputNode)
     outputNode->AddInputNode(this);
@@ -630,11 +677,13 @@ bool SoundInstance::GetOutputForThisMixThreaded(BufferType* outputBuffer, const
     if (mFinished.Get() == cTrue || mPaused.Get() == cTrue)
       return false;
 
-    // if (mVirtual)
-    //{
-    //  SkipForward(bufferFrames);
-    //  return false;
-    //}
+    // If virtual, advance the playback position without processing any audio
+    if (mVirtual.Get(AudioThreads::MixThread))
+    {
+      mInputSamplesThreaded.Clear();
+      SkipForwardThreaded(outputBuffer->Size() / numberOfChannels);
+      return false;
+    }
 
     // Reset the InputSamples buffer
     mInputSamplesThreaded.Clear();
@@ -719,8 +768,13 @@ void SoundInstance::AddSamplesToBufferThreaded(BufferType* buffer, unsigned outp
   unsigned inputFrames = outputFrames;
   BufferType samples;
 
+  // The High quality filter delays its output and keeps a history of the
+  // previous frames, so it must see every buffer even when the pitch is not
+  // being shifted
+  bool usePitchHandler = mPitchShiftingThreaded || Pitch.GetQuality() == ResampleQuality::High;
+
   // If pitch shifting, determine number of asset frames we need
-  if (mPitchShiftingThreaded)
+  if (usePitchHandler)
   {
     Pitch.CalculateBufferSize(outputFrames * outputChannels, outputChannels);
     inputFrames = Pitch.GetInputFrameCount();
@@ -745,7 +799,7 @@ void SoundInstance::AddSamplesToBufferThreaded(BufferType* buffer, unsigned outp
     }
 
     // Reset back to the loop start frame
-    LoopThreaded();
+    LoopThreaded(true);
 
     // Save the number of frames in the second section
     sectionFrames = inputFrames - sectionFrames;
@@ -781,7 +835,7 @@ void SoundInstance::AddSamplesToBufferThreaded(BufferType* buffer, unsigned outp
     TranslateChannelsThreaded(&samples, inputFrames, inputChannels, outputChannels);
 
   // If pitch shifting, interpolate the samples into the buffer
-  if (mPitchShiftingThreaded)
+  if (usePitchHandler)
   {
     // Save the interpolation state
     bool interpolating = Pitch.Interpolating();
@@ -817,7 +871,7 @@ void SoundInstance::AddSamplesToBufferThreaded(BufferType* buffer, unsigned outp
         {
           mVolume.Set(volume, AudioThreads::MixThread);
 
-          Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchEventFromMixThread, (SoundNode*)this, Events::AudioInterpolationDone), this);
+          Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchEventFromMixThread, (SoundNode*)this, Events::AudioInterpolationDone, this);
         }
       }
 
@@ -854,10 +908,10 @@ void SoundInstance::AddSamplesToBufferThreaded(BufferType* buffer, unsigned outp
   MusicNotificationsThreaded();
 }
 
-void SoundInstance::LoopThreaded()
+void SoundInstance::LoopThreaded(bool fadeTail)
 {
   // Handle fading if we're not at the end of the audio
-  if (mLoopEndFrameThreaded < mEndFrameThreaded)
+  if (fadeTail && mLoopEndFrameThreaded < mEndFrameThreaded)
   {
     // Use the default cross fade size if streaming or if the variable hasn't
     // been set
@@ -871,7 +925,7 @@ void SoundInstance::LoopThreaded()
     Fade.StartFade(mVolume.Get(AudioThreads::MixThread), mLoopEndFrameThreaded, fadeSize, mAssetObject, mCrossFadeTail.Get() == cTrue);
   }
 
-  Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, this, Events::SoundLooped), this);
+  Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, this, Events::SoundLooped, this);
 
   // Reset variables
   mFrameIndexThreaded = mLoopStartFrameThreaded;
@@ -912,14 +966,14 @@ void SoundInstance::FinishedCleanUpThreaded()
   forRange (TagObject* tag, TagListThreaded.All())
     tag->RemoveInstanceThreaded(this);
 
-  Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, this, Events::SoundStopped), this);
-  Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::RemoveFromAllTagsThreaded, this), this);
-  Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundNode::RemoveAllOutputs, (SoundNode*)this), this);
+  Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, this, Events::SoundStopped, this);
+  Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::RemoveFromAllTagsThreaded, this, this);
+  Z::gSound->Mixer.AddTaskThreaded(&SoundNode::RemoveAllOutputs, (SoundNode*)this, this);
 
-  Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundAsset::RemoveInstance, *mAssetObject, cNodeID), this);
+  Z::gSound->Mixer.AddTaskThreaded(&SoundAsset::RemoveInstance, *mAssetObject, cNodeID, this);
 }
 
-bool SoundInstance::BelowMinimumVolumeThreaded(unsigned frames)
+float SoundInstance::GetAudibilityThreaded(unsigned frames)
 {
   // Determine overall volume at the beginning and end of the mix
   float volume1 = mVolume.Get(AudioThreads::MixThread);
@@ -927,7 +981,7 @@ bool SoundInstance::BelowMinimumVolumeThreaded(unsigned frames)
 
   // If interpolating volume, get the volume at the end of the mix
   if (mInterpolatingVolumeThreaded)
-    volume2 = VolumeInterpolatorThreaded.ValueAtIndex(mFrameIndexThreaded + frames);
+    volume2 = VolumeInterpolatorThreaded.ValueAtIndex(VolumeInterpolatorThreaded.GetCurrentFrame() + frames);
 
   // Adjust with all volume modifiers
   forRange (InstanceVolumeModifier* modifier, VolumeModListThreaded.All())
@@ -939,11 +993,92 @@ bool SoundInstance::BelowMinimumVolumeThreaded(unsigned frames)
     }
   }
 
-  // Return true if both volumes lower than minimum volume threshold
-  if (volume1 < Z::gSound->Mixer.mMinimumVolumeThresholdThreaded && volume2 < Z::gSound->Mixer.mMinimumVolumeThresholdThreaded)
-    return true;
+  // Use the louder of the two, adjusted by the attenuation from all outputs
+  return Math::Max(volume1, volume2) * GetAttenuationThisMixThreaded();
+}
+
+void SoundInstance::SetVirtualThreaded(bool isVirtual)
+{
+  if (isVirtual == mVirtual.Get(AudioThreads::MixThread))
+    return;
+
+  mVirtual.Set(isVirtual, AudioThreads::MixThread);
+
+  if (isVirtual)
+  {
+    // Saved samples are from before the instance went virtual
+    SavedSamplesThreaded.Clear();
+  }
   else
-    return false;
+  {
+    // Ramp the volume up to avoid a click when becoming real again
+    InstanceVolumeModifier* modifier = GetAvailableVolumeModThreaded();
+    modifier->Reset(0.0f, 1.0f, cPropertyChangeFrames, cPropertyChangeFrames);
+  }
+}
+
+void SoundInstance::SkipForwardThreaded(unsigned outputFrames)
+{
+  // Determine the number of asset frames that would have been used
+  unsigned inputFrames = outputFrames;
+  if (mPitchShiftingThreaded)
+    inputFrames = (unsigned)(outputFrames * Pitch.GetPitchFactor());
+
+  // Move the frame index forward
+  mFrameIndexThreaded += inputFrames;
+
+  // Check if we are looping and have passed the loop end frame
+  if (mLooping.Get() == cTrue)
+  {
+    int loopEndFrame = Math::Min(mLoopEndFrameThreaded, mEndFrameThreaded);
+    int loopFrames = loopEndFrame - mLoopStartFrameThreaded;
+    if (mFrameIndexThreaded >= loopEndFrame && loopFrames > 0)
+    {
+      // Wrap the extra frames around the loop (no tail, since nothing is heard)
+      int extraFrames = (mFrameIndexThreaded - loopEndFrame) % loopFrames;
+      LoopThreaded(false);
+      mFrameIndexThreaded += extraFrames;
+    }
+  }
+  // Check if we have reached the end of the audio
+  else if (mFrameIndexThreaded >= mEndFrameThreaded)
+  {
+    mFrameIndexThreaded = mEndFrameThreaded;
+    FinishedCleanUpThreaded();
+  }
+
+  // Move the volume interpolation forward
+  if (mInterpolatingVolumeThreaded)
+  {
+    VolumeInterpolatorThreaded.JumpForward(outputFrames);
+    mInterpolatingVolumeThreaded = !VolumeInterpolatorThreaded.Finished();
+    mVolume.Set(VolumeInterpolatorThreaded.GetCurrentValue(), AudioThreads::MixThread);
+
+    if (!mInterpolatingVolumeThreaded)
+      Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchEventFromMixThread, (SoundNode*)this, Events::AudioInterpolationDone, this);
+  }
+
+  // Move the volume modifiers forward
+  forRange (InstanceVolumeModifier* modifier, VolumeModListThreaded.All())
+    modifier->SkipForward(outputFrames);
+
+  // Nothing is heard while virtual, so pausing or stopping can finish now
+  if (mPausingThreaded)
+  {
+    mPaused.Set(cTrue);
+    mPausingThreaded = false;
+    if (PausingModifierThreaded)
+    {
+      PausingModifierThreaded->Active = false;
+      PausingModifierThreaded = nullptr;
+    }
+  }
+  else if (mStoppingThreaded)
+    FinishedCleanUpThreaded();
+
+  // Advance time and handle music notifications
+  mCurrentTime.Set(mFrameIndexThreaded * cSystemTimeIncrement, AudioThreads::MixThread);
+  MusicNotificationsThreaded();
 }
 
 void SoundInstance::RemoveFromAllTagsThreaded()
@@ -963,7 +1098,7 @@ void SoundInstance::MusicNotificationsThreaded()
   {
     mCustomNotifySent.Set(true, AudioThreads::MixThread);
 
-    Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundInstance::DispatchInstanceEventFromMixThread, this, Events::MusicCustomTime), this);
+    Z::gSound->Mixer.AddTaskThreaded(&SoundInstance::DispatchInstanceEventFromMixThread, this, Events::MusicCustomTime, this);
   }
 
   MusicNotify.ProcessAndNotify((float)mCurrentTime.Get(AudioThreads::MixThread), this);
@@ -1055,6 +1190,11 @@ void SoundInstance::SetPitchThreaded(float semitones, float time)
   }
 }
 
+void SoundInstance::SetResampleQualityThreaded(ResampleQuality::Enum quality)
+{
+  Pitch.SetQuality(quality);
+}
+
 void SoundInstance::SetTimeThreaded(float seconds)
 {
   // Only need to cross-fade if we're not at the beginning of the file
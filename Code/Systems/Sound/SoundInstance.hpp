@@ -218,6 +218,24 @@ public:
   void SetCustomEventTime(float seconds);
   /// The name of the Sound being played by this SoundInstance.
   String GetSoundName();
+  /// Used when there are more playing SoundInstances than the real voice limits
+  /// allow: SoundInstances with a lower priority will become virtual before
+  /// those with a higher priority. Initially set by the SoundCue's Priority
+  /// property.
+  int GetPriority();
+  void SetPriority(int priority);
+  /// How the audio is resampled when the pitch is changed. High uses a filter
+  /// that keeps more of the sound's quality (best for music and other
+  /// prominent sounds), Linear is cheaper and is good enough for short or
+  /// distant sounds. Initially set by the SoundCue's ResampleQuality property.
+  ResampleQuality::Enum GetResampleQuality();
+  void SetResampleQuality(ResampleQuality::Enum quality);
+  /// This Property will be true while the SoundInstance is virtual: it is
+  /// either too quiet to be heard or was pushed out by the real voice limits.
+  /// A virtual SoundInstance keeps advancing its playback position but does not
+  /// process any audio, and resumes from the right position when it becomes
+  /// real again.
+  bool GetIsVirtual();
 
   // Internals
   Array<SoundTag*> SoundTags;
@@ -226,6 +244,9 @@ public:
   void SetBeatsPerMinute(float beats);
   // Sets the time signature of the music.
   void SetTimeSignature(float beats, float noteType);
+  // Sets the SoundCue whose real voice limit applies to this instance (zero
+  // for no limit). Must be called before playing.
+  void SetVoiceGroup(ResourceId cueId, int maxRealVoices);
 
   void Play(bool loop, SoundNode* outputNode, bool startPaused);
 
@@ -236,6 +257,11 @@ public:
   bool GetOutputForThisMixThreaded(BufferType* buffer, const unsigned numberOfChannels);
   // Gets the cumulative volume attenuation from all output nodes
   float GetAttenuationThisMixThreaded();
+  // Estimates how loud this instance will be over the specified number of
+  // frames, including volume modifiers and attenuation
+  float GetAudibilityThreaded(unsigned frames);
+  // Makes this instance virtual or real
+  void SetVirtualThreaded(bool isVirtual);
 
   void DispatchInstanceEventFromMixThread(const String eventID);
 
@@ -243,15 +269,16 @@ private:
   bool GetOutputSamples(BufferType* outputBuffer, const unsigned numberOfChannels, ListenerNode* listener, const bool firstRequest) override;
   // Fills the provided buffer with the audio data for the current mix
   void AddSamplesToBufferThreaded(BufferType* buffer, unsigned outputFrames, unsigned outputChannels);
-  // Resets back to the loop start point
-  void LoopThreaded();
+  // Resets back to the loop start point, optionally fading out the loop tail
+  void LoopThreaded(bool fadeTail);
   // Translates the audio data in the array to the specified output channels,
   // and puts the data back into the array
   static void TranslateChannelsThreaded(BufferType* inputSamples, const unsigned inputFrames, const unsigned inputChannels, const unsigned outputChannels);
   // Sends notification and removes instance from any associated tags.
   void FinishedCleanUpThreaded();
-  // Check for whether the total volume is lower than the minimum.
-  bool BelowMinimumVolumeThreaded(unsigned frames);
+  // Advances the playback position without producing any audio (used while
+  // virtual)
+  void SkipForwardThreaded(unsigned outputFrames);
   // Removes this instance from all tags it is associated with.
   void RemoveFromAllTagsThreaded();
   // Handle music beat notifications.
@@ -266,10 +293,13 @@ private:
   void StopThreaded();
   void SetVolumeThreaded(float newVolume, float time);
   void SetPitchThreaded(float semitones, float time);
+  void SetResampleQualityThreaded(ResampleQuality::Enum quality);
   void SetTimeThreaded(float seconds);
   void SetBeatsPerMinuteThreaded(float beats);
   void SetTimeSignatureThreaded(float beats, float noteType);
 
+  friend class AudioMixer;
+
   typedef Raverie::Array<TagObject*> TagListType;
   // List of tags that the instance is currently associated with.
   TagListType TagListThreaded;
@@ -311,6 +341,17 @@ private:
   Threaded<bool> mCustomNotifySent;
   // The current number of semitones by which the pitch is being changed.
   Threaded<float> mPitchSemitones;
+  // Priority used by the real voice limits (higher is more important).
+  Threaded<int> mPriority;
+  // How the pitch change handler resamples the audio.
+  ResampleQuality::Enum mResampleQuality;
+  // If true, the instance is virtual and is not processing audio.
+  Threaded<bool> mVirtual;
+  // The SoundCue that played this instance, used for its real voice limit.
+  ResourceId mVoiceGroupId;
+  // The maximum number of real instances played by the same SoundCue (zero for
+  // no limit).
+  int mVoiceGroupMaxReal;
 
   const float cMaxLoopTailTime = 30.0f;
 
@@ -346,6 +387,8 @@ private:
   Array<InstanceVolumeModifier*> VolumeModListThreaded;
   // The mix version of the audio data saved in InputSamples
   unsigned mSavedOutputVersionThreaded;
+  // The audibility estimated for the current mix, used to sort voices.
+  float mAudibilityThreaded;
   // Processed samples that are saved between mixes
   BufferType SavedSamplesThreaded;
 };
@@ -46,7 +46,8 @@ RaverieDefineType(SoundNode, builder, type)
 SoundNode::SoundNode(StringParam name, int ID, bool listenerDependent, bool generator) :
     cNodeID(ID),
     cName(name),
-    mOkayToSaveThreaded(!listenerDependent),
+    mDependsOnListenerThreaded(listenerDependent),
+    mAnalyzedVersionThreaded(Z::gSound->Mixer.mMixVersionThreaded - 1),
     mInProcessThreaded(false),
     mMixedVersionThreaded(Z::gSound->Mixer.mMixVersionThreaded - 1),
     mNumMixedChannelsThreaded(0),
@@ -366,6 +367,34 @@ float SoundNode::GetVolumeChangeFromOutputsThreaded()
   return volume;
 }
 
+bool SoundNode::UpdateListenerDependenceThreaded()
+{
+  // Check if this version has already been analyzed
+  unsigned mixVersion = Z::gSound->Mixer.mMixVersionThreaded;
+  if (mAnalyzedVersionThreaded == mixVersion)
+    return mDependsOnListenerThreaded;
+
+  // Mark as analyzed before the inputs so a loop in the node structure doesn't
+  // recurse forever (the loop will be reported when the node is evaluated)
+  mAnalyzedVersionThreaded = mixVersion;
+  mDependsOnListenerThreaded = mListenerDependentThreaded;
+
+  // Every input must be analyzed, even once the answer is known
+  bool inputsDependOnListener = false;
+  forRange (SoundNode* input, mInputs[AudioThreads::MixThread].All())
+  {
+    if (input->UpdateListenerDependenceThreaded())
+      inputsDependOnListener = true;
+  }
+
+  // If any input depends on the listener, so does this node, unless it chooses
+  // the listener for its inputs itself
+  if (inputsDependOnListener && !ProvidesListenerThreaded())
+    mDependsOnListenerThreaded = true;
+
+  return mDependsOnListenerThreaded;
+}
+
 bool SoundNode::Evaluate(BufferType* outputBuffer, const unsigned numberOfChannels, ListenerNode* listener)
 {
   bool hasOutput;
@@ -384,16 +413,16 @@ bool SoundNode::Evaluate(BufferType* outputBuffer, const unsigned numberOfChanne
     if (!message.Empty())
     {
       String title = "Incorrect SoundNode Structure";
-      Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundNode::WarningFromMixThread, this, title, message), this);
+      Z::gSound->Mixer.AddTaskThreaded(&SoundNode::WarningFromMixThread, this, title, message, this);
 
-      Z::gSound->Mixer.AddTaskThreaded(CreateFunctor(&SoundNode::RemoveAndAttachInputsToOutputs, this), this);
+      Z::gSound->Mixer.AddTaskThreaded(&SoundNode::RemoveAndAttachInputsToOutputs, this, this);
 
       return false;
     }
 
-    // If this node is saved, or if the listener matches the last mix, can
-    // simply copy data
-    if (mOkayToSaveThreaded || listener == mMixedListenerThreaded)
+    // If this node doesn't depend on the listener, or if the listener matches
+    // the last mix, can simply copy data
+    if (!mDependsOnListenerThreaded || listener == mMixedListenerThreaded)
     {
       // Copy mixed samples to output buffer if there is real data
       if (mValidOutputLastMix.Get() == cTrue)
@@ -426,27 +455,19 @@ bool SoundNode::Evaluate(BufferType* outputBuffer, const unsigned numberOfChanne
     mInProcessThreaded = true;
     mMixedVersionThreaded = Z::gSound->Mixer.mMixVersionThreaded;
     mNumMixedChannelsThreaded = numberOfChannels;
+
+    // The mixer analyzes the whole node structure before each mix, but make
+    // sure this node is included
+    // (if the output doesn't depend on the listener, it is processed without
+    // one so that the whole subtree is shared by all listeners and any data
+    // kept per listener isn't duplicated)
+    if (!UpdateListenerDependenceThreaded())
+      listener = nullptr;
     mMixedListenerThreaded = listener;
 
     // Set mixed array to same size as output array
     mMixedOutputThreaded.Resize(outputBuffer->Size());
 
-    // Check whether this node's data can be saved
-    mOkayToSaveThreaded = !mListenerDependentThreaded;
-    // If this node can be saved, check all its inputs to verify
-    // (if any inputs can't be saved, neither can this node)
-    if (mOkayToSaveThreaded)
-    {
-      forRange (SoundNode* input, mInputs[AudioThreads::MixThread].All())
-      {
-        if (!input->mOkayToSaveThreaded)
-        {
-          mOkayToSaveThreaded = false;
-          break;
-        }
-      }
-    }
-
     // Get output
     hasOutput = GetOutputSamples(&mMixedOutputThreaded, numberOfChannels, listener, true);
 
@@ -500,10 +521,7 @@ bool SoundNode::AccumulateInputSamples(const unsigned howManySamples, const unsi
       // Otherwise add the new samples to the existing ones
       else
       {
-        for (BufferRange myData = mInputSamplesThreaded.All(), newData = tempBuffer.All(); !myData.Empty(); myData.PopFront(), newData.PopFront())
-        {
-          myData.Front() += newData.Front();
-        }
+        MixBuffer(tempBuffer.Data(), mInputSamplesThreaded.Data(), 1.0f, howManySamples);
       }
     }
   }
@@ -517,12 +535,7 @@ void SoundNode::AddBypassThreaded(BufferType* outputBuffer)
   // with a percentage of the input buffer
   float bypassValue = mBypassValue.Get(AudioThreads::MixThread);
   if (bypassValue > 0.0f)
-  {
-    for (BufferRange outputRange = outputBuffer->All(), inputRange = mInputSamplesThreaded.All(); !outputRange.Empty(); outputRange.PopFront(), inputRange.PopFront())
-    {
-      outputRange.Front() = (inputRange.Front() * bypassValue) + (outputRange.Front() * (1.0f - bypassValue));
-    }
-  }
+    BlendBuffer(mInputSamplesThreaded.Data(), outputBuffer->Data(), bypassValue, Math::Min(outputBuffer->Size(), mInputSamplesThreaded.Size()));
 }
 
 void SoundNode::AddInputNodeThreaded(HandleOf<SoundNode> newNode)
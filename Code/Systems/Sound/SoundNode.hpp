@@ -101,7 +101,13 @@ public:
   // The output node will return 1.0. Nodes which modify volume should implement
   // this function and multiply their volume with the return value.
   virtual float GetVolumeChangeFromOutputsThreaded();
-  // Handles getting the output from the sound node
+  // Finds whether this node's output depends on the listener it is requested
+  // for during the current mix, analyzing all of its inputs first. Only does
+  // the analysis once per mix, later calls return the saved result.
+  bool UpdateListenerDependenceThreaded();
+  // Handles getting the output from the sound node. If the output doesn't
+  // depend on the listener it is only processed once per mix for all
+  // listeners.
   bool Evaluate(BufferType* outputBuffer, const unsigned numberOfChannels, ListenerNode* listener);
   // Adds the output from all input nodes to the InputSamples buffer
   bool AccumulateInputSamples(const unsigned howManySamples, const unsigned numberOfChannels, ListenerNode* listener);
@@ -112,10 +118,21 @@ public:
   void AddInputNodeThreaded(HandleOf<SoundNode> newNode);
   void RemoveInputNodeThreaded(HandleOf<SoundNode> node);
 
+protected:
+  // Should return true by nodes that request their inputs for a listener of
+  // their own choosing, so their output doesn't depend on the listener they
+  // are requested for
+  virtual bool ProvidesListenerThreaded()
+  {
+    return false;
+  }
+
 private:
-  // If false, this node's output should not be saved into the MixedOutput
-  // buffer
-  bool mOkayToSaveThreaded;
+  // If true, this node's output depends on the listener it is requested for
+  // during the current mix, so it can't be shared between listeners
+  bool mDependsOnListenerThreaded;
+  // Mix version number of the last listener dependence analysis
+  unsigned mAnalyzedVersionThreaded;
   // Array of nodes to use as inputs
   NodeListType mInputs[2];
   // Array of nodes using this node as input
@@ -16,6 +16,8 @@ RaverieDefineEnum(SynthWaveType);
 RaverieDefineEnum(AudioMixTypes);
 RaverieDefineEnum(AudioLatency);
 RaverieDefineEnum(GranularSynthWindows);
+RaverieDefineEnum(ResampleQuality);
+RaverieDefineEnum(SoundBenchmarkGraph);
 
 // Arrays
 RaverieDefineArrayType(Array<SoundEntry>);
@@ -37,6 +39,8 @@ RaverieDefineStaticLibrary(SoundLibrary)
   RaverieInitializeEnum(AudioMixTypes);
   RaverieInitializeEnum(AudioLatency);
   RaverieInitializeEnum(GranularSynthWindows);
+  RaverieInitializeEnum(ResampleQuality);
+  RaverieInitializeEnum(SoundBenchmarkGraph);
 
   // Arrays
   RaverieInitializeArrayTypeAs(Array<SoundEntry>, "Sounds");
@@ -84,6 +88,7 @@ RaverieDefineStaticLibrary(SoundLibrary)
   RaverieInitializeType(BandPassNode);
   RaverieInitializeType(EqualizerNode);
   RaverieInitializeType(ReverbNode);
+  RaverieInitializeType(ConvolutionReverbNode);
   RaverieInitializeType(DelayNode);
   RaverieInitializeType(FlangerNode);
   RaverieInitializeType(ChorusNode);
@@ -110,6 +115,7 @@ RaverieDefineStaticLibrary(SoundLibrary)
   RaverieInitializeType(SoundAsset);
   RaverieInitializeType(DecompressedSoundAsset);
   RaverieInitializeType(StreamingSoundAsset);
+  RaverieInitializeType(SoundBenchmark);
 
   EngineLibraryExtensions::AddNativeExtensions(builder);
 }
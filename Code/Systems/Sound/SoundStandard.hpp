@@ -63,5 +63,6 @@ public:
 #include "SoundSystem.hpp"
 #include "Sound.hpp"
 #include "SoundCue.hpp"
+#include "SoundBenchmark.hpp"
 #include "SimpleSound.hpp"
 #include "SimpleSound.hpp"
@@ -101,6 +101,7 @@ RaverieDefineType(SoundSystem, builder, type)
   RaverieBindMethod(BandPassNode);
   RaverieBindMethod(EqualizerNode);
   RaverieBindMethod(ReverbNode);
+  RaverieBindMethod(ConvolutionReverbNode);
   RaverieBindMethod(DelayNode);
   RaverieBindMethod(CustomAudioNode);
   RaverieBindMethod(SoundBuffer);
@@ -294,6 +295,12 @@ ReverbNode* SoundSystem::ReverbNode()
   return node;
 }
 
+ConvolutionReverbNode* SoundSystem::ConvolutionReverbNode()
+{
+  Raverie::ConvolutionReverbNode* node = new Raverie::ConvolutionReverbNode("ConvolutionReverbNode", Z::gSound->mCounter++);
+  return node;
+}
+
 DelayNode* SoundSystem::DelayNode()
 {
   Raverie::DelayNode* node = new Raverie::DelayNode("DelayNode", Z::gSound->mCounter++);
@@ -458,10 +465,12 @@ RaverieDefineType(AudioSettings, builder, type)
   RaverieBindGetterSetterProperty(Seed)->RaverieFilterEquality(mUseRandomSeed, bool, false);
   RaverieBindGetterSetterProperty(MixType);
   RaverieBindGetterSetterProperty(MinVolumeThreshold)->Add(new EditorSlider(0.0f, 0.2f, 0.001f));
+  RaverieBindGetterSetterProperty(MaxRealVoices);
+  RaverieBindGetterSetterProperty(StreamingCacheSize);
   RaverieBindGetterSetterProperty(LatencySetting);
 }
 
-AudioSettings::AudioSettings() : mSystemVolume(1.0f), mMinVolumeThreshold(0.015f), mMixType(AudioMixTypes::AutoDetect), mLatency(AudioLatency::Low), mUseRandomSeed(true), mSeed(0)
+AudioSettings::AudioSettings() : mSystemVolume(1.0f), mMinVolumeThreshold(0.015f), mMaxRealVoices(64), mStreamingCacheSize(16), mMixType(AudioMixTypes::AutoDetect), mLatency(AudioLatency::Low), mUseRandomSeed(true), mSeed(0)
 {
 }
 
@@ -470,6 +479,8 @@ void AudioSettings::Serialize(Serializer& stream)
   SerializeNameDefault(mSystemVolume, 1.0f);
   SerializeEnumNameDefault(AudioMixTypes, mMixType, AudioMixTypes::AutoDetect);
   SerializeNameDefault(mMinVolumeThreshold, 0.015f);
+  SerializeNameDefault(mMaxRealVoices, 64);
+  SerializeNameDefault(mStreamingCacheSize, 16);
   SerializeEnumNameDefault(AudioLatency, mLatency, AudioLatency::Low);
   SerializeNameDefault(mUseRandomSeed, true);
   SerializeNameDefault(mSeed, 0u);
@@ -480,6 +491,8 @@ void AudioSettings::Initialize(CogInitializer& initializer)
   Z::gSound->Mixer.SetVolume(mSystemVolume);
   SetMixType(mMixType);
   Z::gSound->Mixer.SetMinimumVolumeThreshold(mMinVolumeThreshold);
+  Z::gSound->Mixer.SetMaxRealVoices(mMaxRealVoices);
+  Z::gSound->Mixer.SetStreamingCacheSize(mStreamingCacheSize);
   Z::gSound->SetLatencySetting(mLatency);
   Z::gSound->mUseRandomSeed = mUseRandomSeed;
   Z::gSound->mSeed = mSeed;
@@ -556,6 +569,28 @@ void AudioSettings::SetMinVolumeThreshold(float volume)
   Z::gSound->Mixer.SetMinimumVolumeThreshold(mMinVolumeThreshold);
 }
 
+int AudioSettings::GetMaxRealVoices()
+{
+  return mMaxRealVoices;
+}
+
+void AudioSettings::SetMaxRealVoices(int maxVoices)
+{
+  mMaxRealVoices = Math::Max(maxVoices, 0);
+  Z::gSound->Mixer.SetMaxRealVoices(mMaxRealVoices);
+}
+
+int AudioSettings::GetStreamingCacheSize()
+{
+  return mStreamingCacheSize;
+}
+
+void AudioSettings::SetStreamingCacheSize(int megabytes)
+{
+  mStreamingCacheSize = Math::Clamp(megabytes, 1, 1024);
+  Z::gSound->Mixer.SetStreamingCacheSize(mStreamingCacheSize);
+}
+
 Raverie::AudioLatency::Enum AudioSettings::GetLatencySetting()
 {
   return mLatency;
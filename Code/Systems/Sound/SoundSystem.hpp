@@ -169,6 +169,8 @@ public:
   static EqualizerNode* EqualizerNode();
   /// Creates a new ReverbNode object
   static ReverbNode* ReverbNode();
+  /// Creates a new ConvolutionReverbNode object
+  static ConvolutionReverbNode* ConvolutionReverbNode();
   /// Creates a new DelayNode object
   static DelayNode* DelayNode();
   /// Creates a new FlangerNode object
@@ -241,6 +243,12 @@ namespace Z
 extern SoundSystem* gSound;
 } // namespace Z
 
+template <typename T>
+void SetThreadedValueFromMixThread(T* pointer, T value)
+{
+  Z::gSound->Mixer.AddTaskThreaded(pointer, value, nullptr);
+}
+
 // Sound Settings
 
 class AudioSettings : public Component
@@ -270,6 +278,16 @@ public:
   /// This is a floating point volume number, not decibels.
   float GetMinVolumeThreshold();
   void SetMinVolumeThreshold(float volume);
+  /// The maximum number of SoundInstances that will process audio at once. When
+  /// more are playing, those with the lowest priority and volume will be
+  /// virtualized. A value of zero means there is no limit.
+  int GetMaxRealVoices();
+  void SetMaxRealVoices(int maxVoices);
+  /// The maximum memory, in megabytes, used to keep decoded audio from
+  /// streaming Sounds. Instances of the same streaming Sound share this decoded
+  /// audio instead of each decoding the file separately.
+  int GetStreamingCacheSize();
+  void SetStreamingCacheSize(int megabytes);
   /// Using the high latency setting can fix some audio problems (such as clicks
   /// and static) but can lead to a slight delay in the audio
   AudioLatency::Enum GetLatencySetting();
@@ -285,6 +303,8 @@ public:
 private:
   float mSystemVolume;
   float mMinVolumeThreshold;
+  int mMaxRealVoices;
+  int mStreamingCacheSize;
   AudioMixTypes::Enum mMixType;
   AudioLatency::Enum mLatency;
   bool mUseRandomSeed;
@@ -23,6 +23,7 @@ RaverieDefineType(TagObject, builder, type)
 
 TagObject::TagObject() :
     mInstanceLimit(0),
+    mMaxRealVoices(0),
     mPaused(false),
     mUseEqualizer(false),
     mUseCompressor(false),
@@ -387,6 +388,7 @@ RaverieDefineType(SoundTag, builder, type)
   RaverieBindGetterSetter(CompressorRatio);
   RaverieBindGetterSetter(CompressorKneeWidth);
   RaverieBindGetterSetter(InstanceLimit);
+  RaverieBindGetterSetter(MaxRealVoices);
   RaverieBindGetter(InstanceCount);
   RaverieBindGetterSetter(Paused);
   RaverieBindGetter(Instances);
@@ -772,6 +774,20 @@ void SoundTag::SetInstanceLimit(float limit)
     mTagObject->mInstanceLimit = (int)limit;
 }
 
+int SoundTag::GetMaxRealVoices()
+{
+  if (mTagObject)
+    return mTagObject->mMaxRealVoices.Get(AudioThreads::MainThread);
+  else
+    return 0;
+}
+
+void SoundTag::SetMaxRealVoices(int maxVoices)
+{
+  if (mTagObject)
+    mTagObject->mMaxRealVoices.Set(Math::Max(maxVoices, 0), AudioThreads::MainThread);
+}
+
 void SoundTag::CreateTag()
 {
   if (!mTagObject)
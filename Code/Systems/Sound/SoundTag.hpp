@@ -68,6 +68,9 @@ public:
 
   // The maximum number of instances that can be played with this tag
   int mInstanceLimit;
+  // The maximum number of tagged instances that can be real at once (zero for
+  // no limit)
+  Threaded<int> mMaxRealVoices;
   // If true, all associated sound instances are currently paused
   Threaded<bool> mPaused;
   // If true, the equalizer filter will be applied to tagged instances
@@ -240,6 +243,11 @@ public:
   /// play if the number of tagged SoundInstances is less than this number.
   float GetInstanceLimit();
   void SetInstanceLimit(float limit);
+  /// If this value is greater than zero, only this many tagged SoundInstances
+  /// will process audio at once. The rest, starting with the lowest priority
+  /// and quietest, will be virtual until a real voice is available.
+  int GetMaxRealVoices();
+  void SetMaxRealVoices(int maxVoices);
 
   // Internals
   HandleOf<TagObject> mTagObject;
@@ -46,6 +46,27 @@ void InstanceVolumeModifier::ApplyVolume(float* sampleBuffer, const unsigned buf
   }
 }
 
+void InstanceVolumeModifier::SkipForward(const unsigned howManyFrames)
+{
+  if (!Active)
+    return;
+
+  // Check the lifetime the same way as when applying the volume
+  ++mLifetimeFrameCounter;
+  if (mLifetimeFrames > 0 && mLifetimeFrameCounter > mLifetimeFrames)
+  {
+    Active = false;
+    return;
+  }
+
+  // Move the interpolation forward to where it would be after these frames
+  if (!Interpolator.Finished())
+  {
+    Interpolator.JumpForward(howManyFrames);
+    mCurrentVolume = Interpolator.GetCurrentValue();
+  }
+}
+
 void InstanceVolumeModifier::Reset(const float startVolume, const float endVolume, const float time, const float lifetime)
 {
   Reset(startVolume, endVolume, (unsigned)(time * AudioConstants::cSystemSampleRate), (unsigned)(lifetime * AudioConstants::cSystemSampleRate));
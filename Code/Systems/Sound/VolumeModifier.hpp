@@ -16,6 +16,9 @@ public:
 
   // Applies this modification to a buffer of samples.
   void ApplyVolume(float* sampleBuffer, const unsigned bufferSize, const unsigned channels);
+  // Advances this modification by a number of frames without applying it
+  // (used by virtual sound instances).
+  void SkipForward(const unsigned howManyFrames);
   // Resets the modifier with new volume and time data.
   void Reset(const float startVolume, const float endVolume, const float changeTime, const float lifetime);
   void Reset(const float startVolume, const float endVolume, const unsigned changeFrames, const unsigned lifetimeFrames);
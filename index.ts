@@ -773,6 +773,63 @@ const prebuilt = async (options) => {
   endPnot();
 };
 
+const benchmark = async (options) => {
+  console.log("Running Replication Benchmark");
+  const endPnot = preventNoOutputTimeout();
+  const combo = determineCmakeCombo(options);
+
+  // We need to do this because this creates the 'Active' symlink, which the page builder uses
+  activateBuildDir(combo);
+
+  const port = 3000;
+  const server = await (await vite).createServer({
+    configFile: false,
+    root: dirs.browser,
+    server: {
+      port: 3000
+    }
+  });
+
+  await server.listen();
+  server.printUrls();
+
+  const browser = await puppeteer.launch({
+    headless: "new",
+    timeout: 0
+  });
+  const page = await browser.newPage();
+
+  // The editor prints a single result line once the benchmark finishes
+  const resultPrefix = "ReplicationBenchmark: ";
+  const resultPromise = new Promise<string>((resolve) => {
+    page.on("console", (event) => {
+      const text = event.text();
+      if (text.startsWith(resultPrefix)) {
+        resolve(text.substring(resultPrefix.length).trim());
+      } else {
+        printLogLine(text);
+      }
+    });
+  });
+  page.on("error", (event) => parseLines(event.stack, printErrorLine));
+  page.on("pageerror", (event) => parseLines(event.stack, printErrorLine));
+
+  // Extra arguments override the benchmark settings, e.g. --args="-Clients 8 -Latency 50"
+  const url = new URL(`http://localhost:${port}/`);
+  url.searchParams.set("args", `-ReplicationBenchmark ${options.args || ""}`.trim());
+  await page.goto(url.href);
+  const result = await resultPromise;
+
+  await server.close();
+  await browser.close();
+
+  if (result === "failed") {
+    printErrorLine("Replication benchmark failed");
+  } else {
+    console.log(result);
+  }
+  endPnot();
+};
 
 const documentation = async () => {
   console.log("Running Doxygen");
@@ -870,6 +927,8 @@ const main = async () => {
     usage("documentation").
     command("prebuilt", "Copy prebuilt content", empty, prebuilt).
     usage(`prebuilt ${comboOptions}`).
+    command("benchmark", "Run the replication benchmark headless and print its results", empty, benchmark).
+    usage(`benchmark [--args=...] ${comboOptions}`).
     command("deploy", "Deploy the build", empty, deploy).
     usage(`deploy ${comboOptions}`).
     command("all", "Run all the expected commands in order: cmake build prebuilt documentation build optimize", empty, all).